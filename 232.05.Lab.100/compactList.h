@@ -0,0 +1,451 @@
+/***********************************************************************
+ * Header:
+ *    COMPACT LIST
+ * Summary:
+ *    A doubly linked list with the same interface as custom::list,
+ *    except that the nodes live in a pool and are linked by 32-bit
+ *    indices. On a 64-bit build that halves the link overhead of
+ *    every element and keeps the nodes close together in memory.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        compact_list           : A list whose nodes live in a pool
+ *        compact_list::iterator : An iterator through compact_list
+ * Authors
+ *    Hunter Powell
+ *    Carol Mercau
+ *    Elijah Harrison
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <initializer_list>
+#include "pool.h"      // for pool
+
+class TestCompactList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * COMPACT LIST
+ * Just like custom::list, but index-linked
+ **************************************************/
+template <typename T>
+class compact_list
+{
+   friend class ::TestCompactList; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+   compact_list() : numElements(0), iHead(NIL), iTail(NIL) { }
+   compact_list(size_t num, const T & t);
+   compact_list(size_t num) : compact_list(num, T())                         { }
+   compact_list(const compact_list <T> & rhs) : compact_list()               { *this = rhs; }
+   compact_list(compact_list <T> && rhs) : compact_list()                    { *this = std::move(rhs); }
+   compact_list(const std::initializer_list<T> & il) : compact_list()        { *this = il; }
+   template <class Iterator>
+   compact_list(Iterator first, Iterator last) : compact_list()
+   {
+      for (auto it = first; it != last; ++it)
+         push_back(*it);
+   }
+  ~compact_list()                                                            { clear(); }
+
+   //
+   // Assign
+   //
+   compact_list <T> & operator = (const compact_list & rhs);
+   compact_list <T> & operator = (compact_list && rhs);
+   compact_list <T> & operator = (const std::initializer_list<T> & il);
+   void swap(compact_list & rhs);
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin()  { return iterator(this, iHead); }
+   iterator rbegin() { return iterator(this, iTail); }
+   iterator end()    { return iterator(this, NIL);   }
+
+   //
+   // Access
+   //
+   T & front();
+   T & back();
+
+   //
+   // Insert
+   //
+   void push_front(const T &  data) { insert(begin(), data);                       }
+   void push_front(      T && data) { insert(begin(), std::move(data));            }
+   void push_back (const T &  data) { insert(end(), data, true);                   }
+   void push_back (      T && data) { insert(end(), std::move(data), true);        }
+   iterator insert(iterator it, const T &  data, bool after = false)
+   {
+      return link(it, nodes.allocate(data), after);
+   }
+   iterator insert(iterator it,       T && data, bool after = false)
+   {
+      return link(it, nodes.allocate(std::move(data)), after);
+   }
+
+   //
+   // Remove
+   //
+   void pop_front()  { erase(begin());  }
+   void pop_back()   { erase(rbegin()); }
+   void clear();
+   iterator erase(const iterator & it);
+
+   //
+   // Status
+   //
+   bool empty()  const { return !size(); }
+   size_t size() const { return numElements; }
+
+private:
+   // nested linked list node
+   class Node;
+   typedef uint32_t index;
+   static const index NIL = 0xFFFFFFFF;
+
+   iterator link(iterator it, index iNew, bool after);
+
+   // member variables
+   pool <Node> nodes;  // where the nodes actually live
+   size_t numElements; // number of live nodes
+   index iHead;        // index of the beginning of the list
+   index iTail;        // index of the ending of the list
+};
+
+/*************************************************
+ * NODE
+ * Same as list::Node, but the links are indices
+ * into the owning list's pool
+ *************************************************/
+template <typename T>
+class compact_list <T> :: Node
+{
+public:
+   //
+   // Construct
+   //
+   Node(const T &  data) : data(data),            iNext(NIL), iPrev(NIL) { }
+   Node(      T && data) : data(std::move(data)), iNext(NIL), iPrev(NIL) { }
+
+   //
+   // Data
+   //
+   T data;        // user data
+   index iNext;   // index of next node
+   index iPrev;   // index of previous node
+};
+
+/*************************************************
+ * COMPACT LIST ITERATOR
+ * An index alone does not say which pool it is in,
+ * so the iterator also remembers its list
+ ************************************************/
+template <typename T>
+class compact_list <T> :: iterator
+{
+   friend class ::TestCompactList; // give unit tests access to the privates
+   template <typename TT>
+   friend class custom::compact_list;
+public:
+   // constructors, destructors, and assignment operator
+   iterator()                                 : pList(nullptr), i(NIL) { }
+   iterator(compact_list <T> * pList, index i) : pList(pList),   i(i)   { }
+   iterator(const iterator & rhs)             : pList(rhs.pList), i(rhs.i) { }
+
+   iterator & operator = (const iterator & rhs)
+   {
+      pList = rhs.pList;
+      i = rhs.i;
+      return *this;
+   }
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return i == rhs.i; }
+   bool operator != (const iterator & rhs) const { return i != rhs.i; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return pList->nodes[i].data; }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+      if (i != NIL) i = pList->nodes[i].iNext;
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int postfix)
+   {
+      iterator tmp(*this);
+      ++(*this);
+      return tmp;
+   }
+
+   // prefix decrement
+   iterator & operator -- ()
+   {
+      if (i != NIL) i = pList->nodes[i].iPrev;
+      return *this;
+   }
+
+   // postfix decrement
+   iterator operator -- (int postfix)
+   {
+      iterator tmp(*this);
+      --(*this);
+      return tmp;
+   }
+
+private:
+   compact_list <T> * pList;  // the list whose pool we index into
+   index i;                   // the node, or NIL for end()
+};
+
+/*****************************************
+ * COMPACT LIST :: NON-DEFAULT constructors
+ * Create a list initialized to a value of size num
+ ****************************************/
+template <typename T>
+compact_list <T> :: compact_list(size_t num, const T & t) : compact_list()
+{
+   for (size_t i = 0; i < num; i++)
+      push_back(t);
+}
+
+/**********************************************
+ * COMPACT LIST :: assignment operator
+ * Copy one list onto another, reusing the nodes we
+ * already have before allocating or freeing any
+ *     INPUT  : a list to be copied
+ *     COST   : O(n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+compact_list <T> & compact_list <T> :: operator = (const compact_list <T> & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   index iDest = iHead;
+   for (index iSrc = rhs.iHead; iSrc != NIL; iSrc = rhs.nodes[iSrc].iNext)
+   {
+      if (iDest != NIL)
+      {
+         nodes[iDest].data = rhs.nodes[iSrc].data;
+         iDest = nodes[iDest].iNext;
+      }
+      else
+         push_back(rhs.nodes[iSrc].data);
+   }
+
+   // whatever is left over on our side is extra
+   while (iDest != NIL)
+   {
+      index iNext = nodes[iDest].iNext;
+      erase(iterator(this, iDest));
+      iDest = iNext;
+   }
+
+   return *this;
+}
+
+/**********************************************
+ * COMPACT LIST :: assignment operator - MOVE
+ * Steal the pool from the right-hand-side
+ *     INPUT  : a list to be moved
+ *     COST   : O(n) with respect to the size of the LHS
+ *********************************************/
+template <typename T>
+compact_list <T> & compact_list <T> :: operator = (compact_list <T> && rhs)
+{
+   clear();
+   swap(rhs);
+   return *this;
+}
+
+/**********************************************
+ * COMPACT LIST :: assignment operator
+ * Copy an initializer list onto the list
+ *     INPUT  : a list to be copied
+ *     COST   : O(n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+compact_list <T> & compact_list <T> :: operator = (const std::initializer_list<T> & il)
+{
+   clear();
+   for (auto && t : il)
+      push_back(t);
+   return *this;
+}
+
+/**********************************************
+ * COMPACT LIST :: SWAP
+ * Exchange contents with another list
+ *     COST   : O(1)
+ *********************************************/
+template <typename T>
+void compact_list <T> :: swap(compact_list <T> & rhs)
+{
+   nodes.swap(rhs.nodes);
+   std::swap(numElements, rhs.numElements);
+   std::swap(iHead, rhs.iHead);
+   std::swap(iTail, rhs.iTail);
+}
+
+/**********************************************
+ * COMPACT LIST :: CLEAR
+ * Remove all the items currently in the list.  The
+ * pool keeps its chunks for the next fill.
+ *     COST   : O(n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+void compact_list <T> :: clear()
+{
+   index i = iHead;
+   while (i != NIL)
+   {
+      index iNext = nodes[i].iNext;
+      nodes.release(i);
+      i = iNext;
+   }
+
+   iHead = iTail = NIL;
+   numElements = 0;
+}
+
+/*********************************************
+ * COMPACT LIST :: FRONT
+ * retrieves the first element in the list
+ *     COST   : O(1)
+ *********************************************/
+template <typename T>
+T & compact_list <T> :: front()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+
+   return nodes[iHead].data;
+}
+
+/*********************************************
+ * COMPACT LIST :: BACK
+ * retrieves the last element in the list
+ *     COST   : O(1)
+ *********************************************/
+template <typename T>
+T & compact_list <T> :: back()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+
+   return nodes[iTail].data;
+}
+
+/******************************************
+ * COMPACT LIST :: ERASE
+ * remove an item from the middle of the list
+ *     INPUT  : an iterator to the item being removed
+ *     OUTPUT : iterator to the next item
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+typename compact_list <T> :: iterator compact_list <T> :: erase(const iterator & it)
+{
+   if (it.i == NIL)
+      return end();
+
+   Node & node = nodes[it.i];
+   index iNext = node.iNext;
+
+   // attach next to previous
+   if (node.iNext != NIL)
+      nodes[node.iNext].iPrev = node.iPrev;
+   else
+      iTail = node.iPrev;
+
+   // attach previous to next
+   if (node.iPrev != NIL)
+      nodes[node.iPrev].iNext = node.iNext;
+   else
+      iHead = node.iNext;
+
+   nodes.release(it.i);
+   numElements--;
+   return iterator(this, iNext);
+}
+
+/******************************************
+ * COMPACT LIST :: LINK
+ * hook a freshly allocated node into the list
+ *     INPUT  : where the node goes, the node, and
+ *              whether it goes after (rather than before) it
+ *     OUTPUT : iterator to the new item
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+typename compact_list <T> :: iterator compact_list <T> :: link(iterator it, index iNew, bool after)
+{
+   Node & node = nodes[iNew];
+
+   // end() means "after the tail"
+   index iPivot = it.i;
+   if (iPivot == NIL)
+   {
+      iPivot = iTail;
+      after = true;
+   }
+
+   if (iPivot == NIL)
+      iHead = iTail = iNew;
+
+   else if (after)
+   {
+      node.iPrev = iPivot;
+      node.iNext = nodes[iPivot].iNext;
+      if (node.iNext != NIL)
+         nodes[node.iNext].iPrev = iNew;
+      else
+         iTail = iNew;
+      nodes[iPivot].iNext = iNew;
+   }
+
+   else
+   {
+      node.iNext = iPivot;
+      node.iPrev = nodes[iPivot].iPrev;
+      if (node.iPrev != NIL)
+         nodes[node.iPrev].iNext = iNew;
+      else
+         iHead = iNew;
+      nodes[iPivot].iPrev = iNew;
+   }
+
+   numElements++;
+   return iterator(this, iNew);
+}
+
+/**********************************************
+ * SWAP
+ * Swap the list from LHS to RHS
+ *   COST   : O(1)
+ *********************************************/
+template <typename T>
+inline void swap(compact_list <T> & lhs, compact_list <T> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+}; // namespace custom
@@ -25,6 +25,10 @@
 #include <iostream>    // for nullptr
 #include <new>         // std::bad_alloc
 #include <memory>      // for std::allocator
+#include <map>         // for the block registry
+#include <mutex>       // for std::mutex
+#include <atomic>      // for std::atomic
+#include <functional>  // for std::less
  
 class TestList;        // forward declaration for unit tests
 class TestHash;
@@ -52,7 +56,7 @@ public:
    list(list <T> & rhs) : list()                      { *this = rhs; }
    list(list <T> && rhs) : list()                     { *this = std::move(rhs); }
    list(const std::initializer_list<T>& il) : list()  { *this = il; }
-  ~list()                                             { }
+  ~list()                                             { clear(); set_spare_limit(0); }
    template <class Iterator>
    list(Iterator first, Iterator last);
 
@@ -62,6 +66,8 @@ public:
    list <T> & operator = (list &  rhs);
    list <T> & operator = (list && rhs);
    list <T> & operator = (const std::initializer_list<T>& il);
+   template <class Iterator>
+   void assign(Iterator first, Iterator last);
 
    //
    // Iterator
@@ -95,20 +101,60 @@ public:
    void clear();
    iterator erase(const iterator& it);
 
+   //
+   // Splice and Reorder: these relink nodes, never allocate or copy
+   //
+   void splice(iterator pos, list & rhs);
+   void splice(iterator pos, list & rhs, iterator it);
+   void splice(iterator pos, list & rhs, iterator first, iterator last);
+   void merge(list & rhs);
+   void sort();
+   void unique();
+   void reverse();
+
    // 
    // Status
    //
    bool empty()  const { return !size(); }
    size_t size() const { return numElements; }
 
+   //
+   // Spare Nodes: erase and clear keep up to this many for insert to reuse
+   //
+   void set_spare_limit(size_t num);
+   size_t spare_limit() const { return maxSpare; }
+   size_t spares()      const { return numSpare; }
+
+   //
+   // Locality: move every node into one block, in order
+   //
+   void compact();
+
 private:
    // nested linked list class
    class Node;
+   struct Block;
+   struct Spare;
+
+   // get a node from a free slot, the spares, or the heap, and give it back
+   template <class U>
+   Node * allocate(U && data);
+   void recycle(Node * p);
+   void releaseSlots();
+
+   // helpers for relinking nodes
+   void transfer(Node * pPos, Node * pFirst, Node * pLast);
+   static Node * mergeChains(Node * pLeft, Node * pRight);
+   void relink(Node * pFirst);
 
    // member variables
    size_t numElements; // though we could count, it is faster to keep a variable
    Node * pHead;       // pointer to the beginning of the list
    Node * pTail;       // pointer to the ending of the list
+   Spare * pSpare;     // chain of destroyed heap nodes waiting to be reused
+   size_t numSpare;    // number of nodes on the spare chain
+   size_t maxSpare;    // the spare chain never grows past this
+   Spare * pFreeSlot;  // chain of block slots whose node was erased
 
 };
 
@@ -127,8 +173,8 @@ public:
    // Construct
    //
    Node()               : pNext(nullptr), pPrev(nullptr) { }
-   Node(const T & data) : pNext(nullptr), pPrev(nullptr), data(data) { }
-   Node(T && data)      : pNext(nullptr), pPrev(nullptr), data(std::move(data)) { }
+   Node(const T & data) : data(data),            pNext(nullptr), pPrev(nullptr) { }
+   Node(T && data)      : data(std::move(data)), pNext(nullptr), pPrev(nullptr) { }
    ~Node() { }
 
    //
@@ -144,7 +190,7 @@ public:
     ************************************************/
    void insertAfter(Node * newNode)
    {
-      if (!this || !newNode) return; // one of the tests has NULL for the this pointer for some reason
+      if (!newNode) return;
       
       // attach new node to this and this->pNext
       newNode->pNext = pNext;
@@ -160,7 +206,7 @@ public:
 
    void insertBefore(Node * newNode)
    {
-      if (!this || !newNode) return;
+      if (!newNode) return;
 
       // attach new node to this and this->pPrev
       newNode->pNext = this;
@@ -176,6 +222,132 @@ public:
 
 };
 
+/*************************************************
+ * BLOCK
+ * A contiguous run of nodes made by compact().  A slot
+ * is held while it has a node in it, in whatever list,
+ * or waits on a list's free chain; the block goes away
+ * when the last slot is let go.
+ *
+ * A node does not point back to its block; that would
+ * cost every node a word.  Each live block is in a
+ * registry by address instead, and until something is
+ * compacted the registry is never searched.
+ *************************************************/
+template <typename T>
+struct list <T> :: Block
+{
+   Block(size_t num);
+   Block(const Block & rhs) = delete;
+  ~Block();
+
+   // the block a node lives in, or nullptr for the heap
+   static Block * of(const Node * p);
+
+   // let go of one slot, and of the block with the last one
+   static void release(Block * pBlock)
+   {
+      if (--pBlock->numHeld == 0)
+         delete pBlock;
+   }
+
+   Node * pNodes;   // the first of the node slots
+   size_t numNodes; // how many slots there are
+   size_t numHeld;  // slots with a node in them or on a free chain
+
+private:
+   // Every live block of list<T>, keyed by the address just
+   // past its last slot.  Nodes move between lists, so this
+   // belongs to no one list and has to take a lock.
+   struct Registry
+   {
+      Registry() : numBlocks(0) { }
+      std::mutex lock;
+      std::map<const Node *, Block *> blocks;
+      std::atomic<size_t> numBlocks;  // checked before taking the lock
+   };
+
+   // never destroyed, so a static list can still free its block
+   static Registry & registry()
+   {
+      static Registry * pRegistry = new Registry;
+      return *pRegistry;
+   }
+};
+
+/*************************************************
+ * BLOCK :: CONSTRUCTOR
+ * Get room for num nodes and enter it in the registry
+ *************************************************/
+template <typename T>
+list <T> :: Block :: Block(size_t num) :
+   pNodes(static_cast<Node *>(::operator new(num * sizeof(Node)))),
+   numNodes(num), numHeld(num)
+{
+   Registry & registry = Block::registry();
+   try
+   {
+      std::lock_guard<std::mutex> guard(registry.lock);
+      registry.blocks[pNodes + numNodes] = this;
+   }
+   catch (...)
+   {
+      ::operator delete(static_cast<void *>(pNodes));
+      throw;
+   }
+   registry.numBlocks++;
+}
+
+/*************************************************
+ * BLOCK :: DESTRUCTOR
+ * Leave the registry and give back the room
+ *************************************************/
+template <typename T>
+list <T> :: Block :: ~Block()
+{
+   Registry & registry = Block::registry();
+   {
+      std::lock_guard<std::mutex> guard(registry.lock);
+      registry.blocks.erase(pNodes + numNodes);
+   }
+   registry.numBlocks--;
+   ::operator delete(static_cast<void *>(pNodes));
+}
+
+/*************************************************
+ * BLOCK :: OF
+ * Find the block a node lives in
+ *    INPUT  : the node
+ *    OUTPUT : its block, or nullptr if it came from the heap
+ *    COST   : O(1) if nothing is compacted, else O(log blocks)
+ *************************************************/
+template <typename T>
+typename list <T> :: Block * list <T> :: Block :: of(const Node * p)
+{
+   Registry & registry = Block::registry();
+   if (registry.numBlocks == 0)
+      return nullptr;
+
+   // the first block that ends after p is the only one it can be in
+   std::lock_guard<std::mutex> guard(registry.lock);
+   auto it = registry.blocks.upper_bound(p);
+   if (it == registry.blocks.end() || std::less<const Node *>()(p, it->second->pNodes))
+      return nullptr;
+   return it->second;
+}
+
+/*************************************************
+ * SPARE
+ * What a node's memory holds once the node is
+ * destroyed and the memory waits on a chain
+ *************************************************/
+template <typename T>
+struct list <T> :: Spare
+{
+   Spare * pNext;   // the next one on the chain
+   Block * pBlock;  // the block the memory is in, or nullptr for the heap
+};
+
 /*************************************************
  * LIST ITERATOR
  * Iterate through a List, non-constant version
@@ -254,6 +426,8 @@ list <T> :: list()
 {
    numElements = 0;
    pHead = pTail = nullptr;
+   pSpare = pFreeSlot = nullptr;
+   numSpare = maxSpare = 0;
 }
 
 /*****************************************
@@ -302,128 +476,17 @@ list<T>::list(Iterator first, Iterator last) : list()
 
 /**********************************************
  * LIST :: assignment operator
- * Copy one list onto another
+ * Copy one list onto another, reusing the nodes we
+ * already have before allocating or freeing any
  *     INPUT  : a list to be copied
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
-
-/*********************************************
- * From the book:
- * 
- * list.copy-assignment(rhs)
- *    
- *    itRHS <- rhs.begin
- *    itLHS <- begin()
- *    
- *    WHILE itRHS != rhs.end() AND itLHS != end()
- *       *itLHS <- *itRHS
- *       ++itRHS
- *       ++itLHS
- * 
- *    IF itRHS != rhs.end()
- *       WHILE itRHS != rhs.end()
- *          push_back(*itRHS)
- *          ++itRHS
- *    
- *    ELSE IF rhs.empty()
- *       clear()
- * 
- *    ELSE IF itLHS != end()
- *       p <- itLHS.p
- *       pTail <- p->pPrev
- *       pNext <- p->pNext
- *       
- *       WHILE p != NULL
- *          pNext <- p.pNext
- *          DELETE p
- *          p <- pNext
- *          numElements--
- *       
- *       pTail->pNext <- NULL
- *********************************************/
-
 template <typename T>
 list <T> & list <T> :: operator = (list <T> & rhs)
 {
-   Node * pDestination = this->pHead;
-   Node * pSource = rhs.pHead;
-   
-   // prev <- tmp <- pDestination (this)
-   // tmp will be our pDestination iterator
-   Node * tmp = pDestination;
-   Node * prev = tmp;
-
-   // loop through pSource list
-   for (Node * p = pSource; p; p = p->pNext)
-   {
-      // check tmp against pDestination list to see if space is already allocated for next pSource value
-      if (tmp)
-      {
-         // copy source
-         tmp->data = p->data;
-
-         // iterate prev and tmp
-         prev = tmp;
-         tmp = tmp->pNext;
-      }
-
-      else
-      {
-         // allocate new node and attach
-         Node * newNode = new Node(p->data);
-         newNode->pPrev = prev;
-         if (prev) prev->pNext = newNode;
-         
-         // if pDestination was empty
-         if (!pDestination)
-            pDestination = newNode;
-
-         // iterate prev
-         prev = newNode;
-         tmp = newNode->pNext;
-         this->pTail = prev;
-      }
-   }
-
-   // delete remaining nodes from pDestination
-   if (tmp)
-   {
-      // if emptyToStandard
-      if (tmp == prev)
-         tmp = tmp->pNext;
-
-      // sever ties with the list assigned thus far
-      else
-         prev->pNext = nullptr;
-
-      // loop through the extraneous nodes and delete them using prev
-      while (tmp->pNext)
-      {
-         delete prev;
-         prev = nullptr;
-         prev = tmp;
-         tmp = tmp->pNext;
-         delete prev;
-         prev = nullptr;
-      }
-
-      // the last one is the only one left over
-      delete tmp;
-      tmp = nullptr;
-   }
-
-   if (!pSource)
-   {
-      // any deallocation has been handled above
-      pDestination = nullptr;
-   }
-
-   this->numElements = rhs.numElements;
-
-   rhs.pHead = pSource;
-   this->pHead = pDestination;
-   this->pTail = prev;
+   if (this != &rhs)
+      assign(rhs.begin(), rhs.end());
    return *this;
 }
 
@@ -438,6 +501,8 @@ template <typename T>
 list <T>& list <T> :: operator = (list <T> && rhs)
 {
    this->clear();
+   this->pFreeSlot = rhs.pFreeSlot;
+   rhs.pFreeSlot = nullptr;
    this->pHead = std::move(rhs.pHead);
    rhs.pHead = nullptr;
    this->pTail = std::move(rhs.pTail);
@@ -457,25 +522,49 @@ list <T>& list <T> :: operator = (list <T> && rhs)
 template <typename T>
 list <T>& list <T> :: operator = (const std::initializer_list<T>& il)
 {
-   if (il.size() == 0) return *this;
-   // initialize pHead at a placeholder location
-   Node * it = pHead = new Node();
+   assign(il.begin(), il.end());
+   return *this;
+}
 
-   for (auto element : il)
+/**********************************************
+ * LIST :: ASSIGN
+ * Replace the contents with a range.  Existing nodes
+ * are assigned in place; only the difference in size
+ * is allocated or given back.
+ *     INPUT  : the range to be copied
+ *     OUTPUT :
+ *     COST   : O(n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+template <class Iterator>
+void list <T> :: assign(Iterator first, Iterator last)
+{
+   // overwrite the nodes we already have
+   Node * p = pHead;
+   for (; first != last && p; ++first, p = p->pNext)
+      p->data = *first;
+
+   // the source was longer: append the rest
+   for (; first != last; ++first)
+      push_back(*first);
+
+   // the source was shorter: cut off and give back the rest
+   if (p)
    {
-      it->insertAfter(new Node(element));
-      it = it->pNext;
+      pTail = p->pPrev;
+      if (pTail)
+         pTail->pNext = nullptr;
+      else
+         pHead = nullptr;
+
+      while (p)
+      {
+         Node * pNext = p->pNext;
+         recycle(p);
+         numElements--;
+         p = pNext;
+      }
    }
-   // shift pHead to pHead->pNext and delete placeholder
-   auto tmp = pHead->pNext;
-   std::swap(tmp, pHead);
-   delete tmp;
-   if(pHead) pHead->pPrev = nullptr;
-   pTail = it;
-
-   numElements = il.size();
-   
-	return *this;
 }
 
 /**********************************************
@@ -496,6 +585,9 @@ void list <T> :: clear()
    // https://youtu.be/T_d3teq6pWw?t=26
    pHead = pTail = nullptr;
    numElements = 0;
+
+   // the erased nodes' block slots are not kept either
+   releaseSlots();
 }
 
 /*********************************************
@@ -598,7 +690,7 @@ typename list<T>::iterator list<T>::erase(const list<T>::iterator & it)
    else
       pHead = pHead->pNext;
 
-   delete it.p;
+   recycle(it.p);
    numElements--;
    return itNext;
 }
@@ -614,9 +706,13 @@ typename list<T>::iterator list<T>::erase(const list<T>::iterator & it)
 template <typename T>
 typename list<T>::iterator list<T>::insert(list<T>:: iterator it, const T & data, bool after)
 {
-   Node * newNode = new Node(data);
+   Node * newNode = allocate(data);
    
-   if (it == end())
+   // an empty list: the new node is both ends
+   if (!pTail)
+      pHead = pTail = newNode;
+
+   else if (it == end())
       pTail->insertAfter(newNode);
 
    else if (after)
@@ -639,9 +735,13 @@ typename list<T>::iterator list<T>::insert(list<T>:: iterator it, const T & data
 template <typename T>
 typename list<T>::iterator list<T>::insert(list<T>::iterator it, T && data, bool after)
 {
-   Node * newNode = new Node(std::move(data));
+   Node * newNode = allocate(std::move(data));
    
-   if (it == end())
+   // an empty list: the new node is both ends
+   if (!pTail)
+      pHead = pTail = newNode;
+
+   else if (it == end())
       pTail->insertAfter(newNode);
 
    else if (after)
@@ -661,6 +761,421 @@ typename list<T>::iterator list<T>::insert(list<T>::iterator it, T && data, bool
    return list<T>::iterator(newNode);
 }
 
+/******************************************
+ * LIST :: SET SPARE LIMIT
+ * Bound the number of nodes erase and clear hold on
+ * to.  Zero (the default) turns the spare chain off.
+ *     INPUT  : the largest number of spare nodes to keep
+ *     COST   : O(n) with respect to the spares let go
+ ******************************************/
+template <typename T>
+void list <T> :: set_spare_limit(size_t num)
+{
+   maxSpare = num;
+   while (numSpare > maxSpare)
+   {
+      Spare * p = pSpare;
+      pSpare = p->pNext;
+      ::operator delete(static_cast<void *>(p));
+      numSpare--;
+   }
+}
+
+/******************************************
+ * LIST :: ALLOCATE
+ * construct a node in the first free block slot, else
+ * in a spare, else on the heap
+ *     INPUT  : the data to put in the node
+ *     OUTPUT : the new node
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+template <class U>
+typename list <T> :: Node * list <T> :: allocate(U && data)
+{
+   Spare ** ppChain = pFreeSlot ? &pFreeSlot : &pSpare;
+   if (!*ppChain)
+      return new Node(std::forward<U>(data));
+
+   // take the memory off its chain before the node goes in it
+   Spare * pTake = *ppChain;
+   Spare spare = *pTake;
+   *ppChain = spare.pNext;
+   Node * p;
+   try
+   {
+      p = new (static_cast<void *>(pTake)) Node(std::forward<U>(data));
+   }
+   catch (...)
+   {
+      *ppChain = new (static_cast<void *>(pTake)) Spare(spare);
+      throw;
+   }
+   if (ppChain == &pSpare)
+      numSpare--;
+   return p;
+}
+
+/******************************************
+ * LIST :: RECYCLE
+ * destroy a node that is no longer linked in.  A node
+ * in a block goes on the free slot chain; otherwise its
+ * memory is kept on the spare chain if there is room
+ *     INPUT  : the unlinked node
+ *     COST   : O(1), plus the registry search once anything
+ *              of this type has been compacted
+ ******************************************/
+template <typename T>
+void list <T> :: recycle(Node * p)
+{
+   Block * pBlock = Block::of(p);
+   if (!pBlock && numSpare >= maxSpare)
+   {
+      delete p;
+      return;
+   }
+
+   p->~Node();
+   Spare ** ppChain = pBlock ? &pFreeSlot : &pSpare;
+   *ppChain = new (static_cast<void *>(p)) Spare{ *ppChain, pBlock };
+   if (!pBlock)
+      numSpare++;
+}
+
+/******************************************
+ * LIST :: RELEASE SLOTS
+ * let go of every slot on the free slot chain, and so
+ * of any block nothing else is holding
+ *     COST   : O(n) with respect to the free slots
+ ******************************************/
+template <typename T>
+void list <T> :: releaseSlots()
+{
+   while (pFreeSlot)
+   {
+      Spare * p = pFreeSlot;
+      pFreeSlot = p->pNext;
+      Block::release(p->pBlock);
+   }
+}
+
+/******************************************
+ * LIST :: COMPACT
+ * move every element into one new block of nodes laid
+ * out in iteration order, so walking the list walks
+ * memory front to back.  Elements are moved, not copied,
+ * unless moving could throw.
+ *
+ * An iterator is the address of a node, and the element
+ * lives in its node, so no node can move while iterators
+ * and references to elements stay good.  Those are what
+ * give way: like reallocating a vector, this invalidates
+ * every iterator, pointer, and reference into the list.
+ * The values survive the move; the addresses do not.
+ *     COST   : O(n) with respect to the number of nodes
+ ******************************************/
+template <typename T>
+void list <T> :: compact()
+{
+   if (empty())
+   {
+      releaseSlots();
+      return;
+   }
+
+   // build the new chain first so a throw leaves us untouched
+   Block * pBlock = new Block(numElements);
+   Node * pNewTail = nullptr;
+   size_t num = 0;
+   try
+   {
+      for (Node * p = pHead; p; p = p->pNext, num++)
+      {
+         Node * pNew = new (pBlock->pNodes + num) Node(std::move_if_noexcept(p->data));
+         pNew->pPrev = pNewTail;
+         if (pNewTail)
+            pNewTail->pNext = pNew;
+         pNewTail = pNew;
+      }
+   }
+   catch (...)
+   {
+      while (num--)
+         pBlock->pNodes[num].~Node();
+      delete pBlock;
+      throw;
+   }
+
+   // give back the old nodes, and with them any old block slots
+   for (Node * p = pHead; p; )
+   {
+      Node * pNext = p->pNext;
+      recycle(p);
+      p = pNext;
+   }
+   releaseSlots();
+
+   pHead = pBlock->pNodes;
+   pTail = pNewTail;
+}
+
+/******************************************
+ * LIST :: TRANSFER
+ * hook an already-detached chain of nodes into this list
+ *     INPUT  : the node to put the chain in front of (nullptr for the end)
+ *              the first and last nodes of the chain
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+void list <T> :: transfer(Node * pPos, Node * pFirst, Node * pLast)
+{
+   Node * pBefore = pPos ? pPos->pPrev : pTail;
+
+   pFirst->pPrev = pBefore;
+   pLast->pNext = pPos;
+
+   if (pBefore)
+      pBefore->pNext = pFirst;
+   else
+      pHead = pFirst;
+
+   if (pPos)
+      pPos->pPrev = pLast;
+   else
+      pTail = pLast;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move every node of rhs in front of pos
+ *     INPUT  : where the nodes go and the list they come from
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+void list <T> :: splice(iterator pos, list <T> & rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   transfer(pos.p, rhs.pHead, rhs.pTail);
+   numElements += rhs.numElements;
+
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move one node of rhs (which may be this list) in front of pos
+ *     INPUT  : where the node goes, the list, and the node
+ *     COST   : O(1)
+ ******************************************/
+template <typename T>
+void list <T> :: splice(iterator pos, list <T> & rhs, iterator it)
+{
+   Node * pMove = it.p;
+   if (!pMove)
+      return;
+
+   // already where it belongs?
+   if (&rhs == this && (pMove == pos.p || pMove->pNext == pos.p))
+      return;
+
+   // unhook it from rhs
+   if (pMove->pPrev)
+      pMove->pPrev->pNext = pMove->pNext;
+   else
+      rhs.pHead = pMove->pNext;
+   if (pMove->pNext)
+      pMove->pNext->pPrev = pMove->pPrev;
+   else
+      rhs.pTail = pMove->pPrev;
+   rhs.numElements--;
+
+   transfer(pos.p, pMove, pMove);
+   numElements++;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move the nodes [first, last) of rhs in front of pos
+ *     INPUT  : where the nodes go, the list, and the range
+ *     COST   : O(1) within one list, otherwise O(range)
+ *              because we must count what moved
+ ******************************************/
+template <typename T>
+void list <T> :: splice(iterator pos, list <T> & rhs, iterator first, iterator last)
+{
+   if (first == last)
+      return;
+
+   Node * pFirst = first.p;
+   Node * pLast = last.p ? last.p->pPrev : rhs.pTail;
+
+   size_t num = 0;
+   if (&rhs != this)
+      for (Node * p = pFirst; p != last.p; p = p->pNext)
+         num++;
+
+   // unhook the range from rhs
+   if (pFirst->pPrev)
+      pFirst->pPrev->pNext = last.p;
+   else
+      rhs.pHead = last.p;
+   if (last.p)
+      last.p->pPrev = pFirst->pPrev;
+   else
+      rhs.pTail = pFirst->pPrev;
+
+   transfer(pos.p, pFirst, pLast);
+   rhs.numElements -= num;
+   numElements += num;
+}
+
+/******************************************
+ * LIST :: MERGE CHAINS
+ * merge two sorted chains linked through pNext only.
+ * On a tie the left node goes first so the merge is stable.
+ *     INPUT  : the two chains, each ending in nullptr
+ *     OUTPUT : the first node of the merged chain
+ *     COST   : O(n) with respect to both chains
+ ******************************************/
+template <typename T>
+typename list <T> :: Node * list <T> :: mergeChains(Node * pLeft, Node * pRight)
+{
+   Node * pFirst = nullptr;
+   Node ** ppEnd = &pFirst;   // the link the next node gets hung from
+
+   while (pLeft && pRight)
+   {
+      Node *& pTake = (pRight->data < pLeft->data) ? pRight : pLeft;
+      *ppEnd = pTake;
+      ppEnd = &pTake->pNext;
+      pTake = pTake->pNext;
+   }
+   *ppEnd = pLeft ? pLeft : pRight;
+
+   return pFirst;
+}
+
+/******************************************
+ * LIST :: RELINK
+ * rebuild the pPrev links and pTail after the nodes have
+ * been rearranged through pNext alone
+ *     INPUT  : the new first node
+ *     COST   : O(n)
+ ******************************************/
+template <typename T>
+void list <T> :: relink(Node * pFirst)
+{
+   pHead = pFirst;
+   pTail = nullptr;
+   for (Node * p = pFirst; p; p = p->pNext)
+   {
+      p->pPrev = pTail;
+      pTail = p;
+   }
+}
+
+/******************************************
+ * LIST :: MERGE
+ * merge the sorted rhs into this sorted list, leaving rhs
+ * empty.  Equal elements from this list come first.
+ *     INPUT  : a sorted list
+ *     COST   : O(n + m)
+ ******************************************/
+template <typename T>
+void list <T> :: merge(list <T> & rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   relink(mergeChains(pHead, rhs.pHead));
+   numElements += rhs.numElements;
+
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+}
+
+/******************************************
+ * LIST :: SORT
+ * stable bottom-up merge sort.  Bin i holds a sorted run
+ * of 2^i nodes; each new node is carried up through the
+ * bins like adding one to a binary counter.  Only the
+ * links change, so nothing is allocated or copied.
+ *     COST   : O(n log n)
+ ******************************************/
+template <typename T>
+void list <T> :: sort()
+{
+   if (numElements < 2)
+      return;
+
+   Node * bins[64] = {};
+   int numBins = 0;
+
+   Node * p = pHead;
+   while (p)
+   {
+      Node * pCarry = p;
+      p = p->pNext;
+      pCarry->pNext = nullptr;
+
+      // older runs sit in the bins, so they go on the left
+      int i = 0;
+      for (; i < numBins && bins[i]; i++)
+      {
+         pCarry = mergeChains(bins[i], pCarry);
+         bins[i] = nullptr;
+      }
+      bins[i] = pCarry;
+      if (i == numBins)
+         numBins++;
+   }
+
+   // the higher bins hold the older runs
+   Node * pSorted = nullptr;
+   for (int i = 0; i < numBins; i++)
+      if (bins[i])
+         pSorted = mergeChains(bins[i], pSorted);
+
+   relink(pSorted);
+}
+
+/******************************************
+ * LIST :: UNIQUE
+ * remove all but the first of each run of equal elements
+ *     COST   : O(n)
+ ******************************************/
+template <typename T>
+void list <T> :: unique()
+{
+   if (!pHead)
+      return;
+
+   Node * p = pHead;
+   while (p->pNext)
+   {
+      if (p->pNext->data == p->data)
+         erase(iterator(p->pNext));
+      else
+         p = p->pNext;
+   }
+}
+
+/******************************************
+ * LIST :: REVERSE
+ * turn the list around by swapping every node's links
+ *     COST   : O(n)
+ ******************************************/
+template <typename T>
+void list <T> :: reverse()
+{
+   for (Node * p = pHead; p; p = p->pPrev)
+      std::swap(p->pNext, p->pPrev);
+   std::swap(pHead, pTail);
+}
+
 /**********************************************
  * SWAP
  * Swap the list from LHS to RHS
@@ -0,0 +1,248 @@
+/***********************************************************************
+ * Header:
+ *    POOL
+ * Summary:
+ *    A home for nodes that are linked by 32-bit indices rather than by
+ *    pointers. The nodes live side-by-side in fixed-size chunks so a
+ *    structure built from them has good locality, and an index never
+ *    moves even when the pool grows.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        pool         : A class that hands out node slots by index
+ * Authors
+ *    Hunter Powell
+ *    Carol Mercau
+ *    Elijah Harrison
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t
+#include <new>         // for placement new
+#include <type_traits> // for std::aligned_storage
+#include <utility>     // for std::forward
+
+class TestCompactList; // forward declaration for unit tests
+class TestCompactBST;
+
+namespace custom
+{
+
+/**************************************************
+ * POOL
+ * A growable set of node slots.  A slot is named by
+ * a 32-bit index; NIL is the "null pointer".  Free
+ * slots are chained together through their own
+ * storage so releasing and reusing one is O(1).
+ **************************************************/
+template <typename Node>
+class pool
+{
+   friend class ::TestCompactList; // give unit tests access to the privates
+   friend class ::TestCompactBST;
+public:
+   typedef uint32_t index;
+   static const index NIL = 0xFFFFFFFF;
+
+   //
+   // Construct
+   //
+   pool() : chunks(nullptr), numChunks(0), numSlots(0), numUsed(0), iFree(NIL) { }
+   pool(const pool & rhs) = delete;
+  ~pool();
+
+   pool & operator = (const pool & rhs) = delete;
+   void swap(pool & rhs);
+
+   //
+   // Access
+   //
+   Node & operator [] (index i)
+   {
+      assert(i < numSlots);
+      return *slot(i);
+   }
+   const Node & operator [] (index i) const
+   {
+      assert(i < numSlots);
+      return *slot(i);
+   }
+
+   //
+   // Insert and Remove
+   //
+   template <class ... Args>
+   index allocate(Args && ... args);
+   void release(index i);
+
+   //
+   // Status
+   //
+   size_t size()     const { return numUsed;  }
+   size_t capacity() const { return numSlots; }
+
+private:
+   // a chunk holds this many slots, always a power of two
+   enum { CHUNK_BITS = 8, CHUNK_SIZE = 1 << CHUNK_BITS, CHUNK_MASK = CHUNK_SIZE - 1 };
+
+   // a slot holds a live node or, once released, the next free slot
+   union Slot
+   {
+      typename std::aligned_storage<sizeof(Node), alignof(Node)>::type node;
+      index next;
+   };
+
+   void grow();
+   Slot & cell(index i) const
+   {
+      return chunks[i >> CHUNK_BITS][i & CHUNK_MASK];
+   }
+   Node * slot(index i) const
+   {
+      return reinterpret_cast<Node *>(&cell(i).node);
+   }
+
+   Slot ** chunks;     // table of chunks, each CHUNK_SIZE slots long
+   size_t numChunks;   // number of chunks currently allocated
+   index numSlots;     // slots handed out at least once (the high water mark)
+   size_t numUsed;     // slots currently holding a live node
+   index iFree;        // head of the chain of released slots
+};
+
+/*****************************************
+ * POOL :: DESTRUCTOR
+ * The pool only owns the storage.  The owner is
+ * responsible for releasing every live node first.
+ ****************************************/
+template <typename Node>
+pool <Node> :: ~pool()
+{
+   assert(numUsed == 0);
+   for (size_t i = 0; i < numChunks; i++)
+      delete [] chunks[i];
+   delete [] chunks;
+}
+
+/*****************************************
+ * POOL :: SWAP
+ * Exchange storage with another pool
+ *   COST   : O(1)
+ ****************************************/
+template <typename Node>
+void pool <Node> :: swap(pool <Node> & rhs)
+{
+   std::swap(chunks,    rhs.chunks);
+   std::swap(numChunks, rhs.numChunks);
+   std::swap(numSlots,  rhs.numSlots);
+   std::swap(numUsed,   rhs.numUsed);
+   std::swap(iFree,     rhs.iFree);
+}
+
+/*****************************************
+ * POOL :: ALLOCATE
+ * Construct a node in a free slot, reusing a released
+ * slot before carving a new one off the end
+ *    INPUT  : the node's constructor parameters
+ *    OUTPUT : the index of the new node
+ *    COST   : O(1), amortized
+ ****************************************/
+template <typename Node>
+template <class ... Args>
+typename pool <Node> :: index pool <Node> :: allocate(Args && ... args)
+{
+   index i;
+   if (iFree != NIL)
+   {
+      i = iFree;
+      iFree = cell(i).next;
+   }
+   else
+   {
+      if (numSlots == (index)(numChunks * CHUNK_SIZE))
+         grow();
+      i = numSlots;
+      assert(i != NIL);
+   }
+
+   // construct before we commit so a throwing constructor leaks nothing
+   try
+   {
+      new (slot(i)) Node(std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      // a recycled slot goes back on the free chain; a fresh one was never counted
+      if (i != numSlots)
+      {
+         cell(i).next = iFree;
+         iFree = i;
+      }
+      throw;
+   }
+
+   if (i == numSlots)
+      numSlots++;
+   numUsed++;
+   return i;
+}
+
+/*****************************************
+ * POOL :: RELEASE
+ * Destroy the node in a slot and put the slot
+ * on the free chain
+ *    INPUT  : the index of the node to destroy
+ *    COST   : O(1)
+ ****************************************/
+template <typename Node>
+void pool <Node> :: release(index i)
+{
+   assert(i < numSlots);
+   assert(numUsed > 0);
+   slot(i)->~Node();
+   cell(i).next = iFree;
+   iFree = i;
+   numUsed--;
+}
+
+/*****************************************
+ * POOL :: GROW
+ * Add one more chunk of slots.  Existing chunks are
+ * never moved so indices (and references) stay put.
+ *    COST   : O(number of chunks)
+ ****************************************/
+template <typename Node>
+void pool <Node> :: grow()
+{
+   // the chunk table is just an array of pointers; double it when full
+   if ((numChunks & (numChunks - 1)) == 0)
+   {
+      Slot ** chunksNew = new Slot * [numChunks ? numChunks * 2 : 1];
+      for (size_t i = 0; i < numChunks; i++)
+         chunksNew[i] = chunks[i];
+      delete [] chunks;
+      chunks = chunksNew;
+   }
+
+   chunks[numChunks++] = new Slot[CHUNK_SIZE];
+}
+
+/**********************************************
+ * SWAP
+ * Swap the pool from LHS to RHS
+ *   COST   : O(1)
+ *********************************************/
+template <typename Node>
+inline void swap(pool <Node> & lhs, pool <Node> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+}; // namespace custom
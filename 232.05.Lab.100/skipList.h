@@ -0,0 +1,674 @@
+/***********************************************************************
+ * Header:
+ *    SKIP LIST
+ * Summary:
+ *    A sequence with the same interface as custom::list that can also
+ *    reach the i-th element in O(log n) expected time. Every node has a
+ *    random number of forward links; each link remembers how many
+ *    elements it skips so we can count our way to a position.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        skip_list           : An indexable sequence
+ *        skip_list::iterator : An iterator through skip_list
+ * Authors
+ *    Hunter Powell
+ *    Carol Mercau
+ *    Elijah Harrison
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t
+#include <initializer_list>
+#include <new>         // for placement new
+#include <utility>     // for std::forward
+
+class TestSkipList;    // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * SKIP LIST
+ * Just like custom::list, plus positional access
+ **************************************************/
+template <typename T>
+class skip_list
+{
+   friend class ::TestSkipList; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+   skip_list();
+   skip_list(size_t num, const T & t);
+   skip_list(size_t num) : skip_list(num, T())                         { }
+   skip_list(const skip_list <T> & rhs) : skip_list()                  { *this = rhs; }
+   skip_list(skip_list <T> && rhs) : skip_list()                       { *this = std::move(rhs); }
+   skip_list(const std::initializer_list<T> & il) : skip_list()        { *this = il; }
+   template <class Iterator>
+   skip_list(Iterator first, Iterator last) : skip_list()
+   {
+      for (auto it = first; it != last; ++it)
+         push_back(*it);
+   }
+  ~skip_list()                                                         { clear(); }
+
+   //
+   // Assign
+   //
+   skip_list <T> & operator = (const skip_list & rhs);
+   skip_list <T> & operator = (skip_list && rhs);
+   skip_list <T> & operator = (const std::initializer_list<T> & il);
+   void swap(skip_list & rhs);
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin()  { return iterator(head[0].pNext); }
+   iterator rbegin() { return iterator(pTail);         }
+   iterator end()    { return iterator(nullptr);       }
+   iterator advance(iterator it, long n);
+
+   //
+   // Access
+   //
+   T & front();
+   T & back();
+   T & operator [] (size_t index);
+   const T & operator [] (size_t index) const;
+
+   //
+   // Insert
+   //
+   void push_front(const T &  data) { insertAt(0, data);                       }
+   void push_front(      T && data) { insertAt(0, std::move(data));            }
+   void push_back (const T &  data) { insertAt(numElements, data);             }
+   void push_back (      T && data) { insertAt(numElements, std::move(data));  }
+   iterator insert(iterator it, const T &  data, bool after = false)
+   {
+      return insertAt(positionOf(it, after), data);
+   }
+   iterator insert(iterator it,       T && data, bool after = false)
+   {
+      return insertAt(positionOf(it, after), std::move(data));
+   }
+
+   //
+   // Remove
+   //
+   void pop_front()  { erase(begin());  }
+   void pop_back()   { erase(rbegin()); }
+   void clear();
+   iterator erase(const iterator & it);
+   iterator erase_at(size_t index);
+
+   //
+   // Status
+   //
+   bool empty()  const { return !size(); }
+   size_t size() const { return numElements; }
+
+private:
+   class Node;
+
+   // one forward link and the number of positions it moves forward
+   struct Link
+   {
+      Node * pNext;
+      size_t width;
+   };
+
+   // enough levels for 4^32 elements
+   enum { MAX_LEVEL = 32 };
+
+   // the links leaving a node, or leaving the head when p is nullptr
+   Link * linksOf(Node * p) { return p ? p->links : head; }
+   const Link * linksOf(const Node * p) const { return p ? p->links : head; }
+
+   const Node * nodeAt(size_t index) const;
+   size_t indexOf(const Node * p) const;
+   size_t positionOf(const iterator & it, bool after) const
+   {
+      return it.p ? indexOf(it.p) + (after ? 1 : 0) : numElements;
+   }
+   void findBefore(size_t index, Node ** update, size_t * rank);
+   template <class U>
+   iterator insertAt(size_t index, U && data);
+   unsigned int randomLevel();
+
+   template <class U>
+   static Node * allocate(unsigned int levels, U && data);
+   static void destroy(Node * p);
+
+   // member variables
+   Link head[MAX_LEVEL];  // links leaving the front; only [0, levels) are used
+   unsigned int levels;   // the tallest node's height
+   size_t numElements;    // number of nodes
+   Node * pTail;          // the last node, so we can walk backwards
+   uint32_t seed;         // state for choosing node heights
+};
+
+/*************************************************
+ * NODE
+ * Data, a back link for the iterator, and a run of
+ * forward links stored right after the node itself
+ *************************************************/
+template <typename T>
+class skip_list <T> :: Node
+{
+public:
+   template <class U>
+   Node(unsigned int levels, Link * links, U && data) :
+      data(std::forward<U>(data)), pPrev(nullptr), levels(levels), links(links) { }
+
+   T data;              // user data
+   Node * pPrev;        // the previous node at level 0
+   unsigned int levels; // how many links this node has
+   Link * links;        // links[0] is the plain next pointer
+};
+
+/*************************************************
+ * SKIP LIST ITERATOR
+ * Walks level 0 just like a list iterator
+ ************************************************/
+template <typename T>
+class skip_list <T> :: iterator
+{
+   friend class ::TestSkipList; // give unit tests access to the privates
+   template <typename TT>
+   friend class custom::skip_list;
+public:
+   // constructors, destructors, and assignment operator
+   iterator()                      : p(nullptr) { }
+   iterator(Node * p)              : p(p)       { }
+   iterator(const iterator & rhs)  : p(rhs.p)   { }
+
+   iterator & operator = (const iterator & rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator, fetch a node
+   T & operator * () { return p->data; }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+      if (p) p = p->links[0].pNext;
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int postfix)
+   {
+      iterator tmp(*this);
+      ++(*this);
+      return tmp;
+   }
+
+   // prefix decrement
+   iterator & operator -- ()
+   {
+      if (p) p = p->pPrev;
+      return *this;
+   }
+
+   // postfix decrement
+   iterator operator -- (int postfix)
+   {
+      iterator tmp(*this);
+      --(*this);
+      return tmp;
+   }
+
+private:
+   Node * p;
+};
+
+/*****************************************
+ * SKIP LIST :: DEFAULT constructor
+ * One level, pointing at the end
+ ****************************************/
+template <typename T>
+skip_list <T> :: skip_list() : levels(1), numElements(0), pTail(nullptr), seed(2463534242u)
+{
+   head[0].pNext = nullptr;
+   head[0].width = 1;
+}
+
+/*****************************************
+ * SKIP LIST :: NON-DEFAULT constructors
+ * Create a list initialized to a value of size num
+ ****************************************/
+template <typename T>
+skip_list <T> :: skip_list(size_t num, const T & t) : skip_list()
+{
+   for (size_t i = 0; i < num; i++)
+      push_back(t);
+}
+
+/**********************************************
+ * SKIP LIST :: assignment operator
+ * Copy one list onto another, reusing the nodes we
+ * already have before allocating or freeing any
+ *     INPUT  : a list to be copied
+ *     COST   : O(n log n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+skip_list <T> & skip_list <T> :: operator = (const skip_list <T> & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   Node * pDest = head[0].pNext;
+   const Node * pSrc = rhs.head[0].pNext;
+   for (; pSrc && pDest; pSrc = pSrc->links[0].pNext, pDest = pDest->links[0].pNext)
+      pDest->data = pSrc->data;
+
+   for (; pSrc; pSrc = pSrc->links[0].pNext)
+      push_back(pSrc->data);
+
+   while (numElements > rhs.numElements)
+      pop_back();
+
+   return *this;
+}
+
+/**********************************************
+ * SKIP LIST :: assignment operator - MOVE
+ * Take the nodes from the right-hand-side
+ *     INPUT  : a list to be moved
+ *     COST   : O(n) with respect to the size of the LHS
+ *********************************************/
+template <typename T>
+skip_list <T> & skip_list <T> :: operator = (skip_list <T> && rhs)
+{
+   clear();
+   swap(rhs);
+   return *this;
+}
+
+/**********************************************
+ * SKIP LIST :: assignment operator
+ * Copy an initializer list onto the list
+ *     INPUT  : a list to be copied
+ *     COST   : O(n log n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+skip_list <T> & skip_list <T> :: operator = (const std::initializer_list<T> & il)
+{
+   clear();
+   for (auto && t : il)
+      push_back(t);
+   return *this;
+}
+
+/**********************************************
+ * SKIP LIST :: SWAP
+ * Exchange contents with another list.  The head links
+ * live inside the object so they are swapped one by one.
+ *     COST   : O(levels)
+ *********************************************/
+template <typename T>
+void skip_list <T> :: swap(skip_list <T> & rhs)
+{
+   unsigned int most = levels > rhs.levels ? levels : rhs.levels;
+   for (unsigned int l = 0; l < most; l++)
+      std::swap(head[l], rhs.head[l]);
+   std::swap(levels, rhs.levels);
+   std::swap(numElements, rhs.numElements);
+   std::swap(pTail, rhs.pTail);
+   std::swap(seed, rhs.seed);
+}
+
+/**********************************************
+ * SKIP LIST :: CLEAR
+ * Remove all the items currently in the list
+ *     COST   : O(n) with respect to the number of nodes
+ *********************************************/
+template <typename T>
+void skip_list <T> :: clear()
+{
+   Node * p = head[0].pNext;
+   while (p)
+   {
+      Node * pNext = p->links[0].pNext;
+      destroy(p);
+      p = pNext;
+   }
+
+   levels = 1;
+   head[0].pNext = nullptr;
+   head[0].width = 1;
+   numElements = 0;
+   pTail = nullptr;
+}
+
+/*********************************************
+ * SKIP LIST :: FRONT and BACK
+ * retrieves the first or last element in the list
+ *     COST   : O(1)
+ *********************************************/
+template <typename T>
+T & skip_list <T> :: front()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+   return head[0].pNext->data;
+}
+
+template <typename T>
+T & skip_list <T> :: back()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+   return pTail->data;
+}
+
+/*********************************************
+ * SKIP LIST :: SUBSCRIPT
+ * retrieves the element at a given position
+ *     INPUT  : the zero-based position
+ *     OUTPUT : the element there
+ *     COST   : O(log n), expected
+ *********************************************/
+template <typename T>
+T & skip_list <T> :: operator [] (size_t index)
+{
+   return const_cast<Node *>(nodeAt(index))->data;
+}
+
+template <typename T>
+const T & skip_list <T> :: operator [] (size_t index) const
+{
+   return nodeAt(index)->data;
+}
+
+/*********************************************
+ * SKIP LIST :: ADVANCE
+ * move an iterator n positions in either direction
+ *     INPUT  : where to start and how far to go
+ *     OUTPUT : the new position, end() if we ran off
+ *     COST   : O(log n), expected
+ *********************************************/
+template <typename T>
+typename skip_list <T> :: iterator skip_list <T> :: advance(iterator it, long n)
+{
+   long index = (long)positionOf(it, false) + n;
+   if (index < 0 || index >= (long)numElements)
+      return end();
+   return iterator(const_cast<Node *>(nodeAt((size_t)index)));
+}
+
+/******************************************
+ * SKIP LIST :: ERASE
+ * remove an item from the middle of the list
+ *     INPUT  : an iterator to the item being removed
+ *     OUTPUT : iterator to the next item
+ *     COST   : O(log n), expected
+ ******************************************/
+template <typename T>
+typename skip_list <T> :: iterator skip_list <T> :: erase(const iterator & it)
+{
+   if (!it.p)
+      return end();
+   return erase_at(indexOf(it.p));
+}
+
+/******************************************
+ * SKIP LIST :: ERASE AT
+ * remove the item at a given position
+ *     INPUT  : the zero-based position
+ *     OUTPUT : iterator to the next item
+ *     COST   : O(log n), expected
+ ******************************************/
+template <typename T>
+typename skip_list <T> :: iterator skip_list <T> :: erase_at(size_t index)
+{
+   if (index >= numElements)
+      throw "ERROR: index out of range";
+
+   Node * update[MAX_LEVEL];
+   size_t rank[MAX_LEVEL];
+   findBefore(index, update, rank);
+   Node * pErase = linksOf(update[0])[0].pNext;
+
+   // everything that jumped over or onto this node now lands one short
+   for (unsigned int l = 0; l < levels; l++)
+   {
+      Link & link = linksOf(update[l])[l];
+      if (l < pErase->levels)
+      {
+         link.pNext = pErase->links[l].pNext;
+         link.width += pErase->links[l].width - 1;
+      }
+      else
+         link.width--;
+   }
+
+   Node * pNext = pErase->links[0].pNext;
+   if (pNext)
+      pNext->pPrev = update[0];
+   else
+      pTail = update[0];
+
+   while (levels > 1 && head[levels - 1].pNext == nullptr)
+      levels--;
+
+   destroy(pErase);
+   numElements--;
+   return iterator(pNext);
+}
+
+/******************************************
+ * SKIP LIST :: NODE AT
+ * walk down the levels, counting, to a position
+ *     INPUT  : the zero-based position
+ *     OUTPUT : the node there
+ *     COST   : O(log n), expected
+ ******************************************/
+template <typename T>
+const typename skip_list <T> :: Node * skip_list <T> :: nodeAt(size_t index) const
+{
+   if (index >= numElements)
+      throw "ERROR: index out of range";
+
+   // the head is position 0 so element i is position i + 1
+   const Node * p = nullptr;
+   size_t traveled = 0;
+   for (unsigned int l = levels; l-- > 0; )
+      while (linksOf(p)[l].pNext && traveled + linksOf(p)[l].width <= index + 1)
+      {
+         traveled += linksOf(p)[l].width;
+         p = linksOf(p)[l].pNext;
+      }
+
+   assert(p && traveled == index + 1);
+   return p;
+}
+
+/******************************************
+ * SKIP LIST :: INDEX OF
+ * find a node's position by always taking its highest
+ * link toward the end, then counting back from there
+ *     INPUT  : a node in this list
+ *     OUTPUT : its zero-based position
+ *     COST   : O(log n), expected
+ ******************************************/
+template <typename T>
+size_t skip_list <T> :: indexOf(const Node * p) const
+{
+   // the end is position numElements + 1
+   size_t toEnd = 0;
+   while (p)
+   {
+      const Link & link = p->links[p->levels - 1];
+      toEnd += link.width;
+      p = link.pNext;
+   }
+   return numElements - toEnd;
+}
+
+/******************************************
+ * SKIP LIST :: FIND BEFORE
+ * at every level, find the last node before a position
+ *     INPUT  : the zero-based position
+ *     OUTPUT : update[l] is that node (nullptr is the head)
+ *              rank[l] is its position
+ *     COST   : O(log n), expected
+ ******************************************/
+template <typename T>
+void skip_list <T> :: findBefore(size_t index, Node ** update, size_t * rank)
+{
+   Node * p = nullptr;
+   size_t traveled = 0;
+   for (unsigned int l = levels; l-- > 0; )
+   {
+      while (linksOf(p)[l].pNext && traveled + linksOf(p)[l].width <= index)
+      {
+         traveled += linksOf(p)[l].width;
+         p = linksOf(p)[l].pNext;
+      }
+      update[l] = p;
+      rank[l] = traveled;
+   }
+}
+
+/******************************************
+ * SKIP LIST :: INSERT AT
+ * add an item so it ends up at a given position
+ *     INPUT  : the zero-based position and the data
+ *     OUTPUT : iterator to the new item
+ *     COST   : O(log n), expected
+ ******************************************/
+template <typename T>
+template <class U>
+typename skip_list <T> :: iterator skip_list <T> :: insertAt(size_t index, U && data)
+{
+   assert(index <= numElements);
+
+   Node * update[MAX_LEVEL];
+   size_t rank[MAX_LEVEL];
+   findBefore(index, update, rank);
+
+   unsigned int height = randomLevel();
+   Node * pNew = allocate(height, std::forward<U>(data));
+
+   // new levels start out as one long link from the head to the end
+   for (; levels < height; levels++)
+   {
+      head[levels].pNext = nullptr;
+      head[levels].width = numElements + 1;
+      update[levels] = nullptr;
+      rank[levels] = 0;
+   }
+
+   // the new node is position index + 1; whatever followed moves back one
+   for (unsigned int l = 0; l < levels; l++)
+   {
+      Link & link = linksOf(update[l])[l];
+      if (l < height)
+      {
+         pNew->links[l].pNext = link.pNext;
+         pNew->links[l].width = rank[l] + link.width - index;
+         link.pNext = pNew;
+         link.width = index + 1 - rank[l];
+      }
+      else
+         link.width++;
+   }
+
+   pNew->pPrev = update[0];
+   if (pNew->links[0].pNext)
+      pNew->links[0].pNext->pPrev = pNew;
+   else
+      pTail = pNew;
+
+   numElements++;
+   return iterator(pNew);
+}
+
+/******************************************
+ * SKIP LIST :: RANDOM LEVEL
+ * a node is one level taller with probability 1/4
+ *     OUTPUT : a height in [1, MAX_LEVEL]
+ *     COST   : O(1), expected
+ ******************************************/
+template <typename T>
+unsigned int skip_list <T> :: randomLevel()
+{
+   // xorshift: cheap, and the same sequence every run
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+
+   unsigned int height = 1;
+   for (uint32_t bits = seed; (bits & 3) == 0 && height < MAX_LEVEL; bits >>= 2)
+      height++;
+   return height;
+}
+
+/******************************************
+ * SKIP LIST :: ALLOCATE
+ * a node and its links share a single allocation
+ *     INPUT  : the node's height and data
+ *     OUTPUT : the new node
+ ******************************************/
+template <typename T>
+template <class U>
+typename skip_list <T> :: Node * skip_list <T> :: allocate(unsigned int levels, U && data)
+{
+   // round the node up so the links that follow it are aligned
+   const size_t offset = (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+   char * pRaw = static_cast<char *>(::operator new(offset + levels * sizeof(Link)));
+
+   Link * links = reinterpret_cast<Link *>(pRaw + offset);
+   try
+   {
+      return new (pRaw) Node(levels, links, std::forward<U>(data));
+   }
+   catch (...)
+   {
+      ::operator delete(pRaw);
+      throw;
+   }
+}
+
+/******************************************
+ * SKIP LIST :: DESTROY
+ * undo allocate()
+ ******************************************/
+template <typename T>
+void skip_list <T> :: destroy(Node * p)
+{
+   p->~Node();
+   ::operator delete(static_cast<void *>(p));
+}
+
+/**********************************************
+ * SWAP
+ * Swap the list from LHS to RHS
+ *   COST   : O(1)
+ *********************************************/
+template <typename T>
+inline void swap(skip_list <T> & lhs, skip_list <T> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+}; // namespace custom
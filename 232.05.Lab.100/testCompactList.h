@@ -0,0 +1,492 @@
+/***********************************************************************
+ * Header:
+ *    TEST COMPACT LIST
+ * Summary:
+ *    Unit tests for compact_list and the pool beneath it
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "compactList.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <iostream>
+
+class TestCompactList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sizeThreeFill();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructInit_standard();
+      test_destructor_standard();
+
+      // Assign
+      test_assign_smallToBig();
+      test_assign_bigToSmall();
+      test_assign_reusesNodes();
+
+      // Iterator
+      test_iterator_forward();
+      test_iterator_backward();
+
+      // Insert
+      test_pushback_empty();
+      test_pushfront_standard();
+      test_insert_standardMiddle();
+      test_insert_manyChunks();
+
+      // Remove
+      test_erase_standardFront();
+      test_erase_standardMiddle();
+      test_erase_standardEnd();
+      test_clear_standard();
+      test_clear_reusesSlots();
+
+      // Status
+      test_nodeSize();
+
+      report("CompactList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::compact_list<int> l;
+      // verify
+      assertEmptyFixture(l);
+      assertUnit(l.nodes.capacity() == 0);
+      assertUnit(l.nodes.numChunks == 0);
+   }  // teardown
+
+   // construct with a size of three and fill
+   void test_construct_sizeThreeFill()
+   {  // setup
+      // exercise
+      custom::compact_list<int> l(size_t(3), 99);
+      // verify
+      //    +----+   +----+   +----+
+      //    | 99 | - | 99 | - | 99 |
+      //    +----+   +----+   +----+
+      assertUnit(l.numElements == 3);
+      assertUnit(l.nodes.size() == 3);
+      assertUnit(l.iHead != l.NIL);
+      if (l.iHead != l.NIL)
+      {
+         assertUnit(l.nodes[l.iHead].data == 99);
+         assertUnit(l.nodes[l.iHead].iPrev == l.NIL);
+      }
+      assertUnit(l.iTail != l.NIL);
+      if (l.iTail != l.NIL)
+      {
+         assertUnit(l.nodes[l.iTail].data == 99);
+         assertUnit(l.nodes[l.iTail].iNext == l.NIL);
+      }
+   }  // teardown
+
+   // copy constructor of a standard list
+   void test_constructCopy_standard()
+   {  // setup
+      custom::compact_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      // exercise
+      custom::compact_list<int> lDest(lSrc);
+      // verify
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDest);
+      assertUnit(&lDest.nodes[lDest.iHead] != &lSrc.nodes[lSrc.iHead]);
+   }  // teardown
+
+   // move constructor of a standard list
+   void test_constructMove_standard()
+   {  // setup
+      custom::compact_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      int * pFirst = &lSrc.nodes[lSrc.iHead].data;
+      // exercise
+      custom::compact_list<int> lDest(std::move(lSrc));
+      // verify
+      assertEmptyFixture(lSrc);
+      assertStandardFixture(lDest);
+      assertUnit(&lDest.nodes[lDest.iHead].data == pFirst);
+   }  // teardown
+
+   // initializer list constructor
+   void test_constructInit_standard()
+   {  // setup
+      // exercise
+      custom::compact_list<int> l{ 11, 26, 31 };
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // the destructor releases every node back to the pool
+   void test_destructor_standard()
+   {  // setup
+      std::allocator<custom::compact_list<int>> alloc;
+      custom::compact_list<int> * pl = alloc.allocate(1);
+      alloc.construct(pl);
+      setupStandardFixture(*pl);
+      // exercise
+      pl->~compact_list();
+      // verify
+      assertUnit(pl->numElements == 0);
+      assertUnit(pl->iHead == pl->NIL);
+      // teardown
+      alloc.deallocate(pl, 1);
+   }
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign a three-element list onto a five-element list
+   void test_assign_smallToBig()
+   {  // setup
+      custom::compact_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::compact_list<int> lDest{ 1, 2, 3, 4, 5 };
+      // exercise
+      lDest = lSrc;
+      // verify
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDest);
+      assertUnit(lDest.nodes.size() == 3);
+   }  // teardown
+
+   // assign a three-element list onto a one-element list
+   void test_assign_bigToSmall()
+   {  // setup
+      custom::compact_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::compact_list<int> lDest{ 99 };
+      // exercise
+      lDest = lSrc;
+      // verify
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   // assigning onto a list of the same size touches no slots
+   void test_assign_reusesNodes()
+   {  // setup
+      custom::compact_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::compact_list<int> lDest{ 1, 2, 3 };
+      uint32_t iHead = lDest.iHead;
+      uint32_t iTail = lDest.iTail;
+      // exercise
+      lDest = lSrc;
+      // verify
+      assertStandardFixture(lDest);
+      assertUnit(lDest.iHead == iHead);
+      assertUnit(lDest.iTail == iTail);
+      assertUnit(lDest.nodes.capacity() == 3);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk from begin() to end()
+   void test_iterator_forward()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      int values[3];
+      int i = 0;
+      // exercise
+      for (auto it = l.begin(); it != l.end() && i < 3; ++it)
+         values[i++] = *it;
+      // verify
+      assertUnit(i == 3);
+      assertUnit(values[0] == 11);
+      assertUnit(values[1] == 26);
+      assertUnit(values[2] == 31);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // walk from rbegin() back to end()
+   void test_iterator_backward()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      int values[3];
+      int i = 0;
+      // exercise
+      for (auto it = l.rbegin(); it != l.end() && i < 3; --it)
+         values[i++] = *it;
+      // verify
+      assertUnit(i == 3);
+      assertUnit(values[0] == 31);
+      assertUnit(values[1] == 26);
+      assertUnit(values[2] == 11);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push back onto an empty list
+   void test_pushback_empty()
+   {  // setup
+      custom::compact_list<int> l;
+      // exercise
+      l.push_back(99);
+      // verify
+      assertUnit(l.numElements == 1);
+      assertUnit(l.iHead == l.iTail);
+      assertUnit(l.iHead == 0);
+      assertUnit(l.back() == 99);
+      assertUnit(l.front() == 99);
+   }  // teardown
+
+   // push front onto a standard list
+   void test_pushfront_standard()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.push_front(99);
+      // verify
+      //    +----+   +----+   +----+   +----+
+      //    | 99 | - | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+   +----+
+      assertUnit(l.numElements == 4);
+      assertUnit(l.front() == 99);
+      assertUnit(l.nodes[l.iHead].iPrev == l.NIL);
+      assertUnit(l.nodes[l.nodes[l.iHead].iNext].data == 11);
+      assertUnit(l.nodes[l.nodes[l.iHead].iNext].iPrev == l.iHead);
+      assertUnit(l.back() == 31);
+   }  // teardown
+
+   // insert into the middle of a standard list
+   void test_insert_standardMiddle()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      auto it = l.begin();
+      ++it;
+      // exercise
+      auto itNew = l.insert(it, 99);
+      // verify
+      //    +----+   +----+   +----+   +----+
+      //    | 11 | - | 99 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+   +----+
+      assertUnit(*itNew == 99);
+      assertUnit(l.numElements == 4);
+      assertUnit(l.nodes[l.iHead].iNext == itNew.i);
+      assertUnit(l.nodes[itNew.i].iPrev == l.iHead);
+      assertUnit(l.nodes[itNew.i].iNext == it.i);
+      assertUnit(l.nodes[it.i].iPrev == itNew.i);
+   }  // teardown
+
+   // fill enough to need several chunks; earlier references stay put
+   void test_insert_manyChunks()
+   {  // setup
+      custom::compact_list<int> l;
+      l.push_back(0);
+      int * pFirst = &l.front();
+      // exercise
+      for (int i = 1; i < 1000; i++)
+         l.push_back(i);
+      // verify
+      assertUnit(l.size() == 1000);
+      assertUnit(l.nodes.numChunks == 4);
+      assertUnit(&l.front() == pFirst);
+      int expected = 0;
+      bool inOrder = true;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         inOrder = inOrder && (*it == expected++);
+      assertUnit(inOrder);
+      assertUnit(expected == 1000);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase the first element
+   void test_erase_standardFront()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      auto it = l.erase(l.begin());
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(l.numElements == 2);
+      assertUnit(l.nodes.size() == 2);
+      assertUnit(l.front() == 26);
+      assertUnit(l.nodes[l.iHead].iPrev == l.NIL);
+   }  // teardown
+
+   // erase the middle element
+   void test_erase_standardMiddle()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      auto it = l.begin();
+      ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(*it == 31);
+      assertUnit(l.numElements == 2);
+      assertUnit(l.nodes[l.iHead].iNext == l.iTail);
+      assertUnit(l.nodes[l.iTail].iPrev == l.iHead);
+   }  // teardown
+
+   // erase the last element
+   void test_erase_standardEnd()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      auto it = l.erase(l.rbegin());
+      // verify
+      assertUnit(it == l.end());
+      assertUnit(l.numElements == 2);
+      assertUnit(l.back() == 26);
+      assertUnit(l.nodes[l.iTail].iNext == l.NIL);
+   }  // teardown
+
+   // clear a standard list
+   void test_clear_standard()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.clear();
+      // verify
+      assertEmptyFixture(l);
+      assertUnit(l.nodes.size() == 0);
+      assertUnit(l.nodes.capacity() == 3);
+   }  // teardown
+
+   // refill after a clear without carving any new slots
+   void test_clear_reusesSlots()
+   {  // setup
+      custom::compact_list<int> l;
+      setupStandardFixture(l);
+      l.clear();
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertStandardFixture(l);
+      assertUnit(l.nodes.capacity() == 3);
+      assertUnit(l.nodes.numChunks == 1);
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // the links cost two 32-bit indices per element
+   void test_nodeSize()
+   {  // setup
+      // exercise
+      size_t sizeNode = sizeof(custom::compact_list<int>::Node);
+      // verify
+      assertUnit(sizeNode == sizeof(int) + 2 * sizeof(uint32_t));
+      assertUnit(sizeNode <= sizeof(int) + 2 * sizeof(void *));
+   }  // teardown
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *        iHead             iTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void setupStandardFixture(custom::compact_list<int>& l)
+   {
+      // allocate
+      uint32_t i1 = l.nodes.allocate(int(11));
+      uint32_t i2 = l.nodes.allocate(int(26));
+      uint32_t i3 = l.nodes.allocate(int(31));
+
+      // hook up indices
+      l.nodes[i1].iNext = i2;
+      l.nodes[i2].iNext = i3;
+      l.nodes[i3].iPrev = i2;
+      l.nodes[i2].iPrev = i1;
+
+      // set up the list
+      l.iHead = i1;
+      l.iTail = i3;
+      l.numElements = 3;
+   }
+
+   /****************************************************************
+    * Verify Empty Fixture
+    ****************************************************************/
+   void assertEmptyFixtureParameters(const custom::compact_list<int>& l, int line, const char* function)
+   {
+      // verify the member variables
+      assertIndirect(l.numElements == 0);
+      assertIndirect(l.iHead == l.NIL);
+      assertIndirect(l.iTail == l.NIL);
+   }
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *        iHead             iTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const custom::compact_list<int>& l, int line, const char* function)
+   {
+      // verify the member variables
+      assertIndirect(l.numElements == 3);
+      assertIndirect(l.iHead != l.NIL);
+      assertIndirect(l.iTail != l.NIL);
+
+      // verify the linked list
+      if (l.iHead != l.NIL)
+      {
+         uint32_t i1 = l.iHead;
+         assertIndirect(l.nodes[i1].data == int(11));
+         assertIndirect(l.nodes[i1].iPrev == l.NIL);
+         assertIndirect(l.nodes[i1].iNext != l.NIL);
+         if (l.nodes[i1].iNext != l.NIL)
+         {
+            uint32_t i2 = l.nodes[i1].iNext;
+            assertIndirect(l.nodes[i2].data == int(26));
+            assertIndirect(l.nodes[i2].iPrev == i1);
+            assertIndirect(l.nodes[i2].iNext == l.iTail);
+            if (l.nodes[i2].iNext != l.NIL)
+            {
+               uint32_t i3 = l.nodes[i2].iNext;
+               assertIndirect(l.nodes[i3].data == int(31));
+               assertIndirect(l.nodes[i3].iPrev == i2);
+               assertIndirect(l.nodes[i3].iNext == l.NIL);
+            }
+         }
+      }
+   }
+};
+
+#endif // DEBUG
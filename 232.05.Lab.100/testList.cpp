@@ -12,7 +12,11 @@
 #endif
  //#undef DEBUG  // Remove this comment to disable unit tests
 
-#include "testList.h"       // for the spy unit tests
+#include "testList.h"       // for the list unit tests
+#include "testCompactList.h" // for the compact list unit tests
+#include "testSkipList.h"   // for the skip list unit tests
+#include "testSpy.h"        // for the spy unit tests
+int Spy::counters[] = {};
 
 
 /**********************************************************************
@@ -23,7 +27,10 @@ int main()
 {
 #ifdef DEBUG
    // unit tests
+   TestSpy().run();
    TestList().run();
+   TestCompactList().run();
+   TestSkipList().run();
 #endif // DEBUG
    
    return 0;
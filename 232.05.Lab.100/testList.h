@@ -14,8 +14,12 @@
 #include "list.h"
 #include <list>
 #include "unitTest.h"
+#include "spy.h"
+
+#define assertNoCopies()          assertNoCopiesParameters(__LINE__, __FUNCTION__)
 
 #include <vector>
+#include <algorithm>  // for std::sort
 #include <cassert>
 #include <memory>
 #include <iostream>
@@ -105,6 +109,35 @@ public:
       test_empty_empty();
       test_empty_three();
 
+      // Splice and Reorder
+      test_splice_allToMiddle();
+      test_splice_allToEnd();
+      test_splice_oneWithinList();
+      test_splice_oneFromOther();
+      test_splice_range();
+      test_merge_standard();
+      test_sort_empty();
+      test_sort_standard();
+      test_sort_stable();
+      test_sort_large();
+      test_unique_standard();
+      test_reverse_standard();
+
+      // Node Reuse
+      test_assign_reusesNodes();
+      test_spare_off();
+      test_spare_eraseFeeds();
+      test_spare_clearRefill();
+      test_spare_shrink();
+
+      // Compact
+      test_compact_empty();
+      test_compact_standard();
+      test_compact_eraseThenInsert();
+      test_compact_twice();
+      test_compact_spliceOut();
+      test_compact_heapNode();
+
       report("List");
    }
 
@@ -1909,6 +1942,533 @@ public:
       teardownStandardFixture(l);
    }
 
+   /***************************************
+    * SPLICE AND REORDER
+    *    none of these may allocate, copy, or assign
+    ***************************************/
+
+   // move a whole list into the middle of another
+   void test_splice_allToMiddle()
+   {  // setup
+      custom::list<Spy> lDest{ Spy(11), Spy(26), Spy(31) };
+      custom::list<Spy> lSrc{ Spy(1), Spy(2) };
+      auto it = lDest.begin();
+      ++it;
+      Spy::reset();
+      // exercise
+      lDest.splice(it, lSrc);
+      // verify
+      assertNoCopies();
+      //    +----+   +----+   +----+   +----+   +----+
+      //    | 11 | - | 01 | - | 02 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+   +----+   +----+
+      assertUnit(isLinked(lDest));
+      assertUnit(isLinked(lSrc));
+      assertUnit(lSrc.empty());
+      assertUnit(lSrc.pHead == nullptr);
+      assertUnit(valuesAre(lDest, { 11, 1, 2, 26, 31 }));
+      // teardown
+      lDest.clear();
+   }
+
+   // move a whole list onto the end of another
+   void test_splice_allToEnd()
+   {  // setup
+      custom::list<Spy> lDest{ Spy(11), Spy(26) };
+      custom::list<Spy> lSrc{ Spy(31) };
+      Spy::reset();
+      // exercise
+      lDest.splice(lDest.end(), lSrc);
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(lDest));
+      assertUnit(lSrc.empty());
+      assertUnit(valuesAre(lDest, { 11, 26, 31 }));
+      assertUnit(lDest.back() == Spy(31));
+      // teardown
+      lDest.clear();
+   }
+
+   // move the last node of a list to its front
+   void test_splice_oneWithinList()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      auto * pMove = l.pTail;
+      Spy::reset();
+      // exercise
+      l.splice(l.begin(), l, l.rbegin());
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(l));
+      assertUnit(l.pHead == pMove);
+      assertUnit(valuesAre(l, { 31, 11, 26 }));
+      // teardown
+      l.clear();
+   }
+
+   // move one node from one list to another
+   void test_splice_oneFromOther()
+   {  // setup
+      custom::list<Spy> lDest{ Spy(11), Spy(31) };
+      custom::list<Spy> lSrc{ Spy(1), Spy(26), Spy(2) };
+      auto itDest = lDest.begin();
+      ++itDest;
+      auto itSrc = lSrc.begin();
+      ++itSrc;
+      Spy::reset();
+      // exercise
+      lDest.splice(itDest, lSrc, itSrc);
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(lDest));
+      assertUnit(isLinked(lSrc));
+      assertUnit(valuesAre(lDest, { 11, 26, 31 }));
+      assertUnit(valuesAre(lSrc, { 1, 2 }));
+      // teardown
+      lDest.clear();
+      lSrc.clear();
+   }
+
+   // move a range out of the middle of one list into another
+   void test_splice_range()
+   {  // setup
+      custom::list<Spy> lDest{ Spy(11), Spy(31) };
+      custom::list<Spy> lSrc{ Spy(1), Spy(26), Spy(27), Spy(2) };
+      auto itDest = lDest.begin();
+      ++itDest;
+      auto itFirst = lSrc.begin();
+      ++itFirst;
+      auto itLast = itFirst;
+      ++itLast;
+      ++itLast;
+      Spy::reset();
+      // exercise
+      lDest.splice(itDest, lSrc, itFirst, itLast);
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(lDest));
+      assertUnit(isLinked(lSrc));
+      assertUnit(valuesAre(lDest, { 11, 26, 27, 31 }));
+      assertUnit(valuesAre(lSrc, { 1, 2 }));
+      // teardown
+      lDest.clear();
+      lSrc.clear();
+   }
+
+   // merge two sorted lists; ties keep the left-hand node first
+   void test_merge_standard()
+   {  // setup
+      custom::list<Spy> lDest{ Spy(10), Spy(30), Spy(50) };
+      custom::list<Spy> lSrc{ Spy(20), Spy(30), Spy(40) };
+      auto * p30Dest = lDest.pHead->pNext;
+      auto * p30Src = lSrc.pHead->pNext;
+      Spy::reset();
+      // exercise
+      lDest.merge(lSrc);
+      // verify
+      assertNoCopies();
+      assertUnit(Spy::numLessthan() <= 5);
+      assertUnit(isLinked(lDest));
+      assertUnit(lSrc.empty());
+      assertUnit(valuesAre(lDest, { 10, 20, 30, 30, 40, 50 }));
+      assertUnit(lDest.pHead->pNext->pNext == p30Dest);
+      assertUnit(lDest.pHead->pNext->pNext->pNext == p30Src);
+      // teardown
+      lDest.clear();
+   }
+
+   // sorting an empty list does nothing
+   void test_sort_empty()
+   {  // setup
+      custom::list<Spy> l;
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertNoCopies();
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   // sort a short list in reverse order
+   void test_sort_standard()
+   {  // setup
+      custom::list<Spy> l{ Spy(70), Spy(60), Spy(50), Spy(40), Spy(30), Spy(20), Spy(10) };
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(l));
+      assertUnit(valuesAre(l, { 10, 20, 30, 40, 50, 60, 70 }));
+      // teardown
+      l.clear();
+   }
+
+   // equal elements keep their relative order
+   void test_sort_stable()
+   {  // setup
+      custom::list<Spy> l{ Spy(2), Spy(1), Spy(2), Spy(1), Spy(2) };
+      auto * pFirst2 = l.pHead;
+      auto * pFirst1 = l.pHead->pNext;
+      auto * pLast2 = l.pTail;
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(l));
+      assertUnit(valuesAre(l, { 1, 1, 2, 2, 2 }));
+      assertUnit(l.pHead == pFirst1);
+      assertUnit(l.pHead->pNext->pNext == pFirst2);
+      assertUnit(l.pTail == pLast2);
+      // teardown
+      l.clear();
+   }
+
+   // sort enough elements to exercise many bins
+   void test_sort_large()
+   {  // setup
+      custom::list<int> l;
+      std::vector<int> v;
+      unsigned int seed = 12345;
+      for (int i = 0; i < 1000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)((seed >> 16) % 500);
+         l.push_back(value);
+         v.push_back(value);
+      }
+      // exercise
+      l.sort();
+      // verify
+      std::sort(v.begin(), v.end());
+      assertUnit(isLinked(l));
+      assertUnit(l.size() == 1000);
+      bool same = true;
+      auto it = l.begin();
+      for (size_t i = 0; i < v.size() && it != l.end(); i++, ++it)
+         same = same && (*it == v[i]);
+      assertUnit(same);
+      // teardown
+      l.clear();
+   }
+
+   // remove runs of duplicates
+   void test_unique_standard()
+   {  // setup
+      custom::list<Spy> l{ Spy(1), Spy(1), Spy(2), Spy(2), Spy(2), Spy(3), Spy(1) };
+      Spy::reset();
+      // exercise
+      l.unique();
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(isLinked(l));
+      assertUnit(valuesAre(l, { 1, 2, 3, 1 }));
+      // teardown
+      l.clear();
+   }
+
+   // turn a list around
+   void test_reverse_standard()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      auto * pHead = l.pHead;
+      auto * pTail = l.pTail;
+      Spy::reset();
+      // exercise
+      l.reverse();
+      // verify
+      assertNoCopies();
+      assertUnit(isLinked(l));
+      assertUnit(l.pHead == pTail);
+      assertUnit(l.pTail == pHead);
+      assertUnit(valuesAre(l, { 31, 26, 11 }));
+      // teardown
+      l.clear();
+   }
+
+   /***************************************
+    * NODE REUSE
+    ***************************************/
+
+   // copy onto a longer list: assign in place, give back only the extra
+   void test_assign_reusesNodes()
+   {  // setup
+      custom::list<Spy> lSrc{ Spy(11), Spy(26) };
+      custom::list<Spy> lDes{ Spy(61), Spy(73), Spy(85) };
+      auto * p1 = lDes.pHead;
+      auto * p2 = lDes.pHead->pNext;
+      Spy::reset();
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 2);
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(lDes.pHead == p1);
+      assertUnit(lDes.pTail == p2);
+      assertUnit(isLinked(lDes));
+      assertUnit(valuesAre(lDes, { 11, 26 }));
+      // teardown
+      lSrc.clear();
+      lDes.clear();
+   }
+
+   // with no limit set, nothing is held back
+   void test_spare_off()
+   {  // setup
+      custom::list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.spare_limit() == 0);
+      assertUnit(l.spares() == 0);
+      assertUnit(l.pSpare == nullptr);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // erase keeps nodes up to the limit and no further
+   void test_spare_eraseFeeds()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      l.set_spare_limit(2);
+      auto * pFirst = l.pHead;
+      Spy::reset();
+      // exercise
+      l.pop_front();
+      l.pop_front();
+      l.pop_front();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(l.spares() == 2);
+      assertUnit(l.pSpare != nullptr);
+      assertUnit(static_cast<void *>(l.pSpare) != static_cast<void *>(pFirst));
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   // clear then refill: every node comes off the spare chain
+   void test_spare_clearRefill()
+   {  // setup
+      custom::list<int> l;
+      l.set_spare_limit(8);
+      setupStandardFixture(l);
+      std::vector<custom::list<int>::Node *> before{ l.pHead, l.pHead->pNext, l.pTail };
+      // exercise
+      l.clear();
+      l.push_back(11);
+      l.push_back(26);
+      l.push_front(31);
+      // verify
+      assertUnit(l.spares() == 0);
+      assertUnit(l.size() == 3);
+      std::vector<custom::list<int>::Node *> after{ l.pHead, l.pHead->pNext, l.pTail };
+      std::sort(before.begin(), before.end());
+      std::sort(after.begin(), after.end());
+      assertUnit(before == after);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // lowering the limit frees the surplus
+   void test_spare_shrink()
+   {  // setup
+      custom::list<int> l;
+      l.set_spare_limit(3);
+      setupStandardFixture(l);
+      l.clear();
+      // exercise
+      l.set_spare_limit(1);
+      // verify
+      assertUnit(l.spare_limit() == 1);
+      assertUnit(l.spares() == 1);
+      // teardown
+      l.set_spare_limit(0);
+      assertUnit(l.pSpare == nullptr);
+   }
+
+   /***************************************
+    * COMPACT
+    ***************************************/
+
+   // compacting an empty list does nothing
+   void test_compact_empty()
+   {  // setup
+      custom::list<int> l;
+      // exercise
+      l.compact();
+      // verify
+      assertUnit(l.pFreeSlot == nullptr);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // scattered nodes end up side by side, in order, moved not copied
+   void test_compact_standard()
+   {  // setup
+      custom::list<Spy> l;
+      l.push_back(Spy(26));
+      l.push_front(Spy(11));
+      l.push_back(Spy(31));
+      Spy::reset();
+      // exercise
+      l.compact();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopyMove() == 3);
+      assertUnit(Spy::numDestructor() == 3);
+      auto * pBlock = custom::list<Spy>::Block::of(l.pHead);
+      assertUnit(pBlock != nullptr);
+      assertUnit(pBlock->pNodes == l.pHead);
+      assertUnit(pBlock->numHeld == 3);
+      assertUnit(l.pHead->pNext == l.pHead + 1);
+      assertUnit(l.pTail == l.pHead + 2);
+      assertUnit(isLinked(l));
+      assertUnit(valuesAre(l, { 11, 26, 31 }));
+      // teardown
+      l.clear();
+      assertUnit(l.pFreeSlot == nullptr);
+   }
+
+   // an erased slot in the block is the next one filled
+   void test_compact_eraseThenInsert()
+   {  // setup
+      custom::list<int> l;
+      setupStandardFixture(l);
+      l.compact();
+      auto * pMiddle = l.pHead->pNext;
+      auto it = l.begin();
+      ++it;
+      // exercise
+      l.erase(it);
+      l.push_front(99);
+      // verify
+      assertUnit(l.pHead == pMiddle);
+      assertUnit(l.pFreeSlot == nullptr);
+      assertUnit(l.size() == 3);
+      assertUnit(isLinked(l));
+      // teardown
+      l.clear();
+   }
+
+   // compact twice: the second block replaces the first
+   void test_compact_twice()
+   {  // setup
+      custom::list<int> l;
+      setupStandardFixture(l);
+      l.compact();
+      l.push_back(42);
+      // exercise
+      l.compact();
+      // verify
+      auto * pBlock = custom::list<int>::Block::of(l.pHead);
+      assertUnit(pBlock->numHeld == 4);
+      assertUnit(custom::list<int>::Block::of(l.pTail) == pBlock);
+      assertUnit(l.pTail == l.pHead + 3);
+      assertUnit(l.size() == 4);
+      assertUnit(isLinked(l));
+      // teardown
+      l.clear();
+   }
+
+   // nodes spliced out of a compacted list keep its block alive
+   void test_compact_spliceOut()
+   {  // setup
+      custom::list<Spy> lDest;
+      {
+         custom::list<Spy> lSrc{ Spy(11), Spy(26), Spy(31) };
+         lSrc.compact();
+         // exercise
+         lDest.splice(lDest.end(), lSrc, lSrc.begin());
+         lDest.splice(lDest.end(), lSrc);
+      }  // lSrc goes away with the block still in use
+      // verify
+      assertUnit(custom::list<Spy>::Block::of(lDest.pHead)->numHeld == 3);
+      assertUnit(isLinked(lDest));
+      assertUnit(valuesAre(lDest, { 11, 26, 31 }));
+      lDest.pop_front();
+      lDest.push_back(Spy(99));
+      assertUnit(valuesAre(lDest, { 26, 31, 99 }));
+      // teardown
+      lDest.clear();
+   }
+
+   // nodes stay three words, and a heap node is never taken for a block slot
+   void test_compact_heapNode()
+   {  // setup
+      custom::list<long> l{ 11, 26 };
+      l.compact();
+      // exercise
+      l.push_back(31);
+      // verify
+      assertUnit(sizeof(custom::list<long>::Node) == 3 * sizeof(void *));
+      assertUnit(custom::list<long>::Block::of(l.pHead) != nullptr);
+      assertUnit(custom::list<long>::Block::of(l.pTail) == nullptr);
+      assertUnit(l.size() == 3);
+      assertUnit(isLinked(l));
+      // teardown
+      l.clear();
+      assertUnit(l.pFreeSlot == nullptr);
+   }
+
+   /****************************************************************
+    * Assert No Copies
+    * Relinking nodes must not touch the elements
+    ****************************************************************/
+   void assertNoCopiesParameters(int line, const char* function)
+   {
+      assertIndirect(Spy::numAlloc() == 0);
+      assertIndirect(Spy::numDelete() == 0);
+      assertIndirect(Spy::numCopy() == 0);
+      assertIndirect(Spy::numCopyMove() == 0);
+      assertIndirect(Spy::numAssign() == 0);
+      assertIndirect(Spy::numAssignMove() == 0);
+      assertIndirect(Spy::numDestructor() == 0);
+   }
+
+   /****************************************************************
+    * Is Linked
+    * Every pNext has a matching pPrev and the count is right
+    ****************************************************************/
+   template <class T>
+   bool isLinked(const custom::list<T>& l)
+   {
+      size_t num = 0;
+      const typename custom::list<T>::Node * pPrev = nullptr;
+      for (auto p = l.pHead; p; p = p->pNext)
+      {
+         if (p->pPrev != pPrev)
+            return false;
+         pPrev = p;
+         num++;
+      }
+      return pPrev == l.pTail && num == l.numElements;
+   }
+
+   /****************************************************************
+    * Values Are
+    * Does the list hold exactly these values in this order?
+    ****************************************************************/
+   bool valuesAre(const custom::list<Spy>& l, const std::initializer_list<int>& il)
+   {
+      auto p = l.pHead;
+      for (int value : il)
+      {
+         if (!p || p->data.get() != value)
+            return false;
+         p = p->pNext;
+      }
+      return p == nullptr;
+   }
+
    /****************************************************************
     * Setup Standard Fixture
     *        pHead             pTail
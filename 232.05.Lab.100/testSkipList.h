@@ -0,0 +1,546 @@
+/***********************************************************************
+ * Header:
+ *    TEST SKIP LIST
+ * Summary:
+ *    Unit tests for skip_list
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "skipList.h"
+#include "unitTest.h"
+
+#include <vector>
+#include <string>
+#include <cassert>
+#include <memory>
+#include <iostream>
+
+class TestSkipList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sizeThreeFill();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructInit_standard();
+
+      // Assign
+      test_assign_smallToBig();
+      test_assign_bigToSmall();
+
+      // Iterator
+      test_iterator_forward();
+      test_iterator_backward();
+      test_advance_forwardAndBack();
+      test_advance_offTheEnd();
+
+      // Access
+      test_subscript_standard();
+      test_subscript_outOfRange();
+      test_front_empty();
+
+      // Insert
+      test_pushback_empty();
+      test_pushfront_standard();
+      test_insert_standardMiddle();
+      test_insert_after();
+
+      // Remove
+      test_erase_standardMiddle();
+      test_eraseAt_standardFront();
+      test_eraseAt_outOfRange();
+      test_popBack_standard();
+      test_clear_standard();
+
+      // Against a vector
+      test_random_manyOperations();
+
+      report("SkipList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::skip_list<int> l;
+      // verify
+      assertUnit(l.numElements == 0);
+      assertUnit(l.levels == 1);
+      assertUnit(l.head[0].pNext == nullptr);
+      assertUnit(l.head[0].width == 1);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   // fill constructor
+   void test_construct_sizeThreeFill()
+   {  // setup
+      // exercise
+      custom::skip_list<int> l(size_t(3), 99);
+      // verify
+      assertUnit(l.size() == 3);
+      assertUnit(l[0] == 99);
+      assertUnit(l[1] == 99);
+      assertUnit(l[2] == 99);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // copy constructor makes new nodes
+   void test_constructCopy_standard()
+   {  // setup
+      custom::skip_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      // exercise
+      custom::skip_list<int> lDes(lSrc);
+      // verify
+      assertUnit(lDes.head[0].pNext != lSrc.head[0].pNext);
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // move constructor steals the nodes
+   void test_constructMove_standard()
+   {  // setup
+      custom::skip_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      auto * pFirst = lSrc.head[0].pNext;
+      // exercise
+      custom::skip_list<int> lDes(std::move(lSrc));
+      // verify
+      assertUnit(lDes.head[0].pNext == pFirst);
+      assertUnit(lSrc.empty());
+      assertUnit(lSrc.head[0].pNext == nullptr);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // initializer list constructor
+   void test_constructInit_standard()
+   {  // setup
+      // exercise
+      custom::skip_list<int> l{ 11, 26, 31 };
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign 3 elements onto 5: the first three nodes are kept
+   void test_assign_smallToBig()
+   {  // setup
+      custom::skip_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::skip_list<int> lDes{ 1, 2, 3, 4, 5 };
+      auto * pFirst = lDes.head[0].pNext;
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(lDes.head[0].pNext == pFirst);
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // assign 3 elements onto 1
+   void test_assign_bigToSmall()
+   {  // setup
+      custom::skip_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::skip_list<int> lDes{ 99 };
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk from front to back
+   void test_iterator_forward()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      std::vector<int> v;
+      // exercise
+      for (auto it = l.begin(); it != l.end(); ++it)
+         v.push_back(*it);
+      // verify
+      assertUnit(v == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // walk from back to front
+   void test_iterator_backward()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      std::vector<int> v;
+      // exercise
+      for (auto it = l.rbegin(); it != l.end(); --it)
+         v.push_back(*it);
+      // verify
+      assertUnit(v == std::vector<int>({ 31, 26, 11 }));
+   }  // teardown
+
+   // jump ahead and then back
+   void test_advance_forwardAndBack()
+   {  // setup
+      custom::skip_list<int> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(i * 10);
+      // exercise
+      auto it = l.advance(l.begin(), 57);
+      auto it2 = l.advance(it, -20);
+      // verify
+      assertUnit(it != l.end());
+      assertUnit(*it == 570);
+      assertUnit(it2 != l.end());
+      assertUnit(*it2 == 370);
+   }  // teardown
+
+   // jumping past either end gives end()
+   void test_advance_offTheEnd()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      auto itPast = l.advance(l.begin(), 3);
+      auto itBefore = l.advance(l.rbegin(), -3);
+      // verify
+      assertUnit(itPast == l.end());
+      assertUnit(itBefore == l.end());
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // subscript reads and writes
+   void test_subscript_standard()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l[1] = 99;
+      // verify
+      assertUnit(l[0] == 11);
+      assertUnit(l[1] == 99);
+      assertUnit(l[2] == 31);
+   }  // teardown
+
+   // subscript past the end throws
+   void test_subscript_outOfRange()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      try
+      {
+         l[3];
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("ERROR: index out of range"));
+      }
+   }  // teardown
+
+   // front of an empty list throws
+   void test_front_empty()
+   {  // setup
+      custom::skip_list<int> l;
+      // exercise
+      try
+      {
+         l.front();
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("ERROR: unable to access data from an empty list"));
+      }
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto an empty list
+   void test_pushback_empty()
+   {  // setup
+      custom::skip_list<int> l;
+      // exercise
+      l.push_back(11);
+      // verify
+      assertUnit(l.size() == 1);
+      assertUnit(l.front() == 11);
+      assertUnit(l.back() == 11);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // push onto the front of the standard fixture
+   void test_pushfront_standard()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.push_front(1);
+      // verify
+      assertUnit(l.size() == 4);
+      assertUnit(l[0] == 1);
+      assertUnit(l[1] == 11);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // insert in front of the middle element
+   void test_insert_standardMiddle()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      auto it = l.begin();
+      ++it;
+      // exercise
+      auto itNew = l.insert(it, 20);
+      // verify
+      assertUnit(*itNew == 20);
+      assertUnit(l[1] == 20);
+      assertUnit(l[2] == 26);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // insert after the middle element
+   void test_insert_after()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      auto it = l.begin();
+      ++it;
+      // exercise
+      l.insert(it, 30, true);
+      // verify
+      assertUnit(l[2] == 30);
+      assertUnit(l[3] == 31);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase the middle element through an iterator
+   void test_erase_standardMiddle()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      auto it = l.begin();
+      ++it;
+      // exercise
+      auto itNext = l.erase(it);
+      // verify
+      assertUnit(itNext != l.end());
+      assertUnit(*itNext == 31);
+      assertUnit(l.size() == 2);
+      assertUnit(l[1] == 31);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // erase the first element by position
+   void test_eraseAt_standardFront()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.erase_at(0);
+      // verify
+      assertUnit(l.size() == 2);
+      assertUnit(l.front() == 26);
+      assertUnit(l.begin().p->pPrev == nullptr);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // erase past the end throws and changes nothing
+   void test_eraseAt_outOfRange()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      try
+      {
+         l.erase_at(3);
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("ERROR: index out of range"));
+      }
+      assertStandardFixture(l);
+   }  // teardown
+
+   // pop off the back
+   void test_popBack_standard()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.pop_back();
+      // verify
+      assertUnit(l.size() == 2);
+      assertUnit(l.back() == 26);
+      assertUnit(isConsistent(l));
+   }  // teardown
+
+   // clear returns to the default state
+   void test_clear_standard()
+   {  // setup
+      custom::skip_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.levels == 1);
+      assertUnit(l.head[0].pNext == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   /***************************************
+    * AGAINST A VECTOR
+    ***************************************/
+
+   // a long mix of positional inserts and erases
+   void test_random_manyOperations()
+   {  // setup
+      custom::skip_list<int> l;
+      std::vector<int> v;
+      unsigned int seed = 4242;
+      bool same = true;
+      // exercise
+      for (int i = 0; i < 3000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         size_t r = seed >> 8;
+         if (v.empty() || r % 3)
+         {
+            size_t index = r % (v.size() + 1);
+            l.insert(l.advance(l.begin(), (long)index), i);
+            v.insert(v.begin() + index, i);
+         }
+         else
+         {
+            size_t index = r % v.size();
+            l.erase_at(index);
+            v.erase(v.begin() + index);
+         }
+         if (i % 500 == 0)
+            same = same && isConsistent(l);
+      }
+      // verify
+      assertUnit(isConsistent(l));
+      assertUnit(l.size() == v.size());
+      for (size_t i = 0; i < v.size(); i += 37)
+         same = same && l[i] == v[i];
+      assertUnit(same);
+   }  // teardown
+
+   /****************************************************************
+    * Is Consistent
+    * Every level visits its nodes in order, each width is the
+    * number of level-0 steps it skips, and the back links match
+    ****************************************************************/
+   bool isConsistent(const custom::skip_list<int> & l)
+   {
+      // position of every node along level 0
+      std::vector<const custom::skip_list<int>::Node *> nodes;
+      const custom::skip_list<int>::Node * pPrev = nullptr;
+      for (auto p = l.head[0].pNext; p; p = p->links[0].pNext)
+      {
+         if (p->pPrev != pPrev || p->levels > l.levels)
+            return false;
+         nodes.push_back(p);
+         pPrev = p;
+      }
+      if (pPrev != l.pTail || nodes.size() != l.numElements)
+         return false;
+
+      auto positionOf = [&](const custom::skip_list<int>::Node * p) -> size_t
+      {
+         if (!p)
+            return nodes.size() + 1;
+         for (size_t i = 0; i < nodes.size(); i++)
+            if (nodes[i] == p)
+               return i + 1;
+         return 0;
+      };
+
+      for (unsigned int level = 0; level < l.levels; level++)
+      {
+         size_t position = 0;
+         const custom::skip_list<int>::Link * pLink = &l.head[level];
+         while (true)
+         {
+            size_t next = positionOf(pLink->pNext);
+            if (next == 0 || next - position != pLink->width)
+               return false;
+            if (!pLink->pNext)
+               break;
+            if (pLink->pNext->levels <= level)
+               return false;
+            position = next;
+            pLink = &pLink->pNext->links[level];
+         }
+      }
+      return true;
+   }
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *      +----+   +----+   +----+
+    *      | 11 | - | 26 | - | 31 |
+    *      +----+   +----+   +----+
+    ****************************************************************/
+   void setupStandardFixture(custom::skip_list<int> & l)
+   {
+      l.clear();
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+   }
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *      +----+   +----+   +----+
+    *      | 11 | - | 26 | - | 31 |
+    *      +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const custom::skip_list<int> & l, int line, const char * function)
+   {
+      assertIndirect(l.numElements == 3);
+      assertIndirect(isConsistent(l));
+      if (l.numElements == 3)
+      {
+         assertIndirect(l[0] == 11);
+         assertIndirect(l[1] == 26);
+         assertIndirect(l[2] == 31);
+      }
+   }
+};
+
+#endif // DEBUG
@@ -31,6 +31,14 @@
 
 #include <iostream>  // for OFSTREAM
 #include <cassert>
+#include <exception> // for std::exception_ptr
+#include <future>    // for std::async
+#include <thread>    // for std::thread::hardware_concurrency
+#include <new>       // for placement new
+#include <utility>   // for std::forward
+#include <vector>    // for std::vector
+
+class TestBNode;     // forward declaration for unit tests
 
 /*****************************************************************
  * BNODE
@@ -69,6 +77,117 @@ public:
    T data;
 };
 
+/*****************************************************************
+ * BNODE ARENA
+ * Hands out BNodes from a few large chunks instead of one heap
+ * allocation each.  Nodes allocated one after another sit side by
+ * side, so a tree built in one pass is laid out in that order.
+ * Released nodes are reused; once every node is released the
+ * chunks themselves go back to the heap all at once.
+ *****************************************************************/
+template <class T>
+class BNodeArena
+{
+   friend class ::TestBNode; // give unit tests access to the privates
+public:
+   BNodeArena() : pNext(nullptr), pEnd(nullptr), pFree(nullptr), numLive(0) { }
+   BNodeArena(const BNodeArena & rhs) = delete;
+   BNodeArena & operator = (const BNodeArena & rhs) = delete;
+  ~BNodeArena()
+   {
+      assert(numLive == 0);
+      reset();
+   }
+
+   // construct a node in the next free slot
+   template <class U>
+   BNode <T> * allocate(U && t)
+   {
+      void * pSlot;
+      if (pFree)
+      {
+         pSlot = pFree;
+         pFree = pFree->pNext;
+      }
+      else
+      {
+         if (pNext == pEnd)
+            grow(chunks.empty() ? (size_t)CHUNK_SIZE : 2 * (size_t)(pEnd - chunks.back()));
+         pSlot = pNext++;
+      }
+      BNode <T> * p = new (pSlot) BNode <T> (std::forward<U>(t));
+      numLive++;
+      return p;
+   }
+
+   // destroy a node and keep its slot for the next allocate()
+   void release(BNode <T> * p)
+   {
+      p->~BNode();
+      Free * pSlot = new (static_cast<void *>(p)) Free{ nullptr };
+      release(pSlot, pSlot, 1);
+   }
+
+   // make sure the next num allocations are contiguous
+   void reserve(size_t num)
+   {
+      if ((size_t)(pEnd - pNext) < num)
+         grow(num > (size_t)CHUNK_SIZE ? num : (size_t)CHUNK_SIZE);
+   }
+
+   // how many nodes are in use
+   size_t size() const { return numLive; }
+
+private:
+   template <class TT>
+   friend void clear(BNode <TT> * & pThis, BNodeArena <TT> & arena);
+
+   enum { CHUNK_SIZE = 256 };
+
+   // what a released slot holds until it is reused
+   struct Free
+   {
+      Free * pNext;   // the next released slot
+   };
+
+   // put a chain of already-destroyed nodes back, or let go of
+   // everything if nothing is left in use
+   void release(Free * pFirst, Free * pLast, size_t num)
+   {
+      assert(num <= numLive);
+      numLive -= num;
+      if (numLive == 0)
+      {
+         reset();
+         return;
+      }
+      pLast->pNext = pFree;
+      pFree = pFirst;
+   }
+
+   void grow(size_t num)
+   {
+      pNext = static_cast<BNode <T> *>(::operator new(num * sizeof(BNode <T>)));
+      pEnd = pNext + num;
+      chunks.push_back(pNext);
+   }
+
+   void reset()
+   {
+      for (auto pChunk : chunks)
+         ::operator delete(static_cast<void *>(pChunk));
+      chunks.clear();
+      pNext = pEnd = nullptr;
+      pFree = nullptr;
+   }
+
+   std::vector<BNode <T> *> chunks; // the start of every chunk, oldest first
+   BNode <T> * pNext;               // next never-used slot in the newest chunk
+   BNode <T> * pEnd;                // one past the newest chunk
+   Free * pFree;                    // chain of released slots
+   size_t numLive;                  // nodes currently in use
+};
+
 /*******************************************************************
  * SIZE BTREE
  * Return the size of a b-tree under the current node
@@ -237,3 +356,342 @@ void assign(BNode <T> * & pDest, const BNode <T> * pSrc)
    if (pDest->pRight)
       pDest->pRight->pParent = pDest;
 }
+
+/**********************************************
+ * COPY BINARY TREE - ARENA
+ * Same as copy() but the new nodes come from an arena,
+ * reserved up front so the copy is contiguous in preorder
+ *********************************************/
+template <class T>
+BNode <T> * copyPreorder(const BNode <T> * pSrc, BNodeArena <T> & arena)
+{
+   if (!pSrc)
+      return nullptr;
+
+   BNode<T> * pDest = arena.allocate(pSrc->data);
+
+   pDest->pLeft = copyPreorder(pSrc->pLeft, arena);
+   if (pDest->pLeft)
+      pDest->pLeft->pParent = pDest;
+
+   pDest->pRight = copyPreorder(pSrc->pRight, arena);
+   if (pDest->pRight)
+      pDest->pRight->pParent = pDest;
+
+   return pDest;
+}
+
+template <class T>
+BNode <T> * copy(const BNode <T> * pSrc, BNodeArena <T> & arena)
+{
+   arena.reserve(size(pSrc));
+   return copyPreorder(pSrc, arena);
+}
+
+/*****************************************************
+ * DELETE BINARY TREE - ARENA
+ * Delete all the nodes below pThis including pThis.
+ * Rotating left children up lets us visit every node
+ * without recursion; the dead nodes are chained together
+ * and handed back to the arena in one go.
+ ****************************************************/
+template <class T>
+void clear(BNode <T> * & pThis, BNodeArena <T> & arena)
+{
+   typedef typename BNodeArena <T> :: Free Free;
+   Free * pFirst = nullptr;
+   Free * pLast = nullptr;
+   size_t num = 0;
+
+   BNode <T> * p = pThis;
+   while (p)
+   {
+      if (p->pLeft)
+      {
+         // rotate right so the left child is on top
+         BNode <T> * pLeft = p->pLeft;
+         p->pLeft = pLeft->pRight;
+         pLeft->pRight = p;
+         p = pLeft;
+      }
+      else
+      {
+         BNode <T> * pRight = p->pRight;
+         p->~BNode();
+         pFirst = new (static_cast<void *>(p)) Free{ pFirst };
+         if (!pLast)
+            pLast = pFirst;
+         num++;
+         p = pRight;
+      }
+   }
+
+   if (num)
+      arena.release(pFirst, pLast, num);
+   pThis = nullptr;
+}
+
+/**********************************************
+ * ASSIGN - ARENA
+ * Same as assign() but new nodes come from, and
+ * extra nodes go back to, an arena
+ *********************************************/
+template <class T>
+void assign(BNode <T> * & pDest, const BNode <T> * pSrc, BNodeArena <T> & arena)
+{
+   if (!pSrc)
+   {
+      clear(pDest, arena);
+      return;
+   }
+
+   if (!pDest)
+      pDest = arena.allocate(pSrc->data);
+
+   else
+      pDest->data = pSrc->data;
+
+   assign(pDest->pLeft, pSrc->pLeft, arena);
+   if (pDest->pLeft)
+      pDest->pLeft->pParent = pDest;
+
+   assign(pDest->pRight, pSrc->pRight, arena);
+   if (pDest->pRight)
+      pDest->pRight->pParent = pDest;
+}
+
+/*****************************************************
+ * FORK DEPTH
+ * How many levels down the parallel helpers keep
+ * splitting.  Each level doubles the number of tasks;
+ * two extra levels give the threads some slack when
+ * the tree is lopsided.  Zero means "run sequentially".
+ ****************************************************/
+inline int forkDepth(unsigned int numThreads)
+{
+   if (numThreads <= 1)
+      return 0;
+   int depth = 2;
+   for (unsigned int n = 1; n < numThreads; n *= 2)
+      depth++;
+   return depth;
+}
+
+/*******************************************************************
+ * SIZE BTREE - PARALLEL
+ * Count the left subtree on another thread while this one counts
+ * the right, until we are deep enough to just count
+ *******************************************************************/
+template <class T>
+size_t sizeFork(const BNode <T> * p, int depth)
+{
+   if (p == NULL)
+      return 0;
+   if (depth <= 0 || !p->pLeft || !p->pRight)
+      return size(p);
+
+   auto sizeL = std::async(std::launch::async, [=]() { return sizeFork(p->pLeft, depth - 1); });
+   size_t sizeR = sizeFork(p->pRight, depth - 1);
+   return sizeL.get() + 1 + sizeR;
+}
+
+template <class T>
+size_t sizeParallel(const BNode <T> * p, unsigned int numThreads = std::thread::hardware_concurrency())
+{
+   return sizeFork(p, forkDepth(numThreads));
+}
+
+/**********************************************
+ * COPY BINARY TREE - PARALLEL
+ * Copy the left subtree on another thread while
+ * this one copies the right
+ *********************************************/
+template <class T>
+BNode <T> * copyFork(const BNode <T> * pSrc, int depth)
+{
+   if (!pSrc)
+      return nullptr;
+   if (depth <= 0 || !pSrc->pLeft || !pSrc->pRight)
+      return copy(pSrc);
+
+   BNode<T> * pDest = new BNode<T>(pSrc->data);
+
+   auto left = std::async(std::launch::async, [=]() { return copyFork(pSrc->pLeft, depth - 1); });
+   try
+   {
+      pDest->pRight = copyFork(pSrc->pRight, depth - 1);
+   }
+   catch (...)
+   {
+      // wait for the other half so nothing leaks
+      try
+      {
+         BNode <T> * pLeft = left.get();
+         clear(pLeft);
+      }
+      catch (...) { }
+      delete pDest;
+      throw;
+   }
+
+   try
+   {
+      pDest->pLeft = left.get();
+   }
+   catch (...)
+   {
+      clear(pDest->pRight);
+      delete pDest;
+      throw;
+   }
+
+   pDest->pLeft->pParent = pDest;
+   pDest->pRight->pParent = pDest;
+   return pDest;
+}
+
+template <class T>
+BNode <T> * copyParallel(const BNode <T> * pSrc, unsigned int numThreads = std::thread::hardware_concurrency())
+{
+   return copyFork(pSrc, forkDepth(numThreads));
+}
+
+/*****************************************************
+ * DELETE BINARY TREE - PARALLEL
+ * Clear the left subtree on another thread while
+ * this one clears the right
+ ****************************************************/
+template <class T>
+void clearFork(BNode <T> * & pThis, int depth)
+{
+   if (!pThis)
+      return;
+   if (depth <= 0 || !pThis->pLeft || !pThis->pRight)
+   {
+      clear(pThis);
+      return;
+   }
+
+   BNode <T> * pLeft = pThis->pLeft;
+   auto left = std::async(std::launch::async, [&pLeft, depth]() { clearFork(pLeft, depth - 1); });
+   clearFork(pThis->pRight, depth - 1);
+   left.get();
+
+   delete pThis;
+   pThis = nullptr;
+}
+
+template <class T>
+void clearParallel(BNode <T> * & pThis, unsigned int numThreads = std::thread::hardware_concurrency())
+{
+   clearFork(pThis, forkDepth(numThreads));
+}
+
+/*****************************************************
+ * IN-ORDER TRAVERSAL - MORRIS
+ * Visit every node in order with no stack and no
+ * parent pointers.  Before going left, the rightmost
+ * node of the left subtree is pointed back at us so
+ * we can find our way up; the second time we arrive
+ * through that link it is removed again.  The tree is
+ * back the way it was when we return, even if visit
+ * throws, but visit must not change its shape.
+ *    INPUT  : the tree and what to do with each value
+ *    COST   : O(n) time, O(1) space
+ ****************************************************/
+template <class T, class Visit>
+void morrisInorder(BNode <T> * pRoot, Visit visit)
+{
+   std::exception_ptr error;
+   BNode <T> * p = pRoot;
+   while (p)
+   {
+      BNode <T> * pPred = p->pLeft;
+      if (pPred)
+      {
+         // the rightmost node on our left, unless it already leads back
+         while (pPred->pRight && pPred->pRight != p)
+            pPred = pPred->pRight;
+
+         // first time here: leave a way back, then go left
+         if (!pPred->pRight)
+         {
+            pPred->pRight = p;
+            p = p->pLeft;
+            continue;
+         }
+
+         // second time here: the left is done, so remove the way back
+         pPred->pRight = nullptr;
+      }
+
+      // keep walking after a throw so every link gets removed
+      if (!error)
+      {
+         try
+         {
+            visit(p->data);
+         }
+         catch (...)
+         {
+            error = std::current_exception();
+         }
+      }
+      p = p->pRight;
+   }
+
+   if (error)
+      std::rethrow_exception(error);
+}
+
+/*****************************************************
+ * PREORDER TRAVERSAL - MORRIS
+ * The same walk, but a node is visited the first
+ * time we reach it rather than the second
+ *    INPUT  : the tree and what to do with each value
+ *    COST   : O(n) time, O(1) space
+ ****************************************************/
+template <class T, class Visit>
+void morrisPreorder(BNode <T> * pRoot, Visit visit)
+{
+   std::exception_ptr error;
+   BNode <T> * p = pRoot;
+   while (p)
+   {
+      BNode <T> * pPred = p->pLeft;
+      if (pPred)
+         while (pPred->pRight && pPred->pRight != p)
+            pPred = pPred->pRight;
+
+      // the second time through we only clean up and move on
+      if (pPred && pPred->pRight == p)
+      {
+         pPred->pRight = nullptr;
+         p = p->pRight;
+         continue;
+      }
+
+      if (!error)
+      {
+         try
+         {
+            visit(p->data);
+         }
+         catch (...)
+         {
+            error = std::current_exception();
+         }
+      }
+
+      if (pPred)
+      {
+         pPred->pRight = p;
+         p = p->pLeft;
+      }
+      else
+         p = p->pRight;
+   }
+
+   if (error)
+      std::rethrow_exception(error);
+}
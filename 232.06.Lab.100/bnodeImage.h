@@ -0,0 +1,459 @@
+/***********************************************************************
+ * Header:
+ *    BINARY NODE IMAGE
+ * Summary:
+ *    A compact, position-independent image of a BNode tree: two bits of
+ *    shape per node in preorder followed by the node data packed into one
+ *    array. write() and read() stream an image to and from a file, and
+ *    BNodeView walks an image that is already in memory (for example a
+ *    memory-mapped file) without building any nodes.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    The image is laid out as:
+ *        header   : "BNT1", sizeof(T), number of nodes
+ *        shape    : bit 2i is "node i has a left child", bit 2i+1 "right"
+ *        summary  : for every 32 nodes (and every 32 of those, and so on)
+ *                   the lowest and the final running excess; this is what
+ *                   lets the view jump over a left subtree
+ *        payload  : the data of node i at index i
+ *    Every section starts on an 8-byte boundary.  Integers are stored in
+ *    the byte order of the machine that wrote them.
+ *
+ *    This will contain the class definition of:
+ *        BNodeView    : A read-only tree over an image in memory
+ *    Additionally, it will contain write() and read() for images
+ * Author
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include "bnode.h"      // for BNode and BNodeArena
+#include <cassert>
+#include <cstdint>      // for uint8_t, int32_t, uint64_t
+#include <cstring>      // for memcpy, memcmp
+#include <iostream>     // for std::istream and std::ostream
+#include <type_traits>  // for std::is_trivially_copyable
+#include <vector>       // for std::vector
+
+class TestBNode;     // forward declaration for unit tests
+
+/*****************************************************************
+ * BNODE IMAGE FORMAT
+ * Where everything lives in an image of a given number of nodes.
+ * The writer, the reader, and the view all agree through this.
+ *****************************************************************/
+struct BNodeImageFormat
+{
+   enum { BLOCK = 32, HEADER_SIZE = 16 };
+
+   // one entry in the summary: excess is the number of children still
+   // owed after a run of nodes, minus one for each node in the run
+   struct Summary
+   {
+      int32_t minExcess;  // lowest running excess at the end of any node in the run
+      int32_t excess;     // running excess at the end of the run
+   };
+
+   BNodeImageFormat(uint64_t num, size_t sizeData) : numNodes(num)
+   {
+      // summary levels shrink by BLOCK until there is a single entry
+      uint64_t count = (numNodes + BLOCK - 1) / BLOCK;
+      while (count > 0)
+      {
+         levelCounts.push_back((size_t)count);
+         if (count == 1)
+            break;
+         count = (count + BLOCK - 1) / BLOCK;
+      }
+
+      offsetShape = HEADER_SIZE;
+      offsetSummary = offsetShape + roundUp((numNodes * 2 + 7) / 8);
+      uint64_t offset = offsetSummary;
+      for (size_t num : levelCounts)
+      {
+         levelOffsets.push_back(offset);
+         offset += roundUp(num * sizeof(Summary));
+      }
+      offsetPayload = offset;
+      numBytes = offsetPayload + roundUp(numNodes * sizeData);
+   }
+
+   static uint64_t roundUp(uint64_t num) { return (num + 7) / 8 * 8; }
+
+   uint64_t numNodes;
+   uint64_t offsetShape;
+   uint64_t offsetSummary;
+   uint64_t offsetPayload;
+   uint64_t numBytes;
+   std::vector<size_t>   levelCounts;   // entries in each summary level
+   std::vector<uint64_t> levelOffsets;  // where each summary level starts
+};
+
+/*****************************************************************
+ * BNODE VIEW
+ * A tree that reads straight out of an image.  A node is named by
+ * its preorder index; NONE is the "null pointer".  Going left is
+ * O(1); going right skips the left subtree through the summary in
+ * O(log n).  Nothing is copied, so the image must outlive the view.
+ *****************************************************************/
+template <class T>
+class BNodeView
+{
+   friend class ::TestBNode; // give unit tests access to the privates
+public:
+   static const size_t NONE = (size_t)-1;
+
+   BNodeView(const void * pImage, size_t numBytes);
+
+   //
+   // Navigate
+   //
+   size_t root()  const { return numNodes ? 0 : NONE; }
+   size_t left(size_t i)  const { return hasLeft(i) ? i + 1 : NONE; }
+   size_t right(size_t i) const;
+   bool hasLeft(size_t i)  const { return bit(2 * i);     }
+   bool hasRight(size_t i) const { return bit(2 * i + 1); }
+
+   //
+   // Access
+   //
+   const T & data(size_t i) const
+   {
+      assert(i < numNodes);
+      return pPayload[i];
+   }
+
+   //
+   // Status
+   //
+   size_t size() const { return numNodes; }
+   size_t size(size_t i) const { return i == NONE ? 0 : subtreeEnd(i) - i; }
+
+private:
+   typedef BNodeImageFormat::Summary Summary;
+
+   bool bit(size_t i) const { return (pShape[i / 8] >> (i % 8)) & 1; }
+   int excess(size_t i) const { return (int)hasLeft(i) + (int)hasRight(i) - 1; }
+   size_t subtreeEnd(size_t i) const;
+
+   size_t numNodes;
+   const uint8_t * pShape;
+   std::vector<const Summary *> levels;  // the summary, lowest level first
+   std::vector<size_t> counts;           // entries in each level
+   const T * pPayload;
+};
+
+/*****************************************
+ * BNODE VIEW :: CONSTRUCTOR
+ * Check the header and find the sections
+ *    INPUT  : the image and how many bytes it has
+ ****************************************/
+template <class T>
+BNodeView <T> ::BNodeView(const void * pImage, size_t numBytes)
+{
+   static_assert(std::is_trivially_copyable<T>::value, "a view reads T straight out of the image");
+   static_assert(alignof(T) <= 8, "image sections are only 8-byte aligned");
+
+   const uint8_t * pBytes = static_cast<const uint8_t *>(pImage);
+   uint32_t sizeData;
+   uint64_t num;
+   if (numBytes < BNodeImageFormat::HEADER_SIZE || memcmp(pBytes, "BNT1", 4) != 0)
+      throw "ERROR: not a binary tree image";
+   memcpy(&sizeData, pBytes + 4, sizeof(sizeData));
+   memcpy(&num, pBytes + 8, sizeof(num));
+   if (sizeData != sizeof(T))
+      throw "ERROR: binary tree image holds a different type";
+
+   BNodeImageFormat format(num, sizeof(T));
+   if (format.numBytes > numBytes)
+      throw "ERROR: binary tree image is truncated";
+
+   numNodes = (size_t)num;
+   pShape = pBytes + format.offsetShape;
+   for (uint64_t offset : format.levelOffsets)
+      levels.push_back(reinterpret_cast<const Summary *>(pBytes + offset));
+   counts = format.levelCounts;
+   pPayload = reinterpret_cast<const T *>(pBytes + format.offsetPayload);
+}
+
+/*****************************************
+ * BNODE VIEW :: RIGHT
+ * The right child comes right after the left subtree
+ *    INPUT  : a node
+ *    OUTPUT : its right child, or NONE
+ *    COST   : O(log n)
+ ****************************************/
+template <class T>
+size_t BNodeView <T> ::right(size_t i) const
+{
+   if (!hasRight(i))
+      return NONE;
+   return hasLeft(i) ? subtreeEnd(i + 1) : i + 1;
+}
+
+/*****************************************
+ * BNODE VIEW :: SUBTREE END
+ * A subtree is finished as soon as the running excess
+ * from its root reaches -1.  Scan to the end of our
+ * block, climb the summary until some block reaches -1,
+ * then come back down into it.
+ *    INPUT  : the root of a subtree
+ *    OUTPUT : one past the last node of that subtree
+ *    COST   : O(log n)
+ ****************************************/
+template <class T>
+size_t BNodeView <T> ::subtreeEnd(size_t i) const
+{
+   const int BLOCK = BNodeImageFormat::BLOCK;
+   long running = 0;
+   size_t pos = i;
+
+   // finish the block we start in
+   do
+   {
+      running += excess(pos++);
+      if (running == -1)
+         return pos;
+   }
+   while (pos % BLOCK && pos < numNodes);
+   if (pos >= numNodes)
+      return numNodes;
+
+   // climb until a block dips low enough
+   size_t level = 0;
+   size_t index = pos / BLOCK;
+   while (true)
+   {
+      bool found = false;
+      while (index < counts[level])
+      {
+         if (running + levels[level][index].minExcess <= -1)
+         {
+            found = true;
+            break;
+         }
+         running += levels[level][index].excess;
+         index++;
+         if (index % BLOCK == 0)
+            break;
+      }
+      if (found)
+         break;
+      if (index >= counts[level] || level + 1 >= levels.size())
+         return numNodes;
+      level++;
+      index /= BLOCK;
+   }
+
+   // come back down into that block
+   while (level > 0)
+   {
+      level--;
+      index *= BLOCK;
+      while (running + levels[level][index].minExcess > -1)
+         running += levels[level][index++].excess;
+   }
+
+   // and find the node inside it
+   pos = index * BLOCK;
+   while (true)
+   {
+      running += excess(pos++);
+      if (running == -1)
+         return pos;
+   }
+}
+
+/*****************************************************
+ * WRITE BINARY TREE IMAGE
+ * Stream a tree out as an image.  The shape and the
+ * payload are each one preorder walk, so memory use is
+ * the summary plus one stack as deep as the tree.
+ *    INPUT  : where to write and the tree
+ ****************************************************/
+template <class T>
+void write(std::ostream & out, const BNode <T> * pRoot)
+{
+   static_assert(std::is_trivially_copyable<T>::value, "an image stores T as raw bytes");
+   typedef BNodeImageFormat::Summary Summary;
+   const int BLOCK = BNodeImageFormat::BLOCK;
+
+   BNodeImageFormat format(size(pRoot), sizeof(T));
+   const char zeros[8] = { 0 };
+
+   // header
+   uint32_t sizeData = sizeof(T);
+   out.write("BNT1", 4);
+   out.write(reinterpret_cast<const char *>(&sizeData), sizeof(sizeData));
+   out.write(reinterpret_cast<const char *>(&format.numNodes), sizeof(format.numNodes));
+
+   // shape, gathering the lowest level of the summary as we go
+   std::vector<std::vector<Summary>> levels(format.levelCounts.size());
+   uint8_t byte = 0;
+   uint64_t numBits = 0;
+   int32_t running = 0;
+   std::vector<const BNode <T> *> stack;
+   if (pRoot)
+      stack.push_back(pRoot);
+   for (uint64_t i = 0; !stack.empty(); i++)
+   {
+      const BNode <T> * p = stack.back();
+      stack.pop_back();
+      if (p->pRight)
+         stack.push_back(p->pRight);
+      if (p->pLeft)
+         stack.push_back(p->pLeft);
+
+      byte |= (p->pLeft  ? 1 : 0) << (numBits++ % 8);
+      byte |= (p->pRight ? 1 : 0) << (numBits++ % 8);
+      if (numBits % 8 == 0)
+      {
+         out.put((char)byte);
+         byte = 0;
+      }
+
+      if (i % BLOCK == 0)
+      {
+         levels[0].push_back(Summary{ 0, 0 });
+         running = 0;
+      }
+      running += (p->pLeft ? 1 : 0) + (p->pRight ? 1 : 0) - 1;
+      Summary & summary = levels[0].back();
+      summary.excess = running;
+      if (i % BLOCK == 0 || running < summary.minExcess)
+         summary.minExcess = running;
+   }
+   if (numBits % 8)
+      out.put((char)byte);
+   out.write(zeros, (std::streamsize)(format.offsetSummary - format.offsetShape - (numBits + 7) / 8));
+
+   // every higher level summarizes BLOCK entries of the one below
+   for (size_t level = 1; level < levels.size(); level++)
+      for (size_t i = 0; i < levels[level - 1].size(); i++)
+      {
+         const Summary & child = levels[level - 1][i];
+         if (i % BLOCK == 0)
+            levels[level].push_back(Summary{ child.minExcess, child.excess });
+         else
+         {
+            Summary & summary = levels[level].back();
+            if (summary.excess + child.minExcess < summary.minExcess)
+               summary.minExcess = summary.excess + child.minExcess;
+            summary.excess += child.excess;
+         }
+      }
+   for (auto & level : levels)
+   {
+      out.write(reinterpret_cast<const char *>(level.data()), (std::streamsize)(level.size() * sizeof(Summary)));
+      out.write(zeros, (std::streamsize)(BNodeImageFormat::roundUp(level.size() * sizeof(Summary)) - level.size() * sizeof(Summary)));
+   }
+
+   // payload
+   if (pRoot)
+      stack.push_back(pRoot);
+   while (!stack.empty())
+   {
+      const BNode <T> * p = stack.back();
+      stack.pop_back();
+      if (p->pRight)
+         stack.push_back(p->pRight);
+      if (p->pLeft)
+         stack.push_back(p->pLeft);
+      out.write(reinterpret_cast<const char *>(&p->data), sizeof(T));
+   }
+   out.write(zeros, (std::streamsize)(format.numBytes - format.offsetPayload - format.numNodes * sizeof(T)));
+}
+
+/*****************************************************
+ * READ BINARY TREE IMAGE
+ * Stream an image back into BNodes.  The shape is read
+ * first, then each payload element becomes the next
+ * node in preorder.
+ *    INPUT  : where to read from, and a function that
+ *             turns a T into a new node
+ *    OUTPUT : the root of the new tree
+ ****************************************************/
+template <class T, class Allocate>
+BNode <T> * readImage(std::istream & in, Allocate allocate)
+{
+   static_assert(std::is_trivially_copyable<T>::value, "an image stores T as raw bytes");
+
+   char header[BNodeImageFormat::HEADER_SIZE];
+   if (!in.read(header, sizeof(header)) || memcmp(header, "BNT1", 4) != 0)
+      throw "ERROR: not a binary tree image";
+   uint32_t sizeData;
+   uint64_t numNodes;
+   memcpy(&sizeData, header + 4, sizeof(sizeData));
+   memcpy(&numNodes, header + 8, sizeof(numNodes));
+   if (sizeData != sizeof(T))
+      throw "ERROR: binary tree image holds a different type";
+
+   BNodeImageFormat format(numNodes, sizeof(T));
+   std::vector<uint8_t> shape((size_t)(format.offsetSummary - format.offsetShape));
+   if (!in.read(reinterpret_cast<char *>(shape.data()), (std::streamsize)shape.size()) ||
+       !in.ignore((std::streamsize)(format.offsetPayload - format.offsetSummary)))
+      throw "ERROR: binary tree image is truncated";
+
+   // each entry on the stack is a node still waiting for its right child
+   BNode <T> * pRoot = nullptr;
+   BNode <T> * pParent = nullptr;
+   bool goLeft = true;
+   std::vector<BNode <T> *> stack;
+   for (uint64_t i = 0; i < numNodes; i++)
+   {
+      T t;
+      if (!in.read(reinterpret_cast<char *>(&t), sizeof(T)))
+      {
+         clear(pRoot);
+         throw "ERROR: binary tree image is truncated";
+      }
+      BNode <T> * p = allocate(t);
+
+      if (!pParent)
+         pRoot = p;
+      else if (goLeft)
+         addLeft(pParent, p);
+      else
+         addRight(pParent, p);
+
+      bool left  = (shape[(size_t)(2 * i) / 8]     >> ((2 * i) % 8))     & 1;
+      bool right = (shape[(size_t)(2 * i + 1) / 8] >> ((2 * i + 1) % 8)) & 1;
+      if (right)
+         stack.push_back(p);
+      if (left)
+      {
+         pParent = p;
+         goLeft = true;
+      }
+      else if (!stack.empty())
+      {
+         pParent = stack.back();
+         stack.pop_back();
+         goLeft = false;
+      }
+   }
+   in.ignore((std::streamsize)(format.numBytes - format.offsetPayload - numNodes * sizeof(T)));
+   return pRoot;
+}
+
+template <class T>
+BNode <T> * read(std::istream & in)
+{
+   return readImage<T>(in, [](const T & t) { return new BNode <T> (t); });
+}
+
+// into an arena, so the tree comes back contiguous in preorder
+template <class T>
+BNode <T> * read(std::istream & in, BNodeArena <T> & arena)
+{
+   return readImage<T>(in, [&arena](const T & t) { return arena.allocate(t); });
+}
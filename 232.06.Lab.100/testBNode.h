@@ -11,12 +11,15 @@
 
 #ifdef DEBUG
 #include "bnode.h"
+#include "bnodeImage.h"
 #include "unitTest.h"
 
 #include <cassert>
 #include <memory>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 
 
 class TestBNode : public UnitTest
@@ -71,6 +74,41 @@ public:
       test_size_one();
       test_size_standard();
 
+      // Arena
+      test_arena_copyStandard();
+      test_arena_clearAll();
+      test_arena_clearOneOfTwo();
+      test_arena_assignStandardToOne();
+      test_arena_clearDeep();
+
+      // Parallel
+      test_forkDepth_threads();
+      test_sizeParallel_empty();
+      test_sizeParallel_standard();
+      test_copyParallel_standard();
+      test_clearParallel_standard();
+      test_parallel_bigTree();
+
+      // Image
+      test_image_writeEmpty();
+      test_image_readStandard();
+      test_image_readArena();
+      test_image_viewStandard();
+      test_image_viewLongLeft();
+      test_image_bigTree();
+      test_image_notAnImage();
+      test_image_wrongType();
+      test_image_truncated();
+
+      // Morris traversal
+      test_morrisInorder_empty();
+      test_morrisInorder_standard();
+      test_morrisPreorder_standard();
+      test_morrisInorder_bigTree();
+      test_morrisPreorder_bigTree();
+      test_morrisInorder_throws();
+      test_morrisPreorder_throws();
+
       report("BNode");
    }
 
@@ -1211,6 +1249,680 @@ public:
 
 
 
+   /***************************************
+    * ARENA
+    ***************************************/
+
+   // copying into an arena lays the new tree out in preorder
+   void test_arena_copyStandard()
+   {  // setup
+      //                      (50) = pSrc
+      //            +----------+----------+
+      //           (38)                  (73)
+      //       +----+----+           +----+----+
+      //      (26)      (49)        (64)      (85)
+      BNode <int>* pSrc = setupStandardFixture();
+      BNodeArena <int> arena;
+      // exercise
+      BNode <int>* pDest = copy(pSrc, arena);
+      // verify
+      assertStandardFixture(pDest);
+      assertUnit(arena.size() == 7);
+      assertUnit(arena.chunks.size() == 1);
+      if (pDest && pDest->pLeft && pDest->pRight)
+      {
+         assertUnit(pDest->pLeft == pDest + 1);
+         assertUnit(pDest->pLeft->pLeft == pDest + 2);
+         assertUnit(pDest->pLeft->pRight == pDest + 3);
+         assertUnit(pDest->pRight == pDest + 4);
+         assertUnit(pDest->pRight->pLeft == pDest + 5);
+         assertUnit(pDest->pRight->pRight == pDest + 6);
+      }
+      // teardown
+      clear(pDest, arena);
+      teardownStandardFixture(pSrc);
+   }
+
+   // clearing the only tree in an arena gives back every chunk
+   void test_arena_clearAll()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      BNodeArena <int> arena;
+      BNode <int>* pDest = copy(pSrc, arena);
+      // exercise
+      clear(pDest, arena);
+      // verify
+      assertUnit(pDest == nullptr);
+      assertUnit(arena.size() == 0);
+      assertUnit(arena.chunks.empty());
+      assertUnit(arena.pFree == nullptr);
+      // teardown
+      teardownStandardFixture(pSrc);
+   }
+
+   // clearing one of two trees keeps the slots for reuse
+   void test_arena_clearOneOfTwo()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      BNodeArena <int> arena;
+      BNode <int>* pKeep = copy(pSrc, arena);
+      BNode <int>* pDrop = copy(pSrc, arena);
+      BNode <int>* pOldRoot = pDrop;
+      // exercise
+      clear(pDrop, arena);
+      BNode <int>* pNew = arena.allocate(99);
+      // verify
+      assertUnit(pDrop == nullptr);
+      assertUnit(arena.size() == 8);
+      assertUnit(pNew >= pOldRoot && pNew < pOldRoot + 7);
+      assertUnit(pNew->data == 99);
+      assertStandardFixture(pKeep);
+      // teardown
+      arena.release(pNew);
+      clear(pKeep, arena);
+      teardownStandardFixture(pSrc);
+   }
+
+   // assign through an arena reuses what is there
+   void test_arena_assignStandardToOne()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      BNodeArena <int> arena;
+      BNode <int>* pDest = arena.allocate(99);
+      BNode <int>* pOldRoot = pDest;
+      // exercise
+      assign(pDest, pSrc, arena);
+      // verify
+      assertUnit(pDest == pOldRoot);
+      assertStandardFixture(pDest);
+      assertUnit(arena.size() == 7);
+      // teardown
+      clear(pDest, arena);
+      teardownStandardFixture(pSrc);
+   }
+
+   // a tree far too deep to clear by recursion
+   void test_arena_clearDeep()
+   {  // setup
+      BNodeArena <int> arena;
+      BNode <int>* pRoot = arena.allocate(0);
+      BNode <int>* p = pRoot;
+      for (int i = 1; i < 200000; i++)
+      {
+         BNode <int>* pAdd = arena.allocate(i);
+         if (i % 2)
+            addLeft(p, pAdd);
+         else
+            addRight(p, pAdd);
+         p = pAdd;
+      }
+      // exercise
+      clear(pRoot, arena);
+      // verify
+      assertUnit(pRoot == nullptr);
+      assertUnit(arena.size() == 0);
+      assertUnit(arena.chunks.empty());
+   }  // teardown
+
+   /***************************************
+    * PARALLEL
+    ***************************************/
+
+   // one thread never forks
+   void test_forkDepth_threads()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(forkDepth(0) == 0);
+      assertUnit(forkDepth(1) == 0);
+      assertUnit(forkDepth(2) == 3);
+      assertUnit(forkDepth(4) == 4);
+      assertUnit(forkDepth(5) == 5);
+      assertUnit(forkDepth(32) == 7);
+   }  // teardown
+
+   // parallel size of nothing is zero
+   void test_sizeParallel_empty()
+   {  // setup
+      BNode <int>* pRoot = nullptr;
+      // exercise
+      size_t num = sizeParallel(pRoot, 4u);
+      // verify
+      assertUnit(num == 0);
+   }  // teardown
+
+   // parallel size of the standard fixture
+   void test_sizeParallel_standard()
+   {  // setup
+      BNode <int>* pRoot = setupStandardFixture();
+      // exercise
+      size_t num = sizeParallel(pRoot, 4u);
+      // verify
+      assertUnit(num == 7);
+      assertStandardFixture(pRoot);
+      // teardown
+      teardownStandardFixture(pRoot);
+   }
+
+   // parallel copy of the standard fixture
+   void test_copyParallel_standard()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      // exercise
+      BNode <int>* pDest = copyParallel(pSrc, 4u);
+      // verify
+      assertUnit(pDest != pSrc);
+      assertStandardFixture(pSrc);
+      assertStandardFixture(pDest);
+      // teardown
+      teardownStandardFixture(pSrc);
+      teardownStandardFixture(pDest);
+   }
+
+   // parallel clear of the standard fixture
+   void test_clearParallel_standard()
+   {  // setup
+      BNode <int>* pRoot = setupStandardFixture();
+      // exercise
+      clearParallel(pRoot, 4u);
+      // verify
+      assertUnit(pRoot == nullptr);
+   }  // teardown
+
+   // copy, count, and clear a big random tree with many threads
+   void test_parallel_bigTree()
+   {  // setup
+      BNode <int>* pSrc = nullptr;
+      unsigned int seed = 2021;
+      for (int i = 0; i < 20000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         insertRandom(pSrc, (int)(seed >> 8));
+      }
+      // exercise
+      BNode <int>* pDest = copyParallel(pSrc, 8u);
+      size_t numSrc = size(pSrc);
+      size_t numDest = sizeParallel(pDest, 8u);
+      // verify
+      assertUnit(numSrc == 20000);
+      assertUnit(numDest == numSrc);
+      assertUnit(sameTree(pSrc, pDest, nullptr));
+      // teardown
+      clearParallel(pDest, 8u);
+      assertUnit(pDest == nullptr);
+      clear(pSrc);
+   }
+
+   /***************************************
+    * IMAGE
+    ***************************************/
+
+   // an empty tree is just a header
+   void test_image_writeEmpty()
+   {  // setup
+      std::ostringstream out;
+      // exercise
+      write(out, (BNode <int> *)nullptr);
+      std::istringstream in(out.str());
+      BNode <int>* pDest = read<int>(in);
+      std::vector<uint64_t> image = imageOf((BNode <int> *)nullptr);
+      BNodeView <int> view(image.data(), image.size() * sizeof(uint64_t));
+      // verify
+      assertUnit(out.str().size() == 16);
+      assertUnit(pDest == nullptr);
+      assertUnit(view.size() == 0);
+      assertUnit(view.root() == BNodeView <int>::NONE);
+      assertUnit(view.size(view.root()) == 0);
+   }  // teardown
+
+   // write the standard fixture and read it back
+   void test_image_readStandard()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      std::stringstream stream;
+      // exercise
+      write(stream, pSrc);
+      BNode <int>* pDest = read<int>(stream);
+      // verify
+      assertUnit(stream.peek() == EOF);
+      assertStandardFixture(pSrc);
+      assertStandardFixture(pDest);
+      assertUnit(sameTree(pSrc, pDest, nullptr));
+      // teardown
+      teardownStandardFixture(pSrc);
+      teardownStandardFixture(pDest);
+   }
+
+   // reading into an arena lays the nodes out in preorder
+   void test_image_readArena()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      BNodeArena <int> arena;
+      std::stringstream stream;
+      write(stream, pSrc);
+      // exercise
+      BNode <int>* pDest = read<int>(stream, arena);
+      // verify
+      assertStandardFixture(pDest);
+      assertUnit(arena.size() == 7);
+      assertUnit(pDest->pLeft == pDest + 1);
+      assertUnit(pDest->pLeft->pLeft == pDest + 2);
+      assertUnit(pDest->pLeft->pRight == pDest + 3);
+      assertUnit(pDest->pRight == pDest + 4);
+      // teardown
+      teardownStandardFixture(pSrc);
+      clear(pDest, arena);
+      assertUnit(arena.size() == 0);
+   }
+
+   // walk the standard fixture without building it
+   //                   (50)
+   //         +----------+----------+
+   //        (38)                  (73)
+   //    +----+----+           +----+----+
+   //  (26)       (49)       (64)       (85)
+   void test_image_viewStandard()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      std::vector<uint64_t> image = imageOf(pSrc);
+      // exercise
+      BNodeView <int> view(image.data(), image.size() * sizeof(uint64_t));
+      // verify
+      const size_t NONE = BNodeView <int>::NONE;
+      assertUnit(view.size() == 7);
+      size_t i50 = view.root();
+      assertUnit(i50 == 0);
+      assertUnit(view.data(i50) == 50);
+      assertUnit(view.size(i50) == 7);
+      size_t i38 = view.left(i50);
+      size_t i73 = view.right(i50);
+      assertUnit(i38 == 1);
+      assertUnit(i73 == 4);
+      assertUnit(view.data(i38) == 38);
+      assertUnit(view.data(i73) == 73);
+      assertUnit(view.size(i38) == 3);
+      assertUnit(view.data(view.left(i38)) == 26);
+      assertUnit(view.data(view.right(i38)) == 49);
+      assertUnit(view.data(view.left(i73)) == 64);
+      assertUnit(view.data(view.right(i73)) == 85);
+      assertUnit(view.left(view.left(i38)) == NONE);
+      assertUnit(view.right(view.right(i73)) == NONE);
+      assertUnit(view.size(view.right(i73)) == 1);
+      // teardown
+      teardownStandardFixture(pSrc);
+   }
+
+   // the right child of the root sits past a long left subtree
+   void test_image_viewLongLeft()
+   {  // setup
+      BNode <int>* pSrc = new BNode <int>(0);
+      BNode <int>* p = pSrc;
+      for (int i = 1; i <= 50000; i++)
+      {
+         addLeft(p, new BNode <int>(i));
+         p = p->pLeft;
+      }
+      addRight(pSrc, new BNode <int>(-1));
+      std::vector<uint64_t> image = imageOf(pSrc);
+      // exercise
+      BNodeView <int> view(image.data(), image.size() * sizeof(uint64_t));
+      size_t iRight = view.right(view.root());
+      // verify
+      assertUnit(iRight == 50001);
+      assertUnit(view.data(iRight) == -1);
+      assertUnit(view.size(view.left(view.root())) == 50000);
+      assertUnit(view.right(12345) == BNodeView <int>::NONE);
+      // teardown
+      clear(pSrc);
+   }
+
+   // a big random tree survives both reading and viewing
+   void test_image_bigTree()
+   {  // setup
+      BNode <int>* pSrc = nullptr;
+      unsigned int seed = 232;
+      for (int i = 0; i < 20000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         insertRandom(pSrc, (int)(seed >> 8));
+      }
+      std::stringstream stream;
+      write(stream, pSrc);
+      std::string bytes = stream.str();
+      std::vector<uint64_t> image(bytes.size() / sizeof(uint64_t));
+      memcpy(image.data(), bytes.data(), bytes.size());
+      // exercise
+      BNode <int>* pDest = read<int>(stream);
+      BNodeView <int> view(image.data(), bytes.size());
+      // verify
+      assertUnit(bytes.size() % 8 == 0);
+      assertUnit(sameTree(pSrc, pDest, nullptr));
+      assertUnit(view.size() == 20000);
+      assertUnit(sameView(view, view.root(), pSrc));
+      // teardown
+      clear(pSrc);
+      clear(pDest);
+   }
+
+   // something that is not an image is turned away
+   void test_image_notAnImage()
+   {  // setup
+      std::istringstream in("this is not a tree at all");
+      const char * bytes = "BNT0 and then some more bytes";
+      BNode <int>* pDest = nullptr;
+      // exercise
+      try
+      {
+         pDest = read<int>(in);
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("ERROR: not a binary tree image"));
+      }
+      try
+      {
+         BNodeView <int> view(bytes, strlen(bytes));
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("ERROR: not a binary tree image"));
+      }
+      // verify
+      assertUnit(pDest == nullptr);
+   }  // teardown
+
+   // an image of ints is not an image of doubles
+   void test_image_wrongType()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      std::vector<uint64_t> image = imageOf(pSrc);
+      // exercise
+      try
+      {
+         BNodeView <double> view(image.data(), image.size() * sizeof(uint64_t));
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         // verify
+         assertUnit(std::string(error) == std::string("ERROR: binary tree image holds a different type"));
+      }
+      // teardown
+      teardownStandardFixture(pSrc);
+   }
+
+   // a short image throws and leaves nothing behind
+   void test_image_truncated()
+   {  // setup
+      BNode <int>* pSrc = setupStandardFixture();
+      std::ostringstream out;
+      write(out, pSrc);
+      std::string bytes = out.str();
+      std::istringstream in(bytes.substr(0, bytes.size() - 16));
+      std::vector<uint64_t> image = imageOf(pSrc);
+      // exercise
+      try
+      {
+         read<int>(in);
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         // verify
+         assertUnit(std::string(error) == std::string("ERROR: binary tree image is truncated"));
+      }
+      try
+      {
+         BNodeView <int> view(image.data(), image.size() * sizeof(uint64_t) - 8);
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("ERROR: binary tree image is truncated"));
+      }
+      // teardown
+      teardownStandardFixture(pSrc);
+   }
+
+   /***************************************
+    * MORRIS TRAVERSAL
+    ***************************************/
+
+   // nothing to visit
+   void test_morrisInorder_empty()
+   {  // setup
+      BNode <int>* pRoot = nullptr;
+      int numVisits = 0;
+      // exercise
+      morrisInorder(pRoot, [&numVisits](int) { numVisits++; });
+      morrisPreorder(pRoot, [&numVisits](int) { numVisits++; });
+      // verify
+      assertUnit(numVisits == 0);
+      assertUnit(pRoot == nullptr);
+   }  // teardown
+
+   // in order, and the tree is untouched afterwards
+   //                   (50)
+   //         +----------+----------+
+   //        (38)                  (73)
+   //    +----+----+           +----+----+
+   //  (26)       (49)       (64)       (85)
+   void test_morrisInorder_standard()
+   {  // setup
+      BNode <int>* pRoot = setupStandardFixture();
+      std::vector<int> values;
+      // exercise
+      morrisInorder(pRoot, [&values](int value) { values.push_back(value); });
+      // verify
+      assertUnit(values == std::vector<int>({ 26, 38, 49, 50, 64, 73, 85 }));
+      assertStandardFixture(pRoot);
+      // teardown
+      teardownStandardFixture(pRoot);
+   }
+
+   // preorder, and the tree is untouched afterwards
+   void test_morrisPreorder_standard()
+   {  // setup
+      BNode <int>* pRoot = setupStandardFixture();
+      std::vector<int> values;
+      // exercise
+      morrisPreorder(pRoot, [&values](int value) { values.push_back(value); });
+      // verify
+      assertUnit(values == std::vector<int>({ 50, 38, 26, 49, 73, 64, 85 }));
+      assertStandardFixture(pRoot);
+      // teardown
+      teardownStandardFixture(pRoot);
+   }
+
+   // same order as a recursive walk on a big tree
+   void test_morrisInorder_bigTree()
+   {  // setup
+      BNode <int>* pRoot = nullptr;
+      unsigned int seed = 35;
+      for (int i = 0; i < 20000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         insertRandom(pRoot, (int)(seed >> 8));
+      }
+      BNode <int>* pCopy = copy(pRoot);
+      std::vector<int> expected;
+      std::vector<int> values;
+      inorder(pRoot, expected);
+      // exercise
+      morrisInorder(pRoot, [&values](int value) { values.push_back(value); });
+      // verify
+      assertUnit(values.size() == 20000);
+      assertUnit(values == expected);
+      assertUnit(std::is_sorted(values.begin(), values.end()));
+      assertUnit(sameTree(pCopy, pRoot, nullptr));
+      // teardown
+      clear(pRoot);
+      clear(pCopy);
+   }
+
+   // same order as a recursive walk on a big tree
+   void test_morrisPreorder_bigTree()
+   {  // setup
+      BNode <int>* pRoot = nullptr;
+      unsigned int seed = 53;
+      for (int i = 0; i < 20000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         insertRandom(pRoot, (int)(seed >> 8));
+      }
+      BNode <int>* pCopy = copy(pRoot);
+      std::vector<int> expected;
+      std::vector<int> values;
+      preorder(pRoot, expected);
+      // exercise
+      morrisPreorder(pRoot, [&values](int value) { values.push_back(value); });
+      // verify
+      assertUnit(values.size() == 20000);
+      assertUnit(values == expected);
+      assertUnit(sameTree(pCopy, pRoot, nullptr));
+      // teardown
+      clear(pRoot);
+      clear(pCopy);
+   }
+
+   // a throw part way through still puts the tree back
+   void test_morrisInorder_throws()
+   {  // setup
+      BNode <int>* pRoot = setupStandardFixture();
+      std::vector<int> values;
+      // exercise
+      try
+      {
+         morrisInorder(pRoot, [&values](int value)
+         {
+            if (value == 38)
+               throw "stop";
+            values.push_back(value);
+         });
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("stop"));
+      }
+      // verify
+      assertUnit(values == std::vector<int>({ 26 }));
+      assertStandardFixture(pRoot);
+      // teardown
+      teardownStandardFixture(pRoot);
+   }
+
+   // a throw part way through still puts the tree back
+   void test_morrisPreorder_throws()
+   {  // setup
+      BNode <int>* pRoot = setupStandardFixture();
+      std::vector<int> values;
+      // exercise
+      try
+      {
+         morrisPreorder(pRoot, [&values](int value)
+         {
+            if (value == 26)
+               throw "stop";
+            values.push_back(value);
+         });
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("stop"));
+      }
+      // verify
+      assertUnit(values == std::vector<int>({ 50, 38 }));
+      assertStandardFixture(pRoot);
+      // teardown
+      teardownStandardFixture(pRoot);
+   }
+
+   /*************************************************************
+    * INORDER and PREORDER
+    * The plain recursive walks to check the others against
+    *************************************************************/
+   void inorder(const BNode <int>* p, std::vector<int> & values)
+   {
+      if (!p)
+         return;
+      inorder(p->pLeft, values);
+      values.push_back(p->data);
+      inorder(p->pRight, values);
+   }
+
+   void preorder(const BNode <int>* p, std::vector<int> & values)
+   {
+      if (!p)
+         return;
+      values.push_back(p->data);
+      preorder(p->pLeft, values);
+      preorder(p->pRight, values);
+   }
+
+   /*************************************************************
+    * IMAGE OF
+    * Write a tree into memory that is aligned like a mapped file
+    *************************************************************/
+   std::vector<uint64_t> imageOf(const BNode <int>* pRoot)
+   {
+      std::ostringstream out;
+      write(out, pRoot);
+      std::string bytes = out.str();
+      std::vector<uint64_t> image(bytes.size() / sizeof(uint64_t));
+      memcpy(image.data(), bytes.data(), bytes.size());
+      return image;
+   }
+
+   /*************************************************************
+    * SAME VIEW
+    * The view has the same shape and values as the tree
+    *************************************************************/
+   bool sameView(const BNodeView <int> & view, size_t i, const BNode <int>* p)
+   {
+      if (i == BNodeView <int>::NONE || !p)
+         return i == BNodeView <int>::NONE && !p;
+      return view.data(i) == p->data &&
+             view.size(i) == size(p) &&
+             sameView(view, view.left(i), p->pLeft) &&
+             sameView(view, view.right(i), p->pRight);
+   }
+
+   /*************************************************************
+    * INSERT RANDOM
+    * Put a value where a binary search tree would
+    *************************************************************/
+   void insertRandom(BNode <int>* & pRoot, int value)
+   {
+      BNode <int>** ppNode = &pRoot;
+      BNode <int>* pParent = nullptr;
+      while (*ppNode)
+      {
+         pParent = *ppNode;
+         ppNode = value < pParent->data ? &pParent->pLeft : &pParent->pRight;
+      }
+      *ppNode = new BNode <int>(value);
+      (*ppNode)->pParent = pParent;
+   }
+
+   /*************************************************************
+    * SAME TREE
+    * Same shape, same values, correct parents, different nodes
+    *************************************************************/
+   bool sameTree(const BNode <int>* pLHS, const BNode <int>* pRHS, const BNode <int>* pParent)
+   {
+      if (!pLHS || !pRHS)
+         return pLHS == pRHS;
+      return pLHS != pRHS &&
+             pLHS->data == pRHS->data &&
+             pRHS->pParent == pParent &&
+             sameTree(pLHS->pLeft, pRHS->pLeft, pRHS) &&
+             sameTree(pLHS->pRight, pRHS->pRight, pRHS);
+   }
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *                   (50)
@@ -13,6 +13,11 @@
  *    This will contain the class definition of:
  *        BST           : A class that represents a binary search tree
  *        BST::iterator : An iterator through BST
+ *        BSTNode       : A node of a BST, whatever its Compare
+ *        compare_holder: Keeps a comparator, in no room if it is empty
+ *        BThreads      : How an iterator steps, with or without threads
+ *        assume_sorted : Promise that a bulk load is already in order
+ *        unbalanced, red_black, avl, treap, splay : Balancing policies
  * Authors
  *    Hunter Powell
  *    Elijah Harrison
@@ -32,6 +37,11 @@
 #include <memory>     // for std::allocator
 #include <functional> // for std::less
 #include <utility>    // for std::pair
+#include <algorithm>  // for std::max
+#include <cstdint>    // for uint32_t
+#include <vector>     // for sorting an unsorted bulk load
+#include <cstddef>    // for std::ptrdiff_t
+#include <type_traits> // for std::enable_if
 
 class TestBST; // forward declaration for unit tests
 class TestMap;
@@ -40,38 +50,142 @@ class TestSet;
 namespace custom
 {
 
-template <class TT>
+template <class TT, class BB, class CC>
 class set;
-template <class KK, class VV>
+template <class KK, class VV, class BB, class CC>
 class map;
+struct red_black;
+
+/*****************************************************************
+ * THREADS
+ * How a BST steps from a node to its in-order neighbor.  An
+ * unthreaded tree walks: down and to the left of the right child,
+ * or up past every right child.  A threaded tree also keeps each
+ * node linked to its neighbors, so a step is always one pointer.
+ * Only insert and erase change the order, so only they (and whole
+ * tree copies) have to keep the links.  A split cuts the links at
+ * one place and a join ties them at one place.
+ *****************************************************************/
+template <class Node, bool threaded>
+struct BThreads
+{
+   static Node * next(Node * p);
+   static Node * prev(Node * p);
+   static void link(Node *)   { }
+   static void unlink(Node *) { }
+   static void relink(Node *) { }
+   static void tie(Node *, Node *) { }
+};
+
+template <class Node>
+struct BThreads <Node, true>
+{
+   BThreads() : pPrev(nullptr), pNext(nullptr) { }
+
+   static Node * next(Node * p) { return p->pNext; }
+   static Node * prev(Node * p) { return p->pPrev; }
+   static void link(Node * p);
+   static void unlink(Node * p);
+   static void relink(Node * pRoot);
+   static void tie(Node * pBefore, Node * pAfter)   // either may be null
+   {
+      if (pBefore)
+         pBefore->pNext = pAfter;
+      if (pAfter)
+         pAfter->pPrev = pBefore;
+   }
+
+   Node * pPrev;   // in-order predecessor
+   Node * pNext;   // in-order successor
+};
+
+/*****************************************************************
+ * ASSUME SORTED
+ * Pass this to a bulk load to promise the range is already in
+ * order, so it need not check.  Repeats are still allowed.
+ *****************************************************************/
+struct assume_sorted_t { };
+constexpr assume_sorted_t assume_sorted { };
+
+/*****************************************************************
+ * IS TRANSPARENT
+ * Whether a comparator can compare a T with something else, as
+ * std::less<> can.  Then find(key) builds no T to compare against.
+ *****************************************************************/
+template <class...>
+struct always_void { typedef void type; };
+
+template <class Compare, class = void>
+struct is_transparent : std::false_type { };
+
+template <class Compare>
+struct is_transparent <Compare,
+   typename always_void<typename Compare::is_transparent>::type> : std::true_type { };
+
+/*****************************************************************
+ * COMPARE HOLDER
+ * Where a container keeps its comparator.  An empty one, such as
+ * std::less, is a base class and so takes no room at all; one
+ * with state, or a function pointer, is a member.
+ *****************************************************************/
+template <class Compare,
+          bool = std::is_empty<Compare>::value && !std::is_final<Compare>::value>
+class compare_holder
+{
+public:
+   compare_holder(const Compare & comp = Compare()) : comp(comp) { }
+   const Compare & compare() const { return comp; }
+private:
+   Compare comp;
+};
+
+template <class Compare>
+class compare_holder <Compare, true> : private Compare
+{
+public:
+   compare_holder(const Compare & comp = Compare()) : Compare(comp) { }
+   const Compare & compare() const { return *this; }
+};
+
+template <typename T, class Balance, bool threaded>
+class BSTNode;
 
 /*****************************************************************
  * BINARY SEARCH TREE
  * Create a Binary Search Tree
  *****************************************************************/
-template <typename T>
-class BST
+template <typename T, class Balance = red_black, bool threaded = false,
+          class Compare = std::less<T> >
+class BST : private compare_holder<Compare>
 {
    friend class ::TestBST; // give unit tests access to the privates
    friend class ::TestMap;
    friend class ::TestSet;
 
-   template <class KK, class VV>
+   template <class KK, class VV, class BB, class CC>
    friend class map;
 
-   template <class TT>
+   template <class TT, class BB, class CC>
    friend class set;
 
-   template <class KK, class VV>
-   friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
+   template <class KK, class VV, class BB, class CC>
+   friend void swap(map<KK, VV, BB, CC>& lhs, map<KK, VV, BB, CC>& rhs);
+
+   friend struct unbalanced;  // balancing policies may rotate
+   friend struct red_black;
+   friend struct avl;
+   friend struct treap;
+   friend struct splay;
    
 private:
    //
    // Member Variables
    //
-   class BNode;
+   typedef BSTNode <T, Balance, threaded> BNode;   // the same for any Compare
+   typedef BThreads <BNode, threaded> Threads;
    BNode * root;       // root node of the binary search tree
    size_t numElements; // number of elements currently in the tree
+   BNode * pRecent;    // the most recent insert (or null): the next may go beside it
    
    //
    // Helper Methods
@@ -79,14 +193,44 @@ private:
    void deleteBinaryTree(BNode * & p);
    BNode * copyBinaryTree(const BNode * pSrc);
    void assignBinaryTree(BNode * & pDest, const BNode * pSrc);
+   template <class Iterator>
+   BNode * buildBinaryTree(Iterator & it, Iterator last, size_t num,
+                           bool keepUnique, int depth, int levels);
+   template <class Iterator>
+   void build(Iterator first, Iterator last, size_t num, bool keepUnique);
+   template <class Iterator>
+   bool countSorted(Iterator first, Iterator last, bool keepUnique, size_t & num) const;
+
+   //
+   // Split and Join: whole subtrees change hands, and only the
+   // spines where they meet are rebalanced
+   //
+   template <class Key>
+   void splitBinaryTree(BNode * p, const Key & k, BNode * & pLess, BNode * & pRest);
+   BNode * joinBinaryTree(BNode * pLeft, BNode * pMid, BNode * pRight);
+   void unhook(BNode * pDelete);
+
+   //
+   // Balancing: the policy reshapes the tree only through these
+   //
+   typedef typename Balance::Data BalanceData;
+   void rotateLeft (BNode * p);
+   void rotateRight(BNode * p);
+
+   //
+   // Order Statistics: every node knows how big its subtree is
+   //
+   static size_t sizeOf(const BNode * p) { return BNode::sizeOf(p); }
+   static void resize(BNode * p);
 
 public:
    //
    // Construct
    //
-   BST() : numElements(0), root(nullptr) { }
-   BST(const BST &  rhs) : BST() { *this = rhs; }
-   BST(      BST && rhs) : BST() { *this = std::move(rhs); }
+   explicit BST(const Compare & comp = Compare())
+      : compare_holder<Compare>(comp), numElements(0), root(nullptr), pRecent(nullptr) { }
+   BST(const BST &  rhs) : BST(rhs.key_comp()) { *this = rhs; }
+   BST(      BST && rhs) : BST(rhs.key_comp()) { *this = std::move(rhs); }
    BST(const std::initializer_list<T>& il) : BST() { *this = il; }
    ~BST() { clear(); }
 
@@ -100,8 +244,24 @@ public:
    {
       std::swap(root, rhs.root);
       std::swap(numElements, rhs.numElements);
+      std::swap(pRecent, rhs.pRecent);
+      std::swap(static_cast<compare_holder<Compare> &>(*this),
+                static_cast<compare_holder<Compare> &>(rhs));
    }
 
+   //
+   // Compare: the one comparator every element is ordered by
+   //
+   Compare key_comp() const { return this->compare(); }
+
+   //
+   // Bulk Load: replace the contents with a balanced tree
+   //
+   template <class Iterator>
+   void assign(Iterator first, Iterator last, bool keepUnique = false);
+   template <class Iterator>
+   void assign(assume_sorted_t, Iterator first, Iterator last, bool keepUnique = false);
+
    //
    // Iterator
    //
@@ -110,9 +270,47 @@ public:
    iterator end()   const noexcept { return iterator(nullptr); }
 
    //
-   // Access
+   // Access: each takes a T, or anything Compare is transparent to
+   //
+   template <class Key>
+   using Lookup = typename std::enable_if<std::is_same<Key, T>::value ||
+                                          is_transparent<Compare>::value>::type;
+
+   iterator find(const T & t) { return find<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator find(const Key & k);
+
+   iterator lower_bound(const T & t) const { return lower_bound<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator lower_bound(const Key & k) const;   // first not less than k
+
+   // the same, but searched for from hint, which must not be past
+   // the answer: O(log d) when the answer is d elements on
+   iterator lower_bound(iterator hint, const T & t) const { return lower_bound<T>(hint, t); }
+   template <class Key, class = Lookup<Key> >
+   iterator lower_bound(iterator hint, const Key & k) const;
+
+   iterator upper_bound(const T & t) const { return upper_bound<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator upper_bound(const Key & k) const;   // first greater than k
+
+   std::pair<iterator, iterator> equal_range(const T & t) const
+   {
+      return equal_range<T>(t);
+   }
+   template <class Key, class = Lookup<Key> >
+   std::pair<iterator, iterator> equal_range(const Key & k) const
+   {
+      return std::pair<iterator, iterator>(lower_bound<Key>(k), upper_bound<Key>(k));
+   }
+
+   //
+   // Order Statistics: O(log n) on a balanced tree
    //
-   iterator find(const T& t);
+   iterator nth(size_t k) const;       // the kth smallest, counting from 0
+   size_t rank(const T & t) const { return rank<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   size_t rank(const Key & k) const;   // how many are less than k
 
    //
    // Insert
@@ -120,6 +318,22 @@ public:
    std::pair<iterator, bool> insert(const T &  t, bool keepUnique = false);
    std::pair<iterator, bool> insert(      T && t, bool keepUnique = false);
 
+   // t goes right before hint if it belongs there, else right after
+   // the last insert if it belongs there, else wherever a search says
+   std::pair<iterator, bool> insert(iterator hint, const T & t, bool keepUnique = false)
+   {
+      return insertHinted(hint, t, keepUnique);
+   }
+   std::pair<iterator, bool> insert(iterator hint, T && t, bool keepUnique = false)
+   {
+      return insertHinted(hint, std::move(t), keepUnique);
+   }
+
+   // a sorted range at least as big as the tree is merged with it
+   // and bulk loaded; anything else goes in one at a time
+   template <class Iterator>
+   void insert(Iterator first, Iterator last, bool keepUnique = false);
+
    //
    // Remove
    //
@@ -127,11 +341,53 @@ public:
    void clear() noexcept;
    void deleteNode(BNode * & pDelete, bool toRight);
 
+   //
+   // Split and Join: O(log n) on a balanced tree however many
+   // elements change hands.  Compare must not throw.
+   //
+   BST split(const T & t) { return split<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   BST split(const Key & k);   // what is not less than k moves to the result
+   void join(BST & rhs, bool keepUnique = false); // all of rhs, which comes after all of this, moves here
+
    //
    // Status
    //
    bool empty()  const noexcept { return !numElements; }
    size_t size() const noexcept { return numElements; }
+
+private:
+   //
+   // Hinted Insert: place a node next to ones we already know
+   //
+   bool fitsBetween(const T & t, const BNode * pBefore, const BNode * pAfter) const
+   {
+      return (!pBefore || !less(t, pBefore->data)) && (!pAfter || less(t, pAfter->data));
+   }
+   template <class U>
+   std::pair<iterator, bool> insertHinted(iterator hint, U && t, bool keepUnique);
+   template <class U>
+   std::pair<iterator, bool> insertBetween(BNode * pBefore, BNode * pAfter, U && t, bool keepUnique);
+
+   //
+   // Compare: every ordering decision goes through these two
+   //
+   template <class A, class B>
+   bool less(const A & lhs, const B & rhs) const { return this->compare()(lhs, rhs); }
+   typedef std::is_same<Compare, std::less<T> > usesOperators;
+   template <class A, class B>
+   bool equivalent(const A & lhs, const B & rhs) const
+   {
+      return equivalent(lhs, rhs, usesOperators());
+   }
+   // std::less<T> means T's own operators, so == is one compare, not two
+   template <class A, class B>
+   bool equivalent(const A & lhs, const B & rhs, std::true_type) const { return lhs == rhs; }
+   template <class A, class B>
+   bool equivalent(const A & lhs, const B & rhs, std::false_type) const
+   {
+      return !less(lhs, rhs) & !less(rhs, lhs);   // both, so no branch between
+   }
 };
 
 
@@ -139,17 +395,22 @@ public:
  * BINARY NODE
  * A single node in a binary tree. Note that the node does not know
  * anything about the properties of the tree so no validation can be done.
+ * Nor does it know the comparator, so trees that differ only in that
+ * have the same nodes: BST <T, Balance, threaded, Compare> ::BNode.
  *****************************************************************/
-template <typename T>
-class BST <T> :: BNode
+template <typename T, class Balance, bool threaded>
+class BSTNode : public BThreads <BSTNode <T, Balance, threaded>, threaded>,
+                public Balance::Data
 {
+   typedef BSTNode BNode;
+
 public:
    // 
    // Construct
    //
-   BNode()            : data(T())     { pLeft = pRight = pParent = nullptr; }
-   BNode(const T & t) : data(t)       { pLeft = pRight = pParent = nullptr; }
-   BNode(T && t) : data(std::move(t)) { pLeft = pRight = pParent = nullptr; }
+   BSTNode()            : data(T()),          subtreeSize(1) { pLeft = pRight = pParent = nullptr; }
+   BSTNode(const T & t) : data(t),            subtreeSize(1) { pLeft = pRight = pParent = nullptr; }
+   BSTNode(T && t)      : data(std::move(t)), subtreeSize(1) { pLeft = pRight = pParent = nullptr; }
 
    //
    // Insert
@@ -166,6 +427,9 @@ public:
    //
    bool isRightChild(BNode * pNode) const { return this->pParent->pRight == this; }
    bool isLeftChild( BNode * pNode) const { return this->pParent->pLeft == this; }
+   size_t numBefore() const;   // nodes earlier in the whole tree
+   size_t numAfter()  const;   // nodes later in the whole tree
+   static size_t sizeOf(const BNode * p) { return p ? p->subtreeSize : 0; }
 
    //
    // Data
@@ -174,20 +438,20 @@ public:
    BNode* pLeft;   // Left child - smaller
    BNode* pRight;  // Right child - larger
    BNode* pParent; // Parent
-   bool isRed;     // Red-black balancing stuff
+   size_t subtreeSize; // Nodes in the subtree rooted here, counting this one
 };
 
 /**********************************************************
  * BINARY SEARCH TREE ITERATOR
  * Forward and reverse iterator through a BST
  *********************************************************/
-template <typename T>
-class BST <T> :: iterator
+template <typename T, class Balance, bool threaded, class Compare>
+class BST <T, Balance, threaded, Compare> :: iterator
 {
-   template <class KK, class VV>
+   template <class KK, class VV, class BB, class CC>
    friend class map;
 
-   template <class TT>
+   template <class TT, class BB, class CC>
    friend class set;
    
    friend class ::TestBST; // give unit tests access to the privates
@@ -195,7 +459,10 @@ class BST <T> :: iterator
    friend class ::TestSet;
    
    // must give friend status to remove so it can call getNode() from it
-   friend BST <T> :: iterator BST <T> :: erase(iterator & it);
+   friend BST <T, Balance, threaded, Compare> :: iterator BST <T, Balance, threaded, Compare> :: erase(iterator & it);
+
+   // and to the tree, so a hinted insert can see where the hint points
+   friend class BST <T, Balance, threaded, Compare>;
 
 private:
    // the node
@@ -242,6 +509,19 @@ public:
       --(*this);
       return tmp;
    }
+
+   // how many steps from first to last, found by counting subtrees
+   // on the way up rather than by stepping: O(log n)
+   friend std::ptrdiff_t distance(const iterator & first, const iterator & last)
+   {
+      if (first.pNode == last.pNode)
+         return 0;
+      if (!last.pNode)
+         return (std::ptrdiff_t)first.pNode->numAfter() + 1;
+      if (!first.pNode)
+         return -(std::ptrdiff_t)last.pNode->numAfter() - 1;
+      return (std::ptrdiff_t)last.pNode->numBefore() - (std::ptrdiff_t)first.pNode->numBefore();
+   }
 };
 
 
@@ -258,8 +538,8 @@ public:
  * Delete all the nodes below pThis including pThis
  * using postfix traverse: LRV
  ****************************************************/
-template <class T>
-void BST<T>::deleteBinaryTree(BST<T>::BNode * & p)
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::deleteBinaryTree(BST <T, Balance, threaded, Compare>::BNode * & p)
 {
    if (!p)
       return;
@@ -276,8 +556,8 @@ void BST<T>::deleteBinaryTree(BST<T>::BNode * & p)
  * Copy pSrc->pRight to pDest->pRight and
  * pSrc->pLeft onto pDest->pLeft
  *********************************************/
-template <class T>
-typename BST<T>::BNode * BST<T>::copyBinaryTree(const BST<T>::BNode * pSrc)
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::BNode * BST <T, Balance, threaded, Compare>::copyBinaryTree(const BST <T, Balance, threaded, Compare>::BNode * pSrc)
 {
    if (!pSrc)
       return nullptr;
@@ -317,8 +597,8 @@ typename BST<T>::BNode * BST<T>::copyBinaryTree(const BST<T>::BNode * pSrc)
  * copy the values from pSrc onto pDest preserving
  * as many of the nodes as possible.
  *********************************************/
-template <class T>
-void BST<T>::assignBinaryTree(BST<T>::BNode * & pDest, const BST<T>::BNode * pSrc)
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::assignBinaryTree(BST <T, Balance, threaded, Compare>::BNode * & pDest, const BST <T, Balance, threaded, Compare>::BNode * pSrc)
 {
    if (!pSrc)
    {
@@ -331,6 +611,8 @@ void BST<T>::assignBinaryTree(BST<T>::BNode * & pDest, const BST<T>::BNode * pSr
 
    else
       pDest->data = pSrc->data;
+   static_cast<BalanceData &>(*pDest) = *pSrc;
+   pDest->subtreeSize = pSrc->subtreeSize;
 
    assignBinaryTree(pDest->pLeft, pSrc->pLeft);
    if (pDest->pLeft)
@@ -349,10 +631,13 @@ void BST<T>::assignBinaryTree(BST<T>::BNode * & pDest, const BST<T>::BNode * pSr
  * BST :: ASSIGNMENT OPERATOR
  * Copy one tree to another
  ********************************************/
-template <typename T>
-BST<T> & BST<T>::operator = (const BST<T> & rhs)
+template <typename T, class Balance, bool threaded, class Compare>
+BST <T, Balance, threaded, Compare> & BST <T, Balance, threaded, Compare>::operator = (const BST <T, Balance, threaded, Compare> & rhs)
 {
+   compare_holder<Compare>::operator = (rhs);
    assignBinaryTree(root, rhs.root);
+   Threads::relink(root);
+   pRecent = nullptr;
 
    assert(this->root == nullptr || this->root->pParent == nullptr);
 
@@ -365,8 +650,8 @@ BST<T> & BST<T>::operator = (const BST<T> & rhs)
  * BST :: ASSIGN-MOVE OPERATOR
  * Move one tree to another
  ********************************************/
-template <typename T>
-BST<T> & BST<T>::operator = (BST<T> && rhs)
+template <typename T, class Balance, bool threaded, class Compare>
+BST <T, Balance, threaded, Compare> & BST <T, Balance, threaded, Compare>::operator = (BST <T, Balance, threaded, Compare> && rhs)
 {
    clear();
 
@@ -379,24 +664,204 @@ BST<T> & BST<T>::operator = (BST<T> && rhs)
  * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
  * Copy nodes onto a BTree
  ********************************************/
-template <typename T>
-BST<T> & BST<T>::operator = (const std::initializer_list<T>& il)
+template <typename T, class Balance, bool threaded, class Compare>
+BST <T, Balance, threaded, Compare> & BST <T, Balance, threaded, Compare>::operator = (const std::initializer_list<T>& il)
 {
+   // a sorted list is built straight into a balanced tree
+   size_t num;
+   if (countSorted(il.begin(), il.end(), false /* keep unique */, num))
+   {
+      build(il.begin(), il.end(), num, false /* keep unique */);
+      return *this;
+   }
+
    // since we never replace il with contents from BST
    clear();
 
+   // otherwise one at a time, so the shape follows the order given
    for (auto && it : il)
       insert(it);
 
    return *this;
 }
 
+/*********************************************
+ * BST :: ASSIGN
+ * Replace everything with the range [first, last).  One
+ * pass counts it and checks the order; a sorted range is
+ * then built straight into a balanced tree.  Anything else
+ * is copied out and sorted first, which is still cheaper
+ * than one insert at a time.  Equal items keep their order.
+ *    INPUT  : the range, and whether to drop repeats
+ *    COST   : O(n) when sorted, O(n log n) otherwise
+ ********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Iterator>
+void BST <T, Balance, threaded, Compare>::assign(Iterator first, Iterator last, bool keepUnique)
+{
+   size_t num;
+   if (countSorted(first, last, keepUnique, num))
+   {
+      build(first, last, num, keepUnique);
+      return;
+   }
+
+   std::vector<T> items;
+   for (Iterator it = first; it != last; ++it)
+      items.push_back(*it);
+   std::stable_sort(items.begin(), items.end(), key_comp());
+   if (keepUnique)
+      items.erase(std::unique(items.begin(), items.end(),
+                              [this](const T & lhs, const T & rhs) { return !less(lhs, rhs); }),
+                  items.end());
+   build(std::make_move_iterator(items.begin()),
+         std::make_move_iterator(items.end()), items.size(), false);
+}
+
+/*********************************************
+ * BST :: COUNT SORTED
+ * Count how many items of [first, last) a bulk load
+ * would keep, stopping at the first one out of order
+ *    OUTPUT : whether the range is sorted, and the count
+ *    COST   : O(n), and no more compares than it takes
+ *             to find the first item out of order
+ ********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Iterator>
+bool BST <T, Balance, threaded, Compare>::countSorted(Iterator first, Iterator last, bool keepUnique, size_t & num) const
+{
+   num = 0;
+   Iterator itPrev = first;
+   for (Iterator it = first; it != last; itPrev = it, ++it)
+   {
+      if (it != first && less(*it, *itPrev))
+         return false;
+      if (it == first || !keepUnique || less(*itPrev, *it))
+         num++;
+   }
+   return true;
+}
+
+/*********************************************
+ * BST :: ASSIGN, ASSUME SORTED
+ * The caller promises [first, last) is in order
+ *    COST   : O(n)
+ ********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Iterator>
+void BST <T, Balance, threaded, Compare>::assign(assume_sorted_t, Iterator first, Iterator last, bool keepUnique)
+{
+   size_t num = 0;
+   Iterator itPrev = first;
+   for (Iterator it = first; it != last; itPrev = it, ++it)
+      if (it == first || !keepUnique || less(*itPrev, *it))
+         num++;
+
+   build(first, last, num, keepUnique);
+}
+
+/*********************************************
+ * BST :: BUILD
+ * Make a balanced tree of num items from a sorted
+ * range and put it in place of the old one.  Every
+ * leaf is on one of the bottom two levels.
+ ********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Iterator>
+void BST <T, Balance, threaded, Compare>::build(Iterator first, Iterator last, size_t num, bool keepUnique)
+{
+   int levels = 0;
+   for (size_t n = num; n; n >>= 1)
+      levels++;
+
+   BNode * pNew;
+   try
+   {
+      pNew = buildBinaryTree(first, last, num, keepUnique, 0, levels);
+   }
+   catch (...)
+   {
+      throw "ERROR: Unable to allocate a node";
+   }
+
+   // the new tree is whole, so only now let go of the old one
+   clear();
+   root = pNew;
+   numElements = num;
+   Threads::relink(root);
+}
+
+/**********************************************
+ * BUILD BINARY TREE (recursive)
+ * Take num items off the front of it: the first
+ * half make the left subtree, the next one the
+ * node, the rest the right subtree.  Each node
+ * is handed to the balancing policy once both its
+ * subtrees are done.  A failure part way frees
+ * whatever was already made.
+ *    it     : advanced past everything used
+ *    depth  : how far down this node is
+ *    levels : how many levels the whole tree has
+ *********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Iterator>
+typename BST <T, Balance, threaded, Compare>::BNode * BST <T, Balance, threaded, Compare>::buildBinaryTree(
+   Iterator & it, Iterator last, size_t num, bool keepUnique, int depth, int levels)
+{
+   if (num == 0)
+      return nullptr;
+
+   BNode * pLeft = buildBinaryTree(it, last, num / 2, keepUnique, depth + 1, levels);
+   BNode * pNode;
+   try
+   {
+      pNode = new BNode(*it);
+   }
+   catch (...)
+   {
+      deleteBinaryTree(pLeft);
+      throw;
+   }
+   pNode->pLeft = pLeft;
+   if (pLeft)
+      pLeft->pParent = pNode;
+
+   // step past this item, and any repeats of it
+   ++it;
+   while (keepUnique && it != last && !less(pNode->data, *it))
+      ++it;
+
+   try
+   {
+      pNode->pRight = buildBinaryTree(it, last, num - num / 2 - 1, keepUnique, depth + 1, levels);
+   }
+   catch (...)
+   {
+      deleteBinaryTree(pNode);
+      throw;
+   }
+   if (pNode->pRight)
+      pNode->pRight->pParent = pNode;
+
+   pNode->subtreeSize = num;
+   Balance::built(pNode, depth, levels);
+   return pNode;
+}
+
 /*****************************************************
  * BST :: INSERT
- * Insert a node at a given location in the tree
+ * Insert a node at a given location in the tree.
+ * This always searches from the root and does not try
+ * beside the last insert first, as a hinted insert does.
+ * Sorted input already finds the search path in cache,
+ * while stepping from the last insert to its neighbor
+ * is a walk up the tree without threads, so that try
+ * made sorted inserts slower and every other insert
+ * pay two more compares.  Sorted input given as one
+ * range is bulk loaded instead.
  ****************************************************/
-template <typename T>
-std::pair<typename BST<T>::iterator, bool> BST<T>::insert(const T & t, bool keepUnique)
+template <typename T, class Balance, bool threaded, class Compare>
+std::pair<typename BST <T, Balance, threaded, Compare>::iterator, bool> BST <T, Balance, threaded, Compare>::insert(const T & t, bool keepUnique)
 {
    std::pair<iterator, bool> pairReturn(end(), false);
 
@@ -409,6 +874,9 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(const T & t, bool keep
          
          root = new BNode(t);
          numElements = 1;
+         pRecent = root;
+         Threads::link(root);
+         Balance::inserted(*this, root);
          
          pairReturn.first = iterator(root);  // where it needs to be pointing
          pairReturn.second = true;           // is ""?
@@ -422,15 +890,16 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(const T & t, bool keep
       while (!done)
       {
          // if the node is a match, then do nothing
-         if (keepUnique && t == pNode->data)
+         if (keepUnique && equivalent(t, pNode->data))
          {
+            Balance::found(*this, pNode);
             pairReturn.first = iterator(pNode);
             pairReturn.second = false;
             return pairReturn;
          }
 
          // if the center node is larger, go left
-         if (t < pNode->data)
+         if (less(t, pNode->data))
          {
             // if there is a node to the left, follow it
             if (pNode->pLeft)
@@ -440,8 +909,12 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(const T & t, bool keep
             else
             {
                pNode->addLeft(t);
+               Threads::link(pNode->pLeft);
+               resize(pNode);
+               pRecent = pNode->pLeft;
                done = true; // break
                pairReturn.first = iterator(pNode->pLeft);
+               Balance::inserted(*this, pNode->pLeft);
                pairReturn.second = true;
             }
          }
@@ -457,8 +930,12 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(const T & t, bool keep
             else
             {
                pNode->addRight(t);
+               Threads::link(pNode->pRight);
+               resize(pNode);
+               pRecent = pNode->pRight;
                done = true; // break
                pairReturn.first = iterator(pNode->pRight);
+               Balance::inserted(*this, pNode->pRight);
                pairReturn.second = true;
             }
          }
@@ -481,8 +958,8 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(const T & t, bool keep
    return pairReturn;
 }
 
-template <typename T>
-std::pair<typename BST<T>::iterator, bool> BST<T>::insert(T && t, bool keepUnique)
+template <typename T, class Balance, bool threaded, class Compare>
+std::pair<typename BST <T, Balance, threaded, Compare>::iterator, bool> BST <T, Balance, threaded, Compare>::insert(T && t, bool keepUnique)
 {
    std::pair<iterator, bool> pairReturn(end(), false);
 
@@ -495,6 +972,9 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(T && t, bool keepUniqu
          
          root = new BNode(std::move(t));
          numElements = 1;
+         pRecent = root;
+         Threads::link(root);
+         Balance::inserted(*this, root);
          
          pairReturn.first = iterator(root);  // where it needs to be pointing
          pairReturn.second = true;           // is ""?
@@ -508,15 +988,16 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(T && t, bool keepUniqu
       while (!done)
       {
          // if the node is a match, then do nothing
-         if (keepUnique && pNode->data == t)
+         if (keepUnique && equivalent(pNode->data, t))
          {
+            Balance::found(*this, pNode);
             pairReturn.first = iterator(pNode);
             pairReturn.second = false;
             return pairReturn;
          }
 
          // if the center node is larger, go left
-         if (t < pNode->data)
+         if (less(t, pNode->data))
          {
             // if there is a node to the left, follow it
             if (pNode->pLeft)
@@ -526,8 +1007,12 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(T && t, bool keepUniqu
             else
             {
                pNode->addLeft(std::move(t));
+               Threads::link(pNode->pLeft);
+               resize(pNode);
+               pRecent = pNode->pLeft;
                done = true; // break
                pairReturn.first = iterator(pNode->pLeft);
+               Balance::inserted(*this, pNode->pLeft);
                pairReturn.second = true;
             }
          }
@@ -543,8 +1028,12 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(T && t, bool keepUniqu
             else
             {
                pNode->addRight(std::move(t));
+               Threads::link(pNode->pRight);
+               resize(pNode);
+               pRecent = pNode->pRight;
                done = true; // break
                pairReturn.first = iterator(pNode->pRight);
+               Balance::inserted(*this, pNode->pRight);
                pairReturn.second = true;
             }
          }
@@ -567,32 +1056,206 @@ std::pair<typename BST<T>::iterator, bool> BST<T>::insert(T && t, bool keepUniqu
    return pairReturn;
 }
 
+/*****************************************************
+ * BST :: INSERT HINTED
+ * Try the two places a caller feeding sorted or nearly
+ * sorted data is likely to need: just before the hint,
+ * then just after the last insert (which is also how an
+ * end() hint finds the back of the tree).  Each costs
+ * two comparisons and one step to a neighbor, which is
+ * O(1) with threads and a short walk without.  Only if
+ * both miss do we search from the root.
+ *    INPUT  : where t probably goes, t, and whether to
+ *             refuse a copy of something already there
+ *    OUTPUT : where t is, and whether it was added
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class U>
+std::pair<typename BST <T, Balance, threaded, Compare>::iterator, bool>
+BST <T, Balance, threaded, Compare>::insertHinted(iterator hint, U && t, bool keepUnique)
+{
+   if (hint.pNode)
+   {
+      BNode * pBefore = Threads::prev(hint.pNode);
+      if (fitsBetween(t, pBefore, hint.pNode))
+         return insertBetween(pBefore, hint.pNode, std::forward<U>(t), keepUnique);
+   }
+
+   if (pRecent)
+   {
+      BNode * pAfter = Threads::next(pRecent);
+      if (fitsBetween(t, pRecent, pAfter))
+         return insertBetween(pRecent, pAfter, std::forward<U>(t), keepUnique);
+   }
+
+   return insert(std::forward<U>(t), keepUnique);
+}
+
+/*****************************************************
+ * BST :: INSERT BETWEEN
+ * Add t between two neighbors, either of which may be
+ * null at an end.  One of the two always has a free
+ * child on the side facing the other.
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class U>
+std::pair<typename BST <T, Balance, threaded, Compare>::iterator, bool>
+BST <T, Balance, threaded, Compare>::insertBetween(BNode * pBefore, BNode * pAfter, U && t, bool keepUnique)
+{
+   // t is not less than pBefore, so not greater means the same
+   if (keepUnique && pBefore && !less(pBefore->data, t))
+   {
+      Balance::found(*this, pBefore);
+      return std::pair<iterator, bool>(iterator(pBefore), false);
+   }
+
+   BNode * pNew;
+   try
+   {
+      pNew = new BNode(std::forward<U>(t));
+   }
+   catch (...)
+   {
+      throw "ERROR: Unable to allocate a node";
+   }
+
+   if (pBefore && !pBefore->pRight)
+      pBefore->addRight(pNew);
+   else
+   {
+      assert(pAfter && !pAfter->pLeft);
+      pAfter->addLeft(pNew);
+   }
+
+   Threads::link(pNew);
+   resize(pNew->pParent);
+   numElements++;
+   pRecent = pNew;
+   Balance::inserted(*this, pNew);
+
+   // if the root moved out from under us, find it again
+   while (root->pParent)
+      root = root->pParent;
+
+   return std::pair<iterator, bool>(iterator(pNew), true);
+}
+
+/*****************************************************
+ * BST :: INSERT RANGE
+ * Add everything in [first, last).  An empty tree just
+ * bulk loads it.  A sorted range at least as big as the
+ * tree is merged with the tree in order, and the merge is
+ * bulk loaded; on a tie what is already here goes first.
+ * Anything smaller goes in one at a time, which is quicker
+ * than copying the whole tree.
+ *    INPUT  : the range, and whether to drop repeats
+ *    COST   : O(n + m) when merged, else O(m log(n + m))
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Iterator>
+void BST <T, Balance, threaded, Compare>::insert(Iterator first, Iterator last, bool keepUnique)
+{
+   if (empty())
+   {
+      assign(first, last, keepUnique);
+      return;
+   }
+
+   size_t num;
+   if (!countSorted(first, last, keepUnique, num) || num < numElements)
+   {
+      for (; first != last; ++first)
+         insert(*first, keepUnique);
+      return;
+   }
+
+   // the tree and the range, stepped through together in order
+   struct Merged
+   {
+      Merged(const BST * pTree, iterator itTree, Iterator it, Iterator itEnd)
+         : pTree(pTree), itTree(itTree), it(it), itEnd(itEnd) { pick(); }
+      const T & operator * () const { return fromTree ? *itTree : *it; }
+      Merged & operator ++ ()
+      {
+         if (fromTree)
+            ++itTree;
+         else
+            ++it;
+         pick();
+         return *this;
+      }
+      bool operator == (const Merged & rhs) const { return itTree == rhs.itTree && it == rhs.it; }
+      bool operator != (const Merged & rhs) const { return !(*this == rhs); }
+   private:
+      void pick()
+      {
+         fromTree = itTree != pTree->end() && (it == itEnd || !pTree->less(*it, *itTree));
+      }
+      const BST * pTree;
+      iterator itTree;
+      Iterator it;
+      Iterator itEnd;
+      bool fromTree;
+   };
+
+   Merged itFirst(this, begin(), first, last);
+   Merged itLast(this, end(), last, last);
+   countSorted(itFirst, itLast, keepUnique, num);
+   build(itFirst, itLast, num, keepUnique);
+}
+
 /*************************************************
  * BST :: ERASE
  * Remove a given node as specified by the iterator
  ************************************************/
-template <typename T>
-typename BST<T>::iterator BST<T>::erase(iterator & it)
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::erase(iterator & it)
 {
    // do nothing if there is nothing to do
    if (it == end())
       return end();
 
-   // remember where we were
+   // remember where we were: nodes move, data does not, so this
+   // stays the successor
    iterator itNext(it);
+   ++itNext;
    BNode * pDelete = it.pNode;
+   unhook(pDelete);
+
+   if (pRecent == pDelete)
+      pRecent = nullptr;
+   Threads::unlink(pDelete);
+   delete pDelete;
+   return itNext;
+}
+
+/*************************************************
+ * BST :: UNHOOK
+ * Take a node out of the tree, and rebalance, but
+ * leave it in the threads and do not delete it
+ ************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::unhook(BNode * pDelete)
+{
+   Balance::erasing(*this, pDelete);
+
+   // the balance data that leaves the tree, and the node (possibly
+   // null) that moves up into its place
+   BalanceData removed = *pDelete;
+   BNode * pMoved;
+   BNode * pMovedParent = pDelete->pParent;
 
    // if there is only one child (right) or no children (how sad!)
    if (!pDelete->pLeft)
    {
-      ++itNext;
+      pMoved = pDelete->pRight;
       deleteNode(pDelete, true /* go right */);
    }
 
    // there is only one child (left)
    else if (!pDelete->pRight)
    {
-      ++itNext;
+      pMoved = pDelete->pLeft;
       deleteNode(pDelete, false /* go 'left' */);
    }
 
@@ -604,6 +1267,12 @@ typename BST<T>::iterator BST<T>::erase(iterator & it)
       while (pIOS->pLeft)
          pIOS = pIOS->pLeft;
 
+      // the IOS leaves its old spot and takes on pDelete's balance data
+      removed = *pIOS;
+      pMoved = pIOS->pRight;
+      pMovedParent = (pDelete->pRight == pIOS) ? pIOS : pIOS->pParent;
+      static_cast<BalanceData &>(*pIOS) = *pDelete;
+
       // the IOS must not have a right node. Now it will take pDelete's place.
       assert(pIOS->pLeft == nullptr);
       pIOS->pLeft = pDelete->pLeft;
@@ -634,69 +1303,337 @@ typename BST<T>::iterator BST<T>::erase(iterator & it)
       // what if that was the root?!?!
       if (root == pDelete)
          root = pIOS;
-
-      itNext = iterator(pIOS);
    }
 
+   resize(pMovedParent);
+   Balance::erased(*this, pMoved, pMovedParent, removed);
    numElements--;
-   delete pDelete;
-   return itNext;
 }
 
-/**********************************************
- * DELETE NODE
- * Delete a single node (pDelete) from the tree
- * indicated by a node (pDelete)
- *    pDelete  the node to be deleted
- *    toRight  should the right branch inherit our place?
- *********************************************/
-template <typename T>
-void BST<T>::deleteNode(BNode * & pDelete, bool toRight)
+/*****************************************************
+ * BST :: SPLIT
+ * Cut the tree in two at k: what is less than k stays
+ * and the rest is handed back.  No node is made,
+ * copied, or freed.
+ *    OUTPUT : a tree of everything not less than k
+ *    COST   : O(log n) on a balanced tree; O(log^2 n)
+ *             for red-black, which does not keep its
+ *             black height
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key, class>
+BST <T, Balance, threaded, Compare> BST <T, Balance, threaded, Compare>::split(const Key & k)
 {
-   // shift everything up
-   BNode * pNext = (toRight) ? pDelete->pRight : pDelete->pLeft;
+   BST rest(key_comp());
 
-   // if we are not the parent, hook ourselves into the existing tree
-   if (pDelete != root)
+   // the two that stop being neighbors, to cut the thread between
+   BNode * pAfter = nullptr;
+   BNode * pBefore = nullptr;
+   if (threaded)
    {
-      if (pDelete->pParent->pLeft == pDelete)
-      {
-         pDelete->pParent->pLeft = nullptr;
-         pDelete->pParent->addLeft(pNext);
-      }
-      else
-      {
-         pDelete->pParent->pRight = nullptr;
-         pDelete->pParent->addRight(pNext);
-      }
+      pAfter = lower_bound<Key>(k).pNode;
+      pBefore = pAfter ? Threads::prev(pAfter) : root;
+      while (!pAfter && pBefore && pBefore->pRight)
+         pBefore = pBefore->pRight;
    }
 
-   // otherwise
-   else
-   {
-      this->root = pNext;
-      pNext->pParent = nullptr;
-   }
+   BNode * pRoot = root;
+   root = nullptr;
+   BNode * pLess;
+   BNode * pRest;
+   splitBinaryTree(pRoot, k, pLess, pRest);
+
+   root = pLess;
+   numElements = sizeOf(pLess);
+   pRecent = nullptr;
+   rest.root = pRest;
+   rest.numElements = sizeOf(pRest);
+   Threads::tie(pBefore, nullptr);
+   Threads::tie(nullptr, pAfter);
+   return rest;
 }
 
 /*****************************************************
- * BST :: CLEAR
- * Removes all the BNodes from a tree
+ * BST :: JOIN
+ * Take every element of rhs, all of which must come
+ * after all of ours; keeping unique, none may equal
+ * our last either.  Our last node comes out and goes
+ * back in between the two trees.
+ *    COST   : O(log n) on a balanced tree
  ****************************************************/
-template <typename T>
-void BST<T>::clear() noexcept
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::join(BST & rhs, bool keepUnique)
 {
-   if (root)
-      deleteBinaryTree(root);
-   numElements = 0;
+   if (!rhs.root)
+      return;
+   if (!root)
+   {
+      std::swap(root, rhs.root);
+      std::swap(numElements, rhs.numElements);
+      pRecent = rhs.pRecent = nullptr;
+      return;
+   }
+
+   BNode * pLast = root;
+   while (pLast->pRight)
+      pLast = pLast->pRight;
+   BNode * pFirst = rhs.root;
+   while (pFirst->pLeft)
+      pFirst = pFirst->pLeft;
+   if (keepUnique ? !less(pLast->data, pFirst->data) : less(pFirst->data, pLast->data))
+      throw "ERROR: Unable to join trees whose elements overlap";
+
+   unhook(pLast);
+   BNode * pLeft = root;
+   root = nullptr;
+   root = joinBinaryTree(pLeft, pLast, rhs.root);
+   numElements = sizeOf(root);
+   pRecent = nullptr;
+   Threads::tie(pLast, pFirst);
+
+   rhs.root = nullptr;
+   rhs.numElements = 0;
+   rhs.pRecent = nullptr;
+}
+
+/*****************************************************
+ * SPLIT BINARY TREE
+ * Split the tree under p at k.  Walk down to where k
+ * would go, then back up: each node on the way joins
+ * the child it did not go to with what is already on
+ * its side.  No stack is needed, as each node's parent
+ * is the one above it, and which child it is says
+ * which way that one went.
+ *    pLess : the tree of everything less than k
+ *    pRest : the tree of everything else
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key>
+void BST <T, Balance, threaded, Compare>::splitBinaryTree(BNode * p, const Key & k, BNode * & pLess, BNode * & pRest)
+{
+   pLess = pRest = nullptr;
+
+   // down to where k would go
+   BNode * pNode = nullptr;
+   bool isLess = false;
+   for (BNode * pNext = p; pNext; pNext = isLess ? pNode->pRight : pNode->pLeft)
+   {
+      pNode = pNext;
+      isLess = less(pNode->data, k);
+   }
+
+   // back up, noting the way up before each join moves it
+   while (pNode)
+   {
+      BNode * pUp = (pNode == p) ? nullptr : pNode->pParent;
+      bool isUpLess = pUp && pUp->pRight == pNode;
+      BNode * pKept = isLess ? pNode->pLeft : pNode->pRight;
+      if (pKept)
+         pKept->pParent = nullptr;
+
+      if (isLess)
+         pLess = joinBinaryTree(pKept, pNode, pLess);
+      else
+         pRest = joinBinaryTree(pRest, pNode, pKept);
+
+      pNode = pUp;
+      isLess = isUpLess;
+   }
+}
+
+/*****************************************************
+ * JOIN BINARY TREE
+ * Make one tree of pLeft, then pMid, then pRight.
+ * Walk down the near spine of the taller tree to the
+ * first subtree that is not above the shorter tree in
+ * the policy's rank; pMid takes its place, with it
+ * and the shorter tree as children.  The policy then
+ * rebalances from pMid up, as after an insert.  The
+ * rotations need a tree, so this one, which must be
+ * empty, lends its root while the work is done.
+ *    OUTPUT : the root of the joined tree
+ *    COST   : O(difference in rank), plus the rank
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::BNode * BST <T, Balance, threaded, Compare>::joinBinaryTree(BNode * pLeft, BNode * pMid, BNode * pRight)
+{
+   assert(root == nullptr && pMid);
+   Balance::rooted(pLeft);
+   Balance::rooted(pRight);
+   int rankLeft = Balance::rank(pLeft);
+   int rankRight = Balance::rank(pRight);
+
+   bool leftTaller = rankLeft >= rankRight;
+   BNode * pTall = leftTaller ? pLeft : pRight;
+   BNode * pShort = leftTaller ? pRight : pLeft;
+   int rank = leftTaller ? rankLeft : rankRight;
+   int rankShort = leftTaller ? rankRight : rankLeft;
+
+   // down the right spine of the left tree, or the left of the right
+   BNode * pParent = nullptr;
+   BNode * p = pTall;
+   while (p && Balance::above(rank, rankShort))
+   {
+      pParent = p;
+      p = leftTaller ? p->pRight : p->pLeft;
+      rank = Balance::rankBelow(rank, p);
+   }
+
+   pMid->pLeft = leftTaller ? p : pShort;
+   pMid->pRight = leftTaller ? pShort : p;
+   if (pMid->pLeft)
+      pMid->pLeft->pParent = pMid;
+   if (pMid->pRight)
+      pMid->pRight->pParent = pMid;
+   pMid->pParent = pParent;
+   if (!pParent)
+      root = pMid;
+   else
+   {
+      root = pTall;
+      (leftTaller ? pParent->pRight : pParent->pLeft) = pMid;
+   }
+   resize(pMid);
+   Balance::joined(*this, pMid);
+
+   BNode * pJoined = root;
+   root = nullptr;
+   return pJoined;
+}
+
+/**********************************************
+ * DELETE NODE
+ * Delete a single node (pDelete) from the tree
+ * indicated by a node (pDelete)
+ *    pDelete  the node to be deleted
+ *    toRight  should the right branch inherit our place?
+ *********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::deleteNode(BNode * & pDelete, bool toRight)
+{
+   // shift everything up
+   BNode * pNext = (toRight) ? pDelete->pRight : pDelete->pLeft;
+
+   // if we are not the parent, hook ourselves into the existing tree
+   if (pDelete != root)
+   {
+      if (pDelete->pParent->pLeft == pDelete)
+      {
+         pDelete->pParent->pLeft = nullptr;
+         pDelete->pParent->addLeft(pNext);
+      }
+      else
+      {
+         pDelete->pParent->pRight = nullptr;
+         pDelete->pParent->addRight(pNext);
+      }
+   }
+
+   // otherwise
+   else
+   {
+      this->root = pNext;
+      if (pNext)
+         pNext->pParent = nullptr;
+   }
+}
+
+/**********************************************
+ * BST :: ROTATE LEFT
+ * The right child takes p's place and p becomes
+ * its left child.  The order does not change.
+ *          p                 r
+ *         / \               / \
+ *        a   r      =>     p   c
+ *           / \           / \
+ *          b   c         a   b
+ *********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::rotateLeft(BNode * p)
+{
+   BNode * pRight = p->pRight;
+   assert(pRight);
+
+   p->pRight = pRight->pLeft;
+   if (pRight->pLeft)
+      pRight->pLeft->pParent = p;
+
+   pRight->pParent = p->pParent;
+   if (!p->pParent)
+      root = pRight;
+   else if (p->pParent->pLeft == p)
+      p->pParent->pLeft = pRight;
+   else
+      p->pParent->pRight = pRight;
+
+   pRight->pLeft = p;
+   p->pParent = pRight;
+
+   pRight->subtreeSize = p->subtreeSize;
+   p->subtreeSize = 1 + sizeOf(p->pLeft) + sizeOf(p->pRight);
+}
+
+/**********************************************
+ * BST :: ROTATE RIGHT
+ * The mirror image of rotateLeft()
+ *********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::rotateRight(BNode * p)
+{
+   BNode * pLeft = p->pLeft;
+   assert(pLeft);
+
+   p->pLeft = pLeft->pRight;
+   if (pLeft->pRight)
+      pLeft->pRight->pParent = p;
+
+   pLeft->pParent = p->pParent;
+   if (!p->pParent)
+      root = pLeft;
+   else if (p->pParent->pRight == p)
+      p->pParent->pRight = pLeft;
+   else
+      p->pParent->pLeft = pLeft;
+
+   pLeft->pRight = p;
+   p->pParent = pLeft;
+
+   pLeft->subtreeSize = p->subtreeSize;
+   p->subtreeSize = 1 + sizeOf(p->pLeft) + sizeOf(p->pRight);
+}
+
+/**********************************************
+ * BST :: RESIZE
+ * Recount every subtree from p up to the root
+ * after a node came or went below p
+ *    COST   : O(depth of p)
+ *********************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::resize(BNode * p)
+{
+   for (; p; p = p->pParent)
+      p->subtreeSize = 1 + sizeOf(p->pLeft) + sizeOf(p->pRight);
+}
+
+/*****************************************************
+ * BST :: CLEAR
+ * Removes all the BNodes from a tree
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+void BST <T, Balance, threaded, Compare>::clear() noexcept
+{
+   if (root)
+      deleteBinaryTree(root);
+   numElements = 0;
+   pRecent = nullptr;
 }
 
 /*****************************************************
  * BST :: BEGIN
  * Return the first node (left-most) in a binary search tree
  ****************************************************/
-template <typename T>
-typename BST<T>::iterator BST<T>::begin() const noexcept
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::begin() const noexcept
 {
    if (!root || empty()) return end();
    
@@ -712,36 +1649,237 @@ typename BST<T>::iterator BST<T>::begin() const noexcept
  * BST :: FIND
  * Return the node corresponding to a given value
  ****************************************************/
-template <typename T>
-typename BST<T>::iterator BST<T>::find(const T & t)
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key, class>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::find(const Key & t)
 {
    auto p = root;
+   BNode * pVisited = nullptr;
+   
+   // T's own operators: == is one compare, so try it on the way down
+   if (usesOperators::value)
+      while (p)
+      {
+         if (equivalent(p->data, t))
+         {
+            Balance::found(*this, p);
+            return iterator(p);
+         }
+
+         pVisited = p;
+         if (less(t, p->data))
+            p = p->pLeft;
+         
+         else 
+            p = p->pRight;
+      }
+
+   // otherwise both compares, every time, so that the only branch
+   // is the one taken on a hit, and the step down needs no branch
+   else
+      while (p)
+      {
+         pVisited = p;
+         bool toLeft = less(t, p->data);
+         if (!toLeft & !less(p->data, t))
+         {
+            Balance::found(*this, p);
+            return iterator(p);
+         }
+         p = toLeft ? p->pLeft : p->pRight;
+      }
    
+   // a miss still counts as an access for some policies
+   if (pVisited)
+      Balance::found(*this, pVisited);
+   return end();
+}
+
+/****************************************************
+ * BST :: LOWER BOUND
+ * The first element not less than t.  Every time we
+ * go left the node is a candidate; going right never
+ * is.  The last candidate seen is the answer.
+ *    OUTPUT : the element, or end() if all are less
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key, class>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::lower_bound(const Key & t) const
+{
+   BNode * pBound = nullptr;
+   BNode * p = root;
    while (p)
    {
-      if (p->data == t) 
-         return iterator(p);
-      
-      else if (t < p->data) 
+      if (less(p->data, t))
+         p = p->pRight;
+      else
+      {
+         pBound = p;
          p = p->pLeft;
-      
-      else 
+      }
+   }
+   return iterator(pBound);
+}
+
+/*****************************************************
+ * BST :: LOWER BOUND, FROM A HINT
+ * A finger search: climb from the hint while the
+ * parent still comes before t.  Where that stops, the
+ * answer is in the right subtree or is the parent.
+ * The climb and the descent are no higher than the
+ * subtree spanning the hint and the answer.
+ *    OUTPUT : the element, or end() if all are less
+ *    COST   : O(log d), d the elements from the hint
+ *             to the answer, on a balanced tree
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key, class>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::lower_bound(iterator hint, const Key & t) const
+{
+   BNode * p = hint.pNode;
+   if (!p || !less(p->data, t))
+      return hint;
+
+   // p comes before t, and so does everything climbed past
+   while (p->pParent && less(p->pParent->data, t))
+      p = p->pParent;
+
+   BNode * pBound = p->pParent;
+   for (p = p->pRight; p; )
+   {
+      if (less(p->data, t))
          p = p->pRight;
+      else
+      {
+         pBound = p;
+         p = p->pLeft;
+      }
+   }
+   return iterator(pBound);
+}
+
+/****************************************************
+ * BST :: UPPER BOUND
+ * The first element greater than t
+ *    OUTPUT : the element, or end() if none are
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key, class>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::upper_bound(const Key & t) const
+{
+   BNode * pBound = nullptr;
+   BNode * p = root;
+   while (p)
+   {
+      if (less(t, p->data))
+      {
+         pBound = p;
+         p = p->pLeft;
+      }
+      else
+         p = p->pRight;
+   }
+   return iterator(pBound);
+}
+
+/****************************************************
+ * BST :: NTH
+ * The kth smallest element: skip whole left subtrees
+ * by their sizes instead of stepping through them
+ *    INPUT  : k, counting from 0
+ *    OUTPUT : the element, or end() if there are not
+ *             that many
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::iterator BST <T, Balance, threaded, Compare>::nth(size_t k) const
+{
+   BNode * p = root;
+   while (p)
+   {
+      size_t numLeft = sizeOf(p->pLeft);
+      if (k < numLeft)
+         p = p->pLeft;
+      else if (k == numLeft)
+         return iterator(p);
+      else
+      {
+         k -= numLeft + 1;
+         p = p->pRight;
+      }
    }
-   
    return end();
 }
 
+/****************************************************
+ * BST :: RANK
+ * How many elements are less than t, whether or not
+ * t is in the tree.  So nth(rank(t)) finds the first
+ * element not less than t.
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+template <class Key, class>
+size_t BST <T, Balance, threaded, Compare>::rank(const Key & t) const
+{
+   size_t num = 0;
+   BNode * p = root;
+   while (p)
+   {
+      if (less(p->data, t))
+      {
+         num += sizeOf(p->pLeft) + 1;
+         p = p->pRight;
+      }
+      else
+         p = p->pLeft;
+   }
+   return num;
+}
+
 /*****************************************************************
  **************************** B NODE *****************************
  *****************************************************************/
+
+/******************************************************
+ * BINARY NODE :: NUM BEFORE
+ * Everything in the left subtree comes first, and so
+ * does each ancestor we are right of, along with its
+ * left subtree
+ *    COST   : O(depth)
+ ******************************************************/
+template <typename T, class Balance, bool threaded>
+size_t BSTNode <T, Balance, threaded> :: numBefore() const
+{
+   size_t num = sizeOf(pLeft);
+   for (const BNode * p = this; p->pParent; p = p->pParent)
+      if (p->pParent->pRight == p)
+         num += 1 + sizeOf(p->pParent->pLeft);
+   return num;
+}
+
+/******************************************************
+ * BINARY NODE :: NUM AFTER
+ * The mirror image of numBefore()
+ ******************************************************/
+template <typename T, class Balance, bool threaded>
+size_t BSTNode <T, Balance, threaded> :: numAfter() const
+{
+   size_t num = sizeOf(pRight);
+   for (const BNode * p = this; p->pParent; p = p->pParent)
+      if (p->pParent->pLeft == p)
+         num += 1 + sizeOf(p->pParent->pRight);
+   return num;
+}
  
 /******************************************************
  * BINARY NODE :: ADD LEFT
  * Add a node to the left of the current node
  ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addLeft (BNode * pNode)
+template <typename T, class Balance, bool threaded>
+void BSTNode <T, Balance, threaded> :: addLeft (BNode * pNode)
 {
    if (pNode)
       pNode->pParent = this;
@@ -752,8 +1890,8 @@ void BST <T> :: BNode :: addLeft (BNode * pNode)
  * BINARY NODE :: ADD RIGHT
  * Add a node to the right of the current node
  ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addRight (BNode * pNode)
+template <typename T, class Balance, bool threaded>
+void BSTNode <T, Balance, threaded> :: addRight (BNode * pNode)
 {
    if (pNode)
       pNode->pParent = this;
@@ -764,8 +1902,8 @@ void BST <T> :: BNode :: addRight (BNode * pNode)
  * BINARY NODE :: ADD LEFT
  * Add a node to the left of the current node
  ******************************************************/
-template <typename T>
-void BST<T> :: BNode :: addLeft (const T & t)
+template <typename T, class Balance, bool threaded>
+void BSTNode <T, Balance, threaded> :: addLeft (const T & t)
 {
    assert(pLeft == nullptr);
 
@@ -784,8 +1922,8 @@ void BST<T> :: BNode :: addLeft (const T & t)
  * BINARY NODE :: ADD LEFT
  * Add a node to the left of the current node
  ******************************************************/
-template <typename T>
-void BST<T> ::BNode::addLeft(T && t)
+template <typename T, class Balance, bool threaded>
+void BSTNode <T, Balance, threaded> :: addLeft(T && t)
 {
    assert(pLeft == nullptr);
 
@@ -804,8 +1942,8 @@ void BST<T> ::BNode::addLeft(T && t)
  * BINARY NODE :: ADD RIGHT
  * Add a node to the right of the current node
  ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addRight (const T & t)
+template <typename T, class Balance, bool threaded>
+void BSTNode <T, Balance, threaded> :: addRight (const T & t)
 {
    assert(pRight == nullptr);
 
@@ -824,8 +1962,8 @@ void BST <T> :: BNode :: addRight (const T & t)
  * BINARY NODE :: ADD RIGHT
  * Add a node to the right of the current node
  ******************************************************/
-template <typename T>
-void BST <T> ::BNode::addRight(T && t)
+template <typename T, class Balance, bool threaded>
+void BSTNode <T, Balance, threaded> :: addRight(T && t)
 {
    assert(pRight == nullptr);
 
@@ -849,13 +1987,40 @@ void BST <T> ::BNode::addRight(T && t)
  * BST ITERATOR :: INCREMENT PREFIX
  * advance by one
  *************************************************/
-template <typename T>
-typename BST<T>::iterator & BST<T>::iterator::operator ++ ()
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::iterator & BST <T, Balance, threaded, Compare>::iterator::operator ++ ()
 {
    // do nothing if we have nothing
-   if (!pNode)
-      return *this;
+   if (pNode)
+      pNode = Threads::next(pNode);
+   return *this;
+}
+
+/**************************************************
+ * BST ITERATOR :: DECREMENT PREFIX
+ * advance by one
+ *************************************************/
+template <typename T, class Balance, bool threaded, class Compare>
+typename BST <T, Balance, threaded, Compare>::iterator & BST <T, Balance, threaded, Compare>::iterator::operator -- ()
+{
+   // do nothing if we have nothing
+   if (pNode)
+      pNode = Threads::prev(pNode);
+   return *this;
+}
 
+
+/*****************************************************************
+ **************************** THREADS ****************************
+ *****************************************************************/
+
+/**************************************************
+ * THREADS :: NEXT
+ * Walk to the in-order successor
+ *************************************************/
+template <class Node, bool threaded>
+Node * BThreads <Node, threaded> ::next(Node * pNode)
+{
    // if there is a right node, take it
    if (pNode->pRight)
    {
@@ -866,23 +2031,23 @@ typename BST<T>::iterator & BST<T>::iterator::operator ++ ()
       while (pNode->pLeft)
          pNode = pNode->pLeft;
 
-      return *this;
+      return pNode;
    }
 
    // There are no right children, the left are done
    assert (!pNode->pRight);
-   const BNode * pTmp = pNode;
+   const Node * pTmp = pNode;
 
    // go up
    pNode = pNode->pParent;
    
    // if the parent is nullptr, we are done.
    if (!pNode)
-      return *this;
+      return pNode;
 
    // if we are the left child, go to the parent.
    if (pNode->pLeft == pTmp)
-      return *this;
+      return pNode;
    
    // go up as long as we are the right child.
    while (pNode && pNode->pRight == pTmp)
@@ -891,20 +2056,16 @@ typename BST<T>::iterator & BST<T>::iterator::operator ++ ()
       pNode = pNode->pParent;
    }
 
-   return *this;
+   return pNode;
 }
 
 /**************************************************
- * BST ITERATOR :: DECREMENT PREFIX
- * advance by one
+ * THREADS :: PREV
+ * Walk to the in-order predecessor
  *************************************************/
-template <typename T>
-typename BST<T>::iterator & BST<T>::iterator::operator -- ()
+template <class Node, bool threaded>
+Node * BThreads <Node, threaded> ::prev(Node * pNode)
 {
-   // do nothing if we have nothing
-   if (!pNode)
-      return *this;
-
    // if there is a left node, take it
    if (pNode->pLeft)
    {
@@ -915,23 +2076,23 @@ typename BST<T>::iterator & BST<T>::iterator::operator -- ()
       while (pNode->pRight)
          pNode = pNode->pRight;
 
-      return *this;
+      return pNode;
    }
 
    // There are no left children, the right are done
    assert (!pNode->pLeft);
-   const BNode * pTmp = pNode;
+   const Node * pTmp = pNode;
 
    // go up
    pNode = pNode->pParent;
    
    // if the parent is nullptr, we are done.
    if (!pNode)
-      return *this;
+      return pNode;
 
    // if we are the right child, go to the parent.
    if (pNode->pRight == pTmp)
-      return *this;
+      return pNode;
    
    // go up as long as we are the left child.
    while (pNode && pNode->pLeft == pTmp)
@@ -940,7 +2101,563 @@ typename BST<T>::iterator & BST<T>::iterator::operator -- ()
       pNode = pNode->pParent;
    }
 
-   return *this;
+   return pNode;
+}
+
+/**************************************************
+ * THREADS :: LINK
+ * Thread a node that was just added as a leaf.  A left
+ * child comes right before its parent and a right child
+ * right after it.
+ *************************************************/
+template <class Node>
+void BThreads <Node, true> ::link(Node * p)
+{
+   Node * pParent = p->pParent;
+   if (!pParent)
+      p->pPrev = p->pNext = nullptr;
+   else if (pParent->pLeft == p)
+   {
+      p->pNext = pParent;
+      p->pPrev = pParent->pPrev;
+   }
+   else
+   {
+      p->pPrev = pParent;
+      p->pNext = pParent->pNext;
+   }
+
+   if (p->pPrev)
+      p->pPrev->pNext = p;
+   if (p->pNext)
+      p->pNext->pPrev = p;
+}
+
+/**************************************************
+ * THREADS :: UNLINK
+ * Take a node out of the thread before it is deleted
+ *************************************************/
+template <class Node>
+void BThreads <Node, true> ::unlink(Node * p)
+{
+   if (p->pPrev)
+      p->pPrev->pNext = p->pNext;
+   if (p->pNext)
+      p->pNext->pPrev = p->pPrev;
+   p->pPrev = p->pNext = nullptr;
+}
+
+/**************************************************
+ * THREADS :: RELINK
+ * Thread a whole tree by walking it once
+ *************************************************/
+template <class Node>
+void BThreads <Node, true> ::relink(Node * pRoot)
+{
+   Node * pPrev = nullptr;
+   Node * p = pRoot;
+   while (p && p->pLeft)
+      p = p->pLeft;
+
+   for (; p; p = BThreads <Node, false> ::next(p))
+   {
+      p->pPrev = pPrev;
+      if (pPrev)
+         pPrev->pNext = p;
+      pPrev = p;
+   }
+   if (pPrev)
+      pPrev->pNext = nullptr;
+}
+
+/*****************************************************************
+ *************************** BALANCING ***************************
+ *****************************************************************/
+
+/*****************************************************************
+ * UNBALANCED
+ * The plain binary search tree: nothing is done to keep it short.
+ * This is also the list of hooks every policy offers:
+ *    Data                     what the policy keeps in every node
+ *    inserted(tree, p)        p was just added as a leaf
+ *    found(tree, p)           a search ended at p
+ *    erasing(tree, p)         p is about to come out
+ *    erased(tree, p, pParent, removed)
+ *                             a node whose balance data was removed
+ *                             came out from above p (maybe null),
+ *                             whose parent is pParent (maybe null)
+ *    built(p, depth, levels)  a bulk load made p and both subtrees;
+ *                             the whole tree has that many levels
+ *    rooted(p)                p (maybe null) is now a tree of its own
+ *    rank(p)                  how tall the tree at p (maybe null) is,
+ *                             in whatever the policy balances by
+ *    rankBelow(rank, p)       the rank of p, whose parent has rank
+ *    above(rank, rankOther)   a subtree of rank is too tall to be a
+ *                             sibling of a tree of rankOther
+ *    joined(tree, p)          p was put between two trees: in place
+ *                             of the first subtree down the taller
+ *                             one's near spine that was not above
+ *                             the shorter, which is p's other child
+ * Policies reshape the tree only with tree.rotateLeft() and
+ * tree.rotateRight(), so the order, and any threads, never change.
+ *****************************************************************/
+struct unbalanced
+{
+   struct Data { };
+
+   template <class Tree, class Node>
+   static void inserted(Tree &, Node *) { }
+   template <class Tree, class Node>
+   static void found(Tree &, Node *) { }
+   template <class Tree, class Node>
+   static void erasing(Tree &, Node *) { }
+   template <class Tree, class Node, class Removed>
+   static void erased(Tree &, Node *, Node *, const Removed &) { }
+   template <class Node>
+   static void built(Node *, int, int) { }
+
+   // no rank: a join puts the middle node on top
+   template <class Node>
+   static void rooted(Node *) { }
+   template <class Node>
+   static int rank(const Node *) { return 0; }
+   template <class Node>
+   static int rankBelow(int, const Node *) { return 0; }
+   static bool above(int rank, int rankOther) { return rank > rankOther; }
+   template <class Tree, class Node>
+   static void joined(Tree &, Node *) { }
+
+protected:
+   // make p take its parent's place
+   template <class Tree, class Node>
+   static void rotateUp(Tree & tree, Node * p)
+   {
+      if (p->pParent->pLeft == p)
+         tree.rotateRight(p->pParent);
+      else
+         tree.rotateLeft(p->pParent);
+   }
+};
+
+/*****************************************************************
+ * RED BLACK
+ * Every node is red or black, a red node has no red child, and
+ * every path down holds the same number of black nodes.  The
+ * longest path is then at most twice the shortest.
+ *****************************************************************/
+struct red_black : unbalanced
+{
+   struct Data
+   {
+      Data() : isRed(true) { }
+      bool isRed;     // Red-black balancing stuff: new nodes start red
+   };
+
+   template <class Tree, class Node>
+   static void inserted(Tree & tree, Node * p);
+   template <class Tree, class Node>
+   static void erased(Tree & tree, Node * p, Node * pParent, const Data & removed)
+   {
+      // taking a black node out leaves one path short
+      if (!removed.isRed)
+         balanceErase(tree, p, pParent);
+   }
+
+   // every leaf of a bulk load is on the bottom two levels, so
+   // making just the bottom level red evens out the black counts
+   template <class Node>
+   static void built(Node * p, int depth, int levels)
+   {
+      p->isRed = depth > 0 && depth == levels - 1;
+   }
+
+   // a root may always be black, and joins are simpler when it is
+   template <class Node>
+   static void rooted(Node * p)
+   {
+      if (p)
+         p->isRed = false;
+   }
+
+   // twice the black height, plus one for red, so that a red node
+   // is above the black nodes with its black height
+   template <class Node>
+   static int rank(const Node * p)
+   {
+      int blackHeight = 0;
+      for (const Node * pDown = p; pDown; pDown = pDown->pLeft)
+         blackHeight += pDown->isRed ? 0 : 1;
+      return 2 * blackHeight + (isRed(p) ? 1 : 0);
+   }
+   template <class Node>
+   static int rankBelow(int rank, const Node * p)
+   {
+      int blackHeight = (rank % 2) ? rank / 2 : rank / 2 - 1;
+      return 2 * blackHeight + (isRed(p) ? 1 : 0);
+   }
+
+   // the middle node comes in red over two black subtrees of one
+   // black height, so the only thing wrong is what an insert fixes
+   template <class Tree, class Node>
+   static void joined(Tree & tree, Node * p)
+   {
+      p->isRed = true;
+      inserted(tree, p);
+   }
+
+private:
+   template <class Node>
+   static bool isRed(const Node * p) { return p && p->isRed; }
+   template <class Tree, class Node>
+   static void balanceErase(Tree & tree, Node * p, Node * pParent);
+};
+
+/*****************************************************************
+ * AVL
+ * The two subtrees of every node differ in height by at most one.
+ * Shorter than red-black for the same keys, at the price of more
+ * rotations on insert and erase: good for read-heavy trees.
+ *****************************************************************/
+struct avl : unbalanced
+{
+   struct Data
+   {
+      Data() : height(1) { }
+      signed char height;  // nodes on the longest path down; 1 for a leaf
+   };
+
+   template <class Tree, class Node>
+   static void inserted(Tree & tree, Node * p) { retrace(tree, p->pParent); }
+   template <class Tree, class Node>
+   static void erased(Tree & tree, Node *, Node * pParent, const Data &)
+   {
+      retrace(tree, pParent);
+   }
+   template <class Node>
+   static void built(Node * p, int, int) { update(p); }
+
+   // siblings may differ in height by one, so the middle node is at
+   // most one taller than its taller child; retracing fixes the rest
+   template <class Node>
+   static int rank(const Node * p) { return height(p); }
+   template <class Node>
+   static int rankBelow(int, const Node * p) { return height(p); }
+   static bool above(int rank, int rankOther) { return rank > rankOther + 1; }
+   template <class Tree, class Node>
+   static void joined(Tree & tree, Node * p) { retrace(tree, p); }
+
+private:
+   template <class Node>
+   static int height(const Node * p) { return p ? p->height : 0; }
+   template <class Node>
+   static void update(Node * p)
+   {
+      p->height = (signed char)(1 + std::max(height(p->pLeft), height(p->pRight)));
+   }
+   template <class Tree, class Node>
+   static void retrace(Tree & tree, Node * p);
+};
+
+/*****************************************************************
+ * TREAP
+ * Every node gets a random priority and the tree is kept a heap on
+ * it, so the shape is that of a tree built in random order no
+ * matter what order the keys arrive in.  Few rotations, and cheap
+ * to split and join.
+ *****************************************************************/
+struct treap : unbalanced
+{
+   struct Data
+   {
+      Data() : priority(random()) { }
+      uint32_t priority;   // never less than the children's
+   };
+
+   // a new leaf rises until its parent outranks it
+   template <class Tree, class Node>
+   static void inserted(Tree & tree, Node * p)
+   {
+      while (p->pParent && p->pParent->priority < p->priority)
+         rotateUp(tree, p);
+   }
+
+   // sink until there is at most one child, so no successor has to move
+   template <class Tree, class Node>
+   static void erasing(Tree & tree, Node * p)
+   {
+      while (p->pLeft && p->pRight)
+         rotateUp(tree, p->pLeft->priority > p->pRight->priority ? p->pLeft : p->pRight);
+   }
+
+   // a bulk load fixes the shape, so raise each priority to
+   // outrank the children instead
+   template <class Node>
+   static void built(Node * p, int, int)
+   {
+      if (p->pLeft)
+         p->priority = std::max(p->priority, p->pLeft->priority);
+      if (p->pRight)
+         p->priority = std::max(p->priority, p->pRight->priority);
+   }
+
+   // the middle node starts on top and sinks below whichever child
+   // outranks it, down the two spines that meet
+   template <class Tree, class Node>
+   static void joined(Tree & tree, Node * p)
+   {
+      while (true)
+      {
+         Node * pHigher = p->pLeft;
+         if (!pHigher || (p->pRight && p->pRight->priority > pHigher->priority))
+            pHigher = p->pRight;
+         if (!pHigher || pHigher->priority <= p->priority)
+            break;
+         rotateUp(tree, pHigher);
+      }
+   }
+
+private:
+   static uint32_t random()
+   {
+      static thread_local uint32_t seed = 2463534242u;
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      return seed;
+   }
+};
+
+/*****************************************************************
+ * SPLAY
+ * Whatever was touched last is rotated to the root, so a small set
+ * of hot keys stays near the top.  O(log n) amortized, with no
+ * extra data in the nodes.  Note that find() reshapes the tree.
+ *****************************************************************/
+struct splay : unbalanced
+{
+   template <class Tree, class Node>
+   static void inserted(Tree & tree, Node * p) { splayUp(tree, p); }
+   template <class Tree, class Node>
+   static void found(Tree & tree, Node * p) { splayUp(tree, p); }
+   template <class Tree, class Node>
+   static void erased(Tree & tree, Node *, Node * pParent, const Data &)
+   {
+      if (pParent)
+         splayUp(tree, pParent);
+   }
+
+private:
+   template <class Tree, class Node>
+   static void splayUp(Tree & tree, Node * p);
+};
+
+/**********************************************
+ * RED BLACK :: INSERTED
+ * A new red node may sit under a red parent.
+ *    Red aunt:     recolor and look again at granny
+ *    Inside child: rotate it to the outside
+ *    Outside:      rotate granny down to our side
+ * At most two rotations; the root ends up black.
+ *********************************************/
+template <class Tree, class Node>
+void red_black::inserted(Tree & tree, Node * p)
+{
+   while (isRed(p->pParent) && p->pParent->pParent)
+   {
+      Node * pParent = p->pParent;
+      Node * pGranny = pParent->pParent;
+      bool parentIsLeft = (pGranny->pLeft == pParent);
+      Node * pAunt = parentIsLeft ? pGranny->pRight : pGranny->pLeft;
+
+      // red aunt: push granny's black down a level
+      if (isRed(pAunt))
+      {
+         pParent->isRed = false;
+         pAunt->isRed = false;
+         pGranny->isRed = true;
+         p = pGranny;
+         continue;
+      }
+
+      // inside child: make it an outside child
+      if (parentIsLeft && pParent->pRight == p)
+      {
+         tree.rotateLeft(pParent);
+         pParent = p;
+      }
+      else if (!parentIsLeft && pParent->pLeft == p)
+      {
+         tree.rotateRight(pParent);
+         pParent = p;
+      }
+
+      // outside child: the parent takes granny's place
+      pParent->isRed = false;
+      pGranny->isRed = true;
+      if (parentIsLeft)
+         tree.rotateRight(pGranny);
+      else
+         tree.rotateLeft(pGranny);
+      break;
+   }
+
+   tree.root->isRed = false;
+}
+
+/**********************************************
+ * RED BLACK :: BALANCE ERASE
+ * A black node came out from above p (which may be
+ * null), so every path through p is one black short.
+ *    Red sibling:              rotate so the sibling is black
+ *    Black nephews:            paint the sibling red and move up
+ *    Red far nephew (maybe after rotating the near one out):
+ *                              rotate the parent down to our side
+ *    p:       the node that moved up, or null
+ *    pParent: its parent
+ *********************************************/
+template <class Tree, class Node>
+void red_black::balanceErase(Tree & tree, Node * p, Node * pParent)
+{
+   while (p != tree.root && !isRed(p))
+   {
+      if (pParent->pLeft == p)
+      {
+         Node * pSibling = pParent->pRight;
+         if (isRed(pSibling))
+         {
+            pSibling->isRed = false;
+            pParent->isRed = true;
+            tree.rotateLeft(pParent);
+            pSibling = pParent->pRight;
+         }
+
+         if (!isRed(pSibling->pLeft) && !isRed(pSibling->pRight))
+         {
+            pSibling->isRed = true;
+            p = pParent;
+            pParent = p->pParent;
+            continue;
+         }
+
+         if (!isRed(pSibling->pRight))
+         {
+            pSibling->pLeft->isRed = false;
+            pSibling->isRed = true;
+            tree.rotateRight(pSibling);
+            pSibling = pParent->pRight;
+         }
+
+         pSibling->isRed = pParent->isRed;
+         pParent->isRed = false;
+         pSibling->pRight->isRed = false;
+         tree.rotateLeft(pParent);
+         p = tree.root;
+      }
+      else
+      {
+         Node * pSibling = pParent->pLeft;
+         if (isRed(pSibling))
+         {
+            pSibling->isRed = false;
+            pParent->isRed = true;
+            tree.rotateRight(pParent);
+            pSibling = pParent->pLeft;
+         }
+
+         if (!isRed(pSibling->pLeft) && !isRed(pSibling->pRight))
+         {
+            pSibling->isRed = true;
+            p = pParent;
+            pParent = p->pParent;
+            continue;
+         }
+
+         if (!isRed(pSibling->pLeft))
+         {
+            pSibling->pRight->isRed = false;
+            pSibling->isRed = true;
+            tree.rotateLeft(pSibling);
+            pSibling = pParent->pLeft;
+         }
+
+         pSibling->isRed = pParent->isRed;
+         pParent->isRed = false;
+         pSibling->pLeft->isRed = false;
+         tree.rotateRight(pParent);
+         p = tree.root;
+      }
+   }
+
+   if (p)
+      p->isRed = false;
+}
+
+/**********************************************
+ * AVL :: RETRACE
+ * Walk from p to the root fixing heights.  Where
+ * one side is two taller, rotate it down; if it is
+ * taller on the inside, rotate that out first.
+ *********************************************/
+template <class Tree, class Node>
+void avl::retrace(Tree & tree, Node * p)
+{
+   while (p)
+   {
+      update(p);
+      int balance = height(p->pLeft) - height(p->pRight);
+      if (balance > 1)
+      {
+         if (height(p->pLeft->pLeft) < height(p->pLeft->pRight))
+         {
+            Node * pLeft = p->pLeft;
+            tree.rotateLeft(pLeft);
+            update(pLeft);
+            update(pLeft->pParent);
+         }
+         tree.rotateRight(p);
+         update(p);
+         update(p->pParent);
+         p = p->pParent;
+      }
+      else if (balance < -1)
+      {
+         if (height(p->pRight->pRight) < height(p->pRight->pLeft))
+         {
+            Node * pRight = p->pRight;
+            tree.rotateRight(pRight);
+            update(pRight);
+            update(pRight->pParent);
+         }
+         tree.rotateLeft(p);
+         update(p);
+         update(p->pParent);
+         p = p->pParent;
+      }
+      p = p->pParent;
+   }
+}
+
+/**********************************************
+ * SPLAY :: SPLAY UP
+ * Rotate p to the root two levels at a time.  When
+ * p and its parent lean the same way, rotate the
+ * parent first (zig-zig); otherwise rotate p twice
+ * (zig-zag).  A lone step finishes at the root.
+ *********************************************/
+template <class Tree, class Node>
+void splay::splayUp(Tree & tree, Node * p)
+{
+   while (p->pParent)
+   {
+      Node * pParent = p->pParent;
+      Node * pGranny = pParent->pParent;
+      if (pGranny)
+      {
+         bool zigZig = (pGranny->pLeft == pParent) == (pParent->pLeft == p);
+         rotateUp(tree, zigZig ? pParent : p);
+      }
+      rotateUp(tree, p);
+   }
 }
 
 } // namespace custom
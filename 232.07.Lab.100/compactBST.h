@@ -0,0 +1,536 @@
+/***********************************************************************
+ * Header:
+ *    COMPACT BST
+ * Summary:
+ *    A binary search tree with the same interface as custom::BST,
+ *    except that the nodes live in a pool and are linked by 32-bit
+ *    indices. Three links cost 12 bytes rather than 24 on a 64-bit
+ *    build, and the nodes sit close together in memory.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        compact_BST           : A BST whose nodes live in a pool
+ *        compact_BST::iterator : An iterator through compact_BST
+ * Authors
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <utility>    // for std::pair
+#include <initializer_list>
+#include "pool.h"     // for pool
+
+class TestCompactBST; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************************
+ * COMPACT BINARY SEARCH TREE
+ * Just like BST, but index-linked
+ *****************************************************************/
+template <typename T>
+class compact_BST
+{
+   friend class ::TestCompactBST; // give unit tests access to the privates
+
+public:
+   //
+   // Construct
+   //
+   compact_BST() : iRoot(NIL), numElements(0) { }
+   compact_BST(const compact_BST &  rhs) : compact_BST() { *this = rhs; }
+   compact_BST(      compact_BST && rhs) : compact_BST() { *this = std::move(rhs); }
+   compact_BST(const std::initializer_list<T>& il) : compact_BST() { *this = il; }
+  ~compact_BST() { clear(); }
+
+   //
+   // Assign
+   //
+   compact_BST & operator = (const compact_BST &  rhs);
+   compact_BST & operator = (      compact_BST && rhs);
+   compact_BST & operator = (const std::initializer_list<T>& il);
+   void swap(compact_BST & rhs)
+   {
+      nodes.swap(rhs.nodes);
+      std::swap(iRoot, rhs.iRoot);
+      std::swap(numElements, rhs.numElements);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() const noexcept;
+   iterator end()   const noexcept { return iterator(this, NIL); }
+
+   //
+   // Access
+   //
+   iterator find(const T & t) const;
+
+   //
+   // Insert
+   //
+   std::pair<iterator, bool> insert(const T &  t, bool keepUnique = false);
+   std::pair<iterator, bool> insert(      T && t, bool keepUnique = false);
+
+   //
+   // Remove
+   //
+   iterator erase(iterator & it);
+   void clear() noexcept;
+
+   //
+   // Status
+   //
+   bool empty()  const noexcept { return !numElements; }
+   size_t size() const noexcept { return numElements; }
+
+private:
+   class BNode;
+   typedef uint32_t index;
+   static const index NIL = 0xFFFFFFFF;
+
+   //
+   // Helper Methods
+   //
+   index copyBinaryTree(const compact_BST & rhs, index iSrc, index iParent);
+   std::pair<index, bool> findParent(const T & t, bool keepUnique, bool & toLeft) const;
+   std::pair<iterator, bool> attach(index iNew, index iParent, bool toLeft);
+   void replace(index iOld, index iNew);
+
+   //
+   // Member Variables
+   //
+   pool <BNode> nodes; // where the nodes actually live
+   index iRoot;        // root node of the binary search tree
+   size_t numElements; // number of elements currently in the tree
+};
+
+/*****************************************************************
+ * BINARY NODE
+ * Same as BST::BNode, but the links are indices into the owning
+ * tree's pool
+ *****************************************************************/
+template <typename T>
+class compact_BST <T> :: BNode
+{
+public:
+   //
+   // Construct
+   //
+   BNode(const T &  t) : data(t),            iLeft(NIL), iRight(NIL), iParent(NIL) { }
+   BNode(      T && t) : data(std::move(t)), iLeft(NIL), iRight(NIL), iParent(NIL) { }
+
+   //
+   // Data
+   //
+   T data;         // Actual data stored in the BNode
+   index iLeft;    // Left child - smaller
+   index iRight;   // Right child - larger
+   index iParent;  // Parent
+};
+
+/**********************************************************
+ * COMPACT BST ITERATOR
+ * Forward and reverse iterator through a compact_BST.  The
+ * iterator remembers its tree so it can resolve indices.
+ *********************************************************/
+template <typename T>
+class compact_BST <T> :: iterator
+{
+   friend class ::TestCompactBST; // give unit tests access to the privates
+   template <class TT>
+   friend class custom::compact_BST;
+
+public:
+   // constructors and assignment
+   iterator() : pTree(nullptr), i(NIL) { }
+   iterator(const compact_BST * pTree, index i) : pTree(pTree), i(i) { }
+   iterator(const iterator & rhs) : pTree(rhs.pTree), i(rhs.i) { }
+
+   iterator & operator = (const iterator & rhs)
+   {
+      pTree = rhs.pTree;
+      i = rhs.i;
+      return *this;
+   }
+
+   // operators
+   const T & operator * () const { return pTree->nodes[i].data; }
+
+   bool operator == (const iterator & rhs) const { return i == rhs.i; }
+   bool operator != (const iterator & rhs) const { return i != rhs.i; }
+
+   iterator & operator ++ ();
+   iterator operator ++ (int postfix)
+   {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+   }
+
+   iterator & operator -- ();
+   iterator operator -- (int postfix)
+   {
+      auto tmp = *this;
+      --(*this);
+      return tmp;
+   }
+
+private:
+   const compact_BST * pTree; // the tree whose pool we index into
+   index i;                   // the node, or NIL for end()
+};
+
+
+/*****************************************************************
+ ************************** COMPACT BST **************************
+ *****************************************************************/
+
+/**********************************************
+ * COPY BINARY TREE
+ * Copy the subtree under iSrc in rhs into our pool.  The
+ * copy is made in preorder so the new nodes are laid
+ * out in the order a search visits them.
+ *********************************************/
+template <typename T>
+typename compact_BST <T> :: index compact_BST <T> :: copyBinaryTree(const compact_BST <T> & rhs,
+                                                                    index iSrc, index iParent)
+{
+   if (iSrc == NIL)
+      return NIL;
+
+   index iDest = nodes.allocate(rhs.nodes[iSrc].data);
+   nodes[iDest].iParent = iParent;
+
+   index iLeft = copyBinaryTree(rhs, rhs.nodes[iSrc].iLeft, iDest);
+   nodes[iDest].iLeft = iLeft;
+   index iRight = copyBinaryTree(rhs, rhs.nodes[iSrc].iRight, iDest);
+   nodes[iDest].iRight = iRight;
+
+   return iDest;
+}
+
+/*********************************************
+ * COMPACT BST :: ASSIGNMENT OPERATOR
+ * Copy one tree to another
+ ********************************************/
+template <typename T>
+compact_BST <T> & compact_BST <T> :: operator = (const compact_BST <T> & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   iRoot = copyBinaryTree(rhs, rhs.iRoot, NIL);
+   numElements = rhs.numElements;
+   return *this;
+}
+
+/*********************************************
+ * COMPACT BST :: ASSIGN-MOVE OPERATOR
+ * Move one tree to another
+ ********************************************/
+template <typename T>
+compact_BST <T> & compact_BST <T> :: operator = (compact_BST <T> && rhs)
+{
+   clear();
+   swap(rhs);
+   return *this;
+}
+
+/*********************************************
+ * COMPACT BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
+ * Copy nodes onto a tree
+ ********************************************/
+template <typename T>
+compact_BST <T> & compact_BST <T> :: operator = (const std::initializer_list<T>& il)
+{
+   clear();
+   for (auto && t : il)
+      insert(t);
+   return *this;
+}
+
+/*****************************************************
+ * COMPACT BST :: FIND PARENT
+ * Walk down to where t belongs.  Returns the would-be
+ * parent and whether it is a new spot; if keepUnique and
+ * t is already here, returns the match instead.
+ ****************************************************/
+template <typename T>
+std::pair<typename compact_BST <T> :: index, bool>
+compact_BST <T> :: findParent(const T & t, bool keepUnique, bool & toLeft) const
+{
+   index iParent = NIL;
+   index i = iRoot;
+   while (i != NIL)
+   {
+      if (keepUnique && t == nodes[i].data)
+         return std::pair<index, bool>(i, false);
+
+      iParent = i;
+      toLeft = t < nodes[i].data;
+      i = toLeft ? nodes[i].iLeft : nodes[i].iRight;
+   }
+   return std::pair<index, bool>(iParent, true);
+}
+
+/*****************************************************
+ * COMPACT BST :: ATTACH
+ * Hook a freshly allocated node under its parent
+ ****************************************************/
+template <typename T>
+std::pair<typename compact_BST <T> :: iterator, bool>
+compact_BST <T> :: attach(index iNew, index iParent, bool toLeft)
+{
+   nodes[iNew].iParent = iParent;
+   if (iParent == NIL)
+      iRoot = iNew;
+   else if (toLeft)
+      nodes[iParent].iLeft = iNew;
+   else
+      nodes[iParent].iRight = iNew;
+
+   numElements++;
+   return std::pair<iterator, bool>(iterator(this, iNew), true);
+}
+
+/*****************************************************
+ * COMPACT BST :: INSERT
+ * Insert a node at a given location in the tree
+ ****************************************************/
+template <typename T>
+std::pair<typename compact_BST <T> :: iterator, bool> compact_BST <T> :: insert(const T & t, bool keepUnique)
+{
+   bool toLeft = false;
+   auto spot = findParent(t, keepUnique, toLeft);
+   if (!spot.second)
+      return std::pair<iterator, bool>(iterator(this, spot.first), false);
+
+   return attach(nodes.allocate(t), spot.first, toLeft);
+}
+
+template <typename T>
+std::pair<typename compact_BST <T> :: iterator, bool> compact_BST <T> :: insert(T && t, bool keepUnique)
+{
+   bool toLeft = false;
+   auto spot = findParent(t, keepUnique, toLeft);
+   if (!spot.second)
+      return std::pair<iterator, bool>(iterator(this, spot.first), false);
+
+   return attach(nodes.allocate(std::move(t)), spot.first, toLeft);
+}
+
+/*****************************************************
+ * COMPACT BST :: REPLACE
+ * Put iNew (which may be NIL) where iOld hangs from
+ * its parent.  iOld's own links are left alone.
+ ****************************************************/
+template <typename T>
+void compact_BST <T> :: replace(index iOld, index iNew)
+{
+   index iParent = nodes[iOld].iParent;
+   if (iParent == NIL)
+      iRoot = iNew;
+   else if (nodes[iParent].iLeft == iOld)
+      nodes[iParent].iLeft = iNew;
+   else
+      nodes[iParent].iRight = iNew;
+
+   if (iNew != NIL)
+      nodes[iNew].iParent = iParent;
+}
+
+/*************************************************
+ * COMPACT BST :: ERASE
+ * Remove a given node as specified by the iterator.  The
+ * in-order successor is relinked, not copied, so other
+ * iterators stay valid.
+ ************************************************/
+template <typename T>
+typename compact_BST <T> :: iterator compact_BST <T> :: erase(iterator & it)
+{
+   // do nothing if there is nothing to do
+   if (it == end())
+      return end();
+
+   iterator itNext(it);
+   ++itNext;
+   index iDelete = it.i;
+   BNode & del = nodes[iDelete];
+
+   // zero or one child: the child takes our place
+   if (del.iLeft == NIL)
+      replace(iDelete, del.iRight);
+   else if (del.iRight == NIL)
+      replace(iDelete, del.iLeft);
+
+   // two children: the in-order successor takes our place
+   else
+   {
+      index iIOS = itNext.i;
+      assert(nodes[iIOS].iLeft == NIL);
+      if (nodes[iIOS].iParent != iDelete)
+      {
+         replace(iIOS, nodes[iIOS].iRight);
+         nodes[iIOS].iRight = del.iRight;
+         nodes[del.iRight].iParent = iIOS;
+      }
+      replace(iDelete, iIOS);
+      nodes[iIOS].iLeft = del.iLeft;
+      nodes[del.iLeft].iParent = iIOS;
+   }
+
+   nodes.release(iDelete);
+   numElements--;
+   return itNext;
+}
+
+/*****************************************************
+ * COMPACT BST :: CLEAR
+ * Removes all the nodes from a tree.  Walks the tree with
+ * the parent links so a degenerate tree cannot overflow
+ * the stack.
+ ****************************************************/
+template <typename T>
+void compact_BST <T> :: clear() noexcept
+{
+   index i = iRoot;
+   while (i != NIL)
+   {
+      if (nodes[i].iLeft != NIL)
+         i = nodes[i].iLeft;
+      else if (nodes[i].iRight != NIL)
+         i = nodes[i].iRight;
+      else
+      {
+         // a leaf: detach it from its parent and go back up
+         index iParent = nodes[i].iParent;
+         if (iParent != NIL)
+         {
+            if (nodes[iParent].iLeft == i)
+               nodes[iParent].iLeft = NIL;
+            else
+               nodes[iParent].iRight = NIL;
+         }
+         nodes.release(i);
+         i = iParent;
+      }
+   }
+
+   iRoot = NIL;
+   numElements = 0;
+}
+
+/*****************************************************
+ * COMPACT BST :: BEGIN
+ * Return the first node (left-most) in a binary search tree
+ ****************************************************/
+template <typename T>
+typename compact_BST <T> :: iterator compact_BST <T> :: begin() const noexcept
+{
+   index i = iRoot;
+   if (i != NIL)
+      while (nodes[i].iLeft != NIL)
+         i = nodes[i].iLeft;
+   return iterator(this, i);
+}
+
+/****************************************************
+ * COMPACT BST :: FIND
+ * Return the node corresponding to a given value
+ ****************************************************/
+template <typename T>
+typename compact_BST <T> :: iterator compact_BST <T> :: find(const T & t) const
+{
+   index i = iRoot;
+   while (i != NIL)
+   {
+      if (nodes[i].data == t)
+         return iterator(this, i);
+      i = (t < nodes[i].data) ? nodes[i].iLeft : nodes[i].iRight;
+   }
+   return end();
+}
+
+/*****************************************************************
+ *************************** ITERATOR ****************************
+ *****************************************************************/
+
+/**************************************************
+ * COMPACT BST ITERATOR :: INCREMENT PREFIX
+ * advance by one
+ *************************************************/
+template <typename T>
+typename compact_BST <T> :: iterator & compact_BST <T> :: iterator :: operator ++ ()
+{
+   if (i == NIL)
+      return *this;
+
+   const pool <BNode> & nodes = pTree->nodes;
+
+   // if there is a right node, take it and jig left
+   if (nodes[i].iRight != NIL)
+   {
+      i = nodes[i].iRight;
+      while (nodes[i].iLeft != NIL)
+         i = nodes[i].iLeft;
+      return *this;
+   }
+
+   // go up as long as we are the right child
+   index iPrev = i;
+   i = nodes[i].iParent;
+   while (i != NIL && nodes[i].iRight == iPrev)
+   {
+      iPrev = i;
+      i = nodes[i].iParent;
+   }
+   return *this;
+}
+
+/**************************************************
+ * COMPACT BST ITERATOR :: DECREMENT PREFIX
+ * back up by one
+ *************************************************/
+template <typename T>
+typename compact_BST <T> :: iterator & compact_BST <T> :: iterator :: operator -- ()
+{
+   if (i == NIL)
+      return *this;
+
+   const pool <BNode> & nodes = pTree->nodes;
+
+   // if there is a left node, take it and jig right
+   if (nodes[i].iLeft != NIL)
+   {
+      i = nodes[i].iLeft;
+      while (nodes[i].iRight != NIL)
+         i = nodes[i].iRight;
+      return *this;
+   }
+
+   // go up as long as we are the left child
+   index iPrev = i;
+   i = nodes[i].iParent;
+   while (i != NIL && nodes[i].iLeft == iPrev)
+   {
+      iPrev = i;
+      i = nodes[i].iParent;
+   }
+   return *this;
+}
+
+} // namespace custom
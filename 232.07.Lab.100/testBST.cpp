@@ -13,6 +13,8 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testBST.h"        // for the BST unit tests
+#include "testCompactBST.h" // for the compact BST unit tests
+#include "testBTree.h"      // for the B tree unit tests
 #include "testSpy.h"        // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -26,6 +28,8 @@ int main()
    // unit tests
    TestSpy().run();
    TestBST().run();
+   TestCompactBST().run();
+   TestBTree().run();
 #endif // DEBUG
    
    return 0;
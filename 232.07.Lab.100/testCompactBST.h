@@ -0,0 +1,591 @@
+/***********************************************************************
+ * Header:
+ *    TEST COMPACT BST
+ * Summary:
+ *    Unit tests for compact_BST
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "compactBST.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <iostream>
+
+/***********************************************
+ * TEST COMPACT BST
+ * Unit tests for the compact_BST class
+ ***********************************************/
+class TestCompactBST : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructInitializer_standard();
+
+      // Assign
+      test_assign_standardToStandard();
+      test_swap_standardToEmpty();
+
+      // Iterator
+      test_begin_standard();
+      test_iterator_increment_standard();
+      test_iterator_decrement_standard();
+
+      // Find
+      test_find_standard();
+      test_find_standardMissing();
+
+      // Insert
+      test_insert_empty();
+      test_insert_oneLeft();
+      test_insert_oneRight();
+      test_insert_keepUnique();
+
+      // Remove
+      test_erase_noChildren();
+      test_erase_oneChild();
+      test_erase_twoChildren();
+      test_erase_root();
+      test_clear_standard();
+      test_clear_reusesSlots();
+
+      // Status
+      test_nodeSize();
+
+      report("CompactBST");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::compact_BST<int> bst;
+      // verify
+      assertEmptyFixture(bst);
+      assertUnit(bst.nodes.capacity() == 0);
+   }  // teardown
+
+   // copy constructor lays the copy out in preorder
+   void test_constructCopy_standard()
+   {  // setup
+      custom::compact_BST<Spy> bstSrc;
+      setupStandardFixture(bstSrc);
+      Spy::reset();
+      // exercise
+      custom::compact_BST<Spy> bstDest(bstSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 7);        // copy [50,30,20,40,70,60,80]
+      assertUnit(Spy::numAlloc() == 7);
+      assertUnit(Spy::numAssign() == 0);
+      assertStandardFixture(bstSrc);
+      assertStandardFixture(bstDest);
+      //                 (0)
+      //          +-------+-------+
+      //        (1)              (4)
+      //     +----+----+     +----+----+
+      //   (2)       (3)   (5)       (6)
+      assertUnit(bstDest.iRoot == 0);
+      assertUnit(bstDest.nodes[0].iLeft == 1);
+      assertUnit(bstDest.nodes[1].iLeft == 2);
+      assertUnit(bstDest.nodes[1].iRight == 3);
+      assertUnit(bstDest.nodes[0].iRight == 4);
+      assertUnit(bstDest.nodes[4].iLeft == 5);
+      assertUnit(bstDest.nodes[4].iRight == 6);
+   }  // teardown
+
+   // move constructor takes the pool
+   void test_constructMove_standard()
+   {  // setup
+      custom::compact_BST<Spy> bstSrc;
+      setupStandardFixture(bstSrc);
+      Spy::reset();
+      // exercise
+      custom::compact_BST<Spy> bstDest(std::move(bstSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertEmptyFixture(bstSrc);
+      assertStandardFixture(bstDest);
+   }  // teardown
+
+   // initializer list constructor
+   void test_constructInitializer_standard()
+   {  // setup
+      // exercise
+      custom::compact_BST<Spy> bst{ Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
+      // verify
+      assertStandardFixture(bst);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign a standard tree over a different tree
+   void test_assign_standardToStandard()
+   {  // setup
+      custom::compact_BST<Spy> bstSrc;
+      setupStandardFixture(bstSrc);
+      custom::compact_BST<Spy> bstDest{ Spy(10), Spy(5), Spy(15) };
+      // exercise
+      bstDest = bstSrc;
+      // verify
+      assertStandardFixture(bstSrc);
+      assertStandardFixture(bstDest);
+      assertUnit(bstDest.nodes.size() == 7);
+   }  // teardown
+
+   // swap a standard tree with an empty one
+   void test_swap_standardToEmpty()
+   {  // setup
+      custom::compact_BST<Spy> bstLeft;
+      setupStandardFixture(bstLeft);
+      custom::compact_BST<Spy> bstRight;
+      // exercise
+      bstLeft.swap(bstRight);
+      // verify
+      assertEmptyFixture(bstLeft);
+      assertStandardFixture(bstRight);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // begin() is the left-most node
+   void test_begin_standard()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      // exercise
+      auto it = bst.begin();
+      // verify
+      assertUnit(it != bst.end());
+      if (it != bst.end())
+         assertUnit(*it == Spy(20));
+      assertStandardFixture(bst);
+   }  // teardown
+
+   // walk the whole tree in order
+   void test_iterator_increment_standard()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      int values[7];
+      int i = 0;
+      // exercise
+      for (auto it = bst.begin(); it != bst.end() && i < 7; ++it)
+         values[i++] = (*it).get();
+      // verify
+      assertUnit(i == 7);
+      assertUnit(values[0] == 20);
+      assertUnit(values[1] == 30);
+      assertUnit(values[2] == 40);
+      assertUnit(values[3] == 50);
+      assertUnit(values[4] == 60);
+      assertUnit(values[5] == 70);
+      assertUnit(values[6] == 80);
+      assertStandardFixture(bst);
+   }  // teardown
+
+   // walk the whole tree backwards
+   void test_iterator_decrement_standard()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      auto it = bst.find(Spy(80));
+      int values[7];
+      int i = 0;
+      // exercise
+      for (; it != bst.end() && i < 7; --it)
+         values[i++] = (*it).get();
+      // verify
+      assertUnit(i == 7);
+      assertUnit(values[0] == 80);
+      assertUnit(values[3] == 50);
+      assertUnit(values[6] == 20);
+      assertStandardFixture(bst);
+   }  // teardown
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // find a leaf
+   void test_find_standard()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(60);
+      // exercise
+      auto it = bst.find(s);
+      // verify
+      assertUnit(it != bst.end());
+      if (it != bst.end())
+         assertUnit(*it == Spy(60));
+      assertStandardFixture(bst);
+   }  // teardown
+
+   // find something that is not there
+   void test_find_standardMissing()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(45);
+      // exercise
+      auto it = bst.find(s);
+      // verify
+      assertUnit(it == bst.end());
+      assertStandardFixture(bst);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert into an empty tree
+   void test_insert_empty()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      Spy s(50);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);        // copy-create [50]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [50]
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(pairBST.second == true);
+      assertUnit(pairBST.first != bst.end());
+      assertUnit(bst.numElements == 1);
+      assertUnit(bst.iRoot == 0);
+      assertUnit(bst.nodes[0].iParent == bst.NIL);
+   }  // teardown
+
+   // insert to the left of the root
+   void test_insert_oneLeft()
+   {  // setup
+      custom::compact_BST<Spy> bst{ Spy(50) };
+      Spy s(40);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(s);
+      // verify
+      assertUnit(Spy::numLessthan() == 1);    // compare [50]
+      assertUnit(Spy::numCopy() == 1);        // copy-create [40]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(pairBST.second == true);
+      //           (50)
+      //        +----+
+      //      (40)
+      assertUnit(bst.size() == 2);
+      assertUnit(bst.nodes[bst.iRoot].iLeft == pairBST.first.i);
+      assertUnit(bst.nodes[bst.iRoot].iRight == bst.NIL);
+      assertUnit(bst.nodes[pairBST.first.i].iParent == bst.iRoot);
+   }  // teardown
+
+   // insert to the right of the root
+   void test_insert_oneRight()
+   {  // setup
+      custom::compact_BST<Spy> bst{ Spy(50) };
+      Spy s(60);
+      // exercise
+      auto pairBST = bst.insert(std::move(s));
+      // verify
+      //           (50)
+      //             +----+
+      //                (60)
+      assertUnit(pairBST.second == true);
+      assertUnit(bst.size() == 2);
+      assertUnit(bst.nodes[bst.iRoot].iRight == pairBST.first.i);
+      assertUnit(bst.nodes[bst.iRoot].iLeft == bst.NIL);
+      assertUnit(*pairBST.first == Spy(60));
+   }  // teardown
+
+   // insert a duplicate while keeping the values unique
+   void test_insert_keepUnique()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(40);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(s, true /* keepUnique */);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(pairBST.second == false);
+      assertUnit(pairBST.first != bst.end());
+      if (pairBST.first != bst.end())
+         assertUnit(*pairBST.first == Spy(40));
+      assertStandardFixture(bst);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase a leaf
+   void test_erase_noChildren()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      auto it = bst.find(Spy(20));
+      // exercise
+      auto itNext = bst.erase(it);
+      // verify
+      assertUnit(itNext != bst.end());
+      if (itNext != bst.end())
+         assertUnit(*itNext == Spy(30));
+      assertUnit(bst.size() == 6);
+      assertUnit(bst.nodes.size() == 6);
+      assertUnit(bst.nodes[bst.nodes[bst.iRoot].iLeft].iLeft == bst.NIL);
+   }  // teardown
+
+   // erase a node with only a right child
+   void test_erase_oneChild()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      auto it = bst.find(Spy(20));
+      bst.erase(it);
+      it = bst.find(Spy(30));
+      // exercise
+      auto itNext = bst.erase(it);
+      //                (50)
+      //          +-------+-------+
+      //        (40)            (70)
+      // verify
+      assertUnit(itNext != bst.end());
+      if (itNext != bst.end())
+         assertUnit(*itNext == Spy(40));
+      uint32_t i40 = bst.nodes[bst.iRoot].iLeft;
+      assertUnit(bst.nodes[i40].data == Spy(40));
+      assertUnit(bst.nodes[i40].iParent == bst.iRoot);
+      assertUnit(bst.size() == 5);
+   }  // teardown
+
+   // erase a node with two children
+   void test_erase_twoChildren()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      auto it = bst.find(Spy(30));
+      uint32_t i40 = bst.nodes[it.i].iRight;
+      // exercise
+      auto itNext = bst.erase(it);
+      // verify
+      //                (50)
+      //          +-------+-------+
+      //        (40)            (70)
+      //     +----+          +----+----+
+      //   (20)            (60)      (80)
+      assertUnit(itNext.i == i40);
+      assertUnit(bst.nodes[bst.iRoot].iLeft == i40);
+      assertUnit(bst.nodes[i40].iParent == bst.iRoot);
+      assertUnit(bst.nodes[i40].iRight == bst.NIL);
+      assertUnit(bst.nodes[i40].iLeft != bst.NIL);
+      if (bst.nodes[i40].iLeft != bst.NIL)
+      {
+         assertUnit(bst.nodes[bst.nodes[i40].iLeft].data == Spy(20));
+         assertUnit(bst.nodes[bst.nodes[i40].iLeft].iParent == i40);
+      }
+      assertUnit(bst.size() == 6);
+   }  // teardown
+
+   // erase the root, whose successor is a grandchild
+   void test_erase_root()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      auto it = bst.begin();
+      for (int i = 0; i < 3; i++)
+         ++it;
+      // exercise
+      auto itNext = bst.erase(it);
+      // verify
+      //                (60)
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+          +----+
+      //   (20)      (40)            (80)
+      assertUnit(itNext.i == bst.iRoot);
+      assertUnit(bst.nodes[bst.iRoot].data == Spy(60));
+      assertUnit(bst.nodes[bst.iRoot].iParent == bst.NIL);
+      uint32_t i70 = bst.nodes[bst.iRoot].iRight;
+      assertUnit(bst.nodes[i70].data == Spy(70));
+      assertUnit(bst.nodes[i70].iLeft == bst.NIL);
+      assertUnit(bst.nodes[i70].iParent == bst.iRoot);
+      assertUnit(bst.nodes[bst.nodes[bst.iRoot].iLeft].iParent == bst.iRoot);
+      assertUnit(bst.size() == 6);
+   }  // teardown
+
+   // clear a standard tree
+   void test_clear_standard()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      Spy::reset();
+      // exercise
+      bst.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 7);
+      assertUnit(Spy::numDelete() == 7);
+      assertEmptyFixture(bst);
+      assertUnit(bst.nodes.size() == 0);
+   }  // teardown
+
+   // refilling after a clear reuses the slots
+   void test_clear_reusesSlots()
+   {  // setup
+      custom::compact_BST<Spy> bst;
+      setupStandardFixture(bst);
+      bst.clear();
+      // exercise
+      bst = { Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
+      // verify
+      assertStandardFixture(bst);
+      assertUnit(bst.nodes.capacity() == 7);
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // three 32-bit links per element
+   void test_nodeSize()
+   {  // setup
+      // exercise
+      size_t sizeNode = sizeof(custom::compact_BST<int>::BNode);
+      // verify
+      assertUnit(sizeNode == sizeof(int) + 3 * sizeof(uint32_t));
+      assertUnit(sizeNode < sizeof(int) + 3 * sizeof(void *) || sizeof(void *) == 4);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *                (50)
+    *          +-------+-------+
+    *        (30)            (70)
+    *     +----+----+     +----+----+
+    *   (20)      (40)  (60)      (80)
+    *************************************************************/
+   void setupStandardFixture(custom::compact_BST <Spy>& bst)
+   {
+      // make sure that bst is clean
+      assertUnit(bst.numElements == 0);
+      assertUnit(bst.iRoot == bst.NIL);
+
+      // allocate
+      uint32_t i50 = bst.nodes.allocate(Spy(50));
+      uint32_t i30 = bst.nodes.allocate(Spy(30));
+      uint32_t i70 = bst.nodes.allocate(Spy(70));
+      uint32_t i20 = bst.nodes.allocate(Spy(20));
+      uint32_t i40 = bst.nodes.allocate(Spy(40));
+      uint32_t i60 = bst.nodes.allocate(Spy(60));
+      uint32_t i80 = bst.nodes.allocate(Spy(80));
+
+      // hook up the links down
+      bst.nodes[i30].iLeft  = i20;
+      bst.nodes[i30].iRight = i40;
+      bst.nodes[i50].iLeft  = i30;
+      bst.nodes[i50].iRight = i70;
+      bst.nodes[i70].iLeft  = i60;
+      bst.nodes[i70].iRight = i80;
+
+      // hook up the links up
+      bst.nodes[i20].iParent = bst.nodes[i40].iParent = i30;
+      bst.nodes[i30].iParent = bst.nodes[i70].iParent = i50;
+      bst.nodes[i60].iParent = bst.nodes[i80].iParent = i70;
+
+      // now assign everything to the bst
+      bst.iRoot = i50;
+      bst.numElements = 7;
+   }
+
+   /**************************************************************
+    * VERIFY EMPTY FIXTURE
+    *************************************************************/
+   void assertEmptyFixtureParameters(const custom::compact_BST <Spy>& bst, int line, const char* function)
+   {
+      assertIndirect(bst.iRoot == bst.NIL);
+      assertIndirect(bst.numElements == 0);
+   }
+   void assertEmptyFixtureParameters(const custom::compact_BST <int>& bst, int line, const char* function)
+   {
+      assertIndirect(bst.iRoot == bst.NIL);
+      assertIndirect(bst.numElements == 0);
+   }
+
+   /**************************************************************
+    * VERIFY STANDARD FIXTURE
+    *                (50)
+    *          +-------+-------+
+    *        (30)            (70)
+    *     +----+----+     +----+----+
+    *   (20)      (40)  (60)      (80)
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::compact_BST <Spy>& bst, int line, const char* function)
+   {
+      const uint32_t NIL = bst.NIL;
+
+      // verify the member variables
+      assertIndirect(bst.numElements == 7);
+      assertIndirect(bst.iRoot != NIL);
+      if (bst.iRoot == NIL)
+         return;
+
+      uint32_t i50 = bst.iRoot;
+      assertIndirect(bst.nodes[i50].data == Spy(50));
+      assertIndirect(bst.nodes[i50].iParent == NIL);
+
+      uint32_t i30 = bst.nodes[i50].iLeft;
+      uint32_t i70 = bst.nodes[i50].iRight;
+      assertIndirect(i30 != NIL);
+      assertIndirect(i70 != NIL);
+      if (i30 == NIL || i70 == NIL)
+         return;
+      assertIndirect(bst.nodes[i30].data == Spy(30));
+      assertIndirect(bst.nodes[i30].iParent == i50);
+      assertIndirect(bst.nodes[i70].data == Spy(70));
+      assertIndirect(bst.nodes[i70].iParent == i50);
+
+      uint32_t leaves[4] = { bst.nodes[i30].iLeft, bst.nodes[i30].iRight,
+                             bst.nodes[i70].iLeft, bst.nodes[i70].iRight };
+      uint32_t parents[4] = { i30, i30, i70, i70 };
+      int values[4] = { 20, 40, 60, 80 };
+      for (int i = 0; i < 4; i++)
+      {
+         assertIndirect(leaves[i] != NIL);
+         if (leaves[i] == NIL)
+            continue;
+         assertIndirect(bst.nodes[leaves[i]].data == Spy(values[i]));
+         assertIndirect(bst.nodes[leaves[i]].iParent == parents[i]);
+         assertIndirect(bst.nodes[leaves[i]].iLeft == NIL);
+         assertIndirect(bst.nodes[leaves[i]].iRight == NIL);
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,1218 @@
+/***********************************************************************
+ * Header:
+ *    B TREE
+ * Summary:
+ *    A B+ tree with the same interface as custom::BST. Each node is
+ *    about NodeBytes bytes and holds many sorted elements, so a
+ *    search reads a few cache lines per level instead of one node
+ *    per element, and there are far fewer pointers to pay for.
+ *    Elements live only in the leaves, which are linked in order.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        btree           : A B+ tree
+ *        btree::iterator : An iterator through btree
+ *        key_of          : The part of an element an inner node keeps
+ *        btree_layout    : Asks a set or map to keep a btree
+ *        tree_for        : The tree a set or map keeps
+ * Authors
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>    // for std::ptrdiff_t
+#include <new>        // for placement new
+#include <utility>    // for std::pair
+#include <vector>     // for bulk loads
+#include <iterator>   // for std::make_move_iterator
+#include <algorithm>  // for std::lower_bound and std::stable_sort
+#include <initializer_list>
+#include <type_traits> // for std::enable_if
+#include "bst.h"      // for BST and assume_sorted
+
+class TestBTree;      // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************************
+ * KEY OF
+ * The part of an element its comparator orders it by, which is
+ * all an inner node needs to keep.  That is the element itself,
+ * unless Compare names a key_type and hands it out from key(), as
+ * a map's value_compare does with a pair's first.
+ *****************************************************************/
+template <typename T, class Compare, class = void>
+struct key_of
+{
+   typedef T type;
+   static const T & get(const T & t) { return t; }
+};
+
+template <typename T, class Compare>
+struct key_of <T, Compare, typename always_void<typename Compare::key_type>::type>
+{
+   typedef typename Compare::key_type type;
+   static const type & get(const T & t) { return Compare::key(t); }
+};
+
+/*****************************************************************
+ * B TREE
+ * Every leaf is the same distance from the root.  Inner nodes hold
+ * keys that separate their children: everything in children[i] is
+ * no greater than keys[i], which is no greater than anything in
+ * children[i + 1].  No node but the root is ever empty, and only
+ * the slots in use hold a constructed element or key.
+ *****************************************************************/
+template <typename T, size_t NodeBytes = 256, class Compare = std::less<T> >
+class btree : private compare_holder<Compare>
+{
+   friend class ::TestBTree; // give unit tests access to the privates
+
+public:
+   //
+   // Construct
+   //
+   explicit btree(const Compare & comp = Compare())
+      : compare_holder<Compare>(comp), root(nullptr), numElements(0) { }
+   btree(const btree &  rhs) : btree(rhs.key_comp()) { *this = rhs; }
+   btree(      btree && rhs) : btree(rhs.key_comp()) { swap(rhs); }
+   btree(const std::initializer_list<T>& il) : btree() { *this = il; }
+  ~btree() { clear(); }
+
+   //
+   // Assign
+   //
+   btree & operator = (const btree & rhs)
+   {
+      if (this != &rhs)
+      {
+         compare_holder<Compare>::operator = (rhs);
+         assign(assume_sorted, rhs.begin(), rhs.end());
+      }
+      return *this;
+   }
+   btree & operator = (btree && rhs)
+   {
+      clear();
+      swap(rhs);
+      return *this;
+   }
+   btree & operator = (const std::initializer_list<T>& il)
+   {
+      assign(il.begin(), il.end());
+      return *this;
+   }
+   void swap(btree & rhs)
+   {
+      std::swap(root, rhs.root);
+      std::swap(numElements, rhs.numElements);
+      std::swap(static_cast<compare_holder<Compare> &>(*this),
+                static_cast<compare_holder<Compare> &>(rhs));
+   }
+
+   //
+   // Compare: the one comparator every element is ordered by
+   //
+   Compare key_comp() const { return this->compare(); }
+
+   //
+   // Bulk Load: replace the contents, packing the leaves full
+   //
+   template <class Iterator>
+   void assign(Iterator first, Iterator last, bool keepUnique = false);
+   template <class Iterator>
+   void assign(assume_sorted_t, Iterator first, Iterator last, bool keepUnique = false);
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() const noexcept;
+   iterator end()   const noexcept;
+
+   //
+   // Access: each takes a T, or anything Compare is transparent to
+   //
+   template <class Key>
+   using Lookup = typename std::enable_if<std::is_same<Key, T>::value ||
+                                          is_transparent<Compare>::value>::type;
+
+   iterator find(const T & t) const { return find<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator find(const Key & k) const;
+
+   iterator lower_bound(const T & t) const { return lower_bound<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator lower_bound(const Key & k) const;   // first not less than k
+
+   // the same, but searched for from hint, which must not be past
+   // the answer: in the hint's leaf or the next, else from the root
+   iterator lower_bound(iterator hint, const T & t) const { return lower_bound<T>(hint, t); }
+   template <class Key, class = Lookup<Key> >
+   iterator lower_bound(iterator hint, const Key & k) const;
+
+   iterator upper_bound(const T & t) const { return upper_bound<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator upper_bound(const Key & k) const;   // first greater than k
+
+   std::pair<iterator, iterator> equal_range(const T & t) const
+   {
+      return equal_range<T>(t);
+   }
+   template <class Key, class = Lookup<Key> >
+   std::pair<iterator, iterator> equal_range(const Key & k) const
+   {
+      return std::pair<iterator, iterator>(lower_bound<Key>(k), upper_bound<Key>(k));
+   }
+
+   //
+   // Insert
+   //
+   std::pair<iterator, bool> insert(const T &  t, bool keepUnique = false)
+   {
+      return insertSearched(t, keepUnique);
+   }
+   std::pair<iterator, bool> insert(      T && t, bool keepUnique = false)
+   {
+      return insertSearched(std::move(t), keepUnique);
+   }
+
+   // t goes right before hint if it belongs there, else wherever a
+   // search says.  end() is the hint for an ever increasing stream.
+   std::pair<iterator, bool> insert(iterator hint, const T & t, bool keepUnique = false)
+   {
+      return insertHinted(hint, t, keepUnique);
+   }
+   std::pair<iterator, bool> insert(iterator hint, T && t, bool keepUnique = false)
+   {
+      return insertHinted(hint, std::move(t), keepUnique);
+   }
+
+   //
+   // Remove
+   //
+   iterator erase(iterator & it);
+   void clear() noexcept;
+
+   //
+   // Status
+   //
+   bool empty()  const noexcept { return !numElements; }
+   size_t size() const noexcept { return numElements; }
+
+private:
+   struct Node;
+   struct Leaf;
+   struct Inner;
+   typedef typename key_of<T, Compare>::type Separator; // what keys[] holds
+
+   //
+   // Capacity: as many as fit in NodeBytes after the bookkeeping,
+   // but never so few that splitting and merging stop working
+   //
+   static const size_t LEAF_MAX = (NodeBytes > 4 * sizeof(void *) + 4 * sizeof(T)) ?
+                                  (NodeBytes - 4 * sizeof(void *)) / sizeof(T) : 4;
+   static const size_t INNER_MAX = (NodeBytes > 3 * sizeof(void *) + 4 * (sizeof(Separator) + sizeof(void *))) ?
+                                   (NodeBytes - 3 * sizeof(void *)) / (sizeof(Separator) + sizeof(void *)) : 4;
+   static const size_t LEAF_MIN = LEAF_MAX / 2;
+   static const size_t INNER_MIN = (INNER_MAX - 1) / 2;
+
+   //
+   // Helper Methods
+   //
+   template <class Key>
+   std::pair<Leaf *, size_t> search(const Key & t, bool upper) const;
+   iterator normalize(Leaf * pLeaf, size_t i) const;
+   Leaf * firstLeaf() const;
+   Leaf * lastLeaf() const;
+   static size_t childIndex(const Inner * pParent, const Node * pChild);
+   void destroy(Node * p);
+   static Node * build(std::vector<T> & items);
+
+   template <class U>
+   std::pair<iterator, bool> insertSearched(U && t, bool keepUnique);
+   template <class U>
+   std::pair<iterator, bool> insertHinted(iterator hint, U && t, bool keepUnique);
+   template <class U>
+   iterator insertInLeaf(Leaf * pLeaf, size_t i, U && t);
+   void addToParent(Node * pLeft, const Separator & key, Node * pRight);
+
+   Leaf * fixLeaf(Leaf * pLeaf, size_t & i);
+   void mergeLeaves(Leaf * pLeft, Leaf * pRight, size_t iKey);
+   void fixInner(Inner * p);
+   void mergeInner(Inner * pLeft, Inner * pRight, size_t iKey);
+   void removeFromInner(Inner * p, size_t iKey);
+
+   template <class A, class B>
+   bool less(const A & lhs, const B & rhs) const { return this->compare()(lhs, rhs); }
+   static const Separator & keyOf(const T & t) { return key_of<T, Compare>::get(t); }
+
+   // the slots [0, num) hold something; the rest are raw memory
+   template <class E, class U>
+   static void openAt(E * p, size_t num, size_t i, U && u);
+   template <class E>
+   static void closeAt(E * p, size_t num, size_t i);
+   template <class E>
+   static void moveTo(E * pTo, E * pFrom, size_t num);
+
+   //
+   // Member Variables
+   //
+   Node * root;        // a leaf, or an inner node; null when empty
+   size_t numElements; // number of elements currently in the tree
+};
+
+/*****************************************************************
+ * B TREE NODES
+ * A leaf keeps elements and its neighbors; an inner node keeps the
+ * keys that steer a search and one more child than it has keys.
+ * Both keep raw slots, so an element or key is built only when it
+ * goes in and destroyed when it leaves, and a node's destructor
+ * destroys the first num.
+ *****************************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+struct btree <T, NodeBytes, Compare> :: Node
+{
+   Node(bool isLeaf) : pParent(nullptr), num(0), isLeaf(isLeaf) { }
+   Inner * pParent;  // null at the root
+   unsigned int num; // elements in a leaf, keys in an inner node
+   bool isLeaf;
+};
+
+template <typename T, size_t NodeBytes, class Compare>
+struct btree <T, NodeBytes, Compare> :: Leaf : public Node
+{
+   Leaf() : Node(true), pPrev(nullptr), pNext(nullptr) { }
+  ~Leaf()
+   {
+      for (size_t i = 0; i < this->num; i++)
+         data()[i].~T();
+   }
+   T * data()             { return reinterpret_cast<T *>(slots);       }
+   const T * data() const { return reinterpret_cast<const T *>(slots); }
+
+   typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[LEAF_MAX]; // in order; only the first num are used
+   Leaf * pPrev;         // the leaf before, in order
+   Leaf * pNext;         // the leaf after, in order
+};
+
+template <typename T, size_t NodeBytes, class Compare>
+struct btree <T, NodeBytes, Compare> :: Inner : public Node
+{
+   Inner() : Node(false) { }
+  ~Inner()
+   {
+      for (size_t i = 0; i < this->num; i++)
+         keys()[i].~Separator();
+   }
+   Separator * keys()             { return reinterpret_cast<Separator *>(slots);       }
+   const Separator * keys() const { return reinterpret_cast<const Separator *>(slots); }
+
+   typename std::aligned_storage<sizeof(Separator), alignof(Separator)>::type slots[INNER_MAX]; // keys()[i] separates children i and i + 1
+   Node * children[INNER_MAX + 1]; // only the first num + 1 are used
+};
+
+/**********************************************************
+ * B TREE ITERATOR
+ * A leaf and a place in it.  end() is no leaf at all.
+ *********************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+class btree <T, NodeBytes, Compare> :: iterator
+{
+   friend class btree <T, NodeBytes, Compare>;
+   friend class ::TestBTree; // give unit tests access to the privates
+
+public:
+   // constructors and assignment
+   iterator(Leaf * pLeaf = nullptr, size_t i = 0) : pLeaf(pLeaf), i(i) { }
+   iterator(const iterator & rhs) : pLeaf(rhs.pLeaf), i(rhs.i) { }
+   iterator & operator = (const iterator & rhs)
+   {
+      pLeaf = rhs.pLeaf;
+      i = rhs.i;
+      return *this;
+   }
+
+   // operators
+   const T & operator * () const { return pLeaf->data()[i]; }
+   bool operator == (const iterator & rhs) const { return pLeaf == rhs.pLeaf && i == rhs.i; }
+   bool operator != (const iterator & rhs) const { return !(*this == rhs); }
+
+   iterator & operator ++ ()
+   {
+      if (pLeaf && ++i == pLeaf->num)
+      {
+         pLeaf = pLeaf->pNext;
+         i = 0;
+      }
+      return *this;
+   }
+   iterator operator ++ (int)
+   {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+   }
+
+   iterator & operator -- ()
+   {
+      if (pLeaf && i > 0)
+         i--;
+      else if (pLeaf)
+      {
+         pLeaf = pLeaf->pPrev;
+         i = pLeaf ? pLeaf->num - 1 : 0;
+      }
+      return *this;
+   }
+   iterator operator -- (int)
+   {
+      auto tmp = *this;
+      --(*this);
+      return tmp;
+   }
+
+   // how many steps from first to last, skipping a whole leaf at a
+   // time: O(n / LEAF_MAX)
+   friend std::ptrdiff_t distance(const iterator & first, const iterator & last)
+   {
+      std::ptrdiff_t num = 0;
+      iterator it = first;
+      while (it.pLeaf && it.pLeaf != last.pLeaf)
+      {
+         num += (std::ptrdiff_t)(it.pLeaf->num - it.i);
+         it = iterator(it.pLeaf->pNext, 0);
+      }
+      if (it.pLeaf == last.pLeaf)
+         return num + (std::ptrdiff_t)last.i - (std::ptrdiff_t)it.i;
+
+      // we fell off the end, so last comes first
+      return -distance(last, first);
+   }
+
+private:
+   Leaf * pLeaf;   // null at end()
+   size_t i;       // the place in the leaf
+};
+
+/*****************************************************************
+ * B TREE LAYOUT
+ * Given to a set or map in place of a balancing policy, this keeps
+ * the elements in a btree with nodes of about NodeBytes bytes
+ *****************************************************************/
+template <size_t NodeBytes = 256>
+struct btree_layout { };
+
+/*****************************************************************
+ * TREE FOR
+ * The tree a set or map keeps its elements in: a BST balanced by
+ * the given policy, or a btree, either ordered by Compare
+ *****************************************************************/
+template <typename T, class Balance, class Compare = std::less<T> >
+struct tree_for
+{
+   typedef BST <T, Balance, false, Compare> type;
+};
+
+template <typename T, size_t NodeBytes, class Compare>
+struct tree_for <T, btree_layout <NodeBytes>, Compare>
+{
+   typedef btree <T, NodeBytes, Compare> type;
+};
+
+/*****************************************************************
+ ***************************** BTREE *****************************
+ *****************************************************************/
+
+/*****************************************************
+ * B TREE :: BEGIN and END
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::begin() const noexcept
+{
+   return iterator(firstLeaf(), 0);
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::end() const noexcept
+{
+   return iterator(nullptr, 0);
+}
+
+/*****************************************************
+ * B TREE :: FIRST LEAF and LAST LEAF
+ * Follow the outermost children down
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::Leaf * btree <T, NodeBytes, Compare> ::firstLeaf() const
+{
+   Node * p = root;
+   while (p && !p->isLeaf)
+      p = static_cast<Inner *>(p)->children[0];
+   return static_cast<Leaf *>(p);
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::Leaf * btree <T, NodeBytes, Compare> ::lastLeaf() const
+{
+   Node * p = root;
+   while (p && !p->isLeaf)
+      p = static_cast<Inner *>(p)->children[p->num];
+   return static_cast<Leaf *>(p);
+}
+
+/*****************************************************
+ * B TREE :: SEARCH
+ * The leaf where t belongs, and the place in it: before
+ * every element not less than t, or with upper, before
+ * every element greater than t.  The place may be the
+ * end of the leaf.
+ *    COST   : O(log n), a binary search per level
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class Key>
+std::pair<typename btree <T, NodeBytes, Compare> ::Leaf *, size_t> btree <T, NodeBytes, Compare> ::search(const Key & t, bool upper) const
+{
+   Node * p = root;
+   while (!p->isLeaf)
+   {
+      Inner * pInner = static_cast<Inner *>(p);
+      const Separator * pKey = upper ? std::upper_bound(pInner->keys(), pInner->keys() + p->num, t, this->compare())
+                                     : std::lower_bound(pInner->keys(), pInner->keys() + p->num, t, this->compare());
+      p = pInner->children[pKey - pInner->keys()];
+   }
+
+   Leaf * pLeaf = static_cast<Leaf *>(p);
+   const T * pData = upper ? std::upper_bound(pLeaf->data(), pLeaf->data() + p->num, t, this->compare())
+                           : std::lower_bound(pLeaf->data(), pLeaf->data() + p->num, t, this->compare());
+   return std::pair<Leaf *, size_t>(pLeaf, pData - pLeaf->data());
+}
+
+/*****************************************************
+ * B TREE :: NORMALIZE
+ * A place at the end of a leaf is really the start of
+ * the next one
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::normalize(Leaf * pLeaf, size_t i) const
+{
+   if (pLeaf && i == pLeaf->num)
+      return iterator(pLeaf->pNext, 0);
+   return iterator(pLeaf, i);
+}
+
+/*****************************************************
+ * B TREE :: FIND, LOWER BOUND, UPPER BOUND
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class Key, class>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::find(const Key & t) const
+{
+   iterator it = lower_bound<Key>(t);
+   if (it != end() && !less(t, *it))
+      return it;
+   return end();
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+template <class Key, class>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::lower_bound(const Key & t) const
+{
+   if (!root)
+      return end();
+   auto place = search(t, false /* upper */);
+   return normalize(place.first, place.second);
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+template <class Key, class>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::lower_bound(iterator hint, const Key & t) const
+{
+   if (hint == end() || !less(*hint, t))
+      return hint;
+
+   // a short skip stays in this leaf or the next
+   Leaf * pLeaf = hint.pLeaf;
+   size_t iFrom = hint.i;
+   for (int numLeaves = 0; pLeaf && numLeaves < 2; numLeaves++)
+   {
+      if (!less(pLeaf->data()[pLeaf->num - 1], t))
+      {
+         const T * pData = std::lower_bound(pLeaf->data() + iFrom, pLeaf->data() + pLeaf->num, t, this->compare());
+         return iterator(pLeaf, pData - pLeaf->data());
+      }
+      pLeaf = pLeaf->pNext;
+      iFrom = 0;
+   }
+
+   return lower_bound<Key>(t);
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+template <class Key, class>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::upper_bound(const Key & t) const
+{
+   if (!root)
+      return end();
+   auto place = search(t, true /* upper */);
+   return normalize(place.first, place.second);
+}
+
+/*****************************************************
+ * B TREE :: INSERT SEARCHED
+ * Search from the root.  Keeping unique, a copy of t
+ * may start the next leaf, so look there too.
+ *    INPUT  : t, and whether to refuse a copy of
+ *             something already there
+ *    OUTPUT : where t is, and whether it was added
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class U>
+std::pair<typename btree <T, NodeBytes, Compare> ::iterator, bool> btree <T, NodeBytes, Compare> ::insertSearched(U && t, bool keepUnique)
+{
+   try
+   {
+      if (!root)
+      {
+         Leaf * pLeaf = new Leaf;
+         root = pLeaf;
+         return std::pair<iterator, bool>(insertInLeaf(pLeaf, 0, std::forward<U>(t)), true);
+      }
+
+      auto place = search(t, !keepUnique /* upper */);
+      if (keepUnique)
+      {
+         iterator it = normalize(place.first, place.second);
+         if (it != end() && !less(t, *it))
+            return std::pair<iterator, bool>(it, false);
+      }
+      return std::pair<iterator, bool>(insertInLeaf(place.first, place.second, std::forward<U>(t)), true);
+   }
+   catch (...)
+   {
+      throw "ERROR: Unable to allocate a node";
+   }
+}
+
+/*****************************************************
+ * B TREE :: INSERT HINTED
+ * If t fits just before the hint, with both neighbors
+ * in the hint's leaf (or past an end of the tree), it
+ * goes straight in without a search.  Otherwise search.
+ *    COST   : O(LEAF_MAX) with a good hint
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class U>
+std::pair<typename btree <T, NodeBytes, Compare> ::iterator, bool> btree <T, NodeBytes, Compare> ::insertHinted(iterator hint, U && t, bool keepUnique)
+{
+   Leaf * pLeaf = hint.pLeaf;
+   size_t i = hint.i;
+   if (!pLeaf && root)
+   {
+      pLeaf = lastLeaf();
+      i = pLeaf->num;
+   }
+
+   if (pLeaf)
+   {
+      bool fitsBefore = (i < pLeaf->num) ? less(t, pLeaf->data()[i]) : !pLeaf->pNext;
+      bool fitsAfter  = (i > 0) ? !less(t, pLeaf->data()[i - 1]) : !pLeaf->pPrev;
+      if (fitsBefore && fitsAfter)
+      {
+         // t is not less than the one before, so not greater means the same
+         if (keepUnique && i > 0 && !less(pLeaf->data()[i - 1], t))
+            return std::pair<iterator, bool>(iterator(pLeaf, i - 1), false);
+
+         try
+         {
+            return std::pair<iterator, bool>(insertInLeaf(pLeaf, i, std::forward<U>(t)), true);
+         }
+         catch (...)
+         {
+            throw "ERROR: Unable to allocate a node";
+         }
+      }
+   }
+
+   return insertSearched(std::forward<U>(t), keepUnique);
+}
+
+/*****************************************************
+ * B TREE :: OPEN AT, CLOSE AT, MOVE TO
+ * Shuffle the slots of a node, of which the first num
+ * hold something.  openAt puts u at i, moving the rest
+ * up into the raw slot at num; closeAt takes out i,
+ * moving the rest down and destroying the last; moveTo
+ * moves num of them into raw slots, leaving raw slots
+ * behind.
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class E, class U>
+void btree <T, NodeBytes, Compare> ::openAt(E * p, size_t num, size_t i, U && u)
+{
+   if (i == num)
+   {
+      new (static_cast<void *>(p + num)) E(std::forward<U>(u));
+      return;
+   }
+   new (static_cast<void *>(p + num)) E(std::move(p[num - 1]));
+   for (size_t k = num - 1; k > i; k--)
+      p[k] = std::move(p[k - 1]);
+   p[i] = std::forward<U>(u);
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+template <class E>
+void btree <T, NodeBytes, Compare> ::closeAt(E * p, size_t num, size_t i)
+{
+   for (size_t k = i + 1; k < num; k++)
+      p[k - 1] = std::move(p[k]);
+   p[num - 1].~E();
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+template <class E>
+void btree <T, NodeBytes, Compare> ::moveTo(E * pTo, E * pFrom, size_t num)
+{
+   for (size_t k = 0; k < num; k++)
+   {
+      new (static_cast<void *>(pTo + k)) E(std::move(pFrom[k]));
+      pFrom[k].~E();
+   }
+}
+
+/*****************************************************
+ * B TREE :: INSERT IN LEAF
+ * Put t at place i of a leaf.  A full leaf splits in
+ * half first, unless t goes past the end of the last
+ * leaf: then t starts a new leaf of its own, so that
+ * sorted input leaves full leaves behind it.
+ *    OUTPUT : where t ended up
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class U>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::insertInLeaf(Leaf * pLeaf, size_t i, U && t)
+{
+   if (pLeaf->num == LEAF_MAX)
+   {
+      Leaf * pRight = new Leaf;
+      size_t half = (i == LEAF_MAX && !pLeaf->pNext) ? LEAF_MAX : LEAF_MAX / 2;
+      moveTo(pRight->data(), pLeaf->data() + half, LEAF_MAX - half);
+      pRight->num = LEAF_MAX - half;
+      pLeaf->num = half;
+
+      // pRight goes after pLeaf in the list of leaves
+      pRight->pNext = pLeaf->pNext;
+      if (pRight->pNext)
+         pRight->pNext->pPrev = pRight;
+      pRight->pPrev = pLeaf;
+      pLeaf->pNext = pRight;
+
+      Leaf * pSplit = pLeaf;
+      if (i > half || pRight->num == 0)
+      {
+         i -= half;
+         pLeaf = pRight;
+      }
+
+      openAt(pLeaf->data(), pLeaf->num, i, std::forward<U>(t));
+      pLeaf->num++;
+      numElements++;
+
+      addToParent(pSplit, keyOf(pRight->data()[0]), pRight);
+      return iterator(pLeaf, i);
+   }
+
+   openAt(pLeaf->data(), pLeaf->num, i, std::forward<U>(t));
+   pLeaf->num++;
+   numElements++;
+   return iterator(pLeaf, i);
+}
+
+/*****************************************************
+ * B TREE :: ADD TO PARENT
+ * pRight was split off of pLeft and belongs right after
+ * it, behind key.  A full parent splits around what
+ * would be its middle key, which moves up in turn; a
+ * split root makes the tree one level taller.  The
+ * split is done in place: the new node takes the upper
+ * keys and children first, and the middle key moves
+ * out, before the lower ones shift to let key in.
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::addToParent(Node * pLeft, const Separator & key, Node * pRight)
+{
+   Inner * pParent = pLeft->pParent;
+   if (!pParent)
+   {
+      Inner * pRoot = new Inner;
+      new (static_cast<void *>(pRoot->keys())) Separator(key);
+      pRoot->children[0] = pLeft;
+      pRoot->children[1] = pRight;
+      pRoot->num = 1;
+      pLeft->pParent = pRight->pParent = pRoot;
+      root = pRoot;
+      return;
+   }
+
+   size_t j = childIndex(pParent, pLeft);
+   if (pParent->num < INNER_MAX)
+   {
+      openAt(pParent->keys(), pParent->num, j, key);
+      for (size_t k = pParent->num; k > j; k--)
+         pParent->children[k + 1] = pParent->children[k];
+      pParent->children[j + 1] = pRight;
+      pRight->pParent = pParent;
+      pParent->num++;
+      return;
+   }
+
+   // With key at j and pRight at j + 1, there would be INNER_MAX + 1
+   // keys: the first mid stay, the one at mid moves up, the rest
+   // move over.  The keys from mid on are all at or after the old
+   // keys[mid - 1], so moving them out first never loses one.
+   Separator * keys = pParent->keys();
+   Node ** children = pParent->children;
+   size_t mid = (INNER_MAX + 1) / 2;
+   Inner * pNew = new Inner;
+   for (size_t k = mid + 1; k <= INNER_MAX + 1; k++)
+   {
+      Node * pChild = (k <= j) ? children[k] : (k == j + 1 ? pRight : children[k - 1]);
+      pNew->children[k - mid - 1] = pChild;
+      pChild->pParent = pNew;
+      if (k <= INNER_MAX)
+      {
+         if (k == j)
+            new (static_cast<void *>(pNew->keys() + k - mid - 1)) Separator(key);
+         else
+            new (static_cast<void *>(pNew->keys() + k - mid - 1)) Separator(std::move(keys[k < j ? k : k - 1]));
+         pNew->num++;
+      }
+   }
+   Separator up = (mid == j) ? key : std::move(keys[mid < j ? mid : mid - 1]);
+
+   // what is left of the upper keys is moved from, so it goes, and
+   // key and pRight take their places among the lower ones
+   size_t numKept = (j < mid) ? mid - 1 : mid;
+   for (size_t k = numKept; k < INNER_MAX; k++)
+      keys[k].~Separator();
+   for (size_t k = mid + 1; k <= INNER_MAX; k++)
+      children[k] = nullptr;
+   if (j < mid)
+   {
+      openAt(keys, numKept, j, key);
+      for (size_t k = mid; k > j + 1; k--)
+         children[k] = children[k - 1];
+      children[j + 1] = pRight;
+      pRight->pParent = pParent;
+   }
+   pParent->num = mid;
+
+   addToParent(pParent, up, pNew);
+}
+
+/*****************************************************
+ * B TREE :: CHILD INDEX
+ * Which of its parent's children p is
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+size_t btree <T, NodeBytes, Compare> ::childIndex(const Inner * pParent, const Node * pChild)
+{
+   size_t j = 0;
+   while (pParent->children[j] != pChild)
+      j++;
+   return j;
+}
+
+/*****************************************************
+ * B TREE :: ERASE
+ * Take the element out of its leaf.  A leaf left less
+ * than half full borrows from or merges with a sibling.
+ *    INPUT  : where the element is
+ *    OUTPUT : the element after it
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::iterator btree <T, NodeBytes, Compare> ::erase(iterator & it)
+{
+   Leaf * pLeaf = it.pLeaf;
+   size_t i = it.i;
+   if (!pLeaf)
+      return end();
+
+   closeAt(pLeaf->data(), pLeaf->num, i);
+   pLeaf->num--;
+   numElements--;
+
+   if (pLeaf == root)
+   {
+      if (pLeaf->num == 0)
+      {
+         delete pLeaf;
+         root = nullptr;
+      }
+      return root ? normalize(pLeaf, i) : end();
+   }
+
+   if (pLeaf->num < LEAF_MIN)
+      pLeaf = fixLeaf(pLeaf, i);
+   return normalize(pLeaf, i);
+}
+
+/*****************************************************
+ * B TREE :: FIX LEAF
+ * Top up a leaf that is less than half full: take one
+ * from a sibling that can spare it, or else merge with
+ * a sibling.
+ *    INPUT  : the leaf, and a place in it
+ *    OUTPUT : the leaf now holding what was at the
+ *             place, and the place there
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::Leaf * btree <T, NodeBytes, Compare> ::fixLeaf(Leaf * pLeaf, size_t & i)
+{
+   Inner * pParent = pLeaf->pParent;
+   size_t j = childIndex(pParent, pLeaf);
+   Leaf * pLeft  = (j > 0)            ? static_cast<Leaf *>(pParent->children[j - 1]) : nullptr;
+   Leaf * pRight = (j < pParent->num) ? static_cast<Leaf *>(pParent->children[j + 1]) : nullptr;
+
+   // borrow the last of the left sibling
+   if (pLeft && pLeft->num > LEAF_MIN)
+   {
+      openAt(pLeaf->data(), pLeaf->num, 0, std::move(pLeft->data()[pLeft->num - 1]));
+      closeAt(pLeft->data(), pLeft->num, pLeft->num - 1);
+      pLeft->num--;
+      pLeaf->num++;
+      pParent->keys()[j - 1] = keyOf(pLeaf->data()[0]);
+      i++;
+      return pLeaf;
+   }
+
+   // borrow the first of the right sibling
+   if (pRight && pRight->num > LEAF_MIN)
+   {
+      openAt(pLeaf->data(), pLeaf->num, pLeaf->num, std::move(pRight->data()[0]));
+      pLeaf->num++;
+      closeAt(pRight->data(), pRight->num, 0);
+      pRight->num--;
+      pParent->keys()[j] = keyOf(pRight->data()[0]);
+      return pLeaf;
+   }
+
+   // merge: every leaf but the root has a sibling
+   if (pLeft)
+   {
+      i += pLeft->num;
+      mergeLeaves(pLeft, pLeaf, j - 1);
+      return pLeft;
+   }
+   mergeLeaves(pLeaf, pRight, j);
+   return pLeaf;
+}
+
+/*****************************************************
+ * B TREE :: MERGE LEAVES
+ * Move everything in pRight to the end of pLeft, then
+ * drop pRight and the key between them
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::mergeLeaves(Leaf * pLeft, Leaf * pRight, size_t iKey)
+{
+   moveTo(pLeft->data() + pLeft->num, pRight->data(), pRight->num);
+   pLeft->num += pRight->num;
+   pRight->num = 0;
+
+   pLeft->pNext = pRight->pNext;
+   if (pLeft->pNext)
+      pLeft->pNext->pPrev = pLeft;
+
+   Inner * pParent = pLeft->pParent;
+   delete pRight;
+   removeFromInner(pParent, iKey);
+}
+
+/*****************************************************
+ * B TREE :: REMOVE FROM INNER
+ * Drop keys[iKey] and the child after it.  An empty
+ * root gives way to its only child; any other inner
+ * node left short is fixed.
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::removeFromInner(Inner * p, size_t iKey)
+{
+   closeAt(p->keys(), p->num, iKey);
+   for (size_t k = iKey + 1; k < p->num; k++)
+      p->children[k] = p->children[k + 1];
+   p->children[p->num] = nullptr;
+   p->num--;
+
+   if (p == root)
+   {
+      if (p->num == 0)
+      {
+         root = p->children[0];
+         root->pParent = nullptr;
+         delete p;
+      }
+      return;
+   }
+
+   if (p->num < INNER_MIN)
+      fixInner(p);
+}
+
+/*****************************************************
+ * B TREE :: FIX INNER
+ * Top up an inner node with too few keys: rotate one
+ * through the parent from a sibling that can spare it,
+ * or else merge with a sibling
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::fixInner(Inner * p)
+{
+   Inner * pParent = p->pParent;
+   size_t j = childIndex(pParent, p);
+   Inner * pLeft  = (j > 0)            ? static_cast<Inner *>(pParent->children[j - 1]) : nullptr;
+   Inner * pRight = (j < pParent->num) ? static_cast<Inner *>(pParent->children[j + 1]) : nullptr;
+
+   // the parent's key comes down in front, the left's last key goes up
+   if (pLeft && pLeft->num > INNER_MIN)
+   {
+      openAt(p->keys(), p->num, 0, std::move(pParent->keys()[j - 1]));
+      for (size_t k = p->num + 1; k > 0; k--)
+         p->children[k] = p->children[k - 1];
+      p->children[0] = pLeft->children[pLeft->num];
+      p->children[0]->pParent = p;
+      p->num++;
+
+      pParent->keys()[j - 1] = std::move(pLeft->keys()[pLeft->num - 1]);
+      closeAt(pLeft->keys(), pLeft->num, pLeft->num - 1);
+      pLeft->children[pLeft->num] = nullptr;
+      pLeft->num--;
+      return;
+   }
+
+   // the parent's key comes down at the back, the right's first key goes up
+   if (pRight && pRight->num > INNER_MIN)
+   {
+      openAt(p->keys(), p->num, p->num, std::move(pParent->keys()[j]));
+      p->children[p->num + 1] = pRight->children[0];
+      p->children[p->num + 1]->pParent = p;
+      p->num++;
+
+      pParent->keys()[j] = std::move(pRight->keys()[0]);
+      closeAt(pRight->keys(), pRight->num, 0);
+      for (size_t k = 1; k <= pRight->num; k++)
+         pRight->children[k - 1] = pRight->children[k];
+      pRight->children[pRight->num] = nullptr;
+      pRight->num--;
+      return;
+   }
+
+   if (pLeft)
+      mergeInner(pLeft, p, j - 1);
+   else
+      mergeInner(p, pRight, j);
+}
+
+/*****************************************************
+ * B TREE :: MERGE INNER
+ * pLeft takes the key between them and everything in
+ * pRight, then pRight and that key leave the parent
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::mergeInner(Inner * pLeft, Inner * pRight, size_t iKey)
+{
+   Inner * pParent = pLeft->pParent;
+   openAt(pLeft->keys(), pLeft->num, pLeft->num, std::move(pParent->keys()[iKey]));
+   moveTo(pLeft->keys() + pLeft->num + 1, pRight->keys(), pRight->num);
+   for (size_t k = 0; k <= pRight->num; k++)
+   {
+      pLeft->children[pLeft->num + 1 + k] = pRight->children[k];
+      pRight->children[k]->pParent = pLeft;
+   }
+   pLeft->num += pRight->num + 1;
+   pRight->num = 0;
+
+   delete pRight;
+   removeFromInner(pParent, iKey);
+}
+
+/*****************************************************
+ * B TREE :: CLEAR and DESTROY
+ * Delete every node
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::clear() noexcept
+{
+   destroy(root);
+   root = nullptr;
+   numElements = 0;
+}
+
+template <typename T, size_t NodeBytes, class Compare>
+void btree <T, NodeBytes, Compare> ::destroy(Node * p)
+{
+   if (!p)
+      return;
+   if (p->isLeaf)
+      delete static_cast<Leaf *>(p);
+   else
+   {
+      Inner * pInner = static_cast<Inner *>(p);
+      for (size_t k = 0; k <= pInner->num; k++)
+         destroy(pInner->children[k]);
+      delete pInner;
+   }
+}
+
+/*****************************************************
+ * B TREE :: ASSIGN
+ * Replace the contents with [first, last).  Unsorted
+ * input is sorted first (stably, so keepUnique keeps
+ * the first of each run of equals).
+ *    COST   : O(n) if sorted, else O(n log n)
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class Iterator>
+void btree <T, NodeBytes, Compare> ::assign(Iterator first, Iterator last, bool keepUnique)
+{
+   std::vector<T> items;
+   bool sorted = true;
+   for (auto it = first; it != last; ++it)
+   {
+      if (!items.empty() && less(*it, items.back()))
+         sorted = false;
+      items.push_back(*it);
+   }
+   if (!sorted)
+      std::stable_sort(items.begin(), items.end(), key_comp());
+   assign(assume_sorted, std::make_move_iterator(items.begin()),
+                         std::make_move_iterator(items.end()), keepUnique);
+}
+
+/*****************************************************
+ * B TREE :: ASSIGN ASSUME SORTED
+ * Replace the contents with [first, last), which the
+ * caller promises is in order.  The leaves are filled
+ * evenly from the left, then each level of inner nodes
+ * over the one below.
+ *    COST   : O(n)
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+template <class Iterator>
+void btree <T, NodeBytes, Compare> ::assign(assume_sorted_t, Iterator first, Iterator last, bool keepUnique)
+{
+   std::vector<T> items;
+   for (auto it = first; it != last; ++it)
+      if (!keepUnique || items.empty() || less(items.back(), *it))
+         items.push_back(*it);
+
+   Node * pNew = build(items);
+   clear();
+   root = pNew;
+   numElements = items.size();
+}
+
+/*****************************************************
+ * B TREE :: BUILD
+ * Make a tree out of sorted items, moving them in
+ *    OUTPUT : the new root, or null if there are none
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+typename btree <T, NodeBytes, Compare> ::Node * btree <T, NodeBytes, Compare> ::build(std::vector<T> & items)
+{
+   if (items.empty())
+      return nullptr;
+
+   std::vector<Node *> level;     // the nodes of the level being built
+   std::vector<const T *> lows;   // the first element under each
+   std::vector<Node *> made;      // every node, in case we fail part way
+   try
+   {
+      // the leaves, as evenly filled as they can be
+      size_t numLeaves = (items.size() + LEAF_MAX - 1) / LEAF_MAX;
+      size_t iItem = 0;
+      Leaf * pPrev = nullptr;
+      for (size_t k = 0; k < numLeaves; k++)
+      {
+         made.reserve(made.size() + 1);
+         Leaf * pLeaf = new Leaf;
+         made.push_back(pLeaf);
+         level.push_back(pLeaf);
+         size_t num = items.size() / numLeaves + (k < items.size() % numLeaves ? 1 : 0);
+         for (; pLeaf->num < num; pLeaf->num++)
+            new (static_cast<void *>(pLeaf->data() + pLeaf->num)) T(std::move(items[iItem++]));
+         pLeaf->pPrev = pPrev;
+         if (pPrev)
+            pPrev->pNext = pLeaf;
+         pPrev = pLeaf;
+         lows.push_back(pLeaf->data());
+      }
+
+      // inner levels until one node is left
+      while (level.size() > 1)
+      {
+         std::vector<Node *> above;
+         std::vector<const T *> aboveLows;
+         size_t numInner = (level.size() + INNER_MAX) / (INNER_MAX + 1);
+         size_t iChild = 0;
+         for (size_t k = 0; k < numInner; k++)
+         {
+            made.reserve(made.size() + 1);
+            Inner * pInner = new Inner;
+            made.push_back(pInner);
+            above.push_back(pInner);
+            aboveLows.push_back(lows[iChild]);
+            size_t num = level.size() / numInner + (k < level.size() % numInner ? 1 : 0);
+            for (size_t j = 0; j < num; j++, iChild++)
+            {
+               if (j > 0)
+               {
+                  new (static_cast<void *>(pInner->keys() + j - 1)) Separator(keyOf(*lows[iChild]));
+                  pInner->num = j;
+               }
+               pInner->children[j] = level[iChild];
+               level[iChild]->pParent = pInner;
+            }
+         }
+         level.swap(above);
+         lows.swap(aboveLows);
+      }
+   }
+   catch (...)
+   {
+      for (auto p : made)
+         if (p->isLeaf)
+            delete static_cast<Leaf *>(p);
+         else
+            delete static_cast<Inner *>(p);
+      throw "ERROR: Unable to allocate a node";
+   }
+
+   return level[0];
+}
+
+/*****************************************************
+ * SWAP
+ * Stand-alone btree swap
+ ****************************************************/
+template <typename T, size_t NodeBytes, class Compare>
+void swap(btree <T, NodeBytes, Compare> & lhs, btree <T, NodeBytes, Compare> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
@@ -0,0 +1,481 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT SET
+ * Summary:
+ *    An ordered set whose every version lives on.  A change never
+ *    touches a node: it copies the path from the root down to the
+ *    change and shares everything else with the version before.
+ *    Nodes count the versions and parents that point at them, and
+ *    go away with the last one.  So a snapshot is one more count on
+ *    the root, O(1), and an update makes O(log n) new nodes.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        persistent_set           : A set with O(1) snapshots
+ *        persistent_set::iterator : An in-order iterator through one
+ * Authors
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <atomic>     // for std::atomic
+#include <cstdint>    // for uint32_t
+#include <functional> // for std::less
+#include <vector>     // for the iterator's path
+#include <utility>    // for std::swap
+#include <initializer_list>
+#include "bst.h"      // for compare_holder and is_transparent
+
+class TestPersistentMap; // forward declaration for unit tests
+class TestSet;
+
+namespace custom
+{
+
+/*****************************************************************
+ * PERSISTENT SET
+ * A treap of shared, never-changing nodes.  Each persistent_set
+ * object is one version: copying it, or calling snapshot(), makes
+ * another in O(1), and changing either leaves the other alone.
+ * Different versions may be used by different threads at once;
+ * one version, like any container, by one thread at a time.
+ *****************************************************************/
+template <typename T, class Compare = std::less<T> >
+class persistent_set : private compare_holder<Compare>
+{
+   friend class ::TestPersistentMap; // give unit tests access to the privates
+   friend class ::TestSet;
+
+   template <class KK, class VV, class CC>
+   friend class persistent_map;
+
+   struct Node;
+
+public:
+   //
+   // Construct: a copy shares every node with the original
+   //
+   explicit persistent_set(const Compare & comp = Compare())
+      : compare_holder<Compare>(comp), root(nullptr), numElements(0), seed(2463534242u) { }
+   persistent_set(const persistent_set & rhs)
+      : compare_holder<Compare>(rhs), root(retain(rhs.root)),
+        numElements(rhs.numElements), seed(rhs.seed) { }
+   persistent_set(persistent_set && rhs) : persistent_set(rhs.key_comp()) { swap(rhs); }
+   persistent_set(const std::initializer_list<T> & il) : persistent_set()
+   {
+      for (auto && t : il)
+         insert(t);
+   }
+  ~persistent_set() { release(root); }
+
+   //
+   // Assign
+   //
+   persistent_set & operator = (const persistent_set & rhs)
+   {
+      persistent_set copy(rhs);
+      swap(copy);
+      return *this;
+   }
+   persistent_set & operator = (persistent_set && rhs)
+   {
+      clear();
+      swap(rhs);
+      return *this;
+   }
+   void swap(persistent_set & rhs)
+   {
+      std::swap(root, rhs.root);
+      std::swap(numElements, rhs.numElements);
+      std::swap(seed, rhs.seed);
+      std::swap(static_cast<compare_holder<Compare> &>(*this),
+                static_cast<compare_holder<Compare> &>(rhs));
+   }
+
+   //
+   // Snapshot: this version, which later changes will not disturb
+   //
+   persistent_set snapshot() const { return *this; }
+
+   //
+   // Iterator: valid while the version it came from is unchanged
+   //
+   class iterator;
+   iterator begin() const { return iterator(root); }
+   iterator end()   const { return iterator(); }
+
+   //
+   // Access: each takes a T, or anything Compare is transparent to
+   //
+   template <class Key>
+   using Lookup = typename std::enable_if<std::is_same<Key, T>::value ||
+                                          is_transparent<Compare>::value>::type;
+
+   iterator find(const T & t) const { return find<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   iterator find(const Key & k) const;
+
+   bool contains(const T & t) const { return lookup(t) != nullptr; }
+   template <class Key, class = Lookup<Key> >
+   bool contains(const Key & k) const { return lookup(k) != nullptr; }
+
+   //
+   // Insert and Remove: each makes a new version of O(log n) nodes
+   //
+   bool insert(const T & t) { return write(t, false /* overwrite */); }
+   bool erase(const T & t)  { return erase<T>(t); }
+   template <class Key, class = Lookup<Key> >
+   bool erase(const Key & k);
+   void clear() noexcept
+   {
+      release(root);
+      root = nullptr;
+      numElements = 0;
+   }
+
+   //
+   // Status
+   //
+   bool empty()  const noexcept { return !numElements; }
+   size_t size() const noexcept { return numElements; }
+   Compare key_comp() const     { return this->compare(); }
+
+private:
+   // the node holding k, without the iterator's path
+   template <class Key>
+   const Node * lookup(const Key & k) const;
+
+   // t replaces an equivalent element when overwrite is set
+   bool write(const T & t, bool overwrite);
+
+   Node * insertCopy(Node * p, const T & t, bool overwrite, bool & changed, bool & added);
+   template <class Key>
+   Node * eraseCopy(Node * p, const Key & k, bool & changed);
+   Node * merge(Node * pLeft, Node * pRight);
+   static Node * make(const T & t, uint32_t priority, Node * pLeft, Node * pRight);
+   static Node * retain(Node * p);
+   static void release(Node * p);
+
+   template <class A, class B>
+   bool less(const A & lhs, const B & rhs) const { return this->compare()(lhs, rhs); }
+
+   Node * root;          // this version; shared with others, never changed
+   size_t numElements;   // number of elements in this version
+   uint32_t seed;        // for treap priorities
+};
+
+/*****************************************************************
+ * PERSISTENT SET NODE
+ * Never changed once another node or version points at it
+ *****************************************************************/
+template <typename T, class Compare>
+struct persistent_set <T, Compare> :: Node
+{
+   Node(const T & t, uint32_t priority, Node * pLeft, Node * pRight) :
+      data(t), priority(priority), pLeft(pLeft), pRight(pRight), refs(1) { }
+   T data;
+   uint32_t priority;          // never less than the children's
+   Node * pLeft;               // each child holds one of its refs
+   Node * pRight;
+   std::atomic<size_t> refs;   // parents and versions pointing here
+};
+
+/*****************************************************************
+ * PERSISTENT SET ITERATOR
+ * Nodes have no parent pointers, since a node may have many
+ * parents, so the path down is kept on a stack
+ *****************************************************************/
+template <typename T, class Compare>
+class persistent_set <T, Compare> :: iterator
+{
+   friend class persistent_set <T, Compare>;
+public:
+   iterator() { }
+   iterator(const Node * pRoot) { pushLeft(pRoot); }
+
+   bool operator == (const iterator & rhs) const { return path == rhs.path; }
+   bool operator != (const iterator & rhs) const { return path != rhs.path; }
+
+   const T & operator * () const { return path.back()->data; }
+
+   iterator & operator ++ ()
+   {
+      const Node * p = path.back();
+      path.pop_back();
+      pushLeft(p->pRight);
+      return *this;
+   }
+   iterator operator ++ (int)
+   {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+   }
+
+private:
+   void pushLeft(const Node * p)
+   {
+      for (; p; p = p->pLeft)
+         path.push_back(p);
+   }
+   std::vector<const Node *> path;   // empty at end()
+};
+
+/*****************************************************
+ * PERSISTENT SET :: FIND
+ * The path to k, so the iterator can carry on from it
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Compare>
+template <class Key, class>
+typename persistent_set <T, Compare> ::iterator persistent_set <T, Compare> ::find(const Key & k) const
+{
+   iterator it;
+   for (const Node * p = root; p; )
+   {
+      if (less(k, p->data))
+      {
+         it.path.push_back(p);
+         p = p->pLeft;
+      }
+      else if (less(p->data, k))
+         p = p->pRight;
+      else
+      {
+         it.path.push_back(p);
+         return it;
+      }
+   }
+   return end();
+}
+
+/*****************************************************
+ * PERSISTENT SET :: LOOKUP
+ * Like find, but with no path to allocate
+ *    OUTPUT : the node holding k, or null
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Compare>
+template <class Key>
+const typename persistent_set <T, Compare> ::Node * persistent_set <T, Compare> ::lookup(const Key & k) const
+{
+   const Node * p = root;
+   while (p)
+   {
+      bool toLeft = less(k, p->data);
+      if (!toLeft & !less(p->data, k))
+         break;
+      p = toLeft ? p->pLeft : p->pRight;
+   }
+   return p;
+}
+
+/*****************************************************
+ * PERSISTENT SET :: WRITE
+ * Put t in a new version made beside this one, then
+ * let go of this one
+ *    OUTPUT : whether t was added
+ *    COST   : O(log n) time and new nodes
+ ****************************************************/
+template <typename T, class Compare>
+bool persistent_set <T, Compare> ::write(const T & t, bool overwrite)
+{
+   bool changed = false;
+   bool added = false;
+   Node * pNew = insertCopy(root, t, overwrite, changed, added);
+   if (changed)
+   {
+      release(root);
+      root = pNew;
+   }
+   if (added)
+      numElements++;
+   return added;
+}
+
+/*****************************************************
+ * PERSISTENT SET :: ERASE
+ *    OUTPUT : whether k was there
+ *    COST   : O(log n) time and new nodes
+ ****************************************************/
+template <typename T, class Compare>
+template <class Key, class>
+bool persistent_set <T, Compare> ::erase(const Key & k)
+{
+   bool changed = false;
+   Node * pNew = eraseCopy(root, k, changed);
+   if (changed)
+   {
+      release(root);
+      root = pNew;
+      numElements--;
+   }
+   return changed;
+}
+
+/*****************************************************
+ * PERSISTENT SET :: INSERT COPY
+ * Copy the path down to t and put t there, then rotate
+ * the new node up while it outranks its parent.  Only
+ * the new nodes are rotated, and nobody else has seen
+ * them yet.
+ *    OUTPUT : the new subtree, which the caller owns,
+ *             or null if nothing changed
+ ****************************************************/
+template <typename T, class Compare>
+typename persistent_set <T, Compare> ::Node * persistent_set <T, Compare> ::insertCopy(Node * p, const T & t, bool overwrite, bool & changed, bool & added)
+{
+   if (!p)
+   {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      changed = added = true;
+      return make(t, seed, nullptr, nullptr);
+   }
+
+   if (less(t, p->data))
+   {
+      Node * pLeft = insertCopy(p->pLeft, t, overwrite, changed, added);
+      if (!changed)
+         return nullptr;
+      Node * pCopy = make(p->data, p->priority, pLeft, retain(p->pRight));
+      if (pLeft->priority <= pCopy->priority)
+         return pCopy;
+
+      // rotate right: both nodes are new
+      pCopy->pLeft = pLeft->pRight;
+      pLeft->pRight = pCopy;
+      return pLeft;
+   }
+
+   if (less(p->data, t))
+   {
+      Node * pRight = insertCopy(p->pRight, t, overwrite, changed, added);
+      if (!changed)
+         return nullptr;
+      Node * pCopy = make(p->data, p->priority, retain(p->pLeft), pRight);
+      if (pRight->priority <= pCopy->priority)
+         return pCopy;
+
+      // rotate left: both nodes are new
+      pCopy->pRight = pRight->pLeft;
+      pRight->pLeft = pCopy;
+      return pRight;
+   }
+
+   // already here
+   if (!overwrite)
+      return nullptr;
+   changed = true;
+   return make(t, p->priority, retain(p->pLeft), retain(p->pRight));
+}
+
+/*****************************************************
+ * PERSISTENT SET :: ERASE COPY
+ * Copy the path down to k, and put the merge of its
+ * children where it was
+ *    OUTPUT : the new subtree, which the caller owns,
+ *             or null if k is not here
+ ****************************************************/
+template <typename T, class Compare>
+template <class Key>
+typename persistent_set <T, Compare> ::Node * persistent_set <T, Compare> ::eraseCopy(Node * p, const Key & k, bool & changed)
+{
+   if (!p)
+      return nullptr;
+
+   if (less(k, p->data))
+   {
+      Node * pLeft = eraseCopy(p->pLeft, k, changed);
+      return changed ? make(p->data, p->priority, pLeft, retain(p->pRight)) : nullptr;
+   }
+   if (less(p->data, k))
+   {
+      Node * pRight = eraseCopy(p->pRight, k, changed);
+      return changed ? make(p->data, p->priority, retain(p->pLeft), pRight) : nullptr;
+   }
+
+   changed = true;
+   return merge(p->pLeft, p->pRight);
+}
+
+/*****************************************************
+ * PERSISTENT SET :: MERGE
+ * Join two treaps, everything in pLeft before everything
+ * in pRight, copying the spines that meet
+ *    OUTPUT : the joined treap, which the caller owns
+ ****************************************************/
+template <typename T, class Compare>
+typename persistent_set <T, Compare> ::Node * persistent_set <T, Compare> ::merge(Node * pLeft, Node * pRight)
+{
+   if (!pLeft)
+      return retain(pRight);
+   if (!pRight)
+      return retain(pLeft);
+
+   // merge first: if it throws, nothing has been retained yet
+   if (pLeft->priority > pRight->priority)
+   {
+      Node * pMerged = merge(pLeft->pRight, pRight);
+      return make(pLeft->data, pLeft->priority, retain(pLeft->pLeft), pMerged);
+   }
+   Node * pMerged = merge(pLeft, pRight->pLeft);
+   return make(pRight->data, pRight->priority, pMerged, retain(pRight->pRight));
+}
+
+/*****************************************************
+ * PERSISTENT SET :: MAKE
+ * A new node that takes over one ref to each child.
+ * If it cannot be made, those refs are let go.
+ ****************************************************/
+template <typename T, class Compare>
+typename persistent_set <T, Compare> ::Node * persistent_set <T, Compare> ::make(const T & t, uint32_t priority, Node * pLeft, Node * pRight)
+{
+   try
+   {
+      return new Node(t, priority, pLeft, pRight);
+   }
+   catch (...)
+   {
+      release(pLeft);
+      release(pRight);
+      throw "ERROR: Unable to allocate a node";
+   }
+}
+
+/*****************************************************
+ * PERSISTENT SET :: RETAIN and RELEASE
+ * One more, or one fewer, pointer to p.  The last
+ * release frees p and lets go of its children.
+ ****************************************************/
+template <typename T, class Compare>
+typename persistent_set <T, Compare> ::Node * persistent_set <T, Compare> ::retain(Node * p)
+{
+   if (p)
+      p->refs.fetch_add(1, std::memory_order_relaxed);
+   return p;
+}
+
+template <typename T, class Compare>
+void persistent_set <T, Compare> ::release(Node * p)
+{
+   while (p && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+   {
+      Node * pRight = p->pRight;
+      release(p->pLeft);
+      delete p;
+      p = pRight;   // loop rather than recurse down the right
+   }
+}
+
+} // namespace custom
@@ -12,6 +12,7 @@
  *    This will contain the class definition of:
  *        set                 : A class that represents a Set
  *        set::iterator       : An iterator through Set
+ *        frozen_set          : A read-only snapshot, from set::freeze()
  * Authors
  *    Hunter Powell
  *    Carol Mercau
@@ -23,8 +24,11 @@
 #include <cassert>
 #include <iostream>
 #include "bst.h"
+#include "btree.h"  // for btree_layout
+#include "frozenSet.h"
 #include <memory>     // for std::allocator
 #include <functional> // for std::less
+#include <vector>     // for the elements a set operation keeps
 
 class TestSet;        // forward declaration for unit tests
 
@@ -33,9 +37,14 @@ namespace custom
 
 /************************************************
  * SET
- * A class that represents a Set
+ * A class that represents a Set.  Balance picks how the
+ * underlying BST keeps itself short: red_black, avl,
+ * treap, splay, or unbalanced.  btree_layout<> keeps
+ * the elements in a B+ tree instead: far fewer pointers
+ * and cache misses, but no nth() or rank().  Compare
+ * orders the elements, as it does for std::set.
  ***********************************************/
-template <typename T>
+template <typename T, class Balance = red_black, class Compare = std::less<T> >
 class set
 {
    friend class ::TestSet; // give unit tests access to the privates
@@ -45,12 +54,19 @@ public:
    // Construct
    //
    set() { }
+   explicit set(const Compare & comp) : bst(comp) { }
    set(const set & rhs) : bst(rhs.bst) { }
    set(set && rhs) : bst(std::move(rhs.bst)) { }
-   set(const std::initializer_list <T> & il) { insert(il); }
+   set(const std::initializer_list <T> & il) { *this = il; }
    
+   // a sorted range loads in O(n); say assume_sorted to skip the check
    template <class Iterator>
-   set(Iterator first, Iterator last) { insert(first, last); }
+   set(Iterator first, Iterator last) { bst.assign(first, last, true /* keep unique */); }
+   template <class Iterator>
+   set(assume_sorted_t, Iterator first, Iterator last)
+   {
+      bst.assign(assume_sorted, first, last, true /* keep unique */);
+   }
 
   ~set() { }
 
@@ -71,7 +87,7 @@ public:
 
    set & operator = (const std::initializer_list <T> & il)
    {
-      bst = il;
+      bst.assign(il.begin(), il.end(), true /* keep unique */);
       return *this;
    }
 
@@ -96,12 +112,79 @@ public:
    }
 
    //
-   // Access
+   // Access: each also takes anything Compare is transparent to,
+   // such as std::less<>, without building a T to compare against
    //
+   template <class Key>
+   using KeyOnly = typename std::enable_if<!std::is_same<Key, T>::value &&
+                                           is_transparent<Compare>::value>::type;
+
    iterator find(const T & t) 
    { 
       return bst.find(t); 
    }
+   template <class Key, class = KeyOnly<Key> >
+   iterator find(const Key & k)
+   {
+      return bst.find(k);
+   }
+
+   iterator lower_bound(const T & t) const
+   {
+      return bst.lower_bound(t);
+   }
+   template <class Key, class = KeyOnly<Key> >
+   iterator lower_bound(const Key & k) const
+   {
+      return bst.lower_bound(k);
+   }
+
+   iterator upper_bound(const T & t) const
+   {
+      return bst.upper_bound(t);
+   }
+   template <class Key, class = KeyOnly<Key> >
+   iterator upper_bound(const Key & k) const
+   {
+      return bst.upper_bound(k);
+   }
+
+   std::pair<iterator, iterator> equal_range(const T & t) const
+   {
+      return std::pair<iterator, iterator>(lower_bound(t), upper_bound(t));
+   }
+   template <class Key, class = KeyOnly<Key> >
+   std::pair<iterator, iterator> equal_range(const Key & k) const
+   {
+      return std::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+   }
+
+   //
+   // Order Statistics: O(log n), so percentiles need no walk
+   //
+   iterator nth(size_t k) const
+   {
+      return bst.nth(k);
+   }
+
+   size_t rank(const T & t) const
+   {
+      return bst.rank(t);
+   }
+
+   //
+   // Freeze: a read-only copy laid out for fast lookups.  The set
+   // itself is untouched and may keep changing.
+   //
+   frozen_set <T, Compare> freeze() const
+   {
+      return frozen_set <T, Compare> (begin(), end(), size(), bst.key_comp());
+   }
+
+   Compare key_comp() const
+   {
+      return bst.key_comp();
+   }
 
    //
    // Status
@@ -129,17 +212,33 @@ public:
       return bst.insert(std::move(t), true /* keep unique */);
    }
 
+   // O(1) when t belongs just before hint, or just after the last insert
+   iterator insert(iterator hint, const T & t)
+   {
+      return bst.insert(hint.it, t, true /* keep unique */).first;
+   }
+
+   iterator insert(iterator hint, T && t)
+   {
+      return bst.insert(hint.it, std::move(t), true /* keep unique */).first;
+   }
+
+   template <class ... Args>
+   iterator emplace_hint(iterator hint, Args && ... args)
+   {
+      return insert(hint, T(std::forward<Args>(args)...));
+   }
+
    void insert(const std::initializer_list <T> & il)
    {
-      for (auto && t : il)
-         bst.insert(t, true /* keep unique */);
+      bst.insert(il.begin(), il.end(), true /* keep unique */);
    }
    
+   // a sorted range is merged in and bulk loaded
    template <class Iterator>
    void insert(Iterator first, Iterator last)
    {
-      for (auto it = first; it != last; it++)
-         bst.insert(*it, true /* keep unique */);
+      bst.insert(first, last, true /* keep unique */);
    }
 
    //
@@ -178,9 +277,57 @@ public:
       return it;
    }
 
+   //
+   // Split and Join: O(log n) however many elements change hands,
+   // with the BST layouts.  Cutting out a range is two splits and
+   // a join.
+   //
+   set split(const T & t)   // what is not less than t moves to the result
+   {
+      set rest(key_comp());
+      rest.bst = bst.split(t);
+      return rest;
+   }
+
+   template <class Key, class = KeyOnly<Key> >
+   set split(const Key & k)
+   {
+      set rest(key_comp());
+      rest.bst = bst.split(k);
+      return rest;
+   }
+
+   void join(set & rhs)     // all of rhs, which comes after all of this, moves here
+   {
+      bst.join(rhs.bst, true /* keep unique */);
+   }
+
+   //
+   // Set Algebra: one merge of the two in order, and a bulk load
+   // of the result.  Where both have an element, lhs's is kept.
+   //
+   friend set set_union(const set & lhs, const set & rhs)
+   {
+      return combine(lhs, rhs, true /* left */, true /* both */, true /* right */);
+   }
+   friend set set_intersection(const set & lhs, const set & rhs)
+   {
+      return combine(lhs, rhs, false /* left */, true /* both */, false /* right */);
+   }
+   friend set set_difference(const set & lhs, const set & rhs)
+   {
+      return combine(lhs, rhs, true /* left */, false /* both */, false /* right */);
+   }
+   friend set set_symmetric_difference(const set & lhs, const set & rhs)
+   {
+      return combine(lhs, rhs, true /* left */, false /* both */, true /* right */);
+   }
+
 private:
-   
-   custom::BST <T> bst;
+   // the elements only in lhs, in both, and only in rhs, as asked
+   static set combine(const set & lhs, const set & rhs, bool keepLeft, bool keepBoth, bool keepRight);
+
+   typename tree_for <T, Balance, Compare> ::type bst;
 };
 
 
@@ -188,17 +335,17 @@ private:
  * SET ITERATOR
  * An iterator through Set
  *************************************************/
-template <typename T>
-class set <T> :: iterator
+template <typename T, class Balance, class Compare>
+class set <T, Balance, Compare> :: iterator
 {
    friend class ::TestSet; // give unit tests access to the privates
-   friend class custom::set<T>;
+   friend class custom::set<T, Balance, Compare>;
 
 public:
    // constructors, destructors, and assignment operator
    iterator() { }
 
-   iterator(const typename custom::BST<T>::iterator & it) { this->it = it; }
+   iterator(const typename tree_for <T, Balance, Compare> ::type::iterator & it) { this->it = it; }
 
    iterator(const iterator & rhs) { it = rhs.it; }
 
@@ -254,24 +401,30 @@ public:
       it--;
       return tmp;
    }
+
+   // steps from first to last without visiting each one
+   friend std::ptrdiff_t distance(const iterator & first, const iterator & last)
+   {
+      return distance(first.it, last.it);
+   }
    
 private:
 
-   typename custom::BST<T>::iterator it;
+   typename tree_for <T, Balance, Compare> ::type::iterator it;
 };
 
 /***********************************************
  * SET : EQUIVALENCE
  * See if two sets are the same size
  ***********************************************/
-template <typename T>
-bool operator == (const set <T> & lhs, const set <T> & rhs)
+template <typename T, class Balance, class Compare>
+bool operator == (const set <T, Balance, Compare> & lhs, const set <T, Balance, Compare> & rhs)
 {
    return lhs.size() == rhs.size();
 }
 
-template <typename T>
-inline bool operator != (const set <T> & lhs, const set <T> & rhs)
+template <typename T, class Balance, class Compare>
+inline bool operator != (const set <T, Balance, Compare> & lhs, const set <T, Balance, Compare> & rhs)
 {
    return lhs.size() != rhs.size();
 }
@@ -280,16 +433,88 @@ inline bool operator != (const set <T> & lhs, const set <T> & rhs)
  * SET : RELATIVE COMPARISON
  * See if one set is lexicographically before the second
  ***********************************************/
-template <typename T>
-bool operator < (const set <T> & lhs, const set <T> & rhs)
+template <typename T, class Balance, class Compare>
+bool operator < (const set <T, Balance, Compare> & lhs, const set <T, Balance, Compare> & rhs)
 {
    return lhs.size() < rhs.size();
 }
 
-template <typename T>
-inline bool operator > (const set <T> & lhs, const set <T> & rhs)
+template <typename T, class Balance, class Compare>
+inline bool operator > (const set <T, Balance, Compare> & lhs, const set <T, Balance, Compare> & rhs)
 {
    return lhs.size() > rhs.size();
 }
 
+/*****************************************************
+ * SET : COMBINE
+ * Walk the smaller set one element at a time, and
+ * the larger up to each of those.  When the larger is
+ * much larger it jumps there with a finger search,
+ * so a run it skips costs O(log run), not O(run).
+ * What is kept is gathered as pointers, in order,
+ * and copied once, into a balanced tree.
+ *    COST   : O(n + m); or O(m log(n / m)) compares
+ *             plus the size of the result when n is
+ *             far more than m
+ ****************************************************/
+template <typename T, class Balance, class Compare>
+set <T, Balance, Compare> set <T, Balance, Compare> ::combine(const set & lhs, const set & rhs, bool keepLeft, bool keepBoth, bool keepRight)
+{
+   // below this ratio, stepping is cheaper than the search
+   const size_t GALLOP_RATIO = 8;
+
+   bool leftSmaller = lhs.size() <= rhs.size();
+   const set & smaller = leftSmaller ? lhs : rhs;
+   const set & larger = leftSmaller ? rhs : lhs;
+   bool keepSmaller = leftSmaller ? keepLeft : keepRight;
+   bool keepLarger = leftSmaller ? keepRight : keepLeft;
+   bool gallop = larger.size() / (smaller.size() + 1) >= GALLOP_RATIO;
+   Compare comp = lhs.key_comp();
+
+   std::vector<const T *> kept;
+   kept.reserve((keepSmaller || keepBoth ? smaller.size() : 0) + (keepLarger ? larger.size() : 0));
+
+   auto itLarger = larger.bst.begin();
+   auto itLargerEnd = larger.bst.end();
+   for (auto it = smaller.bst.begin(); it != smaller.bst.end(); ++it)
+   {
+      // what the larger has before *it, only it has
+      auto itBound = itLarger;
+      if (gallop)
+         itBound = larger.bst.lower_bound(itLarger, *it);
+      else
+         while (itBound != itLargerEnd && comp(*itBound, *it))
+            ++itBound;
+      if (keepLarger)
+         for (; itLarger != itBound; ++itLarger)
+            kept.push_back(&*itLarger);
+      itLarger = itBound;
+
+      if (itLarger != itLargerEnd && !comp(*it, *itLarger))
+      {
+         if (keepBoth)
+            kept.push_back(leftSmaller ? &*it : &*itLarger);
+         ++itLarger;
+      }
+      else if (keepSmaller)
+         kept.push_back(&*it);
+   }
+   if (keepLarger)
+      for (; itLarger != itLargerEnd; ++itLarger)
+         kept.push_back(&*itLarger);
+
+   // a bulk load takes anything that steps and gives a T
+   struct Pointee
+   {
+      typename std::vector<const T *>::const_iterator it;
+      const T & operator * () const { return **it; }
+      Pointee & operator ++ () { ++it; return *this; }
+      bool operator == (const Pointee & rhs) const { return it == rhs.it; }
+      bool operator != (const Pointee & rhs) const { return it != rhs.it; }
+   };
+   set result(comp);
+   result.bst.assign(assume_sorted, Pointee{ kept.cbegin() }, Pointee{ kept.cend() });
+   return result;
+}
+
 }; // namespace custom
@@ -20,11 +20,13 @@
 #include <iostream>
 #include <string>
 #include <functional> // for std::less and std::greater
+#include <algorithm>  // for std::sort and std::reverse
+#include <vector>
 
- /***********************************************
-  * TEST BST
-  * Unit tests for the BST class
-  ***********************************************/
+/***********************************************
+ * TEST BST
+ * Unit tests for the BST class
+ ***********************************************/
 class TestBST : public UnitTest
 {
 
@@ -37,6 +39,7 @@ public:
       test_construct_default();
       test_constructCopy_empty();
       test_constructCopy_one();
+
       test_constructCopy_standard();
       test_constructMove_empty();
       test_constructMove_one();
@@ -107,6 +110,87 @@ public:
       test_size_empty();
       test_size_standard();
 
+      // Threaded
+      test_threaded_nodeSize();
+      test_threaded_insertAscending();
+      test_threaded_insertRandom();
+      test_threaded_erase();
+      test_threaded_copy();
+      test_threaded_move();
+      test_threaded_balanced();
+
+      // Red-Black
+      test_redBlack_insertOne();
+      test_redBlack_insertOutside();
+      test_redBlack_insertInside();
+      test_redBlack_insertRedAunt();
+      test_redBlack_insertSorted();
+      test_redBlack_insertReverse();
+      test_redBlack_insertRandom();
+      test_redBlack_eraseOnly();
+      test_redBlack_eraseAll();
+      test_redBlack_eraseRandom();
+      test_redBlack_copy();
+
+      // Balancing Policies
+      test_policy_unbalancedSorted();
+      test_policy_avlInsertSorted();
+      test_policy_avlEraseRandom();
+      test_policy_treapInsertSorted();
+      test_policy_treapEraseRandom();
+      test_policy_splayInsert();
+      test_policy_splayFind();
+      test_policy_splayErase();
+      test_policy_copy();
+      test_policy_threaded();
+
+      // Bulk Load
+      test_bulk_sortedStandard();
+      test_bulk_assumeSorted();
+      test_bulk_sortedLarge();
+      test_bulk_unsorted();
+      test_bulk_keepUnique();
+      test_bulk_replace();
+      test_bulk_policies();
+      test_bulk_initializerSorted();
+      test_bulk_initializerUnbalanced();
+      test_bulk_insertMerge();
+      test_bulk_insertFew();
+
+      // Order Statistics
+      test_order_sizesPolicies();
+      test_order_sizesBulkAndCopy();
+      test_order_nth();
+      test_order_rank();
+      test_order_distance();
+
+      // Bounds
+      test_bound_empty();
+      test_bound_lower();
+      test_bound_upper();
+      test_bound_equalRange();
+      test_bound_fromHint();
+
+      // Hinted Insert
+      test_hint_appendEnd();
+      test_hint_correct();
+      test_hint_wrong();
+      test_hint_keepUnique();
+      test_hint_afterErase();
+      test_hint_invariants();
+
+      // Split and Join
+      test_split_empty();
+      test_split_standard();
+      test_split_noCopies();
+      test_split_policies();
+      test_split_threaded();
+      test_join_emptySides();
+      test_join_uneven();
+      test_join_overlap();
+      test_join_keepUnique();
+      test_join_policies();
+
       report("BST");
    }
    
@@ -294,10 +378,10 @@ public:
       // exercise
       custom::BST <Spy> bstDest(std::move(bstSrc));
       // verify
-      assertUnit(Spy::numCopy() == 0);     
-      assertUnit(Spy::numAlloc() == 0);     
+      assertUnit(Spy::numCopy() == 0);      // returns 1
+      assertUnit(Spy::numAlloc() == 0);     // returns 1
       assertUnit(Spy::numDefault() == 0);
-      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDelete() == 0);    // returns 1
       assertUnit(Spy::numNondefault() == 0);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -311,7 +395,7 @@ public:
       assertUnit(bstSrc.root == nullptr);
       //            (50)
       assertUnit(bstDest.numElements == 1);
-      assertUnit(bstDest.root == p50);
+      assertUnit(bstDest.root == p50);      // assert catches
       assertUnit(bstDest.root != nullptr);
       if (bstDest.root)
       {
@@ -405,7 +489,7 @@ public:
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numEquals() == 0);
-      assertUnit(Spy::numLessthan() == 10);
+      assertUnit(Spy::numLessthan() == 11);   // one to see il is not sorted
       assertStandardFixture(bstDest);
       // teardown
       teardownStandardFixture(bstDest);
@@ -1041,7 +1125,7 @@ public:
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numEquals() == 0);
-      assertUnit(Spy::numLessthan() == 10);
+      assertUnit(Spy::numLessthan() == 11);   // one to see il is not sorted
       //                (50) = bstDest
       //          +-------+-------+
       //        (30)            (70)
@@ -2475,6 +2559,1527 @@ public:
       bst.root = nullptr;
    }
 
+   /***************************************
+    * THREADED
+    ***************************************/
+
+   // only a threaded tree pays for the links
+   void test_threaded_nodeSize()
+   {  // setup
+      typedef custom::BST <int>       ::BNode Plain;
+      typedef custom::BST <int, custom::red_black, true> ::BNode Threaded;
+      // verify
+      assertUnit(sizeof(Threaded) == sizeof(Plain) + 2 * sizeof(Threaded *));
+   }  // teardown
+
+   // ascending input makes the longest walks up for an unthreaded tree
+   void test_threaded_insertAscending()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bst;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         bst.insert(i);
+      // verify
+      assertUnit(threadsMatch(bst));
+      int expected = 0;
+      for (auto it = bst.begin(); it != bst.end(); ++it)
+         assertUnit(*it == expected++);
+      assertUnit(expected == 100);
+      assertUnit(bst.begin().pNode->pPrev == nullptr);
+   }  // teardown
+
+   // forward and backward, duplicates included
+   void test_threaded_insertRandom()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bst;
+      std::vector<int> values;
+      unsigned int seed = 35;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)(seed >> 16) % 300);
+         bst.insert(values.back());
+      }
+      // verify
+      std::sort(values.begin(), values.end());
+      assertUnit(threadsMatch(bst));
+      std::vector<int> forward = valuesOf(bst);
+      assertUnit(forward == values);
+      auto it = bst.begin();
+      for (size_t i = 1; i < values.size(); i++)
+         ++it;
+      std::vector<int> backward;
+      for (; it != bst.end(); --it)
+         backward.push_back(*it);
+      std::reverse(backward.begin(), backward.end());
+      assertUnit(backward == values);
+   }  // teardown
+
+   // leaves, single children and double children all come out of the thread
+   void test_threaded_erase()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bst;
+      for (int value : { 50, 30, 70, 20, 40, 60, 80, 10, 45, 65, 90 })
+         bst.insert(value);
+      // exercise
+      auto it = bst.find(10);       // leaf
+      auto itNext = bst.erase(it);
+      assertUnit(*itNext == 20);
+      it = bst.find(80);            // one child
+      itNext = bst.erase(it);
+      assertUnit(*itNext == 90);
+      it = bst.find(30);            // two children
+      itNext = bst.erase(it);
+      assertUnit(*itNext == 40);
+      it = bst.find(50);            // the root
+      itNext = bst.erase(it);
+      assertUnit(*itNext == 60);
+      // verify
+      assertUnit(bst.size() == 7);
+      assertUnit(threadsMatch(bst));
+      std::vector<int> values = valuesOf(bst);
+      assertUnit(values == std::vector<int>({ 20, 40, 45, 60, 65, 70, 90 }));
+   }  // teardown
+
+   // a copy gets its own threads, even when it reuses nodes
+   void test_threaded_copy()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bstSrc;
+      for (int value : { 50, 30, 70, 20, 40, 60, 80 })
+         bstSrc.insert(value);
+      custom::BST <int, custom::red_black, true> bstDest;
+      for (int value : { 5, 3, 4, 1 })
+         bstDest.insert(value);
+      // exercise
+      custom::BST <int, custom::red_black, true> bstCopy(bstSrc);
+      bstDest = bstSrc;
+      // verify
+      assertUnit(threadsMatch(bstSrc));
+      assertUnit(threadsMatch(bstCopy));
+      assertUnit(threadsMatch(bstDest));
+      assertUnit(bstCopy.begin().pNode->pNext != bstSrc.begin().pNode->pNext);
+      std::vector<int> values = valuesOf(bstDest);
+      assertUnit(values == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // moving hands the nodes, threads and all, to the new tree
+   void test_threaded_move()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bstSrc;
+      for (int value : { 50, 30, 70, 20, 40, 60, 80 })
+         bstSrc.insert(value);
+      custom::BST <int, custom::red_black, true> bstOther;
+      for (int value : { 5, 3 })
+         bstOther.insert(value);
+      // exercise
+      custom::BST <int, custom::red_black, true> bstDest(std::move(bstSrc));
+      bstDest.swap(bstOther);
+      // verify
+      assertUnit(bstSrc.empty());
+      assertUnit(threadsMatch(bstDest));
+      assertUnit(threadsMatch(bstOther));
+      std::vector<int> values = valuesOf(bstOther);
+      assertUnit(values == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // threads survive rotations in both directions
+   void test_threaded_balanced()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bst;
+      unsigned int seed = 36;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)(seed >> 16) % 500;
+         auto it = bst.find(value);
+         if (it != bst.end() && i % 3 == 0)
+            bst.erase(it);
+         else
+            bst.insert(value);
+      }
+      // verify
+      assertUnit(threadsMatch(bst));
+      assertUnit(blackHeight(bst.root) > 0);
+   }  // teardown
+
+   /***************************************
+    * RED-BLACK
+    ***************************************/
+
+   // the root is always black
+   void test_redBlack_insertOne()
+   {  // setup
+      custom::BST <int> bst;
+      // exercise
+      bst.insert(50);
+      // verify
+      assertUnit(bst.root != nullptr);
+      if (bst.root)
+         assertUnit(bst.root->isRed == false);
+   }  // teardown
+
+   // red parent, black aunt, outside child: rotate granny
+   //    (10)                  (20)
+   //       +--+            +---+---+
+   //         [20]    =>  [10]     [30]
+   //            +--+
+   //             [30]
+   void test_redBlack_insertOutside()
+   {  // setup
+      custom::BST <int> bst;
+      bst.insert(10);
+      bst.insert(20);
+      // exercise
+      bst.insert(30);
+      // verify
+      assertUnit(bst.root && bst.root->data == 20);
+      assertUnit(bst.root && !bst.root->isRed);
+      assertUnit(bst.root && bst.root->pLeft  && bst.root->pLeft->data  == 10 && bst.root->pLeft->isRed);
+      assertUnit(bst.root && bst.root->pRight && bst.root->pRight->data == 30 && bst.root->pRight->isRed);
+      assertUnit(bst.root && bst.root->pParent == nullptr);
+      assertUnit(blackHeight(bst.root) == 1);
+   }  // teardown
+
+   // red parent, black aunt, inside child: two rotations
+   //    (30)                  (20)
+   //  +--+                 +---+---+
+   //[10]             =>  [10]     [30]
+   //  +--+
+   //   [20]
+   void test_redBlack_insertInside()
+   {  // setup
+      custom::BST <int> bst;
+      bst.insert(30);
+      bst.insert(10);
+      // exercise
+      bst.insert(20);
+      // verify
+      assertUnit(bst.root && bst.root->data == 20);
+      assertUnit(bst.root && !bst.root->isRed);
+      assertUnit(bst.root && bst.root->pLeft  && bst.root->pLeft->data  == 10 && bst.root->pLeft->isRed);
+      assertUnit(bst.root && bst.root->pRight && bst.root->pRight->data == 30 && bst.root->pRight->isRed);
+      assertUnit(blackHeight(bst.root) == 1);
+   }  // teardown
+
+   // red parent, red aunt: recolor and no rotation
+   //       (20)                   (20)
+   //    +---+---+              +---+---+
+   //  [10]     [30]    =>    (10)     (30)
+   //                                     +--+
+   //                                      [40]
+   void test_redBlack_insertRedAunt()
+   {  // setup
+      custom::BST <int> bst;
+      bst.insert(20);
+      bst.insert(10);
+      bst.insert(30);
+      auto pRoot = bst.root;
+      // exercise
+      bst.insert(40);
+      // verify
+      assertUnit(bst.root == pRoot);
+      assertUnit(bst.root && !bst.root->isRed);
+      assertUnit(bst.root && bst.root->pLeft  && !bst.root->pLeft->isRed);
+      assertUnit(bst.root && bst.root->pRight && !bst.root->pRight->isRed);
+      assertUnit(bst.root && bst.root->pRight && bst.root->pRight->pRight &&
+                 bst.root->pRight->pRight->isRed);
+      assertUnit(blackHeight(bst.root) == 2);
+   }  // teardown
+
+   // sorted input no longer makes a linked list
+   void test_redBlack_insertSorted()
+   {  // setup
+      custom::BST <int> bst;
+      // exercise
+      for (int i = 0; i < 10000; i++)
+         bst.insert(i);
+      // verify
+      assertUnit(bst.size() == 10000);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(height(bst.root) <= 28);   // 2 lg(n + 1)
+      assertUnit(inOrder(bst.root, 10000));
+   }  // teardown
+
+   // reverse sorted input
+   void test_redBlack_insertReverse()
+   {  // setup
+      custom::BST <int> bst;
+      // exercise
+      for (int i = 10000; i > 0; i--)
+         bst.insert(i);
+      // verify
+      assertUnit(bst.size() == 10000);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(height(bst.root) <= 28);
+      assertUnit(inOrder(bst.root, 10000));
+   }  // teardown
+
+   // random input with duplicates, checking after every insert
+   void test_redBlack_insertRandom()
+   {  // setup
+      custom::BST <int> bst;
+      unsigned int seed = 2020;
+      bool valid = true;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         bst.insert((int)(seed >> 16) % 400);
+         valid = valid && blackHeight(bst.root) > 0;
+      }
+      // verify
+      assertUnit(valid);
+      assertUnit(inOrder(bst.root, 1000));
+   }  // teardown
+
+   // erasing the only node leaves an empty tree
+   void test_redBlack_eraseOnly()
+   {  // setup
+      custom::BST <int> bst;
+      bst.insert(50);
+      auto it = bst.begin();
+      // exercise
+      auto itNext = bst.erase(it);
+      // verify
+      assertUnit(itNext == bst.end());
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.size() == 0);
+   }  // teardown
+
+   // erase everything, in order, checking after each one
+   void test_redBlack_eraseAll()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 500; i++)
+         bst.insert(i);
+      bool valid = true;
+      // exercise
+      auto it = bst.begin();
+      while (it != bst.end())
+      {
+         it = bst.erase(it);
+         valid = valid && (bst.root == nullptr || blackHeight(bst.root) > 0);
+      }
+      // verify
+      assertUnit(valid);
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.size() == 0);
+   }  // teardown
+
+   // mixed inserts and erases keep every invariant
+   void test_redBlack_eraseRandom()
+   {  // setup
+      custom::BST <int> bst;
+      unsigned int seed = 1999;
+      bool valid = true;
+      // exercise
+      for (int i = 0; i < 4000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)(seed >> 16) % 300;
+         auto it = bst.find(value);
+         if (it != bst.end() && (seed & 0x100))
+            bst.erase(it);
+         else
+            bst.insert(value);
+         valid = valid && (bst.root == nullptr || blackHeight(bst.root) > 0);
+      }
+      // verify
+      assertUnit(valid);
+      assertUnit(inOrder(bst.root, bst.size()));
+   }  // teardown
+
+   // a copy has the same colors
+   void test_redBlack_copy()
+   {  // setup
+      custom::BST <int> bstSrc;
+      for (int i = 0; i < 100; i++)
+         bstSrc.insert(i);
+      custom::BST <int> bstDest;
+      for (int i = 0; i < 7; i++)
+         bstDest.insert(i * 3);
+      // exercise
+      bstDest = bstSrc;
+      // verify
+      assertUnit(blackHeight(bstDest.root) == blackHeight(bstSrc.root));
+      assertUnit(inOrder(bstDest.root, 100));
+   }  // teardown
+
+   /***************************************
+    * BALANCING POLICIES
+    *     BST<T, unbalanced | avl | treap | splay>
+    ***************************************/
+
+   // sorted input with no balancing makes a chain
+   void test_policy_unbalancedSorted()
+   {  // setup
+      custom::BST <int, custom::unbalanced> bst;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         bst.insert(i);
+      // verify
+      assertUnit(height(bst.root) == 100);
+      assertUnit(inOrder(bst.root, 100));
+   }  // teardown
+
+   // sorted input stays within the AVL height bound
+   void test_policy_avlInsertSorted()
+   {  // setup
+      custom::BST <int, custom::avl> bst;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         bst.insert(i);
+      // verify
+      assertUnit(avlHeight(bst.root) > 0);
+      assertUnit(height(bst.root) <= 14);     // 1.44 log2(1000)
+      assertUnit(inOrder(bst.root, 1000));
+   }  // teardown
+
+   // mixed inserts and erases keep every node balanced
+   void test_policy_avlEraseRandom()
+   {  // setup
+      custom::BST <int, custom::avl> bst;
+      bool valid = true;
+      // exercise
+      randomWork(bst, 4000, valid, [this](const custom::BST <int, custom::avl> & b)
+      {
+         return b.root == nullptr || avlHeight(b.root) > 0;
+      });
+      // verify
+      assertUnit(valid);
+      assertUnit(inOrder(bst.root, bst.size()));
+   }  // teardown
+
+   // sorted input still gives a heap, and a short one
+   void test_policy_treapInsertSorted()
+   {  // setup
+      custom::BST <int, custom::treap> bst;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         bst.insert(i);
+      // verify
+      assertUnit(isHeap(bst.root));
+      assertUnit(height(bst.root) < 60);
+      assertUnit(inOrder(bst.root, 1000));
+   }  // teardown
+
+   // mixed inserts and erases keep the heap
+   void test_policy_treapEraseRandom()
+   {  // setup
+      custom::BST <int, custom::treap> bst;
+      bool valid = true;
+      // exercise
+      randomWork(bst, 4000, valid, [this](const custom::BST <int, custom::treap> & b)
+      {
+         return isHeap(b.root);
+      });
+      // verify
+      assertUnit(valid);
+      assertUnit(inOrder(bst.root, bst.size()));
+   }  // teardown
+
+   // whatever was inserted last is the root
+   void test_policy_splayInsert()
+   {  // setup
+      custom::BST <int, custom::splay> bst;
+      bool atRoot = true;
+      // exercise
+      for (int i = 0; i < 200; i++)
+      {
+         int value = (i * 37) % 200;
+         bst.insert(value);
+         atRoot = atRoot && bst.root->data == value && bst.root->pParent == nullptr;
+      }
+      // verify
+      assertUnit(atRoot);
+      assertUnit(inOrder(bst.root, 200));
+   }  // teardown
+
+   // find brings a hit, or the last node looked at, to the root
+   void test_policy_splayFind()
+   {  // setup
+      custom::BST <int, custom::splay> bst;
+      for (int i = 0; i < 100; i += 2)
+         bst.insert(i);
+      // exercise
+      auto itHit = bst.find(42);
+      int rootHit = bst.root->data;
+      auto itMiss = bst.find(43);
+      int rootMiss = bst.root->data;
+      // verify
+      assertUnit(itHit != bst.end() && *itHit == 42);
+      assertUnit(rootHit == 42);
+      assertUnit(itMiss == bst.end());
+      assertUnit(rootMiss == 42 || rootMiss == 44);
+      assertUnit(inOrder(bst.root, 50));
+   }  // teardown
+
+   // erase splays the parent of whatever moved
+   void test_policy_splayErase()
+   {  // setup
+      custom::BST <int, custom::splay> bst;
+      bool valid = true;
+      // exercise
+      randomWork(bst, 2000, valid, [this](const custom::BST <int, custom::splay> & b)
+      {
+         return b.root == nullptr || b.root->pParent == nullptr;
+      });
+      // verify
+      assertUnit(valid);
+      assertUnit(inOrder(bst.root, bst.size()));
+   }  // teardown
+
+   // a copy keeps the balance data, so it is just as valid
+   void test_policy_copy()
+   {  // setup
+      custom::BST <int, custom::avl> avlSrc;
+      custom::BST <int, custom::treap> treapSrc;
+      for (int i = 0; i < 100; i++)
+      {
+         avlSrc.insert(i);
+         treapSrc.insert(i);
+      }
+      custom::BST <int, custom::avl> avlDest { 4, 2 };
+      custom::BST <int, custom::treap> treapDest { 4, 2 };
+      // exercise
+      avlDest = avlSrc;
+      treapDest = treapSrc;
+      // verify
+      assertUnit(avlHeight(avlDest.root) == avlHeight(avlSrc.root));
+      assertUnit(isHeap(treapDest.root));
+      assertUnit(height(treapDest.root) == height(treapSrc.root));
+   }  // teardown
+
+   // rotations never break the threads, whatever the policy
+   void test_policy_threaded()
+   {  // setup
+      custom::BST <int, custom::unbalanced, true> bstPlain;
+      custom::BST <int, custom::avl,        true> bstAvl;
+      custom::BST <int, custom::treap,      true> bstTreap;
+      custom::BST <int, custom::splay,      true> bstSplay;
+      bool valid = true;
+      // exercise
+      randomWork(bstPlain, 2000, valid, [this](const custom::BST <int, custom::unbalanced, true> & b)
+      {
+         return threadsMatch(b);
+      });
+      randomWork(bstAvl, 2000, valid, [this](const custom::BST <int, custom::avl, true> & b)
+      {
+         return threadsMatch(b);
+      });
+      randomWork(bstTreap, 2000, valid, [this](const custom::BST <int, custom::treap, true> & b)
+      {
+         return threadsMatch(b);
+      });
+      randomWork(bstSplay, 2000, valid, [this](const custom::BST <int, custom::splay, true> & b)
+      {
+         return threadsMatch(b);
+      });
+      // verify
+      assertUnit(valid);
+      assertUnit(valuesOf(bstAvl) == valuesOf(bstTreap));
+      assertUnit(valuesOf(bstAvl) == valuesOf(bstSplay));
+      assertUnit(valuesOf(bstAvl) == valuesOf(bstPlain));
+   }  // teardown
+
+   /***************************************
+    * BULK LOAD
+    *     BST::assign(first, last, keepUnique)
+    *     BST::assign(assume_sorted, first, last, keepUnique)
+    *     BST::BST(initializer_list)
+    *     BST::insert(first, last, keepUnique)
+    ***************************************/
+
+   // a sorted range is checked once and built, no inserts
+   void test_bulk_sortedStandard()
+   {  // setup
+      std::vector<Spy> src{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      custom::BST <Spy> bst;
+      Spy::reset();
+      // exercise
+      bst.assign(src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numCopy() == 7);
+      assertUnit(Spy::numAlloc() == 7);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numLessthan() == 6);
+      assertUnit(Spy::numEquals() == 0);
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      assertStandardFixture(bst);
+      assertUnit(blackHeight(bst.root) == 2);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // promising the order skips even the check
+   void test_bulk_assumeSorted()
+   {  // setup
+      std::vector<Spy> src{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      custom::BST <Spy> bst;
+      Spy::reset();
+      // exercise
+      bst.assign(custom::assume_sorted, src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numCopy() == 7);
+      assertUnit(Spy::numAlloc() == 7);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numEquals() == 0);
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // a big sorted load is as short as it can be
+   void test_bulk_sortedLarge()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 1000; i++)
+         src.push_back(i);
+      custom::BST <int> bst;
+      // exercise
+      bst.assign(src.begin(), src.end());
+      // verify
+      assertUnit(bst.size() == 1000);
+      assertUnit(height(bst.root) == 10);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(inOrder(bst.root, 1000));
+      assertUnit(*bst.begin() == 0);
+   }  // teardown
+
+   // an unsorted range is sorted first; repeats keep their order
+   void test_bulk_unsorted()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 500; i++)
+         src.push_back((i * 37) % 101);
+      custom::BST <int> bst;
+      // exercise
+      bst.assign(src.begin(), src.end());
+      // verify
+      std::sort(src.begin(), src.end());
+      assertUnit(bst.size() == 500);
+      assertUnit(collectAll(bst.root) == src);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(height(bst.root) == 9);
+   }  // teardown
+
+   // keepUnique drops repeats, sorted or not
+   void test_bulk_keepUnique()
+   {  // setup
+      std::vector<int> sorted{ 1, 1, 2, 3, 3, 3, 4, 5, 5 };
+      std::vector<int> unsorted{ 5, 3, 1, 3, 4, 2, 5, 1, 3 };
+      custom::BST <int> bstSorted;
+      custom::BST <int> bstAssumed;
+      custom::BST <int> bstUnsorted;
+      // exercise
+      bstSorted.assign(sorted.begin(), sorted.end(), true);
+      bstAssumed.assign(custom::assume_sorted, sorted.begin(), sorted.end(), true);
+      bstUnsorted.assign(unsorted.begin(), unsorted.end(), true);
+      // verify
+      std::vector<int> expected{ 1, 2, 3, 4, 5 };
+      assertUnit(bstSorted.size() == 5);
+      assertUnit(collectAll(bstSorted.root) == expected);
+      assertUnit(bstAssumed.size() == 5);
+      assertUnit(collectAll(bstAssumed.root) == expected);
+      assertUnit(bstUnsorted.size() == 5);
+      assertUnit(collectAll(bstUnsorted.root) == expected);
+   }  // teardown
+
+   // whatever was there before is gone, and the tree still works
+   void test_bulk_replace()
+   {  // setup
+      custom::BST <int> bst{ 99, 98, 97 };
+      std::vector<int> src{ 10, 20, 30, 40 };
+      // exercise
+      bst.assign(src.begin(), src.end());
+      bst.insert(25);
+      auto it = bst.begin();
+      bst.erase(it);
+      // verify
+      std::vector<int> expected{ 20, 25, 30, 40 };
+      assertUnit(bst.size() == 4);
+      assertUnit(collectAll(bst.root) == expected);
+      assertUnit(blackHeight(bst.root) > 0);
+   }  // teardown
+
+   // every policy, and the threads, get what they need
+   void test_bulk_policies()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 300; i++)
+         src.push_back(i * 2);
+      custom::BST <int, custom::avl> bstAvl;
+      custom::BST <int, custom::treap> bstTreap;
+      custom::BST <int, custom::red_black, true> bstThreaded;
+      // exercise
+      bstAvl.assign(src.begin(), src.end());
+      bstTreap.assign(src.begin(), src.end());
+      bstThreaded.assign(src.begin(), src.end());
+      bstAvl.insert(301);
+      bstTreap.insert(301);
+      bstThreaded.insert(301);
+      // verify
+      assertUnit(avlHeight(bstAvl.root) > 0);
+      assertUnit(isHeap(bstTreap.root));
+      assertUnit(threadsMatch(bstThreaded));
+      assertUnit(blackHeight(bstThreaded.root) > 0);
+      assertUnit(valuesOf(bstThreaded) == collectAll(bstAvl.root));
+   }  // teardown
+
+   // a sorted initializer list is built, not inserted
+   void test_bulk_initializerSorted()
+   {  // setup
+      std::initializer_list<Spy> il{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      Spy::reset();
+      // exercise
+      custom::BST <Spy> bst(il);
+      // verify
+      assertUnit(Spy::numCopy() == 7);
+      assertUnit(Spy::numAlloc() == 7);
+      assertUnit(Spy::numLessthan() == 6);
+      assertUnit(Spy::numEquals() == 0);
+      assertStandardFixture(bst);
+      assertUnit(blackHeight(bst.root) == 2);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // without balancing, a sorted list would otherwise be a chain
+   void test_bulk_initializerUnbalanced()
+   {  // setup
+      custom::BST <int, custom::unbalanced> bst;
+      // exercise
+      bst = { 1, 2, 3, 4, 5, 6, 7 };
+      // verify
+      std::vector<int> expected{ 1, 2, 3, 4, 5, 6, 7 };
+      assertUnit(bst.size() == 7);
+      assertUnit(height(bst.root) == 3);
+      assertUnit(collectAll(bst.root) == expected);
+   }  // teardown
+
+   // a sorted range as big as the tree is merged in; on a tie the
+   // item already there stays
+   void test_bulk_insertMerge()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i += 2)
+         bst.insert(i);
+      std::vector<int> src;
+      for (int i = 0; i < 200; i += 3)
+         src.push_back(i);
+      assertUnit(src.size() > bst.size());
+      // exercise
+      bst.insert(src.begin(), src.end(), true /* keep unique */);
+      // verify
+      std::vector<int> expected;
+      for (int i = 0; i < 200; i++)
+         if (i % 3 == 0 || (i % 2 == 0 && i < 100))
+            expected.push_back(i);
+      assertUnit(bst.size() == expected.size());
+      assertUnit(collectAll(bst.root) == expected);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(height(bst.root) == 7);
+      assertUnit(sizesMatch(bst.root));
+   }  // teardown
+
+   // a few items, or an unsorted range, go in one at a time
+   void test_bulk_insertFew()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert(i * 10);
+      auto * pFirst = bst.begin().pNode;
+      std::vector<int> few{ 5, 15, 25 };
+      std::vector<int> unsorted{ 995, 1, 500, 2 };
+      // exercise
+      bst.insert(few.begin(), few.end());
+      bst.insert(unsorted.begin(), unsorted.end());
+      // verify
+      assertUnit(bst.size() == 107);
+      assertUnit(bst.begin().pNode == pFirst);
+      assertUnit(inOrder(bst.root, 107));
+      assertUnit(blackHeight(bst.root) > 0);
+   }  // teardown
+
+   /***************************************
+    * ORDER STATISTICS
+    *     BST::nth(k)
+    *     BST::rank(t)
+    *     distance(first, last)
+    ***************************************/
+
+   // every policy keeps the subtree sizes through its rotations
+   void test_order_sizesPolicies()
+   {  // setup
+      custom::BST <int> bstRedBlack;
+      custom::BST <int, custom::unbalanced> bstPlain;
+      custom::BST <int, custom::avl> bstAvl;
+      custom::BST <int, custom::treap> bstTreap;
+      custom::BST <int, custom::splay, true> bstSplay;
+      bool valid = true;
+      // exercise
+      randomWork(bstRedBlack, 2000, valid, [this](const custom::BST <int> & b)
+      {
+         return sizesMatch(b.root) && sizeOf(b.root) == b.size();
+      });
+      randomWork(bstPlain, 2000, valid, [this](const custom::BST <int, custom::unbalanced> & b)
+      {
+         return sizesMatch(b.root) && sizeOf(b.root) == b.size();
+      });
+      randomWork(bstAvl, 2000, valid, [this](const custom::BST <int, custom::avl> & b)
+      {
+         return sizesMatch(b.root) && sizeOf(b.root) == b.size();
+      });
+      randomWork(bstTreap, 2000, valid, [this](const custom::BST <int, custom::treap> & b)
+      {
+         return sizesMatch(b.root) && sizeOf(b.root) == b.size();
+      });
+      randomWork(bstSplay, 2000, valid, [this](const custom::BST <int, custom::splay, true> & b)
+      {
+         return sizesMatch(b.root) && sizeOf(b.root) == b.size();
+      });
+      // verify
+      assertUnit(valid);
+   }  // teardown
+
+   // bulk loads and copies come with their sizes
+   void test_order_sizesBulkAndCopy()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 100; i++)
+         src.push_back(i);
+      custom::BST <int> bstSrc;
+      custom::BST <int> bstDest { 7, 8 };
+      // exercise
+      bstSrc.assign(src.begin(), src.end());
+      bstDest = bstSrc;
+      // verify
+      assertUnit(sizesMatch(bstSrc.root));
+      assertUnit(sizeOf(bstSrc.root) == 100);
+      assertUnit(sizesMatch(bstDest.root));
+      assertUnit(sizeOf(bstDest.root) == 100);
+   }  // teardown
+
+   // nth finds every element, and nothing past the end
+   void test_order_nth()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 1000; i++)
+         bst.insert((i * 373) % 1000);
+      bool found = true;
+      // exercise
+      for (int k = 0; k < 1000; k++)
+         found = found && bst.nth(k) != bst.end() && *bst.nth(k) == k;
+      // verify
+      assertUnit(found);
+      assertUnit(bst.nth(1000) == bst.end());
+      assertUnit(custom::BST <int>().nth(0) == bst.end());
+   }  // teardown
+
+   // rank counts what is smaller, present or not
+   void test_order_rank()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert(((i * 37) % 100) * 2);   // 0, 2, 4, ... 198
+      // exercise
+      size_t rankFirst = bst.rank(0);
+      size_t rankBelow = bst.rank(-5);
+      size_t rankHit = bst.rank(50);
+      size_t rankMiss = bst.rank(51);
+      size_t rankAbove = bst.rank(500);
+      // verify
+      assertUnit(rankFirst == 0);
+      assertUnit(rankBelow == 0);
+      assertUnit(rankHit == 25);
+      assertUnit(rankMiss == 26);
+      assertUnit(rankAbove == 100);
+      assertUnit(*bst.nth(bst.rank(51)) == 52);
+   }  // teardown
+
+   // distance counts subtrees instead of stepping
+   void test_order_distance()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 200; i++)
+         bst.insert((i * 7) % 200);
+      auto itBegin = bst.begin();
+      auto itEnd = bst.end();
+      auto it50 = bst.find(50);
+      auto it120 = bst.find(120);
+      // exercise and verify
+      assertUnit(distance(itBegin, itEnd) == 200);
+      assertUnit(distance(itEnd, itBegin) == -200);
+      assertUnit(distance(it50, it120) == 70);
+      assertUnit(distance(it120, it50) == -70);
+      assertUnit(distance(it120, itEnd) == 80);
+      assertUnit(distance(itEnd, it50) == -150);
+      assertUnit(distance(it50, it50) == 0);
+      assertUnit(distance(itEnd, itEnd) == 0);
+   }  // teardown
+
+   /***************************************
+    * BOUNDS
+    *     BST::lower_bound(t)
+    *     BST::upper_bound(t)
+    *     BST::equal_range(t)
+    ***************************************/
+
+   // nothing to find in an empty tree
+   void test_bound_empty()
+   {  // setup
+      custom::BST <int> bst;
+      // exercise
+      auto itLower = bst.lower_bound(5);
+      auto itUpper = bst.upper_bound(5);
+      auto range = bst.equal_range(5);
+      // verify
+      assertUnit(itLower == bst.end());
+      assertUnit(itUpper == bst.end());
+      assertUnit(range.first == bst.end() && range.second == bst.end());
+   }  // teardown
+
+   // lower_bound: hits, misses between, and off each end
+   void test_bound_lower()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert(((i * 37) % 100) * 2);   // 0, 2, 4, ... 198
+      // exercise and verify
+      assertUnit(*bst.lower_bound(50) == 50);
+      assertUnit(*bst.lower_bound(51) == 52);
+      assertUnit(*bst.lower_bound(-9) == 0);
+      assertUnit(*bst.lower_bound(198) == 198);
+      assertUnit(bst.lower_bound(199) == bst.end());
+   }  // teardown
+
+   // upper_bound: always past anything equal
+   void test_bound_upper()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert(((i * 37) % 100) * 2);
+      // exercise and verify
+      assertUnit(*bst.upper_bound(50) == 52);
+      assertUnit(*bst.upper_bound(51) == 52);
+      assertUnit(*bst.upper_bound(-9) == 0);
+      assertUnit(bst.upper_bound(198) == bst.end());
+   }  // teardown
+
+   // equal_range spans every copy of a repeated value
+   void test_bound_equalRange()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 60; i++)
+         bst.insert(i % 6);                  // ten of each of 0 ... 5
+      // exercise
+      auto range3 = bst.equal_range(3);
+      auto range9 = bst.equal_range(9);
+      // verify
+      assertUnit(distance(range3.first, range3.second) == 10);
+      assertUnit(*range3.first == 3);
+      assertUnit(*range3.second == 4);
+      assertUnit(distance(bst.begin(), range3.first) == 30);
+      assertUnit(range9.first == bst.end() && range9.second == bst.end());
+   }  // teardown
+
+   // searching on from a hint finds what searching from the root does
+   void test_bound_fromHint()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 500; i += 5)
+         bst.insert(i);
+      bool same = true;
+      // exercise
+      for (int from = 0; from < 500; from += 35)
+         for (int key = from; key < 520; key += 3)
+            same = same && bst.lower_bound(bst.lower_bound(from), key) == bst.lower_bound(key);
+      auto itPast = bst.lower_bound(bst.find(200), 100);   // hint already there
+      auto itEnd = bst.lower_bound(bst.end(), 3);
+      // verify
+      assertUnit(same);
+      assertUnit(*itPast == 200);
+      assertUnit(itEnd == bst.end());
+   }  // teardown
+
+   /***************************************
+    * HINTED INSERT
+    *     BST::insert(hint, t, keepUnique)
+    ***************************************/
+
+   // appending with an end() hint costs one compare each
+   void test_hint_appendEnd()
+   {  // setup
+      custom::BST <Spy> bst;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 100; i++)
+         bst.insert(bst.end(), Spy(i));
+      // verify
+      assertUnit(Spy::numLessthan() == 99);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(bst.size() == 100);
+      assertUnit(*bst.begin() == Spy(0));
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(sizesMatch(bst.root));
+   }  // teardown
+
+   // a right hint puts t just before it with two compares
+   void test_hint_correct()
+   {  // setup
+      custom::BST <Spy> bst;
+      for (int i = 0; i < 100; i += 10)
+         bst.insert(Spy(i));
+      auto hint = bst.find(Spy(30));
+      Spy::reset();
+      // exercise
+      auto pairReturn = bst.insert(hint, Spy(25));
+      // verify
+      assertUnit(Spy::numLessthan() == 2);
+      assertUnit(pairReturn.second == true);
+      assertUnit(*pairReturn.first == Spy(25));
+      assertUnit(*(++pairReturn.first) == Spy(30));
+      assertUnit(bst.size() == 11);
+   }  // teardown
+
+   // a wrong hint still puts t in the right place
+   void test_hint_wrong()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i += 10)
+         bst.insert(i);
+      // exercise
+      bst.insert(bst.find(80), 15);
+      bst.insert(bst.begin(), 95);
+      bst.insert(bst.end(), 5);
+      // verify
+      std::vector<int> expected{ 0, 5, 10, 15, 20, 30, 40, 50, 60, 70, 80, 90, 95 };
+      assertUnit(collectAll(bst.root) == expected);
+      assertUnit(sizesMatch(bst.root));
+      assertUnit(blackHeight(bst.root) > 0);
+   }  // teardown
+
+   // a hinted repeat is refused when keeping unique, kept otherwise
+   void test_hint_keepUnique()
+   {  // setup
+      custom::BST <int> bst{ 10, 20, 30 };
+      // exercise
+      auto pairUnique = bst.insert(bst.find(30), 20, true);
+      auto pairMulti = bst.insert(bst.find(30), 20, false);
+      // verify
+      assertUnit(pairUnique.second == false);
+      assertUnit(*pairUnique.first == 20);
+      assertUnit(pairMulti.second == true);
+      assertUnit(bst.size() == 4);
+      assertUnit(collectAll(bst.root) == std::vector<int>({ 10, 20, 20, 30 }));
+   }  // teardown
+
+   // the last insert is forgotten when it goes away
+   void test_hint_afterErase()
+   {  // setup
+      custom::BST <int> bst{ 10, 20 };
+      auto it = bst.insert(30).first;
+      // exercise
+      bst.erase(it);
+      bst.insert(bst.end(), 40);
+      custom::BST <int> bstCopy;
+      bstCopy = bst;
+      bstCopy.insert(bstCopy.end(), 50);
+      // verify
+      assertUnit(collectAll(bst.root) == std::vector<int>({ 10, 20, 40 }));
+      assertUnit(collectAll(bstCopy.root) == std::vector<int>({ 10, 20, 40, 50 }));
+   }  // teardown
+
+   // nearly sorted hinted inserts keep every invariant
+   void test_hint_invariants()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bst;
+      custom::BST <int, custom::avl> bstAvl;
+      bool valid = true;
+      // exercise
+      auto hint = bst.end();
+      for (int i = 0; i < 1000; i++)
+      {
+         int value = (i % 10 == 9) ? i - 50 : i;  // every tenth is late
+         hint = bst.insert(hint, value).first;
+         bstAvl.insert(bstAvl.end(), value);
+         valid = valid && threadsMatch(bst) && sizesMatch(bst.root);
+      }
+      // verify
+      assertUnit(valid);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(avlHeight(bstAvl.root) > 0);
+      assertUnit(inOrder(bst.root, 1000));
+      assertUnit(valuesOf(bst) == collectAll(bstAvl.root));
+   }  // teardown
+
+   /***************************************
+    * SPLIT and JOIN
+    *     BST::split(k)
+    *     BST::join(rhs)
+    ***************************************/
+
+   // splitting nothing gives two of nothing
+   void test_split_empty()
+   {  // setup
+      custom::BST <int> bst;
+      // exercise
+      custom::BST <int> bstRest = bst.split(50);
+      // verify
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.size() == 0);
+      assertUnit(bstRest.root == nullptr);
+      assertUnit(bstRest.size() == 0);
+   }  // teardown
+
+   // everything less than the key stays, the rest goes, and both are red-black
+   void test_split_standard()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 200; i += 2)
+         bst.insert(i);
+      // exercise
+      custom::BST <int> bstRest = bst.split(51);
+      // verify
+      assertUnit(bst.size() == 26);
+      assertUnit(bstRest.size() == 74);
+      assertUnit(collectAll(bst.root).back() == 50);
+      assertUnit(collectAll(bstRest.root).front() == 52);
+      assertUnit(inOrder(bst.root, 26));
+      assertUnit(inOrder(bstRest.root, 74));
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(blackHeight(bstRest.root) > 0);
+      assertUnit(sizesMatch(bst.root));
+      assertUnit(sizesMatch(bstRest.root));
+   }  // teardown
+
+   // nodes change hands: nothing is made, copied, or freed
+   void test_split_noCopies()
+   {  // setup
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy::reset();
+      // exercise
+      custom::BST <Spy> bstRest = bst.split(Spy(45));
+      bst.join(bstRest);
+      // verify
+      assertUnit(Spy::numAlloc() == 1);      // just the Spy(45) above
+      assertUnit(Spy::numDelete() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(bst.size() == 7);
+      assertUnit(bstRest.size() == 0);
+      assertUnit(sizesMatch(bst.root));
+   }  // teardown
+
+   // every key of a random tree is a good place to split, in every policy
+   void test_split_policies()
+   {  // setup
+      bool valid = true;
+      // exercise
+      for (int key = -1; key <= 301; key += 7)
+      {
+         splitAndCheck<custom::red_black>(key, valid, [this](const custom::BSTNode <int, custom::red_black, false> * p)
+         {
+            return blackHeight(p) >= 0;
+         });
+         splitAndCheck<custom::avl>(key, valid, [this](const custom::BSTNode <int, custom::avl, false> * p)
+         {
+            return avlHeight(p) >= 0;
+         });
+         splitAndCheck<custom::treap>(key, valid, [this](const custom::BSTNode <int, custom::treap, false> * p)
+         {
+            return isHeap(p);
+         });
+         splitAndCheck<custom::splay>(key, valid, [](const custom::BSTNode <int, custom::splay, false> *)
+         {
+            return true;
+         });
+      }
+      // verify
+      assertUnit(valid);
+   }  // teardown
+
+   // the threads are cut where the trees part and tied where they meet
+   void test_split_threaded()
+   {  // setup
+      custom::BST <int, custom::red_black, true> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert((i * 37) % 100);
+      // exercise
+      auto bstHigh = bst.split(70);
+      auto bstMiddle = bst.split(30);
+      auto bstNone = bstHigh.split(500);
+      bool validApart = threadsMatch(bst) && threadsMatch(bstMiddle) &&
+                        threadsMatch(bstHigh) && threadsMatch(bstNone);
+      bst.join(bstMiddle);
+      bst.join(bstHigh);
+      // verify
+      assertUnit(validApart);
+      assertUnit(threadsMatch(bst));
+      assertUnit(bst.size() == 100);
+      assertUnit(valuesOf(bst) == collectAll(bst.root));
+      assertUnit(inOrder(bst.root, 100));
+      assertUnit(blackHeight(bst.root) > 0);
+   }  // teardown
+
+   // joining with nothing, on either side
+   void test_join_emptySides()
+   {  // setup
+      custom::BST <int> bst{ 10, 20, 30 };
+      custom::BST <int> bstEmpty;
+      custom::BST <int> bstEmptyToo;
+      // exercise
+      bst.join(bstEmpty);
+      bstEmptyToo.join(bst);
+      // verify
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.size() == 0);
+      assertUnit(bstEmptyToo.size() == 3);
+      assertUnit(collectAll(bstEmptyToo.root) == std::vector<int>({ 10, 20, 30 }));
+      assertUnit(blackHeight(bstEmptyToo.root) > 0);
+   }  // teardown
+
+   // a small tree joins a large one down the near spine, either way round
+   void test_join_uneven()
+   {  // setup
+      custom::BST <int> bstBig;
+      custom::BST <int> bstSmall{ -3, -2, -1 };
+      custom::BST <int> bstBigToo;
+      custom::BST <int> bstSmallToo{ 5000, 5001 };
+      for (int i = 0; i < 1000; i++)
+      {
+         bstBig.insert(i);
+         bstBigToo.insert(i + 2000);
+      }
+      // exercise
+      bstSmall.join(bstBig);
+      bstBigToo.join(bstSmallToo);
+      // verify
+      assertUnit(bstSmall.size() == 1003);
+      assertUnit(inOrder(bstSmall.root, 1003));
+      assertUnit(blackHeight(bstSmall.root) > 0);
+      assertUnit(sizesMatch(bstSmall.root));
+      assertUnit(bstBigToo.size() == 1002);
+      assertUnit(inOrder(bstBigToo.root, 1002));
+      assertUnit(blackHeight(bstBigToo.root) > 0);
+      assertUnit(sizesMatch(bstBigToo.root));
+      assertUnit(bstBig.empty());
+      assertUnit(bstSmallToo.empty());
+   }  // teardown
+
+   // trees that overlap are refused and left as they were
+   void test_join_overlap()
+   {  // setup
+      custom::BST <int> bst{ 10, 20, 30 };
+      custom::BST <int> bstOther{ 25, 40 };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         bst.join(bstOther);
+      }
+      catch (const char * error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(collectAll(bst.root) == std::vector<int>({ 10, 20, 30 }));
+      assertUnit(collectAll(bstOther.root) == std::vector<int>({ 25, 40 }));
+   }  // teardown
+
+   // a shared end element joins, unless keeping unique
+   void test_join_keepUnique()
+   {  // setup
+      custom::BST <int> bst{ 10, 20, 30 };
+      custom::BST <int> bstOther{ 30, 40 };
+      custom::BST <int> bstUnique{ 10, 20, 30 };
+      custom::BST <int> bstUniqueOther{ 30, 40 };
+      bool thrown = false;
+      // exercise
+      bst.join(bstOther);
+      try
+      {
+         bstUnique.join(bstUniqueOther, true /* keep unique */);
+      }
+      catch (const char * error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(collectAll(bst.root) == std::vector<int>({ 10, 20, 30, 30, 40 }));
+      assertUnit(bstOther.empty());
+      assertUnit(thrown);
+      assertUnit(collectAll(bstUnique.root) == std::vector<int>({ 10, 20, 30 }));
+      assertUnit(collectAll(bstUniqueOther.root) == std::vector<int>({ 30, 40 }));
+   }  // teardown
+
+   // pieces of every size join back up, still balanced, in every policy
+   void test_join_policies()
+   {  // setup
+      bool valid = true;
+      // exercise
+      joinAndCheck<custom::red_black>(valid, [this](const custom::BSTNode <int, custom::red_black, false> * p)
+      {
+         return blackHeight(p) >= 0;
+      });
+      joinAndCheck<custom::avl>(valid, [this](const custom::BSTNode <int, custom::avl, false> * p)
+      {
+         return avlHeight(p) >= 0;
+      });
+      joinAndCheck<custom::treap>(valid, [this](const custom::BSTNode <int, custom::treap, false> * p)
+      {
+         return isHeap(p);
+      });
+      joinAndCheck<custom::unbalanced>(valid, [](const custom::BSTNode <int, custom::unbalanced, false> *)
+      {
+         return true;
+      });
+      // verify
+      assertUnit(valid);
+   }  // teardown
+
+   /**************************************************************
+    * SPLIT AND CHECK
+    * Split a random tree at key: each side must hold just what
+    * it should and pass check, and joining them gives it all back
+    *************************************************************/
+   template <class Balance, class Check>
+   void splitAndCheck(int key, bool & valid, Check check)
+   {
+      custom::BST <int, Balance> bst;
+      randomWork(bst, 600, valid, [](const custom::BST <int, Balance> &) { return true; });
+      std::vector<int> before = collectAll(bst.root);
+
+      custom::BST <int, Balance> bstRest = bst.split(key);
+      std::vector<int> less = collectAll(bst.root);
+      std::vector<int> rest = collectAll(bstRest.root);
+      valid = valid && check(bst.root) && check(bstRest.root) &&
+              sizesMatch(bst.root) && sizesMatch(bstRest.root) &&
+              bst.size() == less.size() && bstRest.size() == rest.size() &&
+              (less.empty() || less.back() < key) &&
+              (rest.empty() || rest.front() >= key) &&
+              less.size() + rest.size() == before.size();
+
+      bst.join(bstRest);
+      valid = valid && check(bst.root) && sizesMatch(bst.root) &&
+              collectAll(bst.root) == before && bstRest.empty();
+   }
+
+   /**************************************************************
+    * JOIN AND CHECK
+    * Join trees of every pair of sizes from 0 to 40
+    *************************************************************/
+   template <class Balance, class Check>
+   void joinAndCheck(bool & valid, Check check)
+   {
+      for (int numLeft = 0; numLeft <= 40; numLeft += 3)
+         for (int numRight = 0; numRight <= 40; numRight += 5)
+         {
+            custom::BST <int, Balance> bstLeft;
+            custom::BST <int, Balance> bstRight;
+            for (int i = 0; i < numLeft; i++)
+               bstLeft.insert(i);
+            for (int i = 0; i < numRight; i++)
+               bstRight.insert(100 - i);
+            bstLeft.join(bstRight);
+            valid = valid && check(bstLeft.root) && sizesMatch(bstLeft.root) &&
+                    bstLeft.size() == (size_t)(numLeft + numRight) &&
+                    inOrder(bstLeft.root, numLeft + numRight) &&
+                    (!bstLeft.root || !bstLeft.root->pParent) && bstRight.empty();
+         }
+   }
+
+   /**************************************************************
+    * SIZES MATCH
+    * Every node's subtree size is the count of what is under it
+    *************************************************************/
+   template <class BNode>
+   bool sizesMatch(const BNode * p)
+   {
+      if (!p)
+         return true;
+      return p->subtreeSize == 1 + sizeOf(p->pLeft) + sizeOf(p->pRight) &&
+             sizesMatch(p->pLeft) && sizesMatch(p->pRight);
+   }
+
+   template <class BNode>
+   size_t sizeOf(const BNode * p)
+   {
+      return p ? p->subtreeSize : 0;
+   }
+
+   /**************************************************************
+    * RANDOM WORK
+    * The same mix of finds, inserts and erases every time,
+    * checking the tree after each one
+    *************************************************************/
+   template <class Tree, class Check>
+   void randomWork(Tree & bst, int num, bool & valid, Check check)
+   {
+      unsigned int seed = 1999;
+      for (int i = 0; i < num; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)(seed >> 16) % 300;
+         auto it = bst.find(value);
+         if (it != bst.end() && (seed & 0x100))
+            bst.erase(it);
+         else
+            bst.insert(value, true);
+         valid = valid && check(bst);
+      }
+   }
+
+   /**************************************************************
+    * AVL HEIGHT
+    * The height stored in p, or -1 if any stored height is wrong,
+    * any node is out of balance, or a child does not point back
+    * at its parent
+    *************************************************************/
+   template <class BNode>
+   int avlHeight(const BNode * p, const BNode * pParent = nullptr)
+   {
+      if (!p)
+         return 0;
+      if (p->pParent != pParent)
+         return -1;
+      int left = avlHeight(p->pLeft, p);
+      int right = avlHeight(p->pRight, p);
+      if (left < 0 || right < 0 || left - right > 1 || right - left > 1)
+         return -1;
+      if (p->height != 1 + std::max(left, right))
+         return -1;
+      return p->height;
+   }
+
+   /**************************************************************
+    * IS HEAP
+    * No node has a higher priority than its parent
+    *************************************************************/
+   template <class BNode>
+   bool isHeap(const BNode * p, const BNode * pParent = nullptr)
+   {
+      if (!p)
+         return true;
+      if (p->pParent != pParent || (pParent && pParent->priority < p->priority))
+         return false;
+      return isHeap(p->pLeft, p) && isHeap(p->pRight, p);
+   }
+
+   /**************************************************************
+    * BLACK HEIGHT
+    * The number of black nodes on every path from p down to a
+    * leaf, or -1 if the tree breaks a red-black rule: a red root,
+    * a red node with a red child, paths of different black
+    * lengths, or a child that does not point back at its parent.
+    *************************************************************/
+   template <class BNode>
+   int blackHeight(const BNode * p, const BNode * pParent = nullptr)
+   {
+      if (!p)
+         return 0;
+      if (p->pParent != pParent || (!pParent && p->isRed))
+         return -1;
+      if (p->isRed && ((p->pLeft && p->pLeft->isRed) || (p->pRight && p->pRight->isRed)))
+         return -1;
+      int left = blackHeight(p->pLeft, p);
+      int right = blackHeight(p->pRight, p);
+      if (left < 0 || right < 0 || left != right)
+         return -1;
+      return left + (p->isRed ? 0 : 1);
+   }
+
+   /**************************************************************
+    * HEIGHT
+    * The number of nodes on the longest path down from p
+    *************************************************************/
+   template <class BNode>
+   int height(const BNode * p)
+   {
+      if (!p)
+         return 0;
+      return 1 + std::max(height(p->pLeft), height(p->pRight));
+   }
+
+   /**************************************************************
+    * IN ORDER
+    * The tree has num nodes and they are sorted
+    *************************************************************/
+   template <class BNode>
+   bool inOrder(const BNode * p, size_t num)
+   {
+      std::vector<int> values;
+      collect(p, values);
+      return values.size() == num && std::is_sorted(values.begin(), values.end());
+   }
+
+   template <class BNode>
+   std::vector<int> collectAll(const BNode * p)
+   {
+      std::vector<int> values;
+      collect(p, values);
+      return values;
+   }
+
+   template <class BNode>
+   void collect(const BNode * p, std::vector<int> & values)
+   {
+      if (!p)
+         return;
+      collect(p->pLeft, values);
+      values.push_back(p->data);
+      collect(p->pRight, values);
+   }
+
+   /**************************************************************
+    * VALUES OF
+    * Everything in the tree, in the order the iterator gives it
+    *************************************************************/
+   template <class Tree>
+   std::vector<int> valuesOf(const Tree & bst)
+   {
+      std::vector<int> values;
+      for (auto it = bst.begin(); it != bst.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   /**************************************************************
+    * THREADS MATCH
+    * Every node's links agree with walking the tree
+    *************************************************************/
+   template <class Tree>
+   bool threadsMatch(const Tree & bst)
+   {
+      typedef typename Tree::BNode BNode;
+      BNode * p = bst.root;
+      if (!p)
+         return true;
+      while (p->pLeft)
+         p = p->pLeft;
+      if (p->pPrev)
+         return false;
+
+      size_t num = 0;
+      for (; p; num++)
+      {
+         BNode * pNext = custom::BThreads <BNode, false> ::next(p);
+         if (p->pNext != pNext || (pNext && pNext->pPrev != p))
+            return false;
+         p = pNext;
+      }
+      return num == bst.size();
+   }
+
    /**************************************************************
     * SETUP STANDARD FIXTURE
     *                (50) 
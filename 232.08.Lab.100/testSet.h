@@ -13,9 +13,13 @@
 #ifdef DEBUG
 
 #include "set.h"
+#include "persistentSet.h"
+#include "flatSet.h"
 #include "unitTest.h"
 #include <set>
 #include <vector>
+#include <string>
+#include <algorithm>  // for std::lower_bound and std::is_sorted
 
 #include <iostream>
 #include <cassert>
@@ -130,6 +134,64 @@ public:
       test_size_empty();
       test_size_standard();
 
+      // Balancing
+      test_balance_avl();
+      test_balance_bulkLoad();
+
+      // Order Statistics
+      test_order_percentile();
+      test_order_distance();
+
+      // Bounds
+      test_bound_standard();
+
+      // Hinted Insert
+      test_hint_emplace();
+
+      // B Tree Layout
+      test_btree_random();
+      test_btree_bulkLoad();
+
+      // Freeze
+      test_freeze_empty();
+      test_freeze_layout();
+      test_freeze_bounds();
+      test_freeze_iterate();
+
+      // Lookup by Key
+      test_lookup_byKey();
+
+      // Compare
+      test_compare_descending();
+      test_compare_descendingBTree();
+      test_compare_stateful();
+      test_compare_emptyTakesNoRoom();
+
+      // Persistent
+      test_persistent_snapshot();
+      test_persistent_compare();
+
+      // Split and Join
+      test_split_standard();
+      test_split_cutRange();
+      test_join_sameEnds();
+
+      // Set Algebra
+      test_algebra_union();
+      test_algebra_intersection();
+      test_algebra_difference();
+      test_algebra_symmetricDifference();
+      test_algebra_gallop();
+      test_algebra_keepsLeft();
+
+      // Flat
+      test_flat_batchInsert();
+      test_flat_batchKeepsFirst();
+      test_flat_lookup();
+      test_flat_insertErase();
+      test_flat_splitJoin();
+      test_flat_algebra();
+
       report("Set");
    }
    
@@ -541,6 +603,755 @@ public:
       teardownStandardFixture(s);
    }
 
+   /***************************************
+    * BALANCING
+    *    set <T, avl>
+    ***************************************/
+
+   // another balancing policy behaves just like the default
+   void test_balance_avl()
+   {  // setup
+      custom::set <int, custom::avl> s;
+      std::set <int> sExpected;
+      // exercise
+      for (int i = 0; i < 500; i++)
+      {
+         int value = (i * 71) % 211;
+         if (i % 3 == 2)
+         {
+            s.erase(value);
+            sExpected.erase(value);
+         }
+         else
+         {
+            s.insert(value);
+            sExpected.insert(value);
+         }
+      }
+      // verify
+      assertUnit(s.size() == sExpected.size());
+      bool same = true;
+      auto itExpected = sExpected.begin();
+      for (auto it = s.begin(); it != s.end(); ++it, ++itExpected)
+         same = same && *it == *itExpected;
+      assertUnit(same);
+      assertUnit(s.find(sExpected.empty() ? -1 : *sExpected.begin()) != s.end());
+   }  // teardown
+
+   // a sorted range loads straight into a balanced tree
+   void test_balance_bulkLoad()
+   {  // setup
+      std::vector<int> v;
+      for (int i = 0; i < 1023; i++)
+         v.push_back(i / 3);
+      // exercise
+      custom::set <int> s(v.begin(), v.end());
+      custom::set <int> sAssumed(custom::assume_sorted, v.begin(), v.end());
+      // verify
+      assertUnit(s.size() == 341);
+      assertUnit(sAssumed.size() == 341);
+      assertUnit(depth(s.bst.root) == 9);
+      assertUnit(depth(sAssumed.bst.root) == 9);
+      assertUnit(*s.begin() == 0);
+      assertUnit(s.find(340) != s.end());
+      assertUnit(s.find(341) == s.end());
+   }  // teardown
+
+   /***************************************
+    * ORDER STATISTICS
+    *    set::nth(k), set::rank(t), distance()
+    ***************************************/
+
+   // the 99th percentile of a changing set, with no walk
+   void test_order_percentile()
+   {  // setup
+      custom::set <int> s;
+      for (int i = 1; i <= 1000; i++)
+         s.insert((i * 613) % 1000 + 1);    // 1 ... 1000, shuffled
+      for (int i = 1; i <= 100; i++)
+      {
+         auto it = s.find(i * 10);          // drop the multiples of 10
+         s.erase(it);
+      }
+      // exercise
+      size_t k = s.size() * 99 / 100;
+      auto itP99 = s.nth(k);
+      size_t rank = s.rank(*itP99);
+      // verify
+      assertUnit(s.size() == 900);
+      assertUnit(k == 891);
+      assertUnit(*itP99 == 991);            // 891 = 99 decades of 9
+      assertUnit(rank == k);
+      assertUnit(s.nth(900) == s.end());
+      assertUnit(s.rank(10) == 9);
+   }  // teardown
+
+   // distance between set iterators, either way round
+   void test_order_distance()
+   {  // setup
+      custom::set <int> s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      assertUnit(distance(s.begin(), s.end()) == 7);
+      assertUnit(distance(s.find(30), s.find(70)) == 4);
+      assertUnit(distance(s.find(70), s.find(30)) == -4);
+      assertUnit(distance(s.end(), s.find(20)) == -7);
+   }  // teardown
+
+   /***************************************
+    * BOUNDS
+    *    set::lower_bound(t), set::upper_bound(t), set::equal_range(t)
+    ***************************************/
+
+   // scan everything from 30 up to 60 without starting at begin()
+   void test_bound_standard()
+   {  // setup
+      custom::set <int> s{ 50, 30, 70, 20, 40, 60, 80 };
+      std::vector<int> scanned;
+      // exercise
+      for (auto it = s.lower_bound(25); it != s.upper_bound(60); ++it)
+         scanned.push_back(*it);
+      auto range40 = s.equal_range(40);
+      auto range45 = s.equal_range(45);
+      // verify
+      assertUnit(scanned == std::vector<int>({ 30, 40, 50, 60 }));
+      assertUnit(*range40.first == 40 && *range40.second == 50);
+      assertUnit(range45.first == range45.second && *range45.first == 50);
+      assertUnit(s.lower_bound(81) == s.end());
+   }  // teardown
+
+   /***************************************
+    * HINTED INSERT
+    *    set::insert(hint, t), set::emplace_hint(hint, args)
+    ***************************************/
+
+   // hints, right or wrong, never break the set
+   void test_hint_emplace()
+   {  // setup
+      custom::set <std::string> s;
+      // exercise
+      for (int i = 0; i < 26; i++)
+         s.emplace_hint(s.end(), 1, (char)('a' + i));
+      auto it = s.insert(s.find("c"), std::string("bb"));
+      auto itRepeat = s.emplace_hint(s.begin(), "q");
+      // verify
+      assertUnit(s.size() == 27);
+      assertUnit(*s.begin() == "a");
+      assertUnit(*it == "bb");
+      assertUnit(*itRepeat == "q");
+      assertUnit(distance(s.begin(), s.find("c")) == 3);
+   }  // teardown
+
+   /***************************************
+    * B TREE LAYOUT
+    *    set <T, btree_layout <> >
+    ***************************************/
+
+   // the same answers as std::set through random inserts and erases
+   void test_btree_random()
+   {  // setup
+      custom::set <int, custom::btree_layout <> > s;
+      std::set <int> sExpected;
+      unsigned int seed = 1999;
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)(seed >> 16) % 2000;
+         if (seed & 0x100)
+            assertUnit(s.erase(value) == sExpected.erase(value));
+         else
+            assertUnit(s.insert(value).second == sExpected.insert(value).second);
+      }
+      // verify
+      assertUnit(s.size() == sExpected.size());
+      assertUnit(std::vector<int>(sExpected.begin(), sExpected.end()) == valuesOf(s));
+      assertUnit(*s.lower_bound(1000) == *sExpected.lower_bound(1000));
+      assertUnit(distance(s.begin(), s.end()) == (std::ptrdiff_t)s.size());
+   }  // teardown
+
+   // a range loads straight into full leaves
+   void test_btree_bulkLoad()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 1000; i++)
+         src.push_back(i % 500);
+      // exercise
+      custom::set <int, custom::btree_layout <> > s(src.begin(), src.end());
+      // verify
+      assertUnit(s.size() == 500);
+      assertUnit(*s.begin() == 0);
+      assertUnit(s.find(499) != s.end());
+      assertUnit(s.find(500) == s.end());
+   }  // teardown
+
+   /***************************************
+    * FREEZE
+    *    set::freeze()
+    ***************************************/
+
+   // nothing to freeze
+   void test_freeze_empty()
+   {  // setup
+      custom::set <int> s;
+      // exercise
+      auto frozen = s.freeze();
+      // verify
+      assertUnit(frozen.empty());
+      assertUnit(frozen.size() == 0);
+      assertUnit(frozen.begin() == frozen.end());
+      assertUnit(!frozen.contains(50));
+      assertUnit(frozen.lower_bound(50) == frozen.end());
+   }  // teardown
+
+   // the elements are laid out like a heap, in breadth-first order
+   void test_freeze_layout()
+   {  // setup
+      custom::set <int> s{ 10, 20, 30, 40, 50, 60, 70 };
+      // exercise
+      auto frozen = s.freeze();
+      // verify
+      //               (40)
+      //          +------+------+
+      //        (20)          (60)
+      //     +---+---+     +---+---+
+      //   (10)    (30)  (50)    (70)
+      assertUnit(frozen.size() == 7);
+      assertUnit(frozen.data == std::vector<int>({ 0, 40, 20, 60, 10, 30, 50, 70 }));
+      assertUnit(s.size() == 7);
+   }  // teardown
+
+   // every lookup agrees with std::lower_bound on a sorted vector
+   void test_freeze_bounds()
+   {  // setup
+      std::vector<int> sorted;
+      for (int i = 0; i < 1000; i++)
+         sorted.push_back(i * 3);
+      custom::set <int> s(sorted.begin(), sorted.end());
+      auto frozen = s.freeze();
+      bool same = true;
+      // exercise
+      for (int t = -2; t < 3002; t++)
+      {
+         auto itExpected = std::lower_bound(sorted.begin(), sorted.end(), t);
+         auto itLower = frozen.lower_bound(t);
+         auto itUpper = frozen.upper_bound(t);
+         bool found = itExpected != sorted.end() && *itExpected == t;
+         same = same && (itExpected == sorted.end() ? itLower == frozen.end() : *itLower == *itExpected);
+         same = same && frozen.contains(t) == found;
+         same = same && (frozen.find(t) != frozen.end()) == found;
+         if (found)
+            same = same && (t == 2997 ? itUpper == frozen.end() : *itUpper == t + 3);
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // iterating a snapshot visits it in order, both ways
+   void test_freeze_iterate()
+   {  // setup
+      custom::set <std::string> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(std::to_string(i * 37 % 100));
+      auto frozen = s.freeze();
+      s.clear();
+      std::vector<std::string> forward;
+      std::vector<std::string> backward;
+      // exercise
+      for (auto it = frozen.begin(); it != frozen.end(); it++)
+         forward.push_back(*it);
+      for (auto it = frozen.find("99"); it != frozen.end(); it--)
+         backward.push_back(*it);
+      // verify
+      assertUnit(forward.size() == 100);
+      assertUnit(std::is_sorted(forward.begin(), forward.end()));
+      std::reverse(backward.begin(), backward.end());
+      assertUnit(backward == forward);
+   }  // teardown
+
+   /***************************************
+    * LOOKUP BY KEY
+    *    set::find(key) with a transparent Compare
+    ***************************************/
+
+   // an account cannot be made from a bare id, so only a lookup by
+   // key can find one
+   struct Account
+   {
+      explicit Account(int id = 0, const char * name = "") : id(id), name(name) { }
+      bool operator <  (const Account & rhs) const { return id < rhs.id; }
+      bool operator == (const Account & rhs) const { return id == rhs.id; }
+      bool operator <  (int key) const { return id < key; }
+      friend bool operator < (int key, const Account & rhs) { return key < rhs.id; }
+      int id;
+      std::string name;
+   };
+
+   void test_lookup_byKey()
+   {  // setup
+      custom::set <Account, custom::red_black, std::less<> > s{ Account(7, "Ann"), Account(3, "Bo"), Account(9, "Cy") };
+      // exercise
+      auto itFound = s.find(3);
+      auto itMissing = s.find(4);
+      auto itLower = s.lower_bound(4);
+      auto range = s.equal_range(9);
+      // verify
+      assertUnit(itFound != s.end() && (*itFound).name == "Bo");
+      assertUnit(itMissing == s.end());
+      assertUnit(itLower != s.end() && (*itLower).name == "Ann");
+      assertUnit(range.first != s.end() && (*range.first).name == "Cy");
+      assertUnit(range.second == s.end());
+   }  // teardown
+
+   /***************************************
+    * COMPARE
+    *    set <T, Balance, Compare>
+    ***************************************/
+
+   // std::greater keeps the biggest first
+   void test_compare_descending()
+   {  // setup
+      custom::set <int, custom::red_black, std::greater<int> > s;
+      // exercise
+      for (int i : { 30, 10, 50, 20, 40, 10 })
+         s.insert(i);
+      // verify
+      assertUnit(valuesOf(s) == std::vector<int>({ 50, 40, 30, 20, 10 }));
+      assertUnit(s.find(20) != s.end());
+      assertUnit(s.find(25) == s.end());
+      assertUnit(*s.lower_bound(25) == 20);
+      assertUnit(*s.nth(1) == 40);
+      assertUnit(s.rank(30) == 2);
+      auto frozen = s.freeze();
+      assertUnit(*frozen.lower_bound(25) == 20);
+      assertUnit(frozen.contains(50) && !frozen.contains(45));
+   }  // teardown
+
+   // a btree takes the same Compare, bulk loads included
+   void test_compare_descendingBTree()
+   {  // setup
+      std::vector<int> values;
+      for (int i = 0; i < 500; i++)
+         values.push_back(i * 7 % 500);
+      // exercise
+      custom::set <int, custom::btree_layout<64>, std::greater<int> > s(values.begin(), values.end());
+      s.insert(250);
+      s.insert(-1);
+      // verify
+      std::vector<int> expected;
+      for (int i = 499; i >= -1; i--)
+         expected.push_back(i);
+      assertUnit(valuesOf(s) == expected);
+      assertUnit(*s.upper_bound(250) == 249);
+   }  // teardown
+
+   // a comparator with state: only the last digit counts, so 12 and
+   // 22 are the same element
+   struct LastDigits
+   {
+      LastDigits(int base = 10) : base(base) { }
+      bool operator () (int lhs, int rhs) const { return lhs % base < rhs % base; }
+      int base;
+   };
+
+   void test_compare_stateful()
+   {  // setup
+      custom::set <int, custom::red_black, LastDigits> s(LastDigits(10));
+      // exercise
+      for (int i : { 12, 3, 25, 7, 22, 33 })
+         s.insert(i);
+      custom::set <int, custom::red_black, LastDigits> sCopy(s);
+      // verify
+      assertUnit(valuesOf(s) == std::vector<int>({ 12, 3, 25, 7 }));
+      assertUnit(s.find(42) != s.end() && *s.find(42) == 12);
+      assertUnit(sCopy.key_comp().base == 10);
+      assertUnit(s.freeze().contains(15));
+   }  // teardown
+
+   // std::less has no state, so it costs a set nothing
+   void test_compare_emptyTakesNoRoom()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(sizeof(custom::set <int>) == sizeof(custom::set <int, custom::red_black, std::greater<int> >));
+      assertUnit(sizeof(custom::set <int>) == 3 * sizeof(void *));
+      assertUnit(sizeof(custom::set <int, custom::red_black, LastDigits>) > sizeof(custom::set <int>));
+   }  // teardown
+
+   /***************************************
+    * PERSISTENT
+    ***************************************/
+
+   // a snapshot keeps its elements as the set changes, sharing the rest
+   void test_persistent_snapshot()
+   {  // setup
+      custom::persistent_set <int> s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      custom::persistent_set <int> snap = s.snapshot();
+      bool added = s.insert(45);
+      bool removed = s.erase(20);
+      bool missing = s.erase(99);
+      // verify
+      assertUnit(added);
+      assertUnit(removed);
+      assertUnit(!missing);
+      assertUnit(valuesOf(snap) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+      assertUnit(valuesOf(s) == std::vector<int>({ 30, 40, 45, 50, 60, 70, 80 }));
+      assertUnit(snap.contains(20) && !s.contains(20));
+      assertUnit(s.size() == 7);
+      assertUnit(snap.size() == 7);
+   }  // teardown
+
+   // ordered by its Compare, and found by key when that is transparent
+   void test_persistent_compare()
+   {  // setup
+      custom::persistent_set <int, std::greater<int> > s;
+      custom::persistent_set <Account, std::less<> > accounts;
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         s.insert(i);
+         accounts.insert(Account(i * 10, "owner"));
+      }
+      // verify
+      assertUnit(valuesOf(s) == std::vector<int>({ 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }));
+      assertUnit(accounts.contains(30));
+      assertUnit(!accounts.contains(35));
+      assertUnit(accounts.erase(30));
+      assertUnit(accounts.size() == 9);
+   }  // teardown
+
+   /***************************************
+    * SPLIT and JOIN
+    ***************************************/
+
+   // the set keeps what is less than the key and hands back the rest
+   void test_split_standard()
+   {  // setup
+      custom::set <int> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      custom::set <int> sHigh = s.split(60);
+      // verify
+      assertUnit(s.size() == 60);
+      assertUnit(sHigh.size() == 40);
+      assertUnit(*s.nth(59) == 59);
+      assertUnit(*sHigh.begin() == 60);
+      assertUnit(s.find(60) == s.end());
+      assertUnit(sHigh.find(59) == sHigh.end());
+      assertUnit(s.bst.root->isRed == false);
+      assertUnit(sHigh.bst.root->isRed == false);
+   }  // teardown
+
+   // two splits and a join take out a range without touching the rest
+   void test_split_cutRange()
+   {  // setup
+      custom::set <int> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      custom::set <int> sMiddle = s.split(20);
+      custom::set <int> sHigh = sMiddle.split(80);
+      s.join(sHigh);
+      // verify
+      assertUnit(s.size() == 40);
+      assertUnit(sMiddle.size() == 60);
+      assertUnit(sHigh.empty());
+      std::vector<int> expected;
+      for (int i = 0; i < 20; i++)
+         expected.push_back(i);
+      for (int i = 80; i < 100; i++)
+         expected.push_back(i);
+      assertUnit(valuesOf(s) == expected);
+      assertUnit(*sMiddle.begin() == 20);
+      assertUnit(*sMiddle.nth(59) == 79);
+   }  // teardown
+
+   // a set is not joined to one that starts with its own last element
+   void test_join_sameEnds()
+   {  // setup
+      custom::set <int> s{ 1, 2, 3 };
+      custom::set <int> sOther{ 3, 4 };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         s.join(sOther);
+      }
+      catch (const char * error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(s.size() == 3);
+      assertUnit(sOther.size() == 2);
+   }  // teardown
+
+   /***************************************
+    * SET ALGEBRA
+    ***************************************/
+
+   // everything in either, once, and balanced
+   void test_algebra_union()
+   {  // setup
+      custom::set <int> s1{ 1, 3, 5, 7, 9 };
+      custom::set <int> s2{ 2, 3, 4, 9, 10 };
+      custom::set <int> sEmpty;
+      // exercise
+      custom::set <int> sUnion = set_union(s1, s2);
+      custom::set <int> sSame = set_union(s1, sEmpty);
+      // verify
+      assertUnit(valuesOf(sUnion) == std::vector<int>({ 1, 2, 3, 4, 5, 7, 9, 10 }));
+      assertUnit(sUnion.size() == 8);
+      assertUnit(valuesOf(sSame) == valuesOf(s1));
+      assertUnit(depth(sUnion.bst.root) == 4);
+   }  // teardown
+
+   // only what is in both
+   void test_algebra_intersection()
+   {  // setup
+      custom::set <int> s1{ 1, 3, 5, 7, 9 };
+      custom::set <int> s2{ 2, 3, 4, 9, 10 };
+      custom::set <int> sEmpty;
+      // exercise
+      custom::set <int> sBoth = set_intersection(s1, s2);
+      custom::set <int> sNone = set_intersection(sEmpty, s2);
+      // verify
+      assertUnit(valuesOf(sBoth) == std::vector<int>({ 3, 9 }));
+      assertUnit(sBoth.size() == 2);
+      assertUnit(sNone.empty());
+   }  // teardown
+
+   // what is in the first and not the second, each way round
+   void test_algebra_difference()
+   {  // setup
+      custom::set <int> s1{ 1, 3, 5, 7, 9 };
+      custom::set <int> s2{ 2, 3, 4, 9, 10 };
+      // exercise
+      custom::set <int> s1Only = set_difference(s1, s2);
+      custom::set <int> s2Only = set_difference(s2, s1);
+      // verify
+      assertUnit(valuesOf(s1Only) == std::vector<int>({ 1, 5, 7 }));
+      assertUnit(valuesOf(s2Only) == std::vector<int>({ 2, 4, 10 }));
+   }  // teardown
+
+   // what is in one and not the other, in a B tree too
+   void test_algebra_symmetricDifference()
+   {  // setup
+      custom::set <int> s1{ 1, 3, 5, 7, 9 };
+      custom::set <int> s2{ 2, 3, 4, 9, 10 };
+      custom::set <int, custom::btree_layout<> > sTree1{ 1, 3, 5, 7, 9 };
+      custom::set <int, custom::btree_layout<> > sTree2{ 2, 3, 4, 9, 10 };
+      // exercise
+      custom::set <int> sEither = set_symmetric_difference(s1, s2);
+      auto sTreeEither = set_symmetric_difference(sTree1, sTree2);
+      // verify
+      assertUnit(valuesOf(sEither) == std::vector<int>({ 1, 2, 4, 5, 7, 10 }));
+      assertUnit(valuesOf(sTreeEither) == valuesOf(sEither));
+   }  // teardown
+
+   // a small set against a large one jumps through the large one
+   void test_algebra_gallop()
+   {  // setup
+      std::vector<int> evens;
+      for (int i = 0; i < 10000; i += 2)
+         evens.push_back(i);
+      custom::set <int> sLarge(custom::assume_sorted, evens.begin(), evens.end());
+      custom::set <int> sSmall{ -4, 0, 1, 2, 5000, 5001, 9998, 20000 };
+      // exercise
+      custom::set <int> sBoth = set_intersection(sSmall, sLarge);
+      custom::set <int> sBothToo = set_intersection(sLarge, sSmall);
+      custom::set <int> sSmallOnly = set_difference(sSmall, sLarge);
+      custom::set <int> sLargeOnly = set_difference(sLarge, sSmall);
+      // verify
+      assertUnit(valuesOf(sBoth) == std::vector<int>({ 0, 2, 5000, 9998 }));
+      assertUnit(valuesOf(sBothToo) == valuesOf(sBoth));
+      assertUnit(valuesOf(sSmallOnly) == std::vector<int>({ -4, 1, 5001, 20000 }));
+      assertUnit(sLargeOnly.size() == 4996);
+      assertUnit(sLargeOnly.find(5000) == sLargeOnly.end());
+      assertUnit(sLargeOnly.find(5002) != sLargeOnly.end());
+   }  // teardown
+
+   // where both have an element, the result has the left one's
+   void test_algebra_keepsLeft()
+   {  // setup
+      custom::set <Account> s1{ Account(1, "left"), Account(2, "left") };
+      custom::set <Account> s2{ Account(2, "right"), Account(3, "right") };
+      // exercise
+      custom::set <Account> sUnion = set_union(s1, s2);
+      custom::set <Account> sUnionFlipped = set_union(s2, s1);
+      // verify
+      assertUnit(sUnion.size() == 3);
+      assertUnit((*sUnion.find(Account(2))).name == "left");
+      assertUnit((*sUnionFlipped.find(Account(2))).name == "right");
+      assertUnit((*sUnion.find(Account(3))).name == "right");
+   }  // teardown
+
+   /***************************************
+    * FLAT
+    ***************************************/
+
+   // a batch is sorted and merged in, repeats dropped, in one allocation
+   void test_flat_batchInsert()
+   {  // setup
+      custom::flat_set <int> s{ 50, 10, 30 };
+      std::vector<int> batch{ 40, 20, 30, 60, 20, 0 };
+      // exercise
+      s.insert(batch.begin(), batch.end());
+      // verify
+      assertUnit(valuesOf(s) == std::vector<int>({ 0, 10, 20, 30, 40, 50, 60 }));
+      assertUnit(s.size() == 7);
+      assertUnit(s.capacity() == 9);
+      s.insert({ 70, 90, 80, 90 });
+      assertUnit(valuesOf(s) == std::vector<int>({ 0, 10, 20, 30, 40, 50, 60, 70, 80, 90 }));
+   }  // teardown
+
+   // what is already there wins, then the first of the batch
+   void test_flat_batchKeepsFirst()
+   {  // setup
+      custom::flat_set <Account> s{ Account(2, "old") };
+      std::vector<Account> batch{ Account(3, "first"), Account(2, "new"), Account(3, "second"), Account(1, "new") };
+      // exercise
+      s.insert(batch.begin(), batch.end());
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit((*s.find(Account(1))).name == "new");
+      assertUnit((*s.find(Account(2))).name == "old");
+      assertUnit((*s.find(Account(3))).name == "first");
+   }  // teardown
+
+   // every search agrees with std::set, and by key when Compare is transparent
+   void test_flat_lookup()
+   {  // setup
+      custom::flat_set <int> s;
+      std::set<int> expected;
+      unsigned int seed = 11;
+      std::vector<int> batch;
+      for (int i = 0; i < 500; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         batch.push_back((int)(seed >> 16) % 2000);
+      }
+      s.insert(batch.begin(), batch.end());
+      expected.insert(batch.begin(), batch.end());
+      custom::flat_set <Account, std::less<> > accounts{ Account(7, "Ann"), Account(3, "Bo") };
+      // exercise
+      bool same = s.size() == expected.size();
+      for (int k = -1; k <= 2000; k++)
+      {
+         auto itLower = s.lower_bound(k);
+         auto itUpper = s.upper_bound(k);
+         auto itExpected = expected.lower_bound(k);
+         same = same && (itLower == s.end() ? itExpected == expected.end() : *itLower == *itExpected);
+         same = same && (s.find(k) != s.end()) == (expected.count(k) == 1);
+         same = same && distance(itLower, itUpper) == (std::ptrdiff_t)expected.count(k);
+         same = same && s.rank(k) == (size_t)std::distance(expected.begin(), itExpected);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(*s.nth(0) == *expected.begin());
+      assertUnit(*s.nth(s.size() - 1) == *expected.rbegin());
+      assertUnit(s.nth(s.size()) == s.end());
+      assertUnit((*accounts.find(3)).name == "Bo");
+      assertUnit(accounts.find(4) == accounts.end());
+   }  // teardown
+
+   // one at a time, in the middle, at the ends, and by hint
+   void test_flat_insertErase()
+   {  // setup
+      custom::flat_set <int> s{ 20, 40 };
+      // exercise
+      bool added = s.insert(30).second;
+      bool repeated = s.insert(30).second;
+      s.insert(s.begin(), 10);
+      s.insert(s.end(), 50);
+      s.insert(s.begin(), 45);   // wrong hint: searched for instead
+      size_t numRemoved = s.erase(40);
+      numRemoved += s.erase(99);
+      auto it = s.find(10);
+      auto itNext = s.erase(it);
+      // verify
+      assertUnit(added);
+      assertUnit(!repeated);
+      assertUnit(numRemoved == 1);
+      assertUnit(itNext == s.begin() && *itNext == 20);
+      assertUnit(valuesOf(s) == std::vector<int>({ 20, 30, 45, 50 }));
+   }  // teardown
+
+   // split off the top, then join it back
+   void test_flat_splitJoin()
+   {  // setup
+      custom::flat_set <int> s;
+      std::vector<int> batch;
+      for (int i = 0; i < 100; i++)
+         batch.push_back(i);
+      s.insert(batch.begin(), batch.end());
+      custom::flat_set <int> sOverlap{ 50 };
+      bool thrown = false;
+      // exercise
+      custom::flat_set <int> sHigh = s.split(60);
+      try
+      {
+         s.join(sOverlap);
+      }
+      catch (const char * error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(s.size() == 60);
+      assertUnit(sHigh.size() == 40);
+      assertUnit(*sHigh.begin() == 60);
+      assertUnit(thrown);
+      s.join(sHigh);
+      assertUnit(s.size() == 100);
+      assertUnit(sHigh.empty());
+      assertUnit(valuesOf(s) == batch);
+   }  // teardown
+
+   // the same answers as the set, through a long gallop too
+   void test_flat_algebra()
+   {  // setup
+      custom::flat_set <int> s1{ 1, 3, 5, 7, 9 };
+      custom::flat_set <int> s2{ 2, 3, 4, 9, 10 };
+      std::vector<int> evens;
+      for (int i = 0; i < 10000; i += 2)
+         evens.push_back(i);
+      custom::flat_set <int> sLarge(custom::assume_sorted, evens.begin(), evens.end());
+      custom::flat_set <int> sSmall{ -4, 0, 1, 2, 5000, 5001, 9998, 20000 };
+      // exercise
+      auto sUnion = set_union(s1, s2);
+      auto sBoth = set_intersection(s1, s2);
+      auto s1Only = set_difference(s1, s2);
+      auto sEither = set_symmetric_difference(s1, s2);
+      auto sGallop = set_intersection(sSmall, sLarge);
+      auto sLargeOnly = set_difference(sLarge, sSmall);
+      // verify
+      assertUnit(valuesOf(sUnion) == std::vector<int>({ 1, 2, 3, 4, 5, 7, 9, 10 }));
+      assertUnit(valuesOf(sBoth) == std::vector<int>({ 3, 9 }));
+      assertUnit(valuesOf(s1Only) == std::vector<int>({ 1, 5, 7 }));
+      assertUnit(valuesOf(sEither) == std::vector<int>({ 1, 2, 4, 5, 7, 10 }));
+      assertUnit(valuesOf(sGallop) == std::vector<int>({ 0, 2, 5000, 9998 }));
+      assertUnit(sLargeOnly.size() == 4996);
+      assertUnit(sUnion == set_union(s2, s1));
+   }  // teardown
+
+   template <class Set>
+   std::vector<int> valuesOf(const Set & s)
+   {
+      std::vector<int> values;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   template <class BNode>
+   int depth(const BNode * p)
+   {
+      return p ? 1 + std::max(depth(p->pLeft), depth(p->pRight)) : 0;
+   }
+
 
    /***************************************
     * Assignment
@@ -0,0 +1,508 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT MAP
+ * Summary:
+ *    An ordered map that many threads may use at once.  Readers
+ *    never lock: they read whichever version of the tree is current
+ *    when they start, and that version stays whole until they are
+ *    done.  Writers take turns, and never change a node a reader
+ *    might see: they copy the path from the root down to the change
+ *    and swing the root over to the copy.  The nodes a write leaves
+ *    behind are freed once every reader that could have seen them
+ *    has left (epoch-based reclamation).
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        concurrent_map           : A thread-safe ordered map
+ *        concurrent_map::view     : One version of it, to iterate
+ * Authors
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <atomic>     // for std::atomic
+#include <cstdint>    // for uint64_t
+#include <mutex>      // for std::mutex
+#include <thread>     // for std::this_thread
+#include <functional> // for std::hash
+#include <vector>
+#include <utility>    // for std::pair
+#include "pair.h"     // for pair
+
+class TestConcurrentMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************************
+ * CONCURRENT MAP
+ * A treap whose nodes never change once they are in the tree.
+ * find(), contains() and snapshot() are lock-free; insert(),
+ * insert_or_assign() and erase() hold a mutex while they build the
+ * new path, but never wait on a reader.
+ *****************************************************************/
+template <class K, class V>
+class concurrent_map
+{
+   friend class ::TestConcurrentMap; // give unit tests access to the privates
+
+   struct Node;
+   class Guard;
+
+public:
+   typedef pair <K, V> Pairs;
+
+   //
+   // Construct
+   //
+   concurrent_map() : root(nullptr), numElements(0), epoch(1), seed(2463534242u)
+   {
+      for (auto & slot : slots)
+         slot.epoch = 0;
+   }
+   concurrent_map(const concurrent_map & rhs) = delete;
+   concurrent_map & operator = (const concurrent_map & rhs) = delete;
+  ~concurrent_map();
+
+   //
+   // Access: lock-free
+   //
+   bool find(const K & k, V & v) const;
+   bool contains(const K & k) const
+   {
+      V v;
+      return find(k, v);
+   }
+
+   class view;
+   view snapshot() const { return view(*this); }
+
+   //
+   // Insert and Remove: one writer at a time
+   //
+   bool insert(const K & k, const V & v) { return write(k, &v, false /* overwrite */); }
+   bool insert_or_assign(const K & k, const V & v) { return write(k, &v, true /* overwrite */); }
+   bool erase(const K & k) { return write(k, nullptr, false /* overwrite */); }
+
+   //
+   // Status
+   //
+   size_t size() const noexcept { return numElements.load(); }
+   bool empty() const noexcept { return size() == 0; }
+
+private:
+   //
+   // Writer Helpers: all hold the mutex
+   //
+   bool write(const K & k, const V * pV, bool overwrite);
+   Node * insertCopy(Node * p, const K & k, const V & v, bool overwrite, bool & changed);
+   Node * eraseCopy(Node * p, const K & k, bool & changed);
+   Node * merge(Node * pLeft, Node * pRight);
+   Node * copy(Node * p);
+   void reclaim();
+   static void destroy(Node * p);
+
+   // enough that readers seldom wait for a free slot
+   static const size_t NUM_SLOTS = 128;
+
+   // one reader's announcement; padded to a cache line so readers
+   // do not slow each other down
+   struct Slot
+   {
+      std::atomic<uint64_t> epoch;   // 0 when nobody is reading
+      char padding[64 - sizeof(std::atomic<uint64_t>)];
+   };
+
+   //
+   // Member Variables
+   //
+   std::atomic<Node *> root;                       // the current version
+   std::atomic<size_t> numElements;                // in the current version
+   std::atomic<uint64_t> epoch;                    // bumped by every write
+   mutable Slot slots[NUM_SLOTS];                  // epochs of active readers
+   std::mutex writeLock;                           // writers take turns
+   std::vector<std::pair<uint64_t, Node *> > retired; // waiting to be freed
+   std::vector<Node *> created;                    // made by the current write
+   uint32_t seed;                                  // for treap priorities
+};
+
+/*****************************************************************
+ * CONCURRENT MAP NODE
+ * Immutable once a reader can reach it
+ *****************************************************************/
+template <class K, class V>
+struct concurrent_map <K, V> :: Node
+{
+   Node(const K & k, const V & v, uint32_t priority) :
+      data(k, v), priority(priority), pLeft(nullptr), pRight(nullptr) { }
+   Pairs data;
+   uint32_t priority;   // never less than the children's
+   Node * pLeft;
+   Node * pRight;
+};
+
+/*****************************************************************
+ * CONCURRENT MAP GUARD
+ * While a guard lives, nothing reachable from the root it saw is
+ * freed.  It claims a slot and announces the epoch it started in.
+ *****************************************************************/
+template <class K, class V>
+class concurrent_map <K, V> :: Guard
+{
+public:
+   Guard(const concurrent_map & m) : pSlot(nullptr)
+   {
+      // start at a slot that is likely ours, so readers do not collide
+      static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+      uint64_t e = m.epoch.load();
+      for (size_t i = hint; !pSlot; i++)
+      {
+         uint64_t free = 0;
+         Slot & slot = m.slots[i % NUM_SLOTS];
+         if (slot.epoch.load() == 0 && slot.epoch.compare_exchange_strong(free, e))
+         {
+            pSlot = &slot;
+            hint = i % NUM_SLOTS;
+         }
+         else if (i - hint >= NUM_SLOTS)
+            std::this_thread::yield();
+      }
+   }
+   Guard(Guard && rhs) : pSlot(rhs.pSlot) { rhs.pSlot = nullptr; }
+   Guard(const Guard & rhs) = delete;
+  ~Guard()
+   {
+      if (pSlot)
+         pSlot->epoch.store(0);
+   }
+
+private:
+   Slot * pSlot;
+};
+
+/*****************************************************************
+ * CONCURRENT MAP VIEW
+ * One version of the map, which no write will disturb: iterate it
+ * in order for as long as the view lives
+ *****************************************************************/
+template <class K, class V>
+class concurrent_map <K, V> :: view
+{
+   friend class concurrent_map <K, V>;
+public:
+   class iterator;
+   view(view && rhs) : guard(std::move(rhs.guard)), pRoot(rhs.pRoot) { }
+
+   iterator begin() const { return iterator(pRoot); }
+   iterator end()   const { return iterator(); }
+
+private:
+   view(const concurrent_map & m) : guard(m), pRoot(m.root.load()) { }
+   Guard guard;
+   const Node * pRoot;
+};
+
+/*****************************************************************
+ * CONCURRENT MAP VIEW ITERATOR
+ * Nodes have no parent pointers, since a node may be shared by
+ * many versions, so the path down is kept on a stack
+ *****************************************************************/
+template <class K, class V>
+class concurrent_map <K, V> :: view :: iterator
+{
+public:
+   iterator() { }
+   iterator(const Node * pRoot) { pushLeft(pRoot); }
+
+   bool operator == (const iterator & rhs) const { return path == rhs.path; }
+   bool operator != (const iterator & rhs) const { return path != rhs.path; }
+
+   const Pairs & operator * () const { return path.back()->data; }
+
+   iterator & operator ++ ()
+   {
+      const Node * p = path.back();
+      path.pop_back();
+      pushLeft(p->pRight);
+      return *this;
+   }
+   iterator operator ++ (int)
+   {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+   }
+
+private:
+   void pushLeft(const Node * p)
+   {
+      for (; p; p = p->pLeft)
+         path.push_back(p);
+   }
+   std::vector<const Node *> path;   // empty at end()
+};
+
+/*****************************************************
+ * CONCURRENT MAP :: DESTRUCTOR
+ * No reader may still be at work
+ ****************************************************/
+template <class K, class V>
+concurrent_map <K, V> :: ~concurrent_map()
+{
+   destroy(root.load());
+   for (auto & r : retired)
+      delete r.second;
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: FIND
+ * Walk down whatever version is current
+ *    COST   : O(log n), with no lock and no write
+ *             other than the reader's own slot
+ ****************************************************/
+template <class K, class V>
+bool concurrent_map <K, V> ::find(const K & k, V & v) const
+{
+   Guard guard(*this);
+   const Node * p = root.load();
+   while (p)
+   {
+      if (k < p->data.first)
+         p = p->pLeft;
+      else if (p->data.first < k)
+         p = p->pRight;
+      else
+      {
+         v = p->data.second;
+         return true;
+      }
+   }
+   return false;
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: WRITE
+ * Build the new version beside the old, publish it
+ * with one store, then retire the nodes it replaced.
+ *    INPUT  : the key, the value (null to erase), and
+ *             whether to overwrite a value already there
+ *    OUTPUT : whether an element was added or removed
+ *    COST   : O(log n), plus freeing what is safe to
+ ****************************************************/
+template <class K, class V>
+bool concurrent_map <K, V> ::write(const K & k, const V * pV, bool overwrite)
+{
+   std::lock_guard<std::mutex> lock(writeLock);
+   Node * pOld = root.load();
+   size_t numRetired = retired.size();
+   bool changed = false;
+   Node * pNew;
+   try
+   {
+      pNew = pV ? insertCopy(pOld, k, *pV, overwrite, changed)
+                : eraseCopy(pOld, k, changed);
+   }
+   catch (...)
+   {
+      // nobody has seen the new nodes, and the old ones stay put
+      for (auto p : created)
+         delete p;
+      created.clear();
+      retired.resize(numRetired);
+      throw "ERROR: Unable to allocate a node";
+   }
+   created.clear();
+
+   if (pNew != pOld)
+   {
+      // readers that start after this see only the new version
+      root.store(pNew);
+      uint64_t e = epoch.fetch_add(1);
+      for (size_t i = numRetired; i < retired.size(); i++)
+         retired[i].first = e;
+   }
+   if (changed && pV)
+      numElements++;
+   else if (changed)
+      numElements--;
+   reclaim();
+   return changed;
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: COPY
+ * A fresh copy of p, and p goes on the retired list
+ ****************************************************/
+template <class K, class V>
+typename concurrent_map <K, V> ::Node * concurrent_map <K, V> ::copy(Node * p)
+{
+   created.reserve(created.size() + 1);
+   retired.reserve(retired.size() + 1);
+   Node * pCopy = new Node(*p);
+   created.push_back(pCopy);
+   retired.push_back(std::pair<uint64_t, Node *>(0, p));
+   return pCopy;
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: INSERT COPY
+ * Copy the path down to k and put k there, then rotate
+ * the new node up while it outranks its parent.  Only
+ * copies are rotated, so no reader sees a change.
+ *    OUTPUT : the new subtree, or p if nothing changed
+ ****************************************************/
+template <class K, class V>
+typename concurrent_map <K, V> ::Node * concurrent_map <K, V> ::insertCopy(Node * p, const K & k, const V & v, bool overwrite, bool & changed)
+{
+   if (!p)
+   {
+      created.reserve(created.size() + 1);
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      Node * pNew = new Node(k, v, seed);
+      created.push_back(pNew);
+      changed = true;
+      return pNew;
+   }
+
+   if (k < p->data.first)
+   {
+      Node * pLeft = insertCopy(p->pLeft, k, v, overwrite, changed);
+      if (pLeft == p->pLeft)
+         return p;
+      Node * pCopy = copy(p);
+      pCopy->pLeft = pLeft;
+      if (pLeft->priority <= pCopy->priority)
+         return pCopy;
+
+      // rotate right: both nodes are new
+      pCopy->pLeft = pLeft->pRight;
+      pLeft->pRight = pCopy;
+      return pLeft;
+   }
+
+   if (p->data.first < k)
+   {
+      Node * pRight = insertCopy(p->pRight, k, v, overwrite, changed);
+      if (pRight == p->pRight)
+         return p;
+      Node * pCopy = copy(p);
+      pCopy->pRight = pRight;
+      if (pRight->priority <= pCopy->priority)
+         return pCopy;
+
+      // rotate left: both nodes are new
+      pCopy->pRight = pRight->pLeft;
+      pRight->pLeft = pCopy;
+      return pRight;
+   }
+
+   // already here
+   if (!overwrite)
+      return p;
+   Node * pCopy = copy(p);
+   pCopy->data.second = v;
+   return pCopy;
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: ERASE COPY
+ * Copy the path down to k, and put the merge of its
+ * children where it was
+ *    OUTPUT : the new subtree, or p if k is not here
+ ****************************************************/
+template <class K, class V>
+typename concurrent_map <K, V> ::Node * concurrent_map <K, V> ::eraseCopy(Node * p, const K & k, bool & changed)
+{
+   if (!p)
+      return nullptr;
+
+   if (k < p->data.first || p->data.first < k)
+   {
+      bool goLeft = k < p->data.first;
+      Node * pChild = eraseCopy(goLeft ? p->pLeft : p->pRight, k, changed);
+      if (!changed)
+         return p;
+      Node * pCopy = copy(p);
+      (goLeft ? pCopy->pLeft : pCopy->pRight) = pChild;
+      return pCopy;
+   }
+
+   changed = true;
+   retired.reserve(retired.size() + 1);
+   retired.push_back(std::pair<uint64_t, Node *>(0, p));
+   return merge(p->pLeft, p->pRight);
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: MERGE
+ * Join two treaps, everything in pLeft before everything
+ * in pRight, copying the spines that meet
+ ****************************************************/
+template <class K, class V>
+typename concurrent_map <K, V> ::Node * concurrent_map <K, V> ::merge(Node * pLeft, Node * pRight)
+{
+   if (!pLeft)
+      return pRight;
+   if (!pRight)
+      return pLeft;
+
+   if (pLeft->priority > pRight->priority)
+   {
+      Node * pCopy = copy(pLeft);
+      pCopy->pRight = merge(pLeft->pRight, pRight);
+      return pCopy;
+   }
+   Node * pCopy = copy(pRight);
+   pCopy->pLeft = merge(pLeft, pRight->pLeft);
+   return pCopy;
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: RECLAIM
+ * Free what was retired before the oldest epoch a
+ * reader is still in.  Retired nodes are in epoch
+ * order, so these come off the front.
+ ****************************************************/
+template <class K, class V>
+void concurrent_map <K, V> ::reclaim()
+{
+   uint64_t oldest = epoch.load();
+   for (auto & slot : slots)
+   {
+      uint64_t e = slot.epoch.load();
+      if (e && e < oldest)
+         oldest = e;
+   }
+
+   size_t num = 0;
+   while (num < retired.size() && retired[num].first < oldest)
+      delete retired[num++].second;
+   retired.erase(retired.begin(), retired.begin() + num);
+}
+
+/*****************************************************
+ * CONCURRENT MAP :: DESTROY
+ * Delete a whole version
+ ****************************************************/
+template <class K, class V>
+void concurrent_map <K, V> ::destroy(Node * p)
+{
+   if (!p)
+      return;
+   destroy(p->pLeft);
+   destroy(p->pRight);
+   delete p;
+}
+
+} // namespace custom
@@ -0,0 +1,259 @@
+/***********************************************************************
+ * Header:
+ *    FLAT MAP
+ * Summary:
+ *    An ordered map whose pairs sit side by side, in order by key,
+ *    in one vector.  It is a fraction of the size of a map and a
+ *    lookup is a binary search through one array, but one insert
+ *    or erase moves every pair after it: fill it in batches, or
+ *    up front, and then read it.  The pairs are kept in a
+ *    flat_set, ordered by key alone.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        flat_map           : A map in a sorted vector
+ *        flat_map::iterator : An iterator through it
+ * Authors
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include <stdexcept>   // for std::out_of_range
+#include "pair.h"      // for pair
+#include "map.h"       // for map::value_compare
+#include "flatSet.h"   // for flat_set
+
+class TestMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************************
+ * FLAT MAP
+ * The same interface as map.  An iterator points into the
+ * vector, so any insert may move what it points at.
+ *****************************************************************/
+template <class K, class V, class Compare = std::less<K> >
+class flat_map
+{
+   friend ::TestMap; // give unit tests access to the privates
+public:
+   typedef pair <K, V> Pairs;
+   typedef typename map <K, V, red_black, Compare> ::value_compare value_compare;
+   typedef typename flat_set <Pairs, value_compare> ::iterator iterator;
+
+   //
+   // Construct
+   //
+   flat_map() { }
+   explicit flat_map(const Compare & comp) : pairs(value_compare(comp)) { }
+   flat_map(const flat_map &  rhs) : pairs(rhs.pairs)            { }
+   flat_map(      flat_map && rhs) : pairs(std::move(rhs.pairs)) { }
+   flat_map(const std::initializer_list<Pairs> & il) : pairs(il) { }
+  ~flat_map() { }
+
+   // any range loads with one sort; say assume_sorted to skip it
+   template <class Iterator>
+   flat_map(Iterator first, Iterator last) : pairs(first, last) { }
+   template <class Iterator>
+   flat_map(assume_sorted_t, Iterator first, Iterator last) : pairs(assume_sorted, first, last) { }
+
+   //
+   // Assign
+   //
+   flat_map & operator = (const flat_map & rhs)
+   {
+      pairs = rhs.pairs;
+      return *this;
+   }
+   flat_map & operator = (flat_map && rhs)
+   {
+      pairs = std::move(rhs.pairs);
+      return *this;
+   }
+   flat_map & operator = (const std::initializer_list <Pairs> & il)
+   {
+      pairs = il;
+      return *this;
+   }
+   void swap(flat_map & rhs) noexcept { pairs.swap(rhs.pairs); }
+
+   //
+   // Iterator
+   //
+   iterator begin() const { return pairs.begin(); }
+   iterator end()   const { return pairs.end();   }
+
+   //
+   // Access: a pair is never built to look up a key
+   //
+   V & operator [] (const K & k);
+   const V & at (const K & k) const;
+         V & at (const K & k);
+   iterator find(const K & k) const        { return pairs.find(k);        }
+   iterator lower_bound(const K & k) const { return pairs.lower_bound(k); }
+   iterator upper_bound(const K & k) const { return pairs.upper_bound(k); }
+   pair<iterator, iterator> equal_range(const K & k) const
+   {
+      return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+   }
+
+   // every entry with a key from a up to, but not including, b
+   pair<iterator, iterator> range(const K & a, const K & b) const
+   {
+      iterator itLast = lower_bound(b);
+      return pair<iterator, iterator>(key_comp()(b, a) ? itLast : lower_bound(a), itLast);
+   }
+
+   Compare key_comp() const         { return pairs.key_comp().key_comp(); }
+   value_compare value_comp() const { return pairs.key_comp();            }
+
+   //
+   // Order Statistics: O(1) and O(log n)
+   //
+   iterator nth(size_t k) const   { return pairs.nth(k);         }
+   size_t rank(const K & k) const { return pairs.search(k);      }
+
+   //
+   // Insert: one at a time is O(n); a range is one sort and merge
+   //
+   pair<iterator, bool> insert(const Pairs & rhs)
+   {
+      auto returnPair = pairs.insert(rhs);
+      return pair<iterator, bool>(returnPair.first, returnPair.second);
+   }
+
+   pair<iterator, bool> insert(Pairs && rhs)
+   {
+      auto returnPair = pairs.insert(std::move(rhs));
+      return pair<iterator, bool>(returnPair.first, returnPair.second);
+   }
+
+   // no search when the key belongs just before hint
+   iterator insert(iterator hint, const Pairs & rhs) { return pairs.insert(hint, rhs);            }
+   iterator insert(iterator hint, Pairs && rhs)      { return pairs.insert(hint, std::move(rhs)); }
+
+   template <class ... Args>
+   iterator emplace_hint(iterator hint, Args && ... args)
+   {
+      return insert(hint, Pairs(std::forward<Args>(args)...));
+   }
+
+   template <class Iterator>
+   void insert(Iterator first, Iterator last)          { pairs.insert(first, last); }
+   void insert(const std::initializer_list<Pairs> & il) { pairs.insert(il);          }
+
+   //
+   // Remove: O(n)
+   //
+   void clear() noexcept { pairs.clear(); }
+   size_t erase(const K & k);
+   iterator erase(iterator it)                 { return pairs.erase(it);        }
+   iterator erase(iterator first, iterator last) { return pairs.erase(first, last); }
+
+   //
+   // Split and Join: O(n) for the pairs that move
+   //
+   flat_map split(const K & k);   // the pairs not less than k move to the result
+   void join(flat_map & rhs);     // all of rhs, which comes after all of this, moves here
+
+   //
+   // Status
+   //
+   bool empty()  const noexcept { return pairs.empty(); }
+   size_t size() const noexcept { return pairs.size();  }
+   size_t capacity() const noexcept { return pairs.capacity(); }
+   void reserve(size_t num)         { pairs.reserve(num);      }
+   void shrink_to_fit()             { pairs.shrink_to_fit();   }
+
+private:
+   flat_set <Pairs, value_compare> pairs;
+};
+
+/*****************************************************
+ * FLAT MAP :: SUBSCRIPT
+ * Retrieve the value for k, adding a default one first
+ * if k is not there
+ ****************************************************/
+template <class K, class V, class Compare>
+V & flat_map <K, V, Compare> ::operator [] (const K & k)
+{
+   size_t i = pairs.search(k);
+   if (i == pairs.size() || pairs.less(k, pairs.data[i]))
+      pairs.place(i, Pairs(k, V()));
+   return pairs.data[i].second;
+}
+
+/*****************************************************
+ * FLAT MAP :: AT
+ * Retrieve the value for k, which must be there
+ ****************************************************/
+template <class K, class V, class Compare>
+V & flat_map <K, V, Compare> ::at(const K & k)
+{
+   size_t i = pairs.found(k);
+   if (i == pairs.size())
+      throw std::out_of_range("invalid flat_map<K, T> key");
+   return pairs.data[i].second;
+}
+
+template <class K, class V, class Compare>
+const V & flat_map <K, V, Compare> ::at(const K & k) const
+{
+   size_t i = pairs.found(k);
+   if (i == pairs.size())
+      throw std::out_of_range("invalid flat_map<K, T> key");
+   return pairs.data[i].second;
+}
+
+/*****************************************************
+ * FLAT MAP :: ERASE
+ * Find and erase one pair
+ ****************************************************/
+template <class K, class V, class Compare>
+size_t flat_map <K, V, Compare> ::erase(const K & k)
+{
+   auto it = find(k);
+
+   if (it == end())
+      return 0;
+
+   erase(it);
+
+   return 1;
+}
+
+/*****************************************************
+ * FLAT MAP :: SPLIT
+ * Keep the pairs whose keys are less than k, and hand
+ * back the rest
+ ****************************************************/
+template <class K, class V, class Compare>
+flat_map <K, V, Compare> flat_map <K, V, Compare> ::split(const K & k)
+{
+   flat_map rest(key_comp());
+   rest.pairs = pairs.split(k);
+   return rest;
+}
+
+/*****************************************************
+ * FLAT MAP :: JOIN
+ * Take every pair of rhs, whose keys must all come
+ * after all of ours.  The flat_set checks that, by
+ * key, against its last and first.
+ ****************************************************/
+template <class K, class V, class Compare>
+void flat_map <K, V, Compare> ::join(flat_map & rhs)
+{
+   pairs.join(rhs.pairs);
+}
+
+} // namespace custom
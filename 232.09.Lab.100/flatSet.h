@@ -0,0 +1,683 @@
+/***********************************************************************
+ * Header:
+ *    FLAT SET
+ * Summary:
+ *    A set whose elements sit side by side, in order, in one vector.
+ *    There is no node per element: no pointers, no color, no
+ *    separate allocation, so it is a fraction of the size of a set
+ *    and a lookup is a binary search through one array.  The price
+ *    is that one insert or erase moves everything after it, so
+ *    load it in batches: insert(first, last) sorts what is new and
+ *    merges it in with one pass.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        flat_set           : A set in a sorted vector
+ *        flat_set::iterator : An iterator through it
+ * Authors
+ *    Hunter Powell
+ *    Carol Mercau
+ *    Elijah Harrison
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>    // for std::ptrdiff_t
+#include <algorithm>  // for std::stable_sort
+#include <functional> // for std::less
+#include "vector.h"   // for vector
+#include "bst.h"      // for compare_holder, assume_sorted and is_transparent
+#include "frozenSet.h"
+
+class TestSet;        // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * FLAT SET
+ * The same interface as set: the elements are kept
+ * unique and in the order Compare gives them.  An
+ * iterator is a pointer into the vector, so any
+ * insert may move what it points at.
+ ***********************************************/
+template <typename T, class Compare = std::less<T> >
+class flat_set : private compare_holder<Compare>
+{
+   friend class ::TestSet; // give unit tests access to the privates
+   template <class K, class V, class C>
+   friend class flat_map;
+public:
+
+   //
+   // Construct
+   //
+   flat_set() { }
+   explicit flat_set(const Compare & comp) : compare_holder<Compare>(comp) { }
+   flat_set(const flat_set & rhs) : compare_holder<Compare>(rhs), data(rhs.data) { }
+   flat_set(flat_set && rhs) : compare_holder<Compare>(rhs), data(std::move(rhs.data)) { }
+   flat_set(const std::initializer_list <T> & il) { insert(il.begin(), il.end()); }
+
+   // any range loads with one sort; say assume_sorted to skip it
+   template <class Iterator>
+   flat_set(Iterator first, Iterator last) { insert(first, last); }
+   template <class Iterator>
+   flat_set(assume_sorted_t, Iterator first, Iterator last)
+   {
+      for (auto it = first; it != last; ++it)
+         if (data.empty() || less(data.back(), *it))
+            data.push_back(*it);
+   }
+
+  ~flat_set() { }
+
+   //
+   // Assign
+   //
+   flat_set & operator = (const flat_set & rhs)
+   {
+      compare_holder<Compare>::operator = (rhs);
+      data = rhs.data;
+      return *this;
+   }
+
+   flat_set & operator = (flat_set && rhs)
+   {
+      compare_holder<Compare>::operator = (rhs);
+      data = std::move(rhs.data);
+      return *this;
+   }
+
+   flat_set & operator = (const std::initializer_list <T> & il)
+   {
+      clear();
+      insert(il.begin(), il.end());
+      return *this;
+   }
+
+   void swap(flat_set & rhs) noexcept
+   {
+      std::swap(static_cast<compare_holder<Compare> &>(*this),
+                static_cast<compare_holder<Compare> &>(rhs));
+      data.swap(rhs.data);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+
+   iterator begin() const noexcept
+   {
+      return iterator(first());
+   }
+
+   iterator end() const noexcept
+   {
+      return iterator(first() + data.size());
+   }
+
+   //
+   // Access: each is a binary search, and each also takes anything
+   // Compare is transparent to without building a T
+   //
+   template <class Key>
+   using KeyOnly = typename std::enable_if<!std::is_same<Key, T>::value &&
+                                           is_transparent<Compare>::value>::type;
+
+   iterator find(const T & t) const
+   {
+      return at(found(t));
+   }
+   template <class Key, class = KeyOnly<Key> >
+   iterator find(const Key & k) const
+   {
+      return at(found(k));
+   }
+
+   iterator lower_bound(const T & t) const
+   {
+      return at(search(t));
+   }
+   template <class Key, class = KeyOnly<Key> >
+   iterator lower_bound(const Key & k) const
+   {
+      return at(search(k));
+   }
+
+   iterator upper_bound(const T & t) const
+   {
+      return at(searchPast(t));
+   }
+   template <class Key, class = KeyOnly<Key> >
+   iterator upper_bound(const Key & k) const
+   {
+      return at(searchPast(k));
+   }
+
+   std::pair<iterator, iterator> equal_range(const T & t) const
+   {
+      return std::pair<iterator, iterator>(lower_bound(t), upper_bound(t));
+   }
+   template <class Key, class = KeyOnly<Key> >
+   std::pair<iterator, iterator> equal_range(const Key & k) const
+   {
+      return std::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+   }
+
+   //
+   // Order Statistics: O(1) and O(log n), for the array is in order
+   //
+   iterator nth(size_t k) const
+   {
+      return at(k < data.size() ? k : data.size());
+   }
+
+   size_t rank(const T & t) const
+   {
+      return search(t);
+   }
+
+   //
+   // Freeze: a read-only copy laid out for fast lookups
+   //
+   frozen_set <T, Compare> freeze() const
+   {
+      return frozen_set <T, Compare> (begin(), end(), size(), key_comp());
+   }
+
+   Compare key_comp() const
+   {
+      return this->compare();
+   }
+
+   //
+   // Status
+   //
+   bool empty() const noexcept
+   {
+      return data.empty();
+   }
+
+   size_t size() const noexcept
+   {
+      return data.size();
+   }
+
+   size_t capacity() const noexcept
+   {
+      return data.capacity();
+   }
+
+   void reserve(size_t num)
+   {
+      data.reserve(num);
+   }
+
+   void shrink_to_fit()
+   {
+      data.shrink_to_fit();
+   }
+
+   //
+   // Insert: one at a time is O(n), for what comes after moves up
+   //
+   std::pair<iterator, bool> insert(const T & t)
+   {
+      size_t i = search(t);
+      if (i < data.size() && !less(t, data[i]))
+         return std::pair<iterator, bool>(at(i), false);
+      return std::pair<iterator, bool>(place(i, T(t)), true);
+   }
+
+   std::pair<iterator, bool> insert(T && t)
+   {
+      size_t i = search(t);
+      if (i < data.size() && !less(t, data[i]))
+         return std::pair<iterator, bool>(at(i), false);
+      return std::pair<iterator, bool>(place(i, std::move(t)), true);
+   }
+
+   // no search when t belongs just before hint
+   iterator insert(iterator hint, const T & t)
+   {
+      return insert(hint, T(t));
+   }
+
+   iterator insert(iterator hint, T && t)
+   {
+      size_t i = hint.p - first();
+      if ((i == data.size() || less(t, data[i])) && (i == 0 || less(data[i - 1], t)))
+         return place(i, std::move(t));
+      return insert(std::move(t)).first;
+   }
+
+   template <class ... Args>
+   iterator emplace_hint(iterator hint, Args && ... args)
+   {
+      return insert(hint, T(std::forward<Args>(args)...));
+   }
+
+   void insert(const std::initializer_list <T> & il)
+   {
+      insert(il.begin(), il.end());
+   }
+
+   template <class Iterator>
+   void insert(Iterator first, Iterator last);
+
+   //
+   // Remove: O(n), for what comes after moves down
+   //
+   void clear() noexcept
+   {
+      data.clear();
+   }
+
+   iterator erase(iterator & it)
+   {
+      iterator itNext = it;
+      ++itNext;
+      it = erase(it, itNext);
+      return it;
+   }
+
+   size_t erase(const T & t)
+   {
+      auto it = find(t);
+
+      if (it == end())
+         return 0;
+
+      erase(it);
+
+      return 1;
+   }
+
+   iterator erase(iterator & itBegin, iterator & itEnd);
+
+   //
+   // Split and Join: O(n) for the elements that move
+   //
+   flat_set split(const T & t)   // what is not less than t moves to the result
+   {
+      return splitAt(search(t));
+   }
+
+   template <class Key, class = KeyOnly<Key> >
+   flat_set split(const Key & k)
+   {
+      return splitAt(search(k));
+   }
+
+   void join(flat_set & rhs)     // all of rhs, which comes after all of this, moves here
+   {
+      if (!empty() && !rhs.empty() && !less(data.back(), rhs.data.front()))
+         throw "ERROR: Unable to join sets whose elements overlap";
+      data.reserve(data.size() + rhs.data.size());
+      for (size_t i = 0; i < rhs.data.size(); i++)
+         data.push_back(std::move(rhs.data[i]));
+      rhs.clear();
+   }
+
+   //
+   // Set Algebra: one merge of the two arrays.  Where both have an
+   // element, lhs's is kept.
+   //
+   friend flat_set set_union(const flat_set & lhs, const flat_set & rhs)
+   {
+      return combine(lhs, rhs, true /* left */, true /* both */, true /* right */);
+   }
+   friend flat_set set_intersection(const flat_set & lhs, const flat_set & rhs)
+   {
+      return combine(lhs, rhs, false /* left */, true /* both */, false /* right */);
+   }
+   friend flat_set set_difference(const flat_set & lhs, const flat_set & rhs)
+   {
+      return combine(lhs, rhs, true /* left */, false /* both */, false /* right */);
+   }
+   friend flat_set set_symmetric_difference(const flat_set & lhs, const flat_set & rhs)
+   {
+      return combine(lhs, rhs, true /* left */, false /* both */, true /* right */);
+   }
+
+private:
+   // the elements only in lhs, in both, and only in rhs, as asked
+   static flat_set combine(const flat_set & lhs, const flat_set & rhs, bool keepLeft, bool keepBoth, bool keepRight);
+
+   // the index of the first element from iFirst on not less than k
+   template <class Key>
+   size_t search(const Key & k, size_t iFirst = 0) const;
+
+   // the index of the first element greater than k
+   template <class Key>
+   size_t searchPast(const Key & k) const
+   {
+      size_t i = search(k);
+      return i + (i < data.size() && !less(k, data[i]));
+   }
+
+   // the index of k, or size() if it is not there
+   template <class Key>
+   size_t found(const Key & k) const
+   {
+      size_t i = search(k);
+      return (i < data.size() && !less(k, data[i])) ? i : data.size();
+   }
+
+   // move t in at index i, shifting what is there and after up one
+   iterator place(size_t i, T && t);
+   flat_set splitAt(size_t i);
+
+   const T * first() const { return data.empty() ? nullptr : &data.front(); }
+   iterator at(size_t i) const { return iterator(first() + i); }
+
+   template <class Lhs, class Rhs>
+   bool less(const Lhs & lhs, const Rhs & rhs) const { return this->compare()(lhs, rhs); }
+
+   vector <T> data;   // the elements, in order and unique
+};
+
+
+/**************************************************
+ * FLAT SET ITERATOR
+ * A pointer into the vector
+ *************************************************/
+template <typename T, class Compare>
+class flat_set <T, Compare> :: iterator
+{
+   friend class ::TestSet; // give unit tests access to the privates
+   friend class custom::flat_set<T, Compare>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) { }
+   iterator(const T * p) : p(p) { }
+   iterator(const iterator & rhs) : p(rhs.p) { }
+   iterator & operator = (const iterator & rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals operator
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+
+   // dereference operator: read-only, for the order must not change
+   const T & operator * () const { return *p; }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+      ++p;
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int)
+   {
+      auto tmp = *this;
+      ++p;
+      return tmp;
+   }
+
+   // prefix decrement
+   iterator & operator -- ()
+   {
+      --p;
+      return *this;
+   }
+
+   // postfix decrement
+   iterator operator -- (int)
+   {
+      auto tmp = *this;
+      --p;
+      return tmp;
+   }
+
+   // steps from first to last in O(1)
+   friend std::ptrdiff_t distance(const iterator & first, const iterator & last)
+   {
+      return last.p - first.p;
+   }
+
+private:
+   const T * p;
+};
+
+/*****************************************************
+ * FLAT SET :: SEARCH
+ * The index of the first element from iFirst on that
+ * is not less than k.  Each step halves what is left
+ * by moving the base, or not, on one comparison: the
+ * compiler makes that a conditional move, so there is
+ * no branch to mispredict.  Both places the next step
+ * may look are fetched ahead.
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Compare>
+template <class Key>
+size_t flat_set <T, Compare> ::search(const Key & k, size_t iFirst) const
+{
+   if (iFirst >= data.size())
+      return data.size();
+
+   const T * base = first() + iFirst;
+   size_t num = data.size() - iFirst;
+   while (num > 1)
+   {
+      size_t half = num / 2;
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(base + (num - half) / 2);
+      __builtin_prefetch(base + half + (num - half) / 2);
+#endif
+      base = less(base[half], k) ? base + half : base;
+      num -= half;
+   }
+   return (base - first()) + less(*base, k);
+}
+
+/*****************************************************
+ * FLAT SET :: INSERT RANGE
+ * Add the new elements to the end, sort just them, and
+ * merge the two runs into a new vector in one pass.
+ * The first of any repeated element wins: one already
+ * here, or else the first in the range.
+ *    COST   : O(n + m log m) for m new elements
+ ****************************************************/
+template <typename T, class Compare>
+template <class Iterator>
+void flat_set <T, Compare> ::insert(Iterator itFirst, Iterator itLast)
+{
+   size_t numOld = data.size();
+   for (auto it = itFirst; it != itLast; ++it)
+      data.push_back(*it);
+   size_t num = data.size();
+   if (num == numOld)
+      return;
+
+   // sort the new ones, keeping repeats in the order given
+   T * a = &data.front();
+   Compare comp = key_comp();
+   std::stable_sort(a + numOld, a + num, comp);
+
+   // all after what is here: just drop the repeats
+   if (numOld == 0 || less(a[numOld - 1], a[numOld]))
+   {
+      size_t iTo = numOld;
+      for (size_t i = numOld; i < num; i++)
+         if (iTo == numOld || less(a[iTo - 1], a[i]))
+         {
+            if (iTo != i)
+               a[iTo] = std::move(a[i]);
+            iTo++;
+         }
+      while (data.size() > iTo)
+         data.pop_back();
+      return;
+   }
+
+   // merge: on a tie the old one goes first, and the new one is dropped
+   vector <T> merged;
+   merged.reserve(num);
+   size_t iOld = 0;
+   size_t iNew = numOld;
+   while (iOld < numOld || iNew < num)
+   {
+      if (iNew == num || (iOld < numOld && !less(a[iNew], a[iOld])))
+         merged.push_back(std::move(a[iOld++]));
+      else if (merged.empty() || less(merged.back(), a[iNew]))
+         merged.push_back(std::move(a[iNew++]));
+      else
+         iNew++;
+   }
+   data = std::move(merged);
+}
+
+/*****************************************************
+ * FLAT SET :: PLACE
+ * Grow by one at the end, then move everything from i
+ * on up a slot to make room for t
+ *    COST   : O(n - i)
+ ****************************************************/
+template <typename T, class Compare>
+typename flat_set <T, Compare> ::iterator flat_set <T, Compare> ::place(size_t i, T && t)
+{
+   assert(i <= data.size());
+   data.push_back(std::move(t));
+   for (size_t iTo = data.size() - 1; iTo > i; iTo--)
+      std::swap(data[iTo], data[iTo - 1]);
+   return at(i);
+}
+
+/*****************************************************
+ * FLAT SET :: ERASE RANGE
+ * Move what follows the range down over it, then drop
+ * the leftovers off the end.  The vector does not give
+ * back its memory, so the iterator returned is good.
+ *    COST   : O(n - index of itBegin)
+ ****************************************************/
+template <typename T, class Compare>
+typename flat_set <T, Compare> ::iterator flat_set <T, Compare> ::erase(iterator & itBegin, iterator & itEnd)
+{
+   size_t iTo = itBegin.p - first();
+   size_t iFrom = itEnd.p - first();
+   assert(iTo <= iFrom && iFrom <= data.size());
+   if (iTo == iFrom)
+      return itBegin;
+
+   for (size_t i = iFrom; i < data.size(); i++)
+      data[iTo + i - iFrom] = std::move(data[i]);
+   for (size_t num = iFrom - iTo; num; num--)
+      data.pop_back();
+   return at(iTo);
+}
+
+/*****************************************************
+ * FLAT SET :: SPLIT AT
+ * Keep the elements before index i and hand back the rest
+ ****************************************************/
+template <typename T, class Compare>
+flat_set <T, Compare> flat_set <T, Compare> ::splitAt(size_t i)
+{
+   flat_set rest(key_comp());
+   rest.data.reserve(data.size() - i);
+   for (size_t iFrom = i; iFrom < data.size(); iFrom++)
+      rest.data.push_back(std::move(data[iFrom]));
+   while (data.size() > i)
+      data.pop_back();
+   return rest;
+}
+
+/***********************************************
+ * FLAT SET : EQUIVALENCE
+ * See if two flat sets hold the same elements
+ ***********************************************/
+template <typename T, class Compare>
+bool operator == (const flat_set <T, Compare> & lhs, const flat_set <T, Compare> & rhs)
+{
+   if (lhs.size() != rhs.size())
+      return false;
+   Compare comp = lhs.key_comp();
+   for (auto itLhs = lhs.begin(), itRhs = rhs.begin(); itLhs != lhs.end(); ++itLhs, ++itRhs)
+      if (comp(*itLhs, *itRhs) || comp(*itRhs, *itLhs))
+         return false;
+   return true;
+}
+
+template <typename T, class Compare>
+inline bool operator != (const flat_set <T, Compare> & lhs, const flat_set <T, Compare> & rhs)
+{
+   return !(lhs == rhs);
+}
+
+/*****************************************************
+ * FLAT SET : COMBINE
+ * Walk the smaller set one element at a time, and the
+ * larger up to each of those.  When the larger is much
+ * larger, a binary search over what is left of it
+ * finds the spot instead of a walk.  What is kept is
+ * copied straight into the result, already in order.
+ *    COST   : O(n + m); or O(m log n) compares plus the
+ *             size of the result when n is far more
+ *             than m
+ ****************************************************/
+template <typename T, class Compare>
+flat_set <T, Compare> flat_set <T, Compare> ::combine(const flat_set & lhs, const flat_set & rhs, bool keepLeft, bool keepBoth, bool keepRight)
+{
+   // below this ratio, stepping is cheaper than the search
+   const size_t GALLOP_RATIO = 8;
+
+   bool leftSmaller = lhs.size() <= rhs.size();
+   const flat_set & smaller = leftSmaller ? lhs : rhs;
+   const flat_set & larger = leftSmaller ? rhs : lhs;
+   bool keepSmaller = leftSmaller ? keepLeft : keepRight;
+   bool keepLarger = leftSmaller ? keepRight : keepLeft;
+   bool gallop = larger.size() / (smaller.size() + 1) >= GALLOP_RATIO;
+
+   flat_set result(lhs.key_comp());
+   result.data.reserve((keepSmaller || keepBoth ? smaller.size() : 0) + (keepLarger ? larger.size() : 0));
+
+   size_t iLarger = 0;
+   size_t numLarger = larger.size();
+   for (size_t i = 0; i < smaller.size(); i++)
+   {
+      const T & t = smaller.data[i];
+
+      // what the larger has before t, only it has
+      size_t iBound = iLarger;
+      if (gallop)
+         iBound = larger.search(t, iLarger);
+      else
+         while (iBound < numLarger && lhs.less(larger.data[iBound], t))
+            iBound++;
+      if (keepLarger)
+         for (; iLarger < iBound; iLarger++)
+            result.data.push_back(larger.data[iLarger]);
+      iLarger = iBound;
+
+      if (iLarger < numLarger && !lhs.less(t, larger.data[iLarger]))
+      {
+         if (keepBoth)
+            result.data.push_back(leftSmaller ? t : larger.data[iLarger]);
+         iLarger++;
+      }
+      else if (keepSmaller)
+         result.data.push_back(t);
+   }
+   if (keepLarger)
+      for (; iLarger < numLarger; iLarger++)
+         result.data.push_back(larger.data[iLarger]);
+
+   return result;
+}
+
+} // namespace custom
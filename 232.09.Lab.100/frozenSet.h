@@ -0,0 +1,267 @@
+/***********************************************************************
+ * Header:
+ *    FROZEN SET
+ * Summary:
+ *    A read-only snapshot of a set, made by set::freeze().  The
+ *    elements sit in one array in Eytzinger order: the root first,
+ *    then its two children, then their four, and so on, just like a
+ *    heap.  A search then touches the array front to back, the next
+ *    few levels can be fetched before they are needed, and the step
+ *    down is arithmetic rather than a branch.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        frozen_set           : An immutable, search-friendly set
+ *        frozen_set::iterator : An in-order iterator through it
+ * Authors
+ *    Hunter Powell
+ *    Carol Mercau
+ *    Elijah Harrison
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>    // for uintptr_t
+#include <vector>     // for the array
+#include <functional> // for std::less
+#include "bst.h"      // for compare_holder
+
+class TestSet;        // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * FROZEN SET
+ * The element with in-order rank r is at some slot
+ * k of data, 1-based: the children of slot k are at
+ * 2k and 2k + 1.  Slot 0 is unused.
+ ***********************************************/
+template <typename T, class Compare = std::less<T> >
+class frozen_set : private compare_holder<Compare>
+{
+   friend class ::TestSet; // give unit tests access to the privates
+public:
+
+   //
+   // Construct: from a sorted range with no repeats
+   //
+   explicit frozen_set(const Compare & comp = Compare())
+      : compare_holder<Compare>(comp), data(1) { }
+   template <class Iterator>
+   frozen_set(Iterator first, Iterator last, size_t num,
+              const Compare & comp = Compare());
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() const noexcept { return iterator(this, leftmost(1)); }
+   iterator end()   const noexcept { return iterator(this, 0); }
+
+   //
+   // Access
+   //
+   bool contains(const T & t) const
+   {
+      size_t k = search(t);
+      return k && !less(t, data[k]);
+   }
+   iterator find(const T & t) const
+   {
+      size_t k = search(t);
+      return (k && !less(t, data[k])) ? iterator(this, k) : end();
+   }
+   iterator lower_bound(const T & t) const { return iterator(this, search(t)); }
+   iterator upper_bound(const T & t) const
+   {
+      size_t k = search(t);
+      if (k && !less(t, data[k]))
+         k = next(k);
+      return iterator(this, k);
+   }
+
+   //
+   // Status
+   //
+   bool empty()  const noexcept { return data.size() == 1; }
+   size_t size() const noexcept { return data.size() - 1; }
+
+private:
+
+   size_t search(const T & t) const;
+   template <class Iterator>
+   void fill(size_t k, Iterator & it);
+
+   // the first slot in order under k, or 0 if there is none
+   size_t leftmost(size_t k) const
+   {
+      if (k >= data.size())
+         return 0;
+      while (2 * k < data.size())
+         k = 2 * k;
+      return k;
+   }
+   size_t next(size_t k) const;
+   size_t prev(size_t k) const;
+   bool less(const T & lhs, const T & rhs) const { return this->compare()(lhs, rhs); }
+
+   std::vector<T> data;   // data[1 .. n] in Eytzinger order
+};
+
+/**************************************************
+ * FROZEN SET ITERATOR
+ * A slot in the array; 0 is end()
+ *************************************************/
+template <typename T, class Compare>
+class frozen_set <T, Compare> :: iterator
+{
+   friend class ::TestSet; // give unit tests access to the privates
+   friend class custom::frozen_set<T, Compare>;
+
+public:
+   iterator() : pSet(nullptr), k(0) { }
+   iterator(const frozen_set * pSet, size_t k) : pSet(pSet), k(k) { }
+
+   bool operator != (const iterator & rhs) const { return k != rhs.k; }
+   bool operator == (const iterator & rhs) const { return k == rhs.k; }
+
+   const T & operator * () const { return pSet->data[k]; }
+
+   iterator & operator ++ ()
+   {
+      k = pSet->next(k);
+      return *this;
+   }
+   iterator operator ++ (int)
+   {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+   }
+   iterator & operator -- ()
+   {
+      k = pSet->prev(k);
+      return *this;
+   }
+   iterator operator -- (int)
+   {
+      auto tmp = *this;
+      --(*this);
+      return tmp;
+   }
+
+private:
+   const frozen_set * pSet;
+   size_t k;
+};
+
+/*****************************************************
+ * FROZEN SET :: CONSTRUCT
+ * Lay out num sorted elements by filling the implicit
+ * tree in order
+ *    COST   : O(n)
+ ****************************************************/
+template <typename T, class Compare>
+template <class Iterator>
+frozen_set <T, Compare> ::frozen_set(Iterator first, Iterator last, size_t num,
+                                     const Compare & comp)
+   : compare_holder<Compare>(comp), data(num + 1)
+{
+   fill(1, first);
+   assert(first == last);
+}
+
+template <typename T, class Compare>
+template <class Iterator>
+void frozen_set <T, Compare> ::fill(size_t k, Iterator & it)
+{
+   if (k >= data.size())
+      return;
+   fill(2 * k, it);
+   data[k] = *it;
+   ++it;
+   fill(2 * k + 1, it);
+}
+
+/*****************************************************
+ * FROZEN SET :: SEARCH
+ * The slot of the first element not less than t, or 0.
+ * Each step goes left or right by adding the result of
+ * one comparison, with no branch to mispredict, while
+ * the slots four levels down (a cache line of them for
+ * small T) are fetched ahead.  Going right at the end
+ * leaves k just past the answer: drop the trailing
+ * right-turns and the last left-turn to get back to it.
+ *    COST   : O(log n)
+ ****************************************************/
+template <typename T, class Compare>
+size_t frozen_set <T, Compare> ::search(const T & t) const
+{
+   const size_t n = data.size();
+   const T * a = data.data();
+   const size_t ahead = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+   size_t k = 1;
+   while (k < n)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(reinterpret_cast<const void *>(
+         reinterpret_cast<uintptr_t>(a) + k * ahead * sizeof(T)));
+#endif
+      k = 2 * k + less(a[k], t);
+   }
+
+   // strip the right-turns, then the one left-turn before them
+   while (k & 1)
+      k >>= 1;
+   return k >> 1;
+}
+
+/*****************************************************
+ * FROZEN SET :: NEXT and PREV
+ * The slot after or before k in order, or 0
+ ****************************************************/
+template <typename T, class Compare>
+size_t frozen_set <T, Compare> ::next(size_t k) const
+{
+   if (!k)
+      return 0;
+
+   // down the right, then all the way left
+   if (2 * k + 1 < data.size())
+      return leftmost(2 * k + 1);
+
+   // up until we come from a left child
+   while (k & 1)
+      k >>= 1;
+   return k >> 1;
+}
+
+template <typename T, class Compare>
+size_t frozen_set <T, Compare> ::prev(size_t k) const
+{
+   if (!k)
+      return 0;
+
+   // down the left, then all the way right
+   if (2 * k < data.size())
+   {
+      k = 2 * k;
+      while (2 * k + 1 < data.size())
+         k = 2 * k + 1;
+      return k;
+   }
+
+   // up until we come from a right child
+   while (!(k & 1))
+      k >>= 1;
+   return k >> 1;
+}
+
+} // namespace custom
@@ -23,6 +23,7 @@
 
 #include "pair.h"     // for pair
 #include "bst.h"      // no nested class necessary for this assignment
+#include "btree.h"    // for btree_layout
 
 #ifndef debug
 #ifdef DEBUG
@@ -39,28 +40,59 @@ namespace custom
 
 /*****************************************************************
  * MAP
- * Create a Map, similar to a Binary Search Tree
+ * Create a Map, similar to a Binary Search Tree.  Balance picks
+ * the BST's balancing policy: red_black, avl, treap, splay, or
+ * unbalanced.  btree_layout<> keeps the pairs in a B+ tree
+ * instead, which has no nth() or rank().  Compare orders the
+ * keys; the map keeps the one copy of it, not every pair.
  *****************************************************************/
-template <class K, class V>
+template <class K, class V, class Balance = red_black, class Compare = std::less<K> >
 class map
 {
    friend ::TestMap; // give unit tests access to the privates
-   template <class KK, class VV>
-   friend void swap(map<KK, VV> & lhs, map<KK, VV> & rhs);
+   template <class KK, class VV, class BB, class CC>
+   friend void swap(map<KK, VV, BB, CC> & lhs, map<KK, VV, BB, CC> & rhs);
 public:
    using Pairs = custom::pair<K, V>;
 
+   //
+   // Compare: pairs by their keys alone, or a pair against a bare
+   // key, so a lookup need not build a pair.  It is empty when
+   // Compare is, so the tree still pays nothing for it.  key_type
+   // and key() let a btree keep bare keys in its inner nodes.
+   //
+   class value_compare : private compare_holder<Compare>
+   {
+   public:
+      typedef void is_transparent;
+      typedef K key_type;
+      static const K & key(const Pairs & p) { return p.first; }
+      value_compare(const Compare & comp = Compare()) : compare_holder<Compare>(comp) { }
+      bool operator () (const Pairs & lhs, const Pairs & rhs) const { return this->compare()(lhs.first, rhs.first); }
+      bool operator () (const Pairs & lhs, const K & rhs)     const { return this->compare()(lhs.first, rhs);       }
+      bool operator () (const K & lhs, const Pairs & rhs)     const { return this->compare()(lhs, rhs.first);       }
+      bool operator () (const K & lhs, const K & rhs)         const { return this->compare()(lhs, rhs);             }
+      Compare key_comp() const { return this->compare(); }
+   };
+
    // 
    // Construct
    //
    map()                                           { }
+   explicit map(const Compare & comp) : bst(value_compare(comp)) { }
    map(const map &  rhs) : bst(rhs.bst)            { }
    map(      map && rhs) : bst(std::move(rhs.bst)) { }
    map(const std::initializer_list<Pairs> & il)    { *this = il; }
   ~map()                                           { }
 
+   // a range sorted by key loads in O(n); say assume_sorted to skip the check
+   template <class Iterator>
+   map(Iterator first, Iterator last) { bst.assign(first, last, true /* keep unique */); }
    template <class Iterator>
-   map(Iterator first, Iterator last) { insert(first, last); }
+   map(assume_sorted_t, Iterator first, Iterator last)
+   {
+      bst.assign(assume_sorted, first, last, true /* keep unique */);
+   }
 
    //
    // Assign
@@ -84,6 +116,28 @@ public:
    const V & at (const K & k) const;
          V & at (const K & k);
    iterator find(const K & k) { return bst.find(k); }
+   iterator lower_bound(const K & k) const { return bst.lower_bound(k); }
+   iterator upper_bound(const K & k) const { return bst.upper_bound(k); }
+   pair<iterator, iterator> equal_range(const K & k) const
+   {
+      return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+   }
+
+   // every entry with a key from a up to, but not including, b
+   pair<iterator, iterator> range(const K & a, const K & b) const
+   {
+      iterator itLast = lower_bound(b);
+      return pair<iterator, iterator>(key_comp()(b, a) ? itLast : lower_bound(a), itLast);
+   }
+
+   Compare key_comp() const         { return bst.key_comp().key_comp(); }
+   value_compare value_comp() const { return bst.key_comp();            }
+
+   //
+   // Order Statistics: O(log n)
+   //
+   iterator nth(size_t k) const  { return bst.nth(k);   }
+   size_t rank(const K & k) const { return bst.rank(k); }
 
    //
    // Insert
@@ -100,17 +154,34 @@ public:
       return pair<iterator, bool>(returnPair.first, returnPair.second);
    }
 
+   // O(1) when the key belongs just before hint, or just after the
+   // last insert: end() is the hint for mostly increasing keys
+   iterator insert(iterator hint, const Pairs & rhs)
+   {
+      return bst.insert(hint.it, rhs, true /* keep unique */).first;
+   }
+
+   iterator insert(iterator hint, Pairs && rhs)
+   {
+      return bst.insert(hint.it, std::move(rhs), true /* keep unique */).first;
+   }
+
+   template <class ... Args>
+   iterator emplace_hint(iterator hint, Args && ... args)
+   {
+      return insert(hint, Pairs(std::forward<Args>(args)...));
+   }
+
+   // a sorted range is merged in and bulk loaded
    template <class Iterator>
    void insert(Iterator first, Iterator last)
    {
-      for (auto it = first; it != last; it++)
-         bst.insert(*it, true /* keep unique */);
+      bst.insert(first, last, true /* keep unique */);
    }
 
    void insert(const std::initializer_list<Pairs> & il)
    {
-      for (auto && t : il)
-         bst.insert(t, true /* keep unique */);
+      bst.insert(il.begin(), il.end(), true /* keep unique */);
    }
 
    //
@@ -121,17 +192,24 @@ public:
    iterator erase(iterator it);
    iterator erase(iterator first, iterator last);
 
+   //
+   // Split and Join: O(log n) however many pairs change hands,
+   // with the BST layouts
+   //
+   map split(const K & k);   // the pairs not less than k move to the result
+   void join(map & rhs);     // all of rhs, which comes after all of this, moves here
+
    //
    // Status
    //
    bool empty()  const noexcept { return !size(); }
-   size_t size() const noexcept { return bst.numElements; }
+   size_t size() const noexcept { return bst.size(); }
 
 
 private:
 
    // the students DO NOT need to use a nested class
-   BST < pair <K, V >> bst;
+   typename tree_for <pair <K, V>, Balance, value_compare> ::type bst;
 };
 
 
@@ -140,18 +218,18 @@ private:
  * Forward and reverse iterator through a Map, just call
  * through to BSTIterator
  *********************************************************/
-template <typename K, typename V>
-class map <K, V> :: iterator
+template <typename K, typename V, class Balance, class Compare>
+class map <K, V, Balance, Compare> :: iterator
 {
    friend class ::TestMap; // give unit tests access to the privates
-   template <class KK, class VV>
+   template <class KK, class VV, class BB, class CC>
    friend class custom::map;
 public:
    //
    // Construct
    //
    iterator() { }
-   iterator(const typename BST <pair <K, V>>::iterator & rhs) : it(rhs) { }
+   iterator(const typename tree_for <pair <K, V>, Balance, value_compare> ::type::iterator & rhs) : it(rhs) { }
    iterator(const iterator & rhs) : it(rhs.it) { }
 
    //
@@ -203,18 +281,24 @@ public:
       return tmp;
    }
 
+   // steps from first to last without visiting each one
+   friend std::ptrdiff_t distance(const iterator & first, const iterator & last)
+   {
+      return distance(first.it, last.it);
+   }
+
 private:
 
    // Member variable
-   typename BST < pair <K, V >>  :: iterator it;   
+   typename tree_for <pair <K, V>, Balance, value_compare> ::type::iterator it;   
 };
 
  /*****************************************************
   * MAP :: COPY ASSIGNMENT OPERATOR
   * Copy assign all the values from another map to this
   ****************************************************/
-template <typename K, typename V>
-map<K, V> & map<K, V>::operator = (const map<K, V> & rhs)
+template <typename K, typename V, class Balance, class Compare>
+map<K, V, Balance, Compare> & map<K, V, Balance, Compare>::operator = (const map<K, V, Balance, Compare> & rhs)
 {
    bst = rhs.bst;
    return *this;
@@ -224,8 +308,8 @@ map<K, V> & map<K, V>::operator = (const map<K, V> & rhs)
  * MAP :: MOVE ASSIGNMENT OPERATOR
  * Move all the values from another map to this
  ****************************************************/
-template <typename K, typename V>
-map<K, V> & map<K, V>::operator = (map<K, V> && rhs)
+template <typename K, typename V, class Balance, class Compare>
+map<K, V, Balance, Compare> & map<K, V, Balance, Compare>::operator = (map<K, V, Balance, Compare> && rhs)
 {
    bst = std::move(rhs.bst);
    return *this;
@@ -233,12 +317,13 @@ map<K, V> & map<K, V>::operator = (map<K, V> && rhs)
 
 /*****************************************************
  * MAP :: INITIALIZER LIST ASSIGNMENT OPERATOR
- * Assign all the values from an initializer list to this
+ * Assign all the values from an initializer list to this.
+ * The first of any repeated key wins.
  ****************************************************/
-template <typename K, typename V>
-map<K, V> & map<K, V>::operator = (const std::initializer_list<Pairs> & il)
+template <typename K, typename V, class Balance, class Compare>
+map<K, V, Balance, Compare> & map<K, V, Balance, Compare>::operator = (const std::initializer_list<Pairs> & il)
 {
-   bst = il;
+   bst.assign(il.begin(), il.end(), true /* keep unique */);
    return *this;
 }
 
@@ -247,8 +332,8 @@ map<K, V> & map<K, V>::operator = (const std::initializer_list<Pairs> & il)
  * Retrieve an element from the map
  * 
  ****************************************************/
-template <typename K, typename V>
-V & map<K, V>::operator [] (const K & key)
+template <typename K, typename V, class Balance, class Compare>
+V & map<K, V, Balance, Compare>::operator [] (const K & key)
 {
    // iterator
    auto it = iterator(bst.find(key));
@@ -266,8 +351,8 @@ V & map<K, V>::operator [] (const K & key)
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V & map<K, V>::operator [] (const K & key) const
+template <typename K, typename V, class Balance, class Compare>
+const V & map<K, V, Balance, Compare>::operator [] (const K & key) const
 {
    // iterator
    auto it = iterator(bst.find(key));
@@ -285,8 +370,8 @@ const V & map<K, V>::operator [] (const K & key) const
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V & map <K, V>::at(const K & key)
+template <typename K, typename V, class Balance, class Compare>
+V & map<K, V, Balance, Compare>::at(const K & key)
 {
    // iterator
    auto it = iterator(bst.find(key));
@@ -304,8 +389,8 @@ V & map <K, V>::at(const K & key)
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V & map<K, V>::at(const K & key) const
+template <typename K, typename V, class Balance, class Compare>
+const V & map<K, V, Balance, Compare>::at(const K & key) const
 {
    // iterator
    auto it = iterator(bst.find(key));
@@ -323,8 +408,8 @@ const V & map<K, V>::at(const K & key) const
  * MAP :: ERASE
  * Find and erase one element
  ****************************************************/
-template <typename K, typename V>
-size_t map<K, V>::erase(const K & k)
+template <typename K, typename V, class Balance, class Compare>
+size_t map<K, V, Balance, Compare>::erase(const K & k)
 {
    auto it = find(k);
 
@@ -342,8 +427,8 @@ size_t map<K, V>::erase(const K & k)
  * (Note: defined here below because iterator type 
  * needs to have already been defined)
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator it)
+template <typename K, typename V, class Balance, class Compare>
+typename map<K, V, Balance, Compare>::iterator map<K, V, Balance, Compare>::erase(map<K, V, Balance, Compare>::iterator it)
 {
    return bst.erase(it.it);
 }
@@ -352,8 +437,8 @@ typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator it)
  * MAP :: ERASE
  * Erase several elements
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K, V>::iterator last)
+template <typename K, typename V, class Balance, class Compare>
+typename map<K, V, Balance, Compare>::iterator map<K, V, Balance, Compare>::erase(map<K, V, Balance, Compare>::iterator first, map<K, V, Balance, Compare>::iterator last)
 {
    auto it = first;
 
@@ -363,12 +448,37 @@ typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K,
    return it;
 }
 
+/*****************************************************
+ * MAP :: SPLIT
+ * Keep the pairs whose keys are less than k, and hand
+ * back the rest.  Only the tree is cut: no pair is
+ * copied.
+ ****************************************************/
+template <typename K, typename V, class Balance, class Compare>
+map<K, V, Balance, Compare> map<K, V, Balance, Compare>::split(const K & k)
+{
+   map rest(key_comp());
+   rest.bst = bst.split(k);
+   return rest;
+}
+
+/*****************************************************
+ * MAP :: JOIN
+ * Take every pair of rhs, whose keys must all come
+ * after all of ours
+ ****************************************************/
+template <typename K, typename V, class Balance, class Compare>
+void map<K, V, Balance, Compare>::join(map & rhs)
+{
+   bst.join(rhs.bst, true /* keep unique */);
+}
+
 /*****************************************************
  * SWAP
  * Swap two maps
  ****************************************************/
-template <typename K, typename V>
-void swap(map<K, V> & lhs, map<K, V> & rhs)
+template <typename K, typename V, class Balance, class Compare>
+void swap(map<K, V, Balance, Compare> & lhs, map<K, V, Balance, Compare> & rhs)
 {
    lhs.bst.swap(rhs.bst);
 }
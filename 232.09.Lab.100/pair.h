@@ -21,9 +21,10 @@ namespace custom
  * accessed through its public members first and second.
  *
  * Additionally, when compairing two pairs, only T1 is compared. This
- * is a key in a name-value pair.
+ * is a key in a name-value pair.  A pair holds no comparator: the
+ * map it lives in keeps one for all of them.
  ***********************************************/
-template <class T1, class T2, typename C = std::less<T1>>
+template <class T1, class T2>
 class pair
 {
 public:
@@ -32,24 +33,24 @@ public:
    //
    
    // Default Constructor: call the T1, T2 default constructors
-   pair(const C & c = C())
-       : first(     ), second(      ), compare(c) {}
+   pair()
+       : first(     ), second(      ) {}
    // Non-Default Constructor: call the T1, T2 copy constructors
-   pair(const T1 & first, const T2 & second, const C & c = C())
-       : first(first), second(second), compare(c) {}
-   pair(const T1 & first, T2 && second, const C & c = C())
-      : first(first), second(std::move(second)), compare(c) {}
-   pair(const T1 & first, const C& c = C())
-      : first(first), second(), compare(c) {}
+   pair(const T1 & first, const T2 & second)
+       : first(first), second(second) {}
+   pair(const T1 & first, T2 && second)
+      : first(first), second(std::move(second)) {}
+   pair(const T1 & first)
+      : first(first), second() {}
    // Copy Constructor: call the T1, T2 copy constructors
-   pair(const pair <T1, T2> & rhs, const C & c = C())
-       : first(rhs.first), second(rhs.second), compare(c) {}
+   pair(const pair <T1, T2> & rhs)
+       : first(rhs.first), second(rhs.second) {}
    // Non-Default Move Constructor: call the T1, T2 move constructors
-   pair(T1 && first, T2 && second, const C & c = C())
-       : first(std::move(first)), second(std::move(second)), compare(c) {}
+   pair(T1 && first, T2 && second)
+       : first(std::move(first)), second(std::move(second)) {}
    // Move Constructor: call the T1, T2 move constructors
-   pair(pair <T1, T2> && rhs, const C & c = C())
-       : first(std::move(rhs.first)), second(std::move(rhs.second)), compare(c) {}
+   pair(pair <T1, T2> && rhs)
+       : first(std::move(rhs.first)), second(std::move(rhs.second)) {}
 
    //
    // Assignment Operators
@@ -81,10 +82,10 @@ public:
    // Relative: only the first will be compared
    //
 
-   bool operator <  (const pair & rhs) const { return compare(first, rhs.first);        }
-   bool operator >  (const pair & rhs) const { return compare(rhs.first, first);        }
-   bool operator >= (const pair & rhs) const { return !(compare(first, rhs.first));     }
-   bool operator <= (const pair & rhs) const { return !(compare(rhs.first, first));     }
+   bool operator <  (const pair & rhs) const { return first < rhs.first;        }
+   bool operator >  (const pair & rhs) const { return rhs.first < first;        }
+   bool operator >= (const pair & rhs) const { return !(first < rhs.first);     }
+   bool operator <= (const pair & rhs) const { return !(rhs.first < first);     }
    
    //
    // Swap: swap the places
@@ -105,9 +106,6 @@ public:
    // Get: retrieve a value
    //
    
-   C    compare;              // comparision operator
-
-   
    // these are public. We cannot validate because we know nothing about T
    T1 first;
    T2 second;
@@ -118,8 +116,8 @@ public:
  * PAIR SWAP
  * Stand-alone swap function
  ****************************************************/
-template <class T1, class T2, typename C = std::less<T1>>
-inline void swap(pair <T1, T2, C> & lhs, pair <T1, T2, C> & rhs)
+template <class T1, class T2>
+inline void swap(pair <T1, T2> & lhs, pair <T1, T2> & rhs)
 {
    lhs.swap(rhs);
 }
@@ -128,10 +126,10 @@ inline void swap(pair <T1, T2, C> & lhs, pair <T1, T2, C> & rhs)
  * MAKE PAIR
  * Much like the non-default constructor
  ****************************************************/
-template <class T1, class T2, typename C = std::less<T1>>
-inline pair <T1, T2, C> make_pair(const T1 & t1, const T2 & t2)
+template <class T1, class T2>
+inline pair <T1, T2> make_pair(const T1 & t1, const T2 & t2)
 {
-   return pair<T1, T2, C> (t1, t2);
+   return pair<T1, T2> (t1, t2);
 }
 
 
@@ -139,9 +137,9 @@ inline pair <T1, T2, C> make_pair(const T1 & t1, const T2 & t2)
  * PAIR INSERTION
  * Display a pair for debug purposes
  ****************************************************/
-template <class T1, class T2, typename C = std::less<T1>>
+template <class T1, class T2>
 inline std::ostream & operator << (std::ostream & out,
-                                   const pair <T1, T2, C> & rhs)
+                                   const pair <T1, T2> & rhs)
 {
    out << '(' << rhs.first << ", " << rhs.second << ')';
    return out;
@@ -151,9 +149,9 @@ inline std::ostream & operator << (std::ostream & out,
  * PAIR EXTRACTION
  * input a pair
  ****************************************************/
-template <class T1, class T2, typename C = std::less<T1>>
+template <class T1, class T2>
 inline std::istream & operator >> (std::istream & in,
-                                   pair <T1, T2, C> & rhs)
+                                   pair <T1, T2> & rhs)
 {
    in >> rhs.first >> rhs.second;
    return in;
@@ -0,0 +1,108 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT MAP
+ * Summary:
+ *    An ordered map whose every version lives on, so a consistent
+ *    snapshot of it costs O(1) however large it is, and the map can
+ *    keep changing while the snapshot is read.  The pairs are kept
+ *    in a persistent_set, ordered by key alone.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        persistent_map           : A map with O(1) snapshots
+ *        persistent_map::iterator : An in-order iterator through one
+ * Authors
+ *    Hunter Powell
+ *    Elijah Harrison
+ *    Carol Mercau
+ ************************************************************************/
+
+#pragma once
+
+#include <stdexcept>       // for std::out_of_range
+#include "pair.h"          // for pair
+#include "map.h"           // for map::value_compare
+#include "persistentSet.h" // for persistent_set
+
+class TestPersistentMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************************
+ * PERSISTENT MAP
+ * Copying one, or calling snapshot(), shares every node; insert,
+ * insert_or_assign and erase then copy just the path they change.
+ * As with persistent_set, different versions may be used by
+ * different threads at once.
+ *****************************************************************/
+template <class K, class V, class Compare = std::less<K> >
+class persistent_map
+{
+   friend class ::TestPersistentMap; // give unit tests access to the privates
+public:
+   typedef pair <K, V> Pairs;
+   typedef typename map <K, V, red_black, Compare> ::value_compare value_compare;
+   typedef typename persistent_set <Pairs, value_compare> ::iterator iterator;
+
+   //
+   // Construct: a copy shares every node with the original
+   //
+   persistent_map() { }
+   explicit persistent_map(const Compare & comp) : pairs(value_compare(comp)) { }
+   persistent_map(const std::initializer_list<Pairs> & il)
+   {
+      for (auto && p : il)
+         pairs.insert(p);
+   }
+
+   //
+   // Snapshot: this version, which later changes will not disturb
+   //
+   persistent_map snapshot() const { return *this; }
+
+   //
+   // Iterator: valid while the version it came from is unchanged
+   //
+   iterator begin() const { return pairs.begin(); }
+   iterator end()   const { return pairs.end();   }
+
+   //
+   // Access: a pair is never built to look up a key
+   //
+   iterator find(const K & k) const { return pairs.find(k);     }
+   bool contains(const K & k) const { return pairs.contains(k); }
+   const V & at(const K & k) const
+   {
+      auto p = pairs.lookup(k);
+      if (!p)
+         throw std::out_of_range("invalid persistent_map<K, T> key");
+      return p->data.second;
+   }
+
+   //
+   // Insert and Remove: each makes a new version of O(log n) nodes
+   //
+   bool insert(const K & k, const V & v)           { return pairs.write(Pairs(k, v), false /* overwrite */); }
+   bool insert(const Pairs & rhs)                  { return pairs.write(rhs, false /* overwrite */);        }
+   bool insert_or_assign(const K & k, const V & v) { return pairs.write(Pairs(k, v), true /* overwrite */);  }
+   size_t erase(const K & k)                       { return pairs.erase(k) ? 1 : 0; }
+   void clear() noexcept                           { pairs.clear(); }
+
+   //
+   // Status
+   //
+   bool empty()  const noexcept { return pairs.empty(); }
+   size_t size() const noexcept { return pairs.size();  }
+   Compare key_comp() const     { return pairs.key_comp().key_comp(); }
+
+private:
+   persistent_set <Pairs, value_compare> pairs;
+};
+
+} // namespace custom
@@ -0,0 +1,722 @@
+/***********************************************************************
+ * Header:
+ *    TEST B TREE
+ * Summary:
+ *    Unit tests for btree
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "btree.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+#include <algorithm>  // for std::sort and std::shuffle
+
+/***********************************************
+ * TEST B TREE
+ * Unit tests for the btree class.  Most use 64
+ * byte nodes (8 ints to a leaf, 4 keys to an
+ * inner node) so that small trees are deep.
+ ***********************************************/
+class TestBTree : public UnitTest
+{
+   typedef custom::btree <int, 64> Small;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructInitializer_standard();
+
+      // Assign
+      test_assign_unsorted();
+      test_assign_sortedPacks();
+      test_assign_keepUnique();
+      test_swap_standardToEmpty();
+
+      // Iterator
+      test_iterator_increment();
+      test_iterator_decrement();
+      test_iterator_distance();
+
+      // Find
+      test_find_standard();
+      test_find_missing();
+      test_bound_duplicates();
+      test_bound_fromHint();
+
+      // Insert
+      test_insert_sorted();
+      test_insert_random();
+      test_insert_duplicates();
+      test_insert_keepUnique();
+      test_insert_hintAppend();
+      test_insert_hintMiss();
+
+      // Remove
+      test_erase_random();
+      test_erase_all();
+      test_clear_standard();
+      test_clear_buildsNoSpares();
+
+      // Status
+      test_nodeSize();
+      test_strings();
+
+      report("BTree");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // default constructor, nothing allocated
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Small bt;
+      // verify
+      assertUnit(bt.root == nullptr);
+      assertUnit(bt.numElements == 0);
+      assertUnit(bt.empty());
+      assertUnit(bt.begin() == bt.end());
+   }  // teardown
+
+   // copy constructor leaves two equal trees
+   void test_constructCopy_standard()
+   {  // setup
+      Small btSrc;
+      for (int i = 0; i < 100; i++)
+         btSrc.insert(i * 3);
+      // exercise
+      Small btDest(btSrc);
+      // verify
+      assertUnit(valid(btSrc));
+      assertUnit(valid(btDest));
+      assertUnit(valuesOf(btDest) == valuesOf(btSrc));
+      assertUnit(btDest.root != btSrc.root);
+   }  // teardown
+
+   // move constructor takes the nodes
+   void test_constructMove_standard()
+   {  // setup
+      Small btSrc;
+      for (int i = 0; i < 100; i++)
+         btSrc.insert(i);
+      auto pRoot = btSrc.root;
+      // exercise
+      Small btDest(std::move(btSrc));
+      // verify
+      assertUnit(btSrc.root == nullptr);
+      assertUnit(btSrc.size() == 0);
+      assertUnit(btDest.root == pRoot);
+      assertUnit(btDest.size() == 100);
+      assertUnit(valid(btDest));
+   }  // teardown
+
+   // initializer list constructor sorts
+   void test_constructInitializer_standard()
+   {  // setup
+      // exercise
+      Small bt{ 50, 30, 70, 20, 40, 60, 80, 10, 90, 55 };
+      // verify
+      assertUnit(valid(bt));
+      assertUnit(valuesOf(bt) == std::vector<int>({ 10, 20, 30, 40, 50, 55, 60, 70, 80, 90 }));
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // unsorted input is sorted, keeping duplicates
+   void test_assign_unsorted()
+   {  // setup
+      std::vector<int> src = shuffled(500);
+      src.push_back(7);
+      Small bt{ 1, 2, 3 };
+      // exercise
+      bt.assign(src.begin(), src.end());
+      // verify
+      std::sort(src.begin(), src.end());
+      assertUnit(valid(bt));
+      assertUnit(valuesOf(bt) == src);
+   }  // teardown
+
+   // sorted input fills the leaves evenly and all but full
+   void test_assign_sortedPacks()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 1000; i++)
+         src.push_back(i);
+      Small bt;
+      // exercise
+      bt.assign(custom::assume_sorted, src.begin(), src.end());
+      // verify
+      assertUnit(valid(bt));
+      assertUnit(valuesOf(bt) == src);
+      assertUnit(numLeaves(bt) == 125);   // 1000 / 8
+   }  // teardown
+
+   // keepUnique drops repeats, sorted or not
+   void test_assign_keepUnique()
+   {  // setup
+      std::vector<int> sorted{ 1, 1, 2, 3, 3, 3, 4, 5, 5 };
+      std::vector<int> unsorted{ 5, 3, 1, 3, 4, 2, 5, 1, 3 };
+      Small btSorted;
+      Small btUnsorted;
+      // exercise
+      btSorted.assign(custom::assume_sorted, sorted.begin(), sorted.end(), true);
+      btUnsorted.assign(unsorted.begin(), unsorted.end(), true);
+      // verify
+      std::vector<int> expected{ 1, 2, 3, 4, 5 };
+      assertUnit(valuesOf(btSorted) == expected);
+      assertUnit(valuesOf(btUnsorted) == expected);
+      assertUnit(btUnsorted.size() == 5);
+   }  // teardown
+
+   // swap a tree with an empty one
+   void test_swap_standardToEmpty()
+   {  // setup
+      Small btLeft;
+      for (int i = 0; i < 50; i++)
+         btLeft.insert(i);
+      Small btRight;
+      // exercise
+      swap(btLeft, btRight);
+      // verify
+      assertUnit(btLeft.empty());
+      assertUnit(btLeft.root == nullptr);
+      assertUnit(btRight.size() == 50);
+      assertUnit(valid(btRight));
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk every leaf in order
+   void test_iterator_increment()
+   {  // setup
+      Small bt;
+      std::vector<int> src = shuffled(300);
+      for (int value : src)
+         bt.insert(value);
+      std::vector<int> values;
+      // exercise
+      for (auto it = bt.begin(); it != bt.end(); it++)
+         values.push_back(*it);
+      // verify
+      std::sort(src.begin(), src.end());
+      assertUnit(values == src);
+   }  // teardown
+
+   // walk every leaf backwards, stopping past the first
+   void test_iterator_decrement()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 300; i++)
+         bt.insert(i);
+      auto it = bt.find(299);
+      int expected = 299;
+      bool inOrder = true;
+      // exercise
+      for (; it != bt.end(); --it)
+         inOrder = inOrder && *it == expected--;
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expected == -1);
+   }  // teardown
+
+   // distance skips whole leaves, either way round
+   void test_iterator_distance()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 300; i++)
+         bt.insert(i);
+      // exercise
+      auto all = distance(bt.begin(), bt.end());
+      auto some = distance(bt.find(17), bt.find(250));
+      auto back = distance(bt.find(250), bt.find(17));
+      auto none = distance(bt.find(42), bt.find(42));
+      // verify
+      assertUnit(all == 300);
+      assertUnit(some == 233);
+      assertUnit(back == -233);
+      assertUnit(none == 0);
+   }  // teardown
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // find everything in a deep tree
+   void test_find_standard()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 500; i++)
+         bt.insert(i * 2);
+      bool allFound = true;
+      // exercise
+      for (int i = 0; i < 500; i++)
+      {
+         auto it = bt.find(i * 2);
+         allFound = allFound && it != bt.end() && *it == i * 2;
+      }
+      // verify
+      assertUnit(allFound);
+   }  // teardown
+
+   // nothing in between is found
+   void test_find_missing()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 500; i++)
+         bt.insert(i * 2);
+      bool noneFound = true;
+      // exercise
+      for (int i = -1; i < 1000; i += 2)
+         noneFound = noneFound && bt.find(i) == bt.end();
+      // verify
+      assertUnit(noneFound);
+      assertUnit(Small().find(3) == Small().end());
+   }  // teardown
+
+   // bounds find the whole run of equals, even across leaves
+   void test_bound_duplicates()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 100; i++)
+         bt.insert(i);
+      for (int i = 0; i < 30; i++)
+         bt.insert(50);
+      // exercise
+      auto range = bt.equal_range(50);
+      auto below = bt.lower_bound(-5);
+      auto above = bt.upper_bound(99);
+      // verify
+      assertUnit(distance(range.first, range.second) == 31);
+      assertUnit(*range.first == 50);
+      assertUnit(range.second != bt.end() && *range.second == 51);
+      assertUnit(--range.first != bt.end() && *range.first == 49);
+      assertUnit(below == bt.begin());
+      assertUnit(above == bt.end());
+      assertUnit(valid(bt));
+   }  // teardown
+
+   // searching on from a hint finds what searching from the root does
+   void test_bound_fromHint()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 500; i += 5)
+         bt.insert(i);
+      bool same = true;
+      // exercise
+      for (int from = 0; from < 500; from += 35)
+         for (int key = from; key < 520; key += 3)
+            same = same && bt.lower_bound(bt.lower_bound(from), key) == bt.lower_bound(key);
+      // verify
+      assertUnit(same);
+      assertUnit(*bt.lower_bound(bt.find(200), 100) == 200);
+      assertUnit(bt.lower_bound(bt.end(), 3) == bt.end());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // ever increasing input fills the leaves
+   void test_insert_sorted()
+   {  // setup
+      Small bt;
+      bool stillValid = true;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         auto result = bt.insert(i);
+         stillValid = stillValid && result.second && *result.first == i;
+      }
+      // verify
+      stillValid = stillValid && valid(bt);
+      assertUnit(stillValid);
+      assertUnit(bt.size() == 1000);
+      assertUnit(numLeaves(bt) == 125);
+   }  // teardown
+
+   // random input, checking after every insert
+   void test_insert_random()
+   {  // setup
+      Small bt;
+      std::vector<int> src = shuffled(600);
+      bool stillValid = true;
+      // exercise
+      for (int value : src)
+      {
+         auto result = bt.insert(value);
+         stillValid = stillValid && *result.first == value && valid(bt);
+      }
+      // verify
+      std::sort(src.begin(), src.end());
+      assertUnit(stillValid);
+      assertUnit(valuesOf(bt) == src);
+   }  // teardown
+
+   // duplicates go after the ones already there
+   void test_insert_duplicates()
+   {  // setup
+      Small bt;
+      std::vector<int> src;
+      for (int i = 0; i < 400; i++)
+         src.push_back((i * 37) % 20);
+      bool stillValid = true;
+      // exercise
+      for (int value : src)
+      {
+         bt.insert(value);
+         stillValid = stillValid && valid(bt);
+      }
+      // verify
+      std::sort(src.begin(), src.end());
+      assertUnit(stillValid);
+      assertUnit(valuesOf(bt) == src);
+      assertUnit(distance(bt.lower_bound(7), bt.upper_bound(7)) == 20);
+   }  // teardown
+
+   // keepUnique refuses a copy and points at the original
+   void test_insert_keepUnique()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 200; i++)
+         bt.insert(i, true);
+      bool allRefused = true;
+      // exercise
+      for (int i = 0; i < 200; i++)
+      {
+         auto result = bt.insert(i, true);
+         allRefused = allRefused && !result.second && *result.first == i;
+      }
+      // verify
+      assertUnit(allRefused);
+      assertUnit(bt.size() == 200);
+      assertUnit(valid(bt));
+   }  // teardown
+
+   // appending at end() never searches and packs the leaves full
+   void test_insert_hintAppend()
+   {  // setup
+      Small bt;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         bt.insert(bt.end(), i);
+      auto result = bt.insert(bt.end(), 999, true);
+      // verify
+      assertUnit(valid(bt));
+      assertUnit(bt.size() == 1000);
+      assertUnit(numLeaves(bt) == 125);
+      assertUnit(!result.second);
+      assertUnit(*result.first == 999);
+   }  // teardown
+
+   // a hint in the wrong place still puts t where it belongs
+   void test_insert_hintMiss()
+   {  // setup
+      Small bt;
+      for (int i = 0; i < 100; i++)
+         bt.insert(i * 2);
+      // exercise
+      auto low = bt.insert(bt.end(), 3);
+      auto high = bt.insert(bt.begin(), 301);
+      auto inside = bt.insert(bt.find(10), 9);
+      // verify
+      assertUnit(low.second && *low.first == 3);
+      assertUnit(high.second && *high.first == 301);
+      assertUnit(inside.second && *inside.first == 9);
+      assertUnit(*++inside.first == 10);
+      assertUnit(valid(bt));
+      assertUnit(bt.size() == 103);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // inserting and erasing at random, checking after every step
+   void test_erase_random()
+   {  // setup
+      Small bt;
+      std::vector<int> expected;
+      bool stillValid = true;
+      unsigned int seed = 1999;
+      // exercise
+      for (int i = 0; i < 4000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)(seed >> 16) % 300;
+         auto it = bt.find(value);
+         if (it != bt.end() && (seed & 0x100))
+         {
+            auto itNext = bt.erase(it);
+            expected.erase(std::find(expected.begin(), expected.end(), value));
+            auto itExpected = std::upper_bound(expected.begin(), expected.end(), value);
+            stillValid = stillValid && (itExpected == expected.end() ?
+                                        itNext == bt.end() : *itNext == *itExpected);
+         }
+         else
+         {
+            bt.insert(value, true);
+            if (!std::binary_search(expected.begin(), expected.end(), value))
+               expected.insert(std::upper_bound(expected.begin(), expected.end(), value), value);
+         }
+         stillValid = stillValid && valid(bt);
+      }
+      // verify
+      assertUnit(stillValid);
+      assertUnit(valuesOf(bt) == expected);
+   }  // teardown
+
+   // erasing everything from the front leaves nothing
+   void test_erase_all()
+   {  // setup
+      Small bt;
+      for (int value : shuffled(500))
+         bt.insert(value);
+      bool stillValid = true;
+      int expected = 0;
+      // exercise
+      auto it = bt.begin();
+      while (it != bt.end())
+      {
+         stillValid = stillValid && *it == expected++;
+         it = bt.erase(it);
+         stillValid = stillValid && valid(bt);
+      }
+      // verify
+      assertUnit(stillValid);
+      assertUnit(expected == 500);
+      assertUnit(bt.empty());
+      assertUnit(bt.root == nullptr);
+   }  // teardown
+
+   // clear destroys every element
+   void test_clear_standard()
+   {  // setup
+      custom::btree <Spy, 64> bt;
+      for (int i = 0; i < 100; i++)
+         bt.insert(Spy(i));
+      // exercise
+      bt.clear();
+      // verify
+      assertUnit(bt.empty());
+      assertUnit(bt.root == nullptr);
+      assertUnit(bt.begin() == bt.end());
+   }  // teardown
+
+   // a node builds an element only for a slot in use, and every
+   // one built is destroyed, through splits, merges, and clear
+   void test_clear_buildsNoSpares()
+   {  // setup
+      Spy::reset();
+      {
+         custom::btree <Spy, 64> bt;
+         for (int i = 0; i < 200; i++)
+            bt.insert(Spy((i * 37) % 200));
+         for (int i = 0; i < 150; i++)
+         {
+            auto it = bt.find(Spy((i * 11) % 200));
+            bt.erase(it);
+         }
+         // exercise
+         bt.clear();
+      }
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numDestructor() == Spy::numNondefault() + Spy::numCopy() + Spy::numCopyMove());
+      assertUnit(Spy::numAlloc() == Spy::numDelete());
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // a node is about the size asked for
+   void test_nodeSize()
+   {  // setup
+      // exercise
+      size_t sizeLeaf = sizeof(custom::btree <int> ::Leaf);
+      size_t sizeInner = sizeof(custom::btree <int> ::Inner);
+      size_t perLeaf = custom::btree <int> ::LEAF_MAX;
+      // verify
+      assertUnit(sizeLeaf <= 256);
+      assertUnit(sizeInner <= 256);
+      assertUnit(sizeLeaf > 192);
+      assertUnit(perLeaf == (256 - 4 * sizeof(void *)) / sizeof(int));
+   }  // teardown
+
+   // strings work as well as ints
+   void test_strings()
+   {  // setup
+      custom::btree <std::string, 128> bt;
+      std::vector<std::string> src;
+      for (int i = 0; i < 200; i++)
+         src.push_back(std::to_string((i * 7919) % 1000));
+      // exercise
+      for (auto & s : src)
+         bt.insert(s, true);
+      for (int i = 0; i < 200; i += 2)
+      {
+         auto it = bt.find(src[i]);
+         bt.erase(it);
+      }
+      // verify
+      std::vector<std::string> expected;
+      for (int i = 1; i < 200; i += 2)
+         expected.push_back(src[i]);
+      std::sort(expected.begin(), expected.end());
+      assertUnit(valuesOf(bt) == expected);
+      assertUnit(valid(bt));
+   }  // teardown
+
+   /*************************************************************
+    * VALUES OF
+    * Everything in the tree, in order
+    *************************************************************/
+   template <class Tree>
+   auto valuesOf(const Tree & bt) -> std::vector<typename std::decay<decltype(*bt.begin())>::type>
+   {
+      std::vector<typename std::decay<decltype(*bt.begin())>::type> values;
+      for (auto it = bt.begin(); it != bt.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   /*************************************************************
+    * SHUFFLED
+    * 0 .. num-1 in a fixed, scrambled order
+    *************************************************************/
+   std::vector<int> shuffled(int num)
+   {
+      std::vector<int> values;
+      for (int i = 0; i < num; i++)
+         values.push_back(i);
+      unsigned int seed = 1999;
+      for (int i = num - 1; i > 0; i--)
+      {
+         seed = seed * 1103515245 + 12345;
+         std::swap(values[i], values[(seed >> 16) % (i + 1)]);
+      }
+      return values;
+   }
+
+   /*************************************************************
+    * NUM LEAVES
+    * How many leaves are in the list of leaves
+    *************************************************************/
+   template <class Tree>
+   size_t numLeaves(const Tree & bt)
+   {
+      size_t num = 0;
+      for (auto pLeaf = bt.firstLeaf(); pLeaf; pLeaf = pLeaf->pNext)
+         num++;
+      return num;
+   }
+
+   /*************************************************************
+    * VALID
+    * Every leaf is at the same depth and in the list of leaves
+    * in order, no node but the root (and the last leaf, which
+    * appending may leave short) is less than half full, the keys
+    * separate the children, every child points back at its
+    * parent, and the count is right
+    *************************************************************/
+   template <class Tree>
+   bool valid(const Tree & bt)
+   {
+      if (!bt.root)
+         return bt.numElements == 0;
+      if (bt.root->pParent)
+         return false;
+
+      std::vector<const typename Tree::Leaf *> leaves;
+      int depthLeaves = -1;
+      if (!validNode(bt, bt.root, 0, depthLeaves, leaves))
+         return false;
+
+      // the list of leaves matches the tree, and is in order
+      size_t num = 0;
+      auto pLeaf = bt.firstLeaf();
+      for (size_t i = 0; i < leaves.size(); i++, pLeaf = pLeaf->pNext)
+      {
+         if (pLeaf != leaves[i] || pLeaf->pPrev != (i ? leaves[i - 1] : nullptr))
+            return false;
+         for (size_t j = 0; j < pLeaf->num; j++)
+            if ((j && pLeaf->data()[j] < pLeaf->data()[j - 1]) ||
+                (!j && i && pLeaf->data()[0] < leaves[i - 1]->data()[leaves[i - 1]->num - 1]))
+               return false;
+         num += pLeaf->num;
+      }
+      return pLeaf == nullptr && bt.lastLeaf() == leaves.back() && num == bt.numElements;
+   }
+
+   template <class Tree, class Node, class Leaf>
+   bool validNode(const Tree & bt, const Node * p, int depth, int & depthLeaves,
+                  std::vector<const Leaf *> & leaves)
+   {
+      bool isRoot = (p == bt.root);
+      if (p->isLeaf)
+      {
+         auto pLeaf = static_cast<const typename Tree::Leaf *>(p);
+         if (depthLeaves == -1)
+            depthLeaves = depth;
+         leaves.push_back(pLeaf);
+         return depth == depthLeaves && p->num > 0 &&
+            (isRoot || p->num >= Tree::LEAF_MIN || !pLeaf->pNext);
+      }
+
+      auto pInner = static_cast<const typename Tree::Inner *>(p);
+      if (p->num < 1 || (!isRoot && p->num < Tree::INNER_MIN))
+         return false;
+      for (size_t i = 0; i <= p->num; i++)
+      {
+         auto pChild = pInner->children[i];
+         if (pChild->pParent != pInner)
+            return false;
+         if (!validNode(bt, pChild, depth + 1, depthLeaves, leaves))
+            return false;
+
+         // keys[i - 1] <= everything in child i <= keys[i]
+         auto pLow = edgeLeaf<Tree>(pChild, false);
+         auto pHigh = edgeLeaf<Tree>(pChild, true);
+         if (i > 0 && pLow->data()[0] < pInner->keys()[i - 1])
+            return false;
+         if (i < p->num && pInner->keys()[i] < pHigh->data()[pHigh->num - 1])
+            return false;
+      }
+      return true;
+   }
+
+   /*************************************************************
+    * EDGE LEAF
+    * The first or the last leaf under p
+    *************************************************************/
+   template <class Tree>
+   const typename Tree::Leaf * edgeLeaf(const typename Tree::Node * p, bool last)
+   {
+      while (!p->isLeaf)
+         p = static_cast<const typename Tree::Inner *>(p)->children[last ? p->num : 0];
+      return static_cast<const typename Tree::Leaf *>(p);
+   }
+};
+
+#endif // DEBUG
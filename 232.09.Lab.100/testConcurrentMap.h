@@ -0,0 +1,362 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT MAP
+ * Summary:
+ *    Unit tests for concurrent_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+#ifdef DEBUG
+
+#include "concurrentMap.h" // class under test
+#include "unitTest.h"      // unit test baseclass
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST CONCURRENT MAP
+ * Unit tests for the concurrent_map class
+ ***********************************************/
+class TestConcurrentMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_insert_standard();
+      test_insert_duplicate();
+      test_insertOrAssign_standard();
+
+      // Remove
+      test_erase_standard();
+      test_erase_missing();
+
+      // Snapshot
+      test_snapshot_inOrder();
+      test_snapshot_unchangedByWrites();
+
+      // Reclamation
+      test_reclaim_noReaders();
+      test_reclaim_heldByReader();
+
+      // Threads
+      test_threads_readersAndWriters();
+
+      report("ConcurrentMap");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // default constructor: no tree, nobody reading
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::concurrent_map <int, int> m;
+      // verify
+      assertUnit(m.root.load() == nullptr);
+      assertUnit(m.empty());
+      assertUnit(m.size() == 0);
+      assertUnit(activeReaders(m) == 0);
+      assertUnit(!m.contains(3));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert many, find them all
+   void test_insert_standard()
+   {  // setup
+      custom::concurrent_map <int, std::string> m;
+      bool allAdded = true;
+      // exercise
+      for (int i = 0; i < 200; i++)
+         allAdded = m.insert((i * 37) % 200, std::to_string(i)) && allAdded;
+      // verify
+      assertUnit(allAdded);
+      assertUnit(m.size() == 200);
+      bool allFound = true;
+      for (int i = 0; i < 200; i++)
+      {
+         std::string s;
+         allFound = allFound && m.find((i * 37) % 200, s) && s == std::to_string(i);
+      }
+      assertUnit(allFound);
+      assertUnit(isTreap(m.root.load()));
+      assertUnit(activeReaders(m) == 0);
+   }  // teardown
+
+   // insert leaves the first value alone
+   void test_insert_duplicate()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      m.insert(5, 50);
+      auto pRoot = m.root.load();
+      // exercise
+      bool added = m.insert(5, 99);
+      // verify
+      int v = 0;
+      assertUnit(!added);
+      assertUnit(m.find(5, v) && v == 50);
+      assertUnit(m.size() == 1);
+      assertUnit(m.root.load() == pRoot);   // nothing was copied
+   }  // teardown
+
+   // insert_or_assign replaces the value with a copy of the node
+   void test_insertOrAssign_standard()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      for (int i = 0; i < 20; i++)
+         m.insert(i, i);
+      // exercise
+      bool addedOld = m.insert_or_assign(7, 700);
+      bool addedNew = m.insert_or_assign(70, 7000);
+      // verify
+      int v = 0;
+      assertUnit(!addedOld);
+      assertUnit(addedNew);
+      assertUnit(m.find(7, v) && v == 700);
+      assertUnit(m.find(70, v) && v == 7000);
+      assertUnit(m.size() == 21);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase every other one
+   void test_erase_standard()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      for (int i = 0; i < 100; i++)
+         m.insert(i, i * 2);
+      bool allRemoved = true;
+      // exercise
+      for (int i = 0; i < 100; i += 2)
+         allRemoved = m.erase(i) && allRemoved;
+      // verify
+      assertUnit(allRemoved);
+      assertUnit(m.size() == 50);
+      bool right = true;
+      for (int i = 0; i < 100; i++)
+         right = right && m.contains(i) == (i % 2 == 1);
+      assertUnit(right);
+      assertUnit(isTreap(m.root.load()));
+   }  // teardown
+
+   // erasing what is not there changes nothing
+   void test_erase_missing()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      m.insert(1, 1);
+      m.insert(3, 3);
+      auto pRoot = m.root.load();
+      // exercise
+      bool removed = m.erase(2);
+      // verify
+      assertUnit(!removed);
+      assertUnit(m.size() == 2);
+      assertUnit(m.root.load() == pRoot);
+   }  // teardown
+
+   /***************************************
+    * SNAPSHOT
+    ***************************************/
+
+   // a view walks the map in order
+   void test_snapshot_inOrder()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      for (int i = 0; i < 100; i++)
+         m.insert((i * 71) % 100, i);
+      std::vector<int> keys;
+      // exercise
+      {
+         auto view = m.snapshot();
+         assertUnit(activeReaders(m) == 1);
+         for (auto it = view.begin(); it != view.end(); ++it)
+            keys.push_back((*it).first);
+      }
+      // verify
+      assertUnit(keys.size() == 100);
+      bool inOrder = true;
+      for (int i = 0; i < (int)keys.size(); i++)
+         inOrder = inOrder && keys[i] == i;
+      assertUnit(inOrder);
+      assertUnit(activeReaders(m) == 0);
+   }  // teardown
+
+   // writes after a view is taken do not show up in it
+   void test_snapshot_unchangedByWrites()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      for (int i = 0; i < 50; i++)
+         m.insert(i, i);
+      auto view = m.snapshot();
+      // exercise
+      for (int i = 0; i < 50; i++)
+      {
+         m.erase(i);
+         m.insert(i + 1000, i);
+      }
+      // verify
+      int num = 0;
+      bool same = true;
+      for (auto it = view.begin(); it != view.end(); ++it, num++)
+         same = same && (*it).first == num && (*it).second == num;
+      assertUnit(same);
+      assertUnit(num == 50);
+      assertUnit(!m.contains(0));
+      assertUnit(m.contains(1000));
+   }  // teardown
+
+   /***************************************
+    * RECLAMATION
+    ***************************************/
+
+   // with nobody reading, what a write replaces is freed at once
+   void test_reclaim_noReaders()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         m.insert(i, i);
+      for (int i = 0; i < 100; i += 3)
+         m.erase(i);
+      // verify
+      assertUnit(m.retired.empty());
+      assertUnit(m.created.empty());
+   }  // teardown
+
+   // a reader holds back only what it might still see
+   void test_reclaim_heldByReader()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      for (int i = 0; i < 100; i++)
+         m.insert(i, i);
+      size_t numHeld = 0;
+      // exercise
+      {
+         auto view = m.snapshot();
+         m.erase(50);
+         numHeld = m.retired.size();
+      }
+      m.insert(500, 500);
+      // verify
+      assertUnit(numHeld > 0);
+      assertUnit(m.retired.empty());
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // readers only ever see whole versions while writers churn
+   void test_threads_readersAndWriters()
+   {  // setup
+      custom::concurrent_map <int, int> m;
+      for (int i = 0; i < 500; i += 2)
+         m.insert(i, i * 2);
+      std::atomic<bool> done(false);
+      std::atomic<bool> valid(true);
+      // exercise
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&m, &done, &valid, t]()
+         {
+            unsigned int seed = 1999 + t;
+            while (!done.load())
+            {
+               seed = seed * 1103515245 + 12345;
+               int k = (int)(seed >> 16) % 500;
+               int v = -1;
+               if (m.find(k, v) && v != k * 2)
+                  valid = false;
+               if (seed & 0x1000)
+               {
+                  auto view = m.snapshot();
+                  int prev = -1;
+                  for (auto it = view.begin(); it != view.end(); ++it)
+                  {
+                     if ((*it).first <= prev || (*it).second != (*it).first * 2)
+                        valid = false;
+                     prev = (*it).first;
+                  }
+               }
+            }
+         }));
+      for (int t = 0; t < 2; t++)
+         threads.push_back(std::thread([&m, t]()
+         {
+            unsigned int seed = 7 + t;
+            for (int i = 0; i < 2000; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               int k = (int)(seed >> 16) % 500;
+               if (seed & 0x100)
+                  m.erase(k);
+               else
+                  m.insert_or_assign(k, k * 2);
+            }
+         }));
+      for (size_t t = 4; t < threads.size(); t++)
+         threads[t].join();
+      done = true;
+      for (size_t t = 0; t < 4; t++)
+         threads[t].join();
+      // verify
+      assertUnit(valid.load());
+      assertUnit(activeReaders(m) == 0);
+      assertUnit(isTreap(m.root.load()));
+      auto view = m.snapshot();
+      size_t num = 0;
+      for (auto it = view.begin(); it != view.end(); ++it)
+         num++;
+      assertUnit(num == m.size());
+   }  // teardown
+
+   /*************************************************************
+    * ACTIVE READERS
+    * How many slots are claimed
+    *************************************************************/
+   template <class Map>
+   int activeReaders(const Map & m)
+   {
+      int num = 0;
+      for (auto & slot : m.slots)
+         num += slot.epoch.load() ? 1 : 0;
+      return num;
+   }
+
+   /*************************************************************
+    * IS TREAP
+    * Keys in order and every priority no less than its children's
+    *************************************************************/
+   template <class Node>
+   bool isTreap(const Node * p, const Node * pLow = nullptr, const Node * pHigh = nullptr)
+   {
+      if (!p)
+         return true;
+      if ((pLow && !(pLow->data.first < p->data.first)) ||
+          (pHigh && !(p->data.first < pHigh->data.first)))
+         return false;
+      if ((p->pLeft && p->pLeft->priority > p->priority) ||
+          (p->pRight && p->pRight->priority > p->priority))
+         return false;
+      return isTreap(p->pLeft, pLow, p) && isTreap(p->pRight, p, pHigh);
+   }
+};
+
+#endif // DEBUG
@@ -15,7 +15,10 @@
 #include "testSpy.h"       // for the spy unit tests
 #include "testPair.h"      // for the pair unit tests
 #include "testBST.h"       // for the BST unit tests
+#include "testBTree.h"     // for the B tree unit tests
 #include "testMap.h"       // for the map unit tests
+#include "testConcurrentMap.h" // for the concurrent map unit tests
+#include "testPersistentMap.h" // for the persistent map unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -29,7 +32,10 @@ int main()
    TestSpy().run();
    TestPair().run();
    TestBST().run();
+   TestBTree().run();
    TestMap().run();
+   TestConcurrentMap().run();
+   TestPersistentMap().run();
 #endif // DEBUG
    
    return 0;
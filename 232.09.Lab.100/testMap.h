@@ -11,7 +11,9 @@
 #ifdef DEBUG
 
 #include "map.h"        // class under test
+#include "flatMap.h"    // class under test
 #include "unitTest.h"   // unit test baseclass
+#include "spy.h"        // for counting what a lookup builds
 
 
 #include <map>
@@ -121,6 +123,43 @@ public:
       test_size_empty();
       test_size_standard();
 
+      // Balancing
+      test_balance_splay();
+      test_balance_bulkLoad();
+
+      // Order Statistics
+      test_order_nthRank();
+
+      // Bounds
+      test_bound_range();
+
+      // Hinted Insert
+      test_hint_ingest();
+
+      // B Tree Layout
+      test_btree_wordCount();
+
+      // Lookup by Key
+      test_lookup_findBuildsNothing();
+      test_lookup_subscriptHit();
+      test_lookup_subscriptMiss();
+      test_lookup_boundsBuildNothing();
+
+      // Compare
+      test_compare_descending();
+      test_compare_descendingBTree();
+      test_compare_emptyTakesNoRoom();
+
+      // Split and Join
+      test_split_standard();
+      test_join_standard();
+
+      // Flat
+      test_flat_batchInsert();
+      test_flat_findBuildsNothing();
+      test_flat_subscript();
+      test_flat_eraseSplitJoin();
+
       report("Map");
    }
 
@@ -546,6 +585,488 @@ public:
       teardownStandardFixture(m);
    }
 
+   /***************************************
+    * BALANCING
+    *    map <K, V, splay>
+    ***************************************/
+
+   // another balancing policy behaves just like the default
+   void test_balance_splay()
+   {  // setup
+      custom::map <int, int, custom::splay> m;
+      std::map <int, int> mExpected;
+      // exercise
+      for (int i = 0; i < 500; i++)
+      {
+         int key = (i * 71) % 211;
+         if (i % 3 == 2)
+         {
+            m.erase(key);
+            mExpected.erase(key);
+         }
+         else
+         {
+            m[key] += i;
+            mExpected[key] += i;
+         }
+      }
+      // verify
+      assertUnit(m.size() == mExpected.size());
+      bool same = true;
+      auto itExpected = mExpected.begin();
+      for (auto it = m.begin(); it != m.end(); ++it, ++itExpected)
+         same = same && (*it).first == itExpected->first && (*it).second == itExpected->second;
+      assertUnit(same);
+   }  // teardown
+
+   // pairs sorted by key load straight into a balanced tree,
+   // and the first of a repeated key wins
+   void test_balance_bulkLoad()
+   {  // setup
+      std::vector<custom::pair<int, int>> v;
+      for (int i = 0; i < 200; i++)
+         v.push_back(custom::pair<int, int>(i / 2, i));
+      // exercise
+      custom::map <int, int> m(v.begin(), v.end());
+      custom::map <int, int> mAssumed(custom::assume_sorted, v.begin(), v.end());
+      // verify
+      assertUnit(m.size() == 100);
+      assertUnit(mAssumed.size() == 100);
+      assertUnit(m[7] == 14);
+      assertUnit(mAssumed[99] == 198);
+      assertUnit(m.bst.root != nullptr && m.bst.root->data.first == 50);
+   }  // teardown
+
+   /***************************************
+    * ORDER STATISTICS
+    *    map::nth(k), map::rank(k), distance()
+    ***************************************/
+
+   // find by position, position by key, and count between
+   void test_order_nthRank()
+   {  // setup
+      custom::map <std::string, int> m;
+      m["delta"] = 4;
+      m["alpha"] = 1;
+      m["echo"] = 5;
+      m["charlie"] = 3;
+      m["bravo"] = 2;
+      // exercise
+      auto itThird = m.nth(2);
+      size_t rankDelta = m.rank("delta");
+      size_t rankCat = m.rank("cat");
+      // verify
+      assertUnit(itThird != m.end() && (*itThird).first == "charlie");
+      assertUnit((*m.nth(4)).second == 5);
+      assertUnit(m.nth(5) == m.end());
+      assertUnit(rankDelta == 3);
+      assertUnit(rankCat == 2);
+      assertUnit(distance(m.begin(), m.end()) == 5);
+      assertUnit(distance(m.find("bravo"), m.find("echo")) == 3);
+   }  // teardown
+
+   /***************************************
+    * BOUNDS
+    *    map::lower_bound(k), map::upper_bound(k)
+    *    map::equal_range(k), map::range(a, b)
+    ***************************************/
+
+   // a range scan touches only the keys from a up to b
+   void test_bound_range()
+   {  // setup
+      custom::map <int, int> m;
+      for (int i = 0; i < 100; i++)
+         m[(i * 37) % 100 * 10] = i;         // keys 0, 10, ... 990
+      std::vector<int> keys;
+      // exercise
+      auto range = m.range(245, 300);
+      for (auto it = range.first; it != range.second; ++it)
+         keys.push_back((*it).first);
+      auto rangeBackwards = m.range(300, 245);
+      auto rangeExact = m.equal_range(500);
+      // verify
+      assertUnit(keys == std::vector<int>({ 250, 260, 270, 280, 290 }));
+      assertUnit(rangeBackwards.first == rangeBackwards.second);
+      assertUnit((*rangeExact.first).first == 500);
+      assertUnit((*rangeExact.second).first == 510);
+      assertUnit((*m.upper_bound(985)).first == 990);
+      assertUnit(m.lower_bound(991) == m.end());
+   }  // teardown
+
+   /***************************************
+    * HINTED INSERT
+    *    map::insert(hint, pair), map::emplace_hint(hint, args)
+    ***************************************/
+
+   // mostly increasing timestamps with an end() hint
+   void test_hint_ingest()
+   {  // setup
+      custom::map <int, int> m;
+      std::map <int, int> mExpected;
+      // exercise
+      for (int i = 0; i < 500; i++)
+      {
+         int stamp = (i % 7 == 6) ? i - 20 : i;   // a few arrive late
+         m.emplace_hint(m.end(), stamp, i);
+         mExpected.emplace_hint(mExpected.end(), stamp, i);
+      }
+      m.insert(m.begin(), custom::pair<int, int>(250, -1));  // already there
+      // verify
+      assertUnit(m.size() == mExpected.size());
+      bool same = true;
+      auto itExpected = mExpected.begin();
+      for (auto it = m.begin(); it != m.end(); ++it, ++itExpected)
+         same = same && (*it).first == itExpected->first && (*it).second == itExpected->second;
+      assertUnit(same);
+      assertUnit(m[250] == 250);
+   }  // teardown
+
+   /***************************************
+    * B TREE LAYOUT
+    *    map <K, V, btree_layout <> >
+    ***************************************/
+
+   // count words in a B+ tree, then drop the rare ones
+   void test_btree_wordCount()
+   {  // setup
+      custom::map <std::string, int, custom::btree_layout <128> > m;
+      std::map <std::string, int> mExpected;
+      // exercise
+      for (int i = 0; i < 3000; i++)
+      {
+         std::string word = std::to_string((i * 7919) % 400 + (i % 3) * 1000);
+         m[word]++;
+         mExpected[word]++;
+      }
+      for (auto it = mExpected.begin(); it != mExpected.end(); ++it)
+         if (it->second < 4)
+            m.erase(it->first);
+      for (auto it = mExpected.begin(); it != mExpected.end(); )
+         it = (it->second < 4) ? mExpected.erase(it) : std::next(it);
+      // verify
+      assertUnit(m.size() == mExpected.size());
+      bool same = true;
+      auto itExpected = mExpected.begin();
+      for (auto it = m.begin(); it != m.end() && itExpected != mExpected.end(); ++it, ++itExpected)
+         same = same && (*it).first == itExpected->first && (*it).second == itExpected->second;
+      assertUnit(same);
+   }  // teardown
+
+   /***************************************
+    * LOOKUP BY KEY
+    *    map::find(k), map::operator[](k), map::lower_bound(k)
+    ***************************************/
+
+   // find compares the key against each pair, building no pair
+   void test_lookup_findBuildsNothing()
+   {  // setup
+      custom::map <Spy, Spy> m;
+      setupSpyFixture(m);
+      Spy key(20);
+      Spy::reset();
+      // exercise
+      auto it = m.find(key);
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(it != m.end() && (*it).first.get() == 20);
+   }  // teardown
+
+   // subscripting a key that is there builds nothing
+   void test_lookup_subscriptHit()
+   {  // setup
+      custom::map <Spy, Spy> m;
+      setupSpyFixture(m);
+      Spy key(30);
+      Spy::reset();
+      // exercise
+      Spy & value = m[key];
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(value == Spy(300));
+   }  // teardown
+
+   // subscripting a new key builds just the pair that goes in
+   void test_lookup_subscriptMiss()
+   {  // setup
+      custom::map <Spy, Spy> m;
+      setupSpyFixture(m);
+      Spy key(25);
+      Spy::reset();
+      // exercise
+      m[key];
+      // verify
+      assertUnit(Spy::numDefault() == 1);     // the value
+      assertUnit(Spy::numCopy() == 1);        // the key
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(m.size() == 4);
+   }  // teardown
+
+   // bounds and ranges, in a BST or a B+ tree, build nothing either
+   void test_lookup_boundsBuildNothing()
+   {  // setup
+      custom::map <Spy, Spy> m;
+      custom::map <Spy, Spy, custom::btree_layout <> > mBTree;
+      setupSpyFixture(m);
+      setupSpyFixture(mBTree);
+      Spy key15(15);
+      Spy key30(30);
+      Spy::reset();
+      // exercise
+      auto itLower = m.lower_bound(key15);
+      auto itUpper = m.upper_bound(key30);
+      auto range = mBTree.equal_range(key30);
+      auto itFound = mBTree.find(key15);
+      size_t rank = m.rank(key30);
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(itLower != m.end() && (*itLower).first.get() == 20);
+      assertUnit(itUpper == m.end());
+      assertUnit(range.first != mBTree.end() && (*range.first).first.get() == 30);
+      assertUnit(range.second == mBTree.end());
+      assertUnit(itFound == mBTree.end());
+      assertUnit(rank == 2);
+   }  // teardown
+
+   /***************************************
+    * COMPARE
+    *    map <K, V, Balance, Compare>
+    ***************************************/
+
+   // std::greater keeps the biggest key first
+   void test_compare_descending()
+   {  // setup
+      custom::map <int, std::string, custom::red_black, std::greater<int> > m;
+      // exercise
+      m[20] = "twenty";
+      m[40] = "forty";
+      m[10] = "ten";
+      m[30] = "thirty";
+      // verify
+      std::vector<int> keys;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         keys.push_back((*it).first);
+      assertUnit(keys == std::vector<int>({ 40, 30, 20, 10 }));
+      assertUnit(m.at(30) == "thirty");
+      assertUnit(m.find(25) == m.end());
+      assertUnit((*m.lower_bound(25)).first == 20);
+      auto range = m.range(40, 20);
+      assertUnit(range.first != m.end() && (*range.first).first == 40);
+      assertUnit(range.second != m.end() && (*range.second).first == 20);
+      assertUnit(m.key_comp()(2, 1));
+   }  // teardown
+
+   // a btree takes the same Compare
+   void test_compare_descendingBTree()
+   {  // setup
+      custom::map <int, int, custom::btree_layout <64>, std::greater<int> > m;
+      // exercise
+      for (int i = 0; i < 300; i++)
+         m[i * 7 % 300] = i;
+      // verify
+      int prev = 300;
+      bool descending = true;
+      for (auto it = m.begin(); it != m.end(); ++it)
+      {
+         descending = descending && (*it).first == prev - 1;
+         prev = (*it).first;
+      }
+      assertUnit(descending);
+      assertUnit(prev == 0);
+      assertUnit(m[7] == 1);
+   }  // teardown
+
+   // the map keeps the comparator, so a pair is just its two halves
+   // and std::less adds nothing to the map either
+   void test_compare_emptyTakesNoRoom()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(sizeof(custom::pair <int, int>) == 2 * sizeof(int));
+      assertUnit(sizeof(custom::map <int, int>) == 3 * sizeof(void *));
+      assertUnit(sizeof(custom::map <int, int, custom::red_black, std::greater<int> >) ==
+                 sizeof(custom::map <int, int>));
+   }  // teardown
+
+   /***************************************
+    * SPLIT and JOIN
+    ***************************************/
+
+   // split by key, and no pair is built or copied to do it
+   void test_split_standard()
+   {  // setup
+      custom::map <int, Spy> m;
+      for (int i = 0; i < 50; i++)
+         m[i] = Spy(i);
+      Spy::reset();
+      // exercise
+      custom::map <int, Spy> mHigh = m.split(10);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(m.size() == 10);
+      assertUnit(mHigh.size() == 40);
+      assertUnit(m.find(9) != m.end());
+      assertUnit(m.find(10) == m.end());
+      assertUnit((*mHigh.begin()).first == 10);
+      assertUnit(mHigh.at(49).get() == 49);
+   }  // teardown
+
+   // join puts the pairs of both in one map, in order
+   void test_join_standard()
+   {  // setup
+      custom::map <std::string, int> m{ { "apple", 1 }, { "bean", 2 } };
+      custom::map <std::string, int> mLater{ { "cherry", 3 }, { "date", 4 }, { "elm", 5 } };
+      custom::map <std::string, int> mEarlier{ { "aardvark", 0 } };
+      // exercise
+      m.join(mLater);
+      bool thrown = false;
+      try
+      {
+         m.join(mEarlier);
+      }
+      catch (const char * error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.size() == 5);
+      assertUnit(mLater.empty());
+      assertUnit(mEarlier.size() == 1);
+      std::string keys;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         keys += (*it).first[0];
+      assertUnit(keys == "abcde");
+      assertUnit(m["date"] == 4);
+   }  // teardown
+
+   /***************************************
+    * FLAT
+    *    flat_map
+    ***************************************/
+
+   // a batch goes in with one merge, the first of any key winning
+   void test_flat_batchInsert()
+   {  // setup
+      custom::flat_map <int, std::string> m{ { 20, "old" }, { 40, "old" } };
+      std::vector<custom::pair <int, std::string> > batch;
+      batch.push_back(custom::pair <int, std::string> (30, "first"));
+      batch.push_back(custom::pair <int, std::string> (20, "new"));
+      batch.push_back(custom::pair <int, std::string> (30, "second"));
+      batch.push_back(custom::pair <int, std::string> (10, "new"));
+      // exercise
+      m.insert(batch.begin(), batch.end());
+      // verify
+      assertUnit(m.size() == 4);
+      assertUnit(m.at(10) == "new");
+      assertUnit(m.at(20) == "old");
+      assertUnit(m.at(30) == "first");
+      assertUnit(m.at(40) == "old");
+      assertUnit(m.capacity() == 6);
+      assertUnit(m.rank(30) == 2);
+      assertUnit((*m.nth(3)).first == 40);
+   }  // teardown
+
+   // the binary search compares the key against each pair, building no pair
+   void test_flat_findBuildsNothing()
+   {  // setup
+      custom::flat_map <Spy, Spy> m;
+      setupSpyFixture(m);
+      Spy key(20);
+      Spy keyBetween(25);
+      Spy::reset();
+      // exercise
+      auto it = m.find(key);
+      auto itLower = m.lower_bound(keyBetween);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(it != m.end() && (*it).first.get() == 20);
+      assertUnit(itLower != m.end() && (*itLower).first.get() == 30);
+   }  // teardown
+
+   // a hit changes the value in place; a miss goes in where it belongs
+   void test_flat_subscript()
+   {  // setup
+      custom::flat_map <std::string, int> m{ { "apple", 1 }, { "cherry", 3 } };
+      bool thrown = false;
+      // exercise
+      m["apple"] = 10;
+      m["bean"] = 2;
+      try
+      {
+         m.at("date");
+      }
+      catch (const std::out_of_range & error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.size() == 3);
+      std::string keys;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         keys += (*it).first[0];
+      assertUnit(keys == "abc");
+      assertUnit(m.at("apple") == 10);
+      assertUnit(m["bean"] == 2);
+   }  // teardown
+
+   // erase a range, split off the top, and join it back
+   void test_flat_eraseSplitJoin()
+   {  // setup
+      custom::flat_map <int, int> m;
+      for (int i = 0; i < 10; i++)
+         m[i] = i * i;
+      custom::flat_map <int, int> mEarlier{ { -1, 1 } };
+      bool thrown = false;
+      // exercise
+      auto itNext = m.erase(m.find(2), m.find(5));
+      size_t numRemoved = m.erase(7);
+      custom::flat_map <int, int> mHigh = m.split(6);
+      try
+      {
+         m.join(mEarlier);
+      }
+      catch (const char * error)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit((*itNext).first == 5);
+      assertUnit(numRemoved == 1);
+      assertUnit(m.size() == 3);
+      assertUnit(mHigh.size() == 3);
+      assertUnit(thrown);
+      m.join(mHigh);
+      std::vector<int> keys;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         keys.push_back((*it).first);
+      assertUnit(keys == std::vector<int>({ 0, 1, 5, 6, 8, 9 }));
+      assertUnit(m.at(8) == 64);
+   }  // teardown
+
+   // 10 -> 100, 20 -> 200, 30 -> 300
+   template <class Map>
+   void setupSpyFixture(Map & m)
+   {
+      for (int i = 1; i <= 3; i++)
+         m.insert(custom::pair <Spy, Spy> (Spy(i * 10), Spy(i * 100)));
+   }
+
    /***************************************
     * ASSIGNMENT
     *    map::operator=(const map &)
@@ -0,0 +1,412 @@
+/***********************************************************************
+ * Header:
+ *    TEST PERSISTENT MAP
+ * Summary:
+ *    Unit tests for persistent_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+#ifdef DEBUG
+
+#include "persistentMap.h" // class under test
+#include "unitTest.h"      // unit test baseclass
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************
+ * TEST PERSISTENT MAP
+ * Unit tests for the persistent_map class
+ ***********************************************/
+class TestPersistentMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+
+      // Insert
+      test_insert_standard();
+      test_insert_duplicate();
+      test_insertOrAssign_standard();
+
+      // Remove
+      test_erase_standard();
+      test_erase_missing();
+
+      // Snapshot
+      test_snapshot_sharesRoot();
+      test_snapshot_unchangedByWrites();
+      test_snapshot_copiesOnlyThePath();
+      test_snapshot_freedWithLastVersion();
+
+      // Threads
+      test_threads_snapshotsWhileWriting();
+
+      report("PersistentMap");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // default constructor: no tree
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::persistent_map <int, int> m;
+      // verify
+      assertUnit(m.pairs.root == nullptr);
+      assertUnit(m.empty());
+      assertUnit(m.size() == 0);
+      assertUnit(m.begin() == m.end());
+      assertUnit(!m.contains(3));
+   }  // teardown
+
+   // initializer list: in order, first of each key wins
+   void test_construct_initializerList()
+   {  // setup
+      // exercise
+      custom::persistent_map <std::string, int> m{ { "b", 2 }, { "a", 1 }, { "b", 9 } };
+      // verify
+      assertUnit(m.size() == 2);
+      assertUnit(m.at("a") == 1);
+      assertUnit(m.at("b") == 2);
+      auto it = m.begin();
+      assertUnit((*it).first == "a");
+      ++it;
+      assertUnit((*it).first == "b");
+      ++it;
+      assertUnit(it == m.end());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert many, find them all
+   void test_insert_standard()
+   {  // setup
+      custom::persistent_map <int, std::string> m;
+      bool allAdded = true;
+      // exercise
+      for (int i = 0; i < 200; i++)
+         allAdded = m.insert((i * 37) % 200, std::to_string(i)) && allAdded;
+      // verify
+      assertUnit(allAdded);
+      assertUnit(m.size() == 200);
+      bool allFound = true;
+      for (int i = 0; i < 200; i++)
+         allFound = allFound && m.contains((i * 37) % 200) &&
+                    m.at((i * 37) % 200) == std::to_string(i);
+      assertUnit(allFound);
+      assertUnit(isTreap(m.pairs.root));
+      assertUnit(allOwnedOnce(m.pairs.root));
+   }  // teardown
+
+   // insert leaves the first value, and the tree, alone
+   void test_insert_duplicate()
+   {  // setup
+      custom::persistent_map <int, int> m{ { 5, 50 }, { 3, 30 } };
+      auto pRoot = m.pairs.root;
+      // exercise
+      bool added = m.insert(5, 99);
+      // verify
+      assertUnit(!added);
+      assertUnit(m.at(5) == 50);
+      assertUnit(m.size() == 2);
+      assertUnit(m.pairs.root == pRoot);   // nothing was copied
+   }  // teardown
+
+   // insert_or_assign replaces the value with a copy of the node
+   void test_insertOrAssign_standard()
+   {  // setup
+      custom::persistent_map <int, int> m;
+      for (int i = 0; i < 20; i++)
+         m.insert(i, i);
+      // exercise
+      bool addedOld = m.insert_or_assign(7, 700);
+      bool addedNew = m.insert_or_assign(70, 7000);
+      // verify
+      assertUnit(!addedOld);
+      assertUnit(addedNew);
+      assertUnit(m.at(7) == 700);
+      assertUnit(m.at(70) == 7000);
+      assertUnit(m.size() == 21);
+      assertUnit(isTreap(m.pairs.root));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase every other one
+   void test_erase_standard()
+   {  // setup
+      custom::persistent_map <int, int> m;
+      for (int i = 0; i < 100; i++)
+         m.insert(i, i * 2);
+      size_t numRemoved = 0;
+      // exercise
+      for (int i = 0; i < 100; i += 2)
+         numRemoved += m.erase(i);
+      // verify
+      assertUnit(numRemoved == 50);
+      assertUnit(m.size() == 50);
+      bool right = true;
+      for (int i = 0; i < 100; i++)
+         right = right && m.contains(i) == (i % 2 == 1);
+      assertUnit(right);
+      assertUnit(isTreap(m.pairs.root));
+      assertUnit(allOwnedOnce(m.pairs.root));
+   }  // teardown
+
+   // erasing what is not there changes nothing
+   void test_erase_missing()
+   {  // setup
+      custom::persistent_map <int, int> m{ { 1, 1 }, { 3, 3 } };
+      auto pRoot = m.pairs.root;
+      // exercise
+      size_t numRemoved = m.erase(2);
+      // verify
+      assertUnit(numRemoved == 0);
+      assertUnit(m.size() == 2);
+      assertUnit(m.pairs.root == pRoot);
+   }  // teardown
+
+   /***************************************
+    * SNAPSHOT
+    ***************************************/
+
+   // a snapshot is the same tree, counted twice
+   void test_snapshot_sharesRoot()
+   {  // setup
+      custom::persistent_map <int, int> m;
+      for (int i = 0; i < 100; i++)
+         m.insert(i, i);
+      // exercise
+      auto snap = m.snapshot();
+      // verify
+      assertUnit(snap.pairs.root == m.pairs.root);
+      assertUnit(m.pairs.root->refs.load() == 2);
+      assertUnit(snap.size() == 100);
+   }  // teardown
+
+   // writes after a snapshot is taken do not show up in it
+   void test_snapshot_unchangedByWrites()
+   {  // setup
+      custom::persistent_map <int, int> m;
+      for (int i = 0; i < 50; i++)
+         m.insert(i, i);
+      auto snap = m.snapshot();
+      // exercise
+      for (int i = 0; i < 50; i++)
+      {
+         m.erase(i);
+         m.insert(i + 1000, i);
+      }
+      m.insert_or_assign(1000, -1);
+      // verify
+      int num = 0;
+      bool same = true;
+      for (auto it = snap.begin(); it != snap.end(); ++it, num++)
+         same = same && (*it).first == num && (*it).second == num;
+      assertUnit(same);
+      assertUnit(num == 50);
+      assertUnit(snap.size() == 50);
+      assertUnit(m.size() == 50);
+      assertUnit(!m.contains(0));
+      assertUnit(m.at(1000) == -1);
+      assertUnit(isTreap(snap.pairs.root));
+      assertUnit(isTreap(m.pairs.root));
+   }  // teardown
+
+   // an insert after a snapshot makes only the nodes on its path
+   void test_snapshot_copiesOnlyThePath()
+   {  // setup
+      custom::persistent_map <int, int> m;
+      for (int i = 0; i < 1000; i++)
+         m.insert((i * 7919) % 1000, i);
+      auto snap = m.snapshot();
+      std::set<const void *> before;
+      nodesOf(snap.pairs.root, before);
+      // exercise
+      m.insert(5000, 5000);
+      m.erase(500);
+      // verify
+      std::set<const void *> after;
+      nodesOf(m.pairs.root, after);
+      size_t numNew = 0;
+      for (auto p : after)
+         numNew += before.count(p) ? 0 : 1;
+      assertUnit(after.size() == 1000);
+      assertUnit(numNew <= 2 * (size_t)depth(snap.pairs.root) + 1);
+      assertUnit(numNew < 60);
+   }  // teardown
+
+   // what only an old version can reach goes when it does
+   void test_snapshot_freedWithLastVersion()
+   {  // setup
+      live() = 0;
+      {
+         custom::persistent_map <int, Counted> m;
+         for (int i = 0; i < 100; i++)
+            m.insert(i, Counted());
+         int numAlone = live();
+         // exercise
+         {
+            auto snap = m.snapshot();
+            for (int i = 0; i < 100; i += 2)
+               m.erase(i);
+            assertUnit(live() > numAlone);
+         }
+         // verify
+         assertUnit(live() == 50);
+      }
+      assertUnit(live() == 0);
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // a reader walks the snapshots it is handed while the writer goes on
+   void test_threads_snapshotsWhileWriting()
+   {  // setup
+      custom::persistent_map <int, int> m;
+      for (int i = 0; i < 500; i += 2)
+         m.insert(i, i * 2);
+      std::mutex lock;
+      std::vector<custom::persistent_map <int, int> > handed;
+      bool done = false;
+      bool valid = true;
+      size_t numRead = 0;
+      // exercise
+      std::thread reader([&]()
+      {
+         while (true)
+         {
+            custom::persistent_map <int, int> snap;
+            {
+               std::lock_guard<std::mutex> guard(lock);
+               if (handed.empty())
+               {
+                  if (done)
+                     return;
+                  continue;
+               }
+               snap = std::move(handed.back());
+               handed.pop_back();
+            }
+            int prev = -1;
+            size_t num = 0;
+            for (auto it = snap.begin(); it != snap.end(); ++it, num++)
+            {
+               if ((*it).first <= prev || (*it).second != (*it).first * 2)
+                  valid = false;
+               prev = (*it).first;
+            }
+            if (num != snap.size())
+               valid = false;
+            numRead++;
+         }
+      });
+      unsigned int seed = 7;
+      for (int i = 0; i < 2000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int k = (int)(seed >> 16) % 500;
+         if (seed & 0x100)
+            m.erase(k);
+         else
+            m.insert_or_assign(k, k * 2);
+         if (i % 50 == 0)
+         {
+            std::lock_guard<std::mutex> guard(lock);
+            handed.push_back(m.snapshot());
+         }
+      }
+      {
+         std::lock_guard<std::mutex> guard(lock);
+         done = true;
+      }
+      reader.join();
+      // verify
+      assertUnit(valid);
+      assertUnit(numRead == 40);
+      assertUnit(isTreap(m.pairs.root));
+      assertUnit(allOwnedOnce(m.pairs.root));
+   }  // teardown
+
+   /*************************************************************
+    * COUNTED
+    * A value that knows how many of it there are
+    *************************************************************/
+   static int & live()
+   {
+      static int num = 0;
+      return num;
+   }
+   struct Counted
+   {
+      Counted()                 { live()++; }
+      Counted(const Counted &)  { live()++; }
+     ~Counted()                 { live()--; }
+      Counted & operator = (const Counted &) { return *this; }
+   };
+
+   /*************************************************************
+    * IS TREAP
+    * Keys in order and every priority no less than its children's
+    *************************************************************/
+   template <class Node>
+   bool isTreap(const Node * p, const Node * pLow = nullptr, const Node * pHigh = nullptr)
+   {
+      if (!p)
+         return true;
+      if ((pLow && !(pLow->data.first < p->data.first)) ||
+          (pHigh && !(p->data.first < pHigh->data.first)))
+         return false;
+      if ((p->pLeft && p->pLeft->priority > p->priority) ||
+          (p->pRight && p->pRight->priority > p->priority))
+         return false;
+      return isTreap(p->pLeft, pLow, p) && isTreap(p->pRight, p, pHigh);
+   }
+
+   /*************************************************************
+    * ALL OWNED ONCE
+    * With no other versions about, every node has one ref
+    *************************************************************/
+   template <class Node>
+   bool allOwnedOnce(const Node * p)
+   {
+      return !p || (p->refs.load() == 1 && allOwnedOnce(p->pLeft) && allOwnedOnce(p->pRight));
+   }
+
+   template <class Node>
+   void nodesOf(const Node * p, std::set<const void *> & nodes)
+   {
+      if (!p)
+         return;
+      nodes.insert(p);
+      nodesOf(p->pLeft, nodes);
+      nodesOf(p->pRight, nodes);
+   }
+
+   template <class Node>
+   int depth(const Node * p)
+   {
+      return p ? 1 + std::max(depth(p->pLeft), depth(p->pRight)) : 0;
+   }
+};
+
+#endif // DEBUG
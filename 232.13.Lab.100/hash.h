@@ -43,47 +43,68 @@ public:
    //
    // Construct
    //
-   unordered_set() : numElements(0)                   { }
-   unordered_set(unordered_set &  rhs)                { *this = rhs;     }
-   unordered_set(unordered_set && rhs)                { *this = std::move(rhs); }
-   unordered_set(const std::initializer_list<T>& il)  { *this = il; }
+   unordered_set() : buckets(initial), numBuckets(10), numElements(0) { }
+   unordered_set(unordered_set &  rhs)               : unordered_set() { *this = rhs;     }
+   unordered_set(unordered_set && rhs)               : unordered_set() { *this = std::move(rhs); }
+   unordered_set(const std::initializer_list<T>& il) : unordered_set() { *this = il; }
    
    template <class Iterator>
-   unordered_set(Iterator first, Iterator last) : numElements(0) { insert(first, last); }
+   unordered_set(Iterator first, Iterator last) : unordered_set() { insert(first, last); }
    
-   unordered_set(const T & t, size_t num)
+   unordered_set(const T & t, size_t num) : unordered_set()
    {
       reserve(num);
       for (size_t i = 0; i < num; i++)
          insert(t);
       assert(numElements == num);
    }
+  ~unordered_set() { if (buckets != initial) delete [] buckets; }
 
    //
    // Assign
    //
    unordered_set & operator = (unordered_set & rhs)
    {
+      // every element must land in the same bucket as in rhs
+      if (numBuckets != rhs.numBuckets)
+      {
+         release();
+         if (rhs.buckets != rhs.initial)
+         {
+            buckets = new custom::list<T>[rhs.numBuckets];
+            numBuckets = rhs.numBuckets;
+         }
+      }
       numElements = rhs.numElements;
-      for (size_t i = 0; i < 10; i++)
+      for (size_t i = 0; i < numBuckets; i++)
          buckets[i] = rhs.buckets[i];
       return *this;
    }
    
    unordered_set & operator = (unordered_set && rhs)
    {
-      // numElements = std::move(rhs.numElements);
-      numElements = 0;
+      release();
+      if (rhs.buckets == rhs.initial)
+      {
+         for (size_t i = 0; i < 10; i++)
+            initial[i] = std::move(rhs.initial[i]);
+      }
+      else
+      {
+         // take the whole array, leaving rhs its initial buckets
+         buckets = rhs.buckets;
+         numBuckets = rhs.numBuckets;
+         rhs.buckets = rhs.initial;
+         rhs.numBuckets = 10;
+      }
       std::swap(numElements, rhs.numElements);
-      for (size_t i = 0; i < 10; i++)
-         buckets[i] = std::move(rhs.buckets[i]);
       return *this;
    }
    
    unordered_set & operator=(const std::initializer_list<T>& il)
    {
       clear();
-      reserve(il.size);
+      reserve(il.size());
       for (auto & i : il)
          insert(i);
       return *this;
@@ -91,9 +112,9 @@ public:
    
    void swap(unordered_set & rhs)
    {
-      std::swap(numElements, rhs.numElements);
-      for (size_t i = 0; i < 10; i++)
-         std::swap(buckets[i], rhs.buckets[i]);
+      unordered_set tmp(std::move(rhs));
+      rhs = std::move(*this);
+      *this = std::move(tmp);
    }
 
    // 
@@ -103,7 +124,7 @@ public:
    class local_iterator;
    
    iterator begin();
-   iterator end() { return iterator(&buckets[10], &buckets[10], buckets[0].end()); }
+   iterator end() { return iterator(buckets + numBuckets, buckets + numBuckets, buckets[0].end()); }
 
    local_iterator begin(size_t iBucket) { return local_iterator(buckets[iBucket].begin()); }
    local_iterator end(size_t iBucket)   { return local_iterator(buckets[iBucket].end()); }
@@ -116,9 +137,10 @@ public:
    iterator find(const T & t);
    
    //
-   // Reserve
+   // Reserve: make room for num elements without growing again
    //
-   void reserve(size_t num) { numElements = num; }
+   void reserve(size_t num) { rehash(min_buckets_required(num)); }
+   void rehash(size_t num);
 
    //
    // Insert
@@ -158,12 +180,21 @@ public:
    //
    size_t size() const { return numElements; }
    bool empty() const { return !numElements; }
-   size_t bucket_count() const { return 10; }
+   size_t bucket_count() const { return numBuckets; }
    size_t bucket_size(size_t i) const { return buckets[i].size(); }
+   float load_factor() const { return (float)numElements / (float)numBuckets; }
+   float max_load_factor() const { return 1.0; }
 
 private:
+   size_t min_buckets_required(size_t num) const
+   {
+      return (size_t)std::ceil((float)num / max_load_factor());
+   }
+   void release();
 
-   custom::list<T> buckets [10]; // exactly 10 buckets (empty lists)
+   custom::list<T> initial [10]; // the first 10 buckets, used until we outgrow them
+   custom::list<T> * buckets;    // initial, or a bigger array from the heap
+   size_t numBuckets;            // how many lists buckets points to
    int numElements;              // number of elements in the Hash
 };
 
@@ -329,12 +360,9 @@ custom::pair<typename custom::unordered_set<T>::iterator, bool> unordered_set<T>
    if (it != end())
       return ReturnPair(it, false /* did not insert */);
    
-   // rehash/reserve more space if we are already at the limit (115 option)
-   // if (min_buckets_required(numElements + 1) > bucket_count())
-   // {
-   //    reserve(numElements * 2);
-   //    iBucket = bucket(element);
-   // }
+   // rehash to twice the buckets if we are already at the limit
+   if (min_buckets_required(numElements + 1) > bucket_count())
+      rehash(bucket_count() * 2);
    
    // actually insert the new element on the back of the bucket
    auto iBucket = bucket(t);
@@ -344,23 +372,71 @@ custom::pair<typename custom::unordered_set<T>::iterator, bool> unordered_set<T>
    // return the results
    return ReturnPair(iterator( // iterator pointing to new element
       &buckets[iBucket],       // list<T>* pBucket
-      &buckets[10],            // list<T>* pBucketEnd
+      buckets + numBuckets,    // list<T>* pBucketEnd
       buckets[iBucket].find(t) // list<T>::iterator itList
    ), true /* did insert */);
 }
 
+/*****************************************
+ * UNORDERED SET :: REHASH
+ * Grow to at least num buckets.  The nodes are spliced
+ * into their new buckets, so no element is copied.
+ *    INPUT  : the number of buckets wanted
+ *    COST   : O(n + num)
+ ****************************************/
+template <typename T>
+void unordered_set<T>::rehash(size_t num)
+{
+   if (num <= numBuckets)
+      return;
+
+   custom::list<T> * bucketsNew = new custom::list<T>[num];
+   for (size_t i = 0; i < numBuckets; i++)
+      while (!buckets[i].empty())
+      {
+         auto it = buckets[i].begin();
+         custom::list<T> & bucketNew = bucketsNew[hash(*it) % num];
+         bucketNew.splice(bucketNew.end(), buckets[i], it);
+      }
+
+   if (buckets != initial)
+      delete [] buckets;
+   buckets = bucketsNew;
+   numBuckets = num;
+}
+
+/*****************************************
+ * UNORDERED SET :: RELEASE
+ * Drop every element and go back to the initial buckets
+ ****************************************/
+template <typename T>
+void unordered_set<T>::release()
+{
+   for (size_t i = 0; i < 10; i++)
+      initial[i].clear();
+   if (buckets != initial)
+      delete [] buckets;
+   buckets = initial;
+   numBuckets = 10;
+   numElements = 0;
+}
+
+/*****************************************
+ * UNORDERED SET :: BEGIN
+ * The first element of the first non-empty bucket
+ ****************************************/
 template <typename T>
 typename custom::unordered_set<T>::iterator custom::unordered_set<T>::begin()
 {
    // look for first non-empty bucket
-   for (size_t i = 0; i < 10; i++)
+   for (size_t i = 0; i < numBuckets; i++)
    {
       if (!buckets[i].empty())
       {
          // return begin() from the first non-empty bucket
          return iterator(
             &buckets[i],       // list<T>* pBucket
-            &buckets[10],       // list<T>* pBucketEnd
+            buckets + numBuckets, // list<T>* pBucketEnd
             buckets[i].begin() // list<T>::iterator itList
          );
       }
@@ -95,6 +95,13 @@ public:
    void clear();
    iterator erase(const iterator & it);
 
+   //
+   // Splice: these relink nodes, never allocate or copy
+   //
+   void splice(iterator pos, list & rhs);
+   void splice(iterator pos, list & rhs, iterator it);
+   void splice(iterator pos, list & rhs, iterator first, iterator last);
+
    // 
    // Status
    //
@@ -105,6 +112,9 @@ private:
    // nested linked list class
    class Node;
 
+   // hook a detached chain of nodes in front of pPos
+   void transfer(Node * pPos, Node * pFirst, Node * pLast);
+
    // member variables
    size_t numElements; // though we could count, it is faster to keep a variable
    Node * pHead;       // pointer to the beginning of the list
@@ -144,7 +154,7 @@ public:
    ************************************************/
    void insertAfter(Node * newNode)
    {
-      if (!this || !newNode) return; // one of the tests has NULL for the this pointer for some reason
+      if (!newNode) return;
 
       // attach new node to this and this->pNext
       newNode->pNext = pNext;
@@ -160,7 +170,7 @@ public:
 
    void insertBefore(Node * newNode)
    {
-      if (!this || !newNode) return;
+      if (!newNode) return;
 
       // attach new node to this and this->pPrev
       newNode->pNext = this;
@@ -599,7 +609,11 @@ typename list<T>::iterator list<T>::insert(list<T>::iterator it, const T & data,
 {
    Node * newNode = new Node(data);
 
-   if (it == end())
+   // an empty list: the new node is both ends
+   if (!pTail)
+      pHead = pTail = newNode;
+
+   else if (it == end())
       pTail->insertAfter(newNode);
 
    else if (after)
@@ -624,7 +638,11 @@ typename list<T>::iterator list<T>::insert(list<T>::iterator it, T && data, bool
 {
    Node * newNode = new Node(std::move(data));
 
-   if (it == end())
+   // an empty list: the new node is both ends
+   if (!pTail)
+      pHead = pTail = newNode;
+
+   else if (it == end())
       pTail->insertAfter(newNode);
 
    else if (after)
@@ -644,6 +662,119 @@ typename list<T>::iterator list<T>::insert(list<T>::iterator it, T && data, bool
    return list<T>::iterator(newNode);
 }
 
+/******************************************
+* LIST :: TRANSFER
+* hook an already-detached chain of nodes into this list
+*     INPUT  : the node to put the chain in front of (nullptr for the end)
+*              the first and last nodes of the chain
+*     COST   : O(1)
+******************************************/
+template <typename T>
+void list <T> ::transfer(Node * pPos, Node * pFirst, Node * pLast)
+{
+   Node * pBefore = pPos ? pPos->pPrev : pTail;
+
+   pFirst->pPrev = pBefore;
+   pLast->pNext = pPos;
+
+   if (pBefore)
+      pBefore->pNext = pFirst;
+   else
+      pHead = pFirst;
+
+   if (pPos)
+      pPos->pPrev = pLast;
+   else
+      pTail = pLast;
+}
+
+/******************************************
+* LIST :: SPLICE
+* move every node of rhs in front of pos
+*     INPUT  : where the nodes go and the list they come from
+*     COST   : O(1)
+******************************************/
+template <typename T>
+void list <T> ::splice(iterator pos, list <T> & rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   transfer(pos.p, rhs.pHead, rhs.pTail);
+   numElements += rhs.numElements;
+
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+}
+
+/******************************************
+* LIST :: SPLICE
+* move one node of rhs (which may be this list) in front of pos
+*     INPUT  : where the node goes, the list, and the node
+*     COST   : O(1)
+******************************************/
+template <typename T>
+void list <T> ::splice(iterator pos, list <T> & rhs, iterator it)
+{
+   Node * pMove = it.p;
+   if (!pMove)
+      return;
+
+   // already where it belongs?
+   if (&rhs == this && (pMove == pos.p || pMove->pNext == pos.p))
+      return;
+
+   // unhook it from rhs
+   if (pMove->pPrev)
+      pMove->pPrev->pNext = pMove->pNext;
+   else
+      rhs.pHead = pMove->pNext;
+   if (pMove->pNext)
+      pMove->pNext->pPrev = pMove->pPrev;
+   else
+      rhs.pTail = pMove->pPrev;
+   rhs.numElements--;
+
+   transfer(pos.p, pMove, pMove);
+   numElements++;
+}
+
+/******************************************
+* LIST :: SPLICE
+* move the nodes [first, last) of rhs in front of pos
+*     INPUT  : where the nodes go, the list, and the range
+*     COST   : O(1) within one list, otherwise O(range)
+*              because we must count what moved
+******************************************/
+template <typename T>
+void list <T> ::splice(iterator pos, list <T> & rhs, iterator first, iterator last)
+{
+   if (first == last)
+      return;
+
+   Node * pFirst = first.p;
+   Node * pLast = last.p ? last.p->pPrev : rhs.pTail;
+
+   size_t num = 0;
+   if (&rhs != this)
+      for (Node * p = pFirst; p != last.p; p = p->pNext)
+         num++;
+
+   // unhook the range from rhs
+   if (pFirst->pPrev)
+      pFirst->pPrev->pNext = last.p;
+   else
+      rhs.pHead = last.p;
+   if (last.p)
+      last.p->pPrev = pFirst->pPrev;
+   else
+      rhs.pTail = pFirst->pPrev;
+
+   transfer(pos.p, pFirst, pLast);
+   rhs.numElements -= num;
+   numElements += num;
+}
+
 /**********************************************
 * SWAP
 * Swap the list from LHS to RHS
@@ -0,0 +1,399 @@
+/***********************************************************************
+ * Header:
+ *    LRU CACHE
+ * Summary:
+ *    A fixed-capacity key/value cache that throws out the least recently
+ *    used entry when it is full. Entries sit in a list ordered by recency
+ *    and an unordered_set finds an entry's node by key, so lookups,
+ *    updates and evictions all avoid walking the list.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        lru_cache         : A least recently used cache
+ *        sharded_lru_cache : Several lru_caches, each behind its own lock
+ * Author
+ *    Carol Mercau
+ *    Elijah Harrison
+ *    Hunter Powell
+ ************************************************************************/
+
+#pragma once
+
+#include "list.h"     // for the recency order
+#include "hash.h"     // for finding an entry by key
+#include <cstdint>    // for uint64_t
+#include <functional> // for std::hash and std::function
+#include <memory>     // for std::unique_ptr
+#include <mutex>      // for std::mutex
+#include <vector>     // for std::vector
+
+class TestLruCache;         // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * LRU CACHE
+ * Holds at most capacity() entries
+ ************************************************/
+template <typename K, typename V>
+class lru_cache
+{
+   friend class ::TestLruCache;   // give unit tests access to the privates
+public:
+   // what the cache has seen since it was made or last reset
+   struct Stats
+   {
+      size_t hits;
+      size_t misses;
+      size_t evictions;
+   };
+
+   // called with each entry just before it is evicted
+   typedef std::function<void(const K & key, V & value)> EvictCallback;
+
+   //
+   // Construct
+   //
+   lru_cache(size_t capacity) : maxSize(capacity), counts{ 0, 0, 0 } { }
+   lru_cache(const lru_cache & rhs) = delete;
+   lru_cache & operator = (const lru_cache & rhs) = delete;
+  ~lru_cache() { clear(); }
+
+   //
+   // Access: a hit makes the entry the most recently used
+   //
+   V * find(const K & key);
+   bool get(const K & key, V & value);
+   bool contains(const K & key) { return index.find(probe(key)) != index.end(); }
+
+   //
+   // Insert: add or overwrite, evicting if full
+   //
+   void put(const K & key, const V &  value) { emplace(key, value);            }
+   void put(const K & key,       V && value) { emplace(key, std::move(value)); }
+
+   //
+   // Remove
+   //
+   bool erase(const K & key);
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size()      const { return recent.size(); }
+   size_t capacity()  const { return maxSize;       }
+   bool empty()       const { return recent.empty(); }
+   const Stats & stats() const { return counts; }
+   void reset_stats()       { counts = Stats{ 0, 0, 0 }; }
+   void on_evict(EvictCallback callback) { onEvict = callback; }
+
+private:
+   struct Entry
+   {
+      K key;
+      V value;
+   };
+   typedef typename list<Entry>::iterator Position;
+   class Slot;
+
+   Slot probe(const K & key) const { return Slot(&key, std::hash<K>()(key)); }
+   template <class U>
+   void emplace(const K & key, U && value);
+   void evict();
+
+   list<Entry> recent;        // most recently used at the front
+   unordered_set<Slot> index; // one slot per entry in recent
+   size_t maxSize;            // never hold more than this many entries
+   Stats counts;              // hits, misses, and evictions
+   EvictCallback onEvict;     // may be empty
+};
+
+/************************************************
+ * LRU CACHE :: SLOT
+ * What the unordered_set holds.  It hashes to the key's
+ * hash and compares by key, and it remembers where the
+ * entry is in the recency list.  The key it points to
+ * lives in that list node, which never moves.
+ ************************************************/
+template <typename K, typename V>
+class lru_cache <K, V> ::Slot
+{
+public:
+   Slot() : pKey(nullptr), code(0) { }
+   Slot(const K * pKey, size_t code, Position it = Position()) : pKey(pKey), code(code), it(it) { }
+
+   // unordered_set finds the bucket by casting to size_t
+   operator size_t () const { return code; }
+   bool operator == (const Slot & rhs) const { return code == rhs.code && *pKey == *rhs.pKey; }
+
+   const K * pKey;   // the key, inside the list node
+   size_t code;      // the key's hash, computed once
+   Position it;      // the entry in the recency list
+};
+
+/*****************************************
+ * LRU CACHE :: FIND
+ * Look up a key and mark it most recently used
+ *    INPUT  : the key
+ *    OUTPUT : the value, or nullptr on a miss
+ *    COST   : O(1) list work plus one bucket search
+ ****************************************/
+template <typename K, typename V>
+V * lru_cache <K, V> ::find(const K & key)
+{
+   auto itSlot = index.find(probe(key));
+   if (itSlot == index.end())
+   {
+      counts.misses++;
+      return nullptr;
+   }
+
+   counts.hits++;
+   Position it = (*itSlot).it;
+   recent.splice(recent.begin(), recent, it);
+   return &(*it).value;
+}
+
+/*****************************************
+ * LRU CACHE :: GET
+ * Like find, but copy the value out
+ *    INPUT  : the key, and where to put its value
+ *    OUTPUT : whether the key was there
+ ****************************************/
+template <typename K, typename V>
+bool lru_cache <K, V> ::get(const K & key, V & value)
+{
+   V * pValue = find(key);
+   if (!pValue)
+      return false;
+   value = *pValue;
+   return true;
+}
+
+/*****************************************
+ * LRU CACHE :: EMPLACE
+ * Overwrite an existing entry or add a new one at the
+ * front, making room by evicting from the back
+ *    INPUT  : the key and value
+ ****************************************/
+template <typename K, typename V>
+template <class U>
+void lru_cache <K, V> ::emplace(const K & key, U && value)
+{
+   Slot slot = probe(key);
+   auto itSlot = index.find(slot);
+   if (itSlot != index.end())
+   {
+      Position it = (*itSlot).it;
+      (*it).value = std::forward<U>(value);
+      recent.splice(recent.begin(), recent, it);
+      return;
+   }
+
+   if (maxSize == 0)
+      return;
+   if (recent.size() >= maxSize)
+      evict();
+
+   recent.push_front(Entry{ key, std::forward<U>(value) });
+   slot.pKey = &recent.front().key;
+   slot.it = recent.begin();
+   index.insert(slot);
+}
+
+/*****************************************
+ * LRU CACHE :: ERASE
+ * Remove one entry without calling the eviction callback
+ *    INPUT  : the key
+ *    OUTPUT : whether the key was there
+ ****************************************/
+template <typename K, typename V>
+bool lru_cache <K, V> ::erase(const K & key)
+{
+   auto itSlot = index.find(probe(key));
+   if (itSlot == index.end())
+      return false;
+
+   Position it = (*itSlot).it;
+   index.erase(*itSlot);
+   recent.erase(it);
+   return true;
+}
+
+/*****************************************
+ * LRU CACHE :: CLEAR
+ * Remove every entry.  The slots point into the list
+ * so they have to go first.
+ ****************************************/
+template <typename K, typename V>
+void lru_cache <K, V> ::clear()
+{
+   index.clear();
+   recent.clear();
+}
+
+/*****************************************
+ * LRU CACHE :: EVICT
+ * Throw out the least recently used entry
+ ****************************************/
+template <typename K, typename V>
+void lru_cache <K, V> ::evict()
+{
+   Position it = recent.rbegin();
+   if (onEvict)
+      onEvict((*it).key, (*it).value);
+
+   index.erase(probe((*it).key));
+   recent.erase(it);
+   counts.evictions++;
+}
+
+/************************************************
+ * SHARDED LRU CACHE
+ * Splits the key space over several independent
+ * lru_caches so threads working on different keys
+ * rarely wait for each other.  Recency is tracked per
+ * shard, so the entry evicted is the least recently
+ * used in its shard rather than in the whole cache.
+ ************************************************/
+template <typename K, typename V>
+class sharded_lru_cache
+{
+   friend class ::TestLruCache;   // give unit tests access to the privates
+public:
+   typedef typename lru_cache<K, V>::Stats Stats;
+   typedef typename lru_cache<K, V>::EvictCallback EvictCallback;
+
+   //
+   // Construct: the capacity is divided as evenly as it can be
+   //
+   sharded_lru_cache(size_t capacity, size_t numShards);
+
+   //
+   // Access and Insert
+   //
+   bool get(const K & key, V & value)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard<std::mutex> guard(shard.lock);
+      return shard.cache.get(key, value);
+   }
+   void put(const K & key, const V & value)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard<std::mutex> guard(shard.lock);
+      shard.cache.put(key, value);
+   }
+
+   //
+   // Remove
+   //
+   bool erase(const K & key)
+   {
+      Shard & shard = shardOf(key);
+      std::lock_guard<std::mutex> guard(shard.lock);
+      return shard.cache.erase(key);
+   }
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size() const;
+   size_t capacity() const { return maxSize; }
+   Stats stats() const;
+
+   // the callback runs while its shard is locked
+   void on_evict(EvictCallback callback);
+
+private:
+   struct Shard
+   {
+      Shard(size_t capacity) : cache(capacity) { }
+      mutable std::mutex lock;
+      lru_cache<K, V> cache;
+   };
+
+   // the index inside a shard also uses the hash, so mix it before
+   // choosing a shard or every key in a shard would share a bucket
+   Shard & shardOf(const K & key)
+   {
+      uint64_t mixed = (uint64_t)std::hash<K>()(key) * 0x9E3779B97F4A7C15ull;
+      return *shards[(size_t)(mixed >> 32) % shards.size()];
+   }
+
+   std::vector<std::unique_ptr<Shard>> shards;
+   size_t maxSize;
+};
+
+/*****************************************
+ * SHARDED LRU CACHE :: CONSTRUCTOR
+ * The first capacity % numShards shards get one extra
+ ****************************************/
+template <typename K, typename V>
+sharded_lru_cache <K, V> ::sharded_lru_cache(size_t capacity, size_t numShards) : maxSize(capacity)
+{
+   if (numShards == 0)
+      numShards = 1;
+   for (size_t i = 0; i < numShards; i++)
+      shards.push_back(std::unique_ptr<Shard>(new Shard(capacity / numShards + (i < capacity % numShards ? 1 : 0))));
+}
+
+/*****************************************
+ * SHARDED LRU CACHE :: CLEAR, SIZE, STATS, ON EVICT
+ * Visit every shard in turn, one lock at a time
+ ****************************************/
+template <typename K, typename V>
+void sharded_lru_cache <K, V> ::clear()
+{
+   for (auto & pShard : shards)
+   {
+      std::lock_guard<std::mutex> guard(pShard->lock);
+      pShard->cache.clear();
+   }
+}
+
+template <typename K, typename V>
+size_t sharded_lru_cache <K, V> ::size() const
+{
+   size_t num = 0;
+   for (auto & pShard : shards)
+   {
+      std::lock_guard<std::mutex> guard(pShard->lock);
+      num += pShard->cache.size();
+   }
+   return num;
+}
+
+template <typename K, typename V>
+typename sharded_lru_cache <K, V> ::Stats sharded_lru_cache <K, V> ::stats() const
+{
+   Stats total{ 0, 0, 0 };
+   for (auto & pShard : shards)
+   {
+      std::lock_guard<std::mutex> guard(pShard->lock);
+      total.hits      += pShard->cache.stats().hits;
+      total.misses    += pShard->cache.stats().misses;
+      total.evictions += pShard->cache.stats().evictions;
+   }
+   return total;
+}
+
+template <typename K, typename V>
+void sharded_lru_cache <K, V> ::on_evict(EvictCallback callback)
+{
+   for (auto & pShard : shards)
+   {
+      std::lock_guard<std::mutex> guard(pShard->lock);
+      pShard->cache.on_evict(callback);
+   }
+}
+
+} // namespace custom
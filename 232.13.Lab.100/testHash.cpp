@@ -16,6 +16,7 @@
 #include "testPair.h"       // for the pair unit tests
 #include "testHash.h"       // for the hash unit tests
 #include "testList.h"       // for the list unit tests
+#include "testLruCache.h"   // for the lru cache unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -30,6 +31,7 @@ int main()
    TestPair().run();
    TestList().run();
    TestHash().run();
+   TestLruCache().run();
 #endif // DEBUG
    
    // driver
@@ -0,0 +1,459 @@
+/***********************************************************************
+ * Header:
+ *    TEST LRU CACHE
+ * Summary:
+ *    Unit tests for lru_cache and sharded_lru_cache
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "lruCache.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestLruCache : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_empty();
+      test_construct_shards();
+
+      // Find and Get
+      test_find_miss();
+      test_find_hitMovesToFront();
+      test_find_hitDoesNotCopy();
+      test_get_copiesValue();
+      test_contains_doesNotTouch();
+
+      // Put
+      test_put_overwrite();
+      test_put_evictsLeastRecent();
+      test_put_evictCallback();
+      test_put_capacityZero();
+
+      // Remove
+      test_erase_present();
+      test_erase_missing();
+      test_clear_standard();
+
+      // Workloads
+      test_zipf_hitRate();
+      test_fill_bucketLoad();
+      test_sharded_standard();
+      test_sharded_threads();
+
+      report("LruCache");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a new cache is empty
+   void test_construct_empty()
+   {  // setup
+      // exercise
+      custom::lru_cache<int, std::string> cache(3);
+      // verify
+      assertUnit(cache.empty());
+      assertUnit(cache.size() == 0);
+      assertUnit(cache.capacity() == 3);
+      assertUnit(cache.stats().hits == 0);
+      assertUnit(cache.stats().misses == 0);
+      assertUnit(cache.stats().evictions == 0);
+   }  // teardown
+
+   // capacity is spread over the shards
+   void test_construct_shards()
+   {  // setup
+      // exercise
+      custom::sharded_lru_cache<int, int> cache(10, 4);
+      // verify
+      assertUnit(cache.shards.size() == 4);
+      assertUnit(cache.capacity() == 10);
+      assertUnit(cache.shards[0]->cache.capacity() == 3);
+      assertUnit(cache.shards[1]->cache.capacity() == 3);
+      assertUnit(cache.shards[2]->cache.capacity() == 2);
+      assertUnit(cache.shards[3]->cache.capacity() == 2);
+   }  // teardown
+
+   /***************************************
+    * FIND AND GET
+    ***************************************/
+
+   // a missing key counts as a miss
+   void test_find_miss()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      std::string * pValue = cache.find(99);
+      // verify
+      assertUnit(pValue == nullptr);
+      assertUnit(cache.stats().misses == 1);
+      assertUnit(cache.stats().hits == 0);
+      assertStandardFixture(cache);
+   }  // teardown
+
+   // a hit becomes the most recently used
+   void test_find_hitMovesToFront()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      std::string * pValue = cache.find(11);
+      // verify
+      assertUnit(pValue != nullptr);
+      if (pValue)
+         assertUnit(*pValue == std::string("eleven"));
+      assertUnit(cache.stats().hits == 1);
+      assertUnit(keysAre(cache, { 11, 31, 26 }));
+   }  // teardown
+
+   // moving to the front relinks a node; the value is left alone
+   void test_find_hitDoesNotCopy()
+   {  // setup
+      custom::lru_cache<int, Spy> cache(3);
+      cache.put(11, Spy(11));
+      cache.put(26, Spy(26));
+      Spy::reset();
+      // exercise
+      Spy * pValue = cache.find(11);
+      // verify
+      assertUnit(pValue != nullptr);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(keysAre(cache, { 11, 26 }));
+   }  // teardown
+
+   // get copies the value out
+   void test_get_copiesValue()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      std::string value;
+      // exercise
+      bool found = cache.get(26, value);
+      bool missing = cache.get(99, value);
+      // verify
+      assertUnit(found);
+      assertUnit(!missing);
+      assertUnit(value == std::string("twenty-six"));
+      assertUnit(cache.stats().hits == 1);
+      assertUnit(cache.stats().misses == 1);
+   }  // teardown
+
+   // contains() neither reorders nor counts
+   void test_contains_doesNotTouch()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      bool there = cache.contains(11);
+      bool notThere = cache.contains(99);
+      // verify
+      assertUnit(there);
+      assertUnit(!notThere);
+      assertUnit(cache.stats().hits == 0);
+      assertUnit(cache.stats().misses == 0);
+      assertStandardFixture(cache);
+   }  // teardown
+
+   /***************************************
+    * PUT
+    ***************************************/
+
+   // putting a key that is there replaces the value and moves it up
+   void test_put_overwrite()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      cache.put(11, std::string("ELEVEN"));
+      // verify
+      assertUnit(cache.size() == 3);
+      assertUnit(cache.stats().evictions == 0);
+      assertUnit(keysAre(cache, { 11, 31, 26 }));
+      assertUnit(*cache.find(11) == std::string("ELEVEN"));
+   }  // teardown
+
+   // a full cache throws out whatever was used longest ago
+   void test_put_evictsLeastRecent()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      cache.find(11);
+      // exercise
+      cache.put(42, std::string("forty-two"));
+      // verify
+      assertUnit(cache.size() == 3);
+      assertUnit(cache.stats().evictions == 1);
+      assertUnit(!cache.contains(26));
+      assertUnit(keysAre(cache, { 42, 11, 31 }));
+   }  // teardown
+
+   // the callback sees the evicted entry before it goes
+   void test_put_evictCallback()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      std::vector<int> keys;
+      std::vector<std::string> values;
+      cache.on_evict([&](const int & key, std::string & value)
+      {
+         keys.push_back(key);
+         values.push_back(value);
+      });
+      // exercise
+      cache.put(42, std::string("forty-two"));
+      cache.put(43, std::string("forty-three"));
+      cache.erase(31);
+      // verify
+      assertUnit(keys == std::vector<int>({ 11, 26 }));
+      assertUnit(values.size() == 2);
+      if (values.size() == 2)
+         assertUnit(values[0] == std::string("eleven"));
+      assertUnit(cache.stats().evictions == 2);
+   }  // teardown
+
+   // nothing fits in a cache of zero
+   void test_put_capacityZero()
+   {  // setup
+      custom::lru_cache<int, int> cache(0);
+      // exercise
+      cache.put(1, 1);
+      // verify
+      assertUnit(cache.empty());
+      assertUnit(cache.find(1) == nullptr);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase an entry in the middle
+   void test_erase_present()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      bool erased = cache.erase(26);
+      // verify
+      assertUnit(erased);
+      assertUnit(cache.size() == 2);
+      assertUnit(cache.index.size() == 2);
+      assertUnit(keysAre(cache, { 31, 11 }));
+      assertUnit(cache.stats().evictions == 0);
+   }  // teardown
+
+   // erase something that is not there
+   void test_erase_missing()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      bool erased = cache.erase(99);
+      // verify
+      assertUnit(!erased);
+      assertStandardFixture(cache);
+   }  // teardown
+
+   // clear empties both the list and the index
+   void test_clear_standard()
+   {  // setup
+      custom::lru_cache<int, std::string> cache(3);
+      setupStandardFixture(cache);
+      // exercise
+      cache.clear();
+      // verify
+      assertUnit(cache.empty());
+      assertUnit(cache.index.empty());
+      assertUnit(!cache.contains(11));
+   }  // teardown
+
+   /***************************************
+    * WORKLOADS
+    ***************************************/
+
+   // with a skewed workload, a small cache catches most requests
+   void test_zipf_hitRate()
+   {  // setup
+      custom::lru_cache<int, int> cache(50);
+      Zipf zipf(1000);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int key = zipf.next();
+         if (!cache.find(key))
+            cache.put(key, key);
+      }
+      // verify
+      size_t total = cache.stats().hits + cache.stats().misses;
+      assertUnit(total == 20000);
+      assertUnit(cache.size() == 50);
+      assertUnit(cache.stats().evictions == cache.stats().misses - 50);
+      // 5% of the keys, but well over a third of the requests
+      assertUnit(cache.stats().hits * 3 > total);
+   }  // teardown
+
+   // a large cache grows its index so the buckets stay short
+   void test_fill_bucketLoad()
+   {  // setup
+      custom::lru_cache<int, int> cache(100000);
+      // exercise
+      for (int i = 0; i < 100000; i++)
+         cache.put(i, i);
+      // verify
+      assertUnit(cache.size() == 100000);
+      assertUnit(cache.index.bucket_count() >= 100000);
+      assertUnit(cache.index.load_factor() <= cache.index.max_load_factor());
+      size_t longest = 0;
+      for (size_t i = 0; i < cache.index.bucket_count(); i++)
+         longest = std::max(longest, cache.index.bucket_size(i));
+      assertUnit(longest <= 8);
+   }  // teardown
+
+   // the sharded cache behaves like one big cache for a few keys
+   void test_sharded_standard()
+   {  // setup
+      custom::sharded_lru_cache<int, std::string> cache(40, 4);
+      // exercise
+      cache.put(11, std::string("eleven"));
+      cache.put(26, std::string("twenty-six"));
+      std::string value;
+      bool found = cache.get(26, value);
+      bool erased = cache.erase(11);
+      bool missing = cache.get(11, value);
+      // verify
+      assertUnit(found);
+      assertUnit(value == std::string("twenty-six"));
+      assertUnit(erased);
+      assertUnit(!missing);
+      assertUnit(cache.size() == 1);
+      assertUnit(cache.stats().hits == 1);
+      assertUnit(cache.stats().misses == 1);
+   }  // teardown
+
+   // several threads at once never push it past capacity
+   void test_sharded_threads()
+   {  // setup
+      custom::sharded_lru_cache<int, int> cache(64, 8);
+      const int numThreads = 4;
+      const int numOps = 5000;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&cache, t]()
+         {
+            Zipf zipf(500, 17 + t);
+            for (int i = 0; i < numOps; i++)
+            {
+               int key = zipf.next();
+               int value;
+               if (!cache.get(key, value))
+                  cache.put(key, key);
+               else
+                  assert(value == key);
+            }
+         }));
+      for (auto & thread : threads)
+         thread.join();
+      // verify
+      assertUnit(cache.size() <= 64);
+      assertUnit(cache.stats().hits + cache.stats().misses == (size_t)(numThreads * numOps));
+      assertUnit(cache.stats().hits > 0);
+   }  // teardown
+
+   /****************************************************************
+    * Zipf
+    * Key k in [1, n] comes up with probability proportional to 1/k.
+    * Deterministic so the tests always see the same requests.
+    ****************************************************************/
+   class Zipf
+   {
+   public:
+      Zipf(int n, unsigned int seed = 12345) : seed(seed)
+      {
+         double sum = 0.0;
+         for (int k = 1; k <= n; k++)
+            cdf.push_back(sum += 1.0 / k);
+         for (auto & c : cdf)
+            c /= sum;
+      }
+
+      int next()
+      {
+         seed = seed * 1103515245 + 12345;
+         double u = (double)((seed >> 8) & 0xFFFFFF) / (double)0x1000000;
+         size_t lo = 0;
+         size_t hi = cdf.size() - 1;
+         while (lo < hi)
+         {
+            size_t mid = (lo + hi) / 2;
+            if (cdf[mid] < u)
+               lo = mid + 1;
+            else
+               hi = mid;
+         }
+         return (int)lo + 1;
+      }
+
+   private:
+      std::vector<double> cdf;
+      unsigned int seed;
+   };
+
+   /****************************************************************
+    * Keys Are
+    * The keys from most to least recently used
+    ****************************************************************/
+   template <class V>
+   bool keysAre(custom::lru_cache<int, V> & cache, const std::vector<int> & keys)
+   {
+      std::vector<int> actual;
+      for (auto it = cache.recent.begin(); it != cache.recent.end(); ++it)
+         actual.push_back((*it).key);
+      return actual == keys && cache.index.size() == keys.size();
+   }
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *    most recent  31 - 26 - 11  least recent
+    ****************************************************************/
+   void setupStandardFixture(custom::lru_cache<int, std::string> & cache)
+   {
+      cache.put(11, std::string("eleven"));
+      cache.put(26, std::string("twenty-six"));
+      cache.put(31, std::string("thirty-one"));
+      cache.reset_stats();
+   }
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *    most recent  31 - 26 - 11  least recent
+    ****************************************************************/
+   void assertStandardFixtureParameters(custom::lru_cache<int, std::string> & cache, int line, const char * function)
+   {
+      assertIndirect(cache.size() == 3);
+      assertIndirect(keysAre(cache, { 31, 26, 11 }));
+   }
+};
+
+#endif // DEBUG